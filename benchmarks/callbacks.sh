@@ -0,0 +1,43 @@
+#!/bin/bash
+# map / filter / reduce callback benchmark
+#
+# Runs one map, filter and reduce over (range N) with a top-level function
+# literal as the callback, once with the loop emitted in IR calling the
+# callback directly and once through franz_llvm_map / franz_llvm_filter /
+# franz_llvm_reduce (FRANZ_DIRECT_CALLBACKS=0). Times are wall time of
+# compile + run in ms, minus a script that only builds the list, so they
+# cover the N callback calls alone. Uses --no-cache so every run compiles.
+#
+# Usage: benchmarks/callbacks.sh [N] [opt level]
+#   N defaults to 10000000, opt level to -O2
+
+N=${1:-10000000}
+OPT=${2:--O2}
+
+. "$(dirname "$0")/common.sh"
+bench_franz
+bench_workdir callbacks
+
+echo "(println (length (range $N)))" > "$WORK/range.franz"
+echo "(println (length (map (range $N) {x i -> <- (multiply x 3)})))" > "$WORK/map.franz"
+echo "(println (length (filter (range $N) {x i -> <- (is (remainder x 3) 0)})))" > "$WORK/filter.franz"
+echo "(println (reduce (range $N) {acc x i -> <- (add acc x)} 0))" > "$WORK/reduce.franz"
+
+# Wall time in milliseconds with FRANZ_DIRECT_CALLBACKS=$1 on a script ($2)
+run_ms() {
+  bench_ms env FRANZ_DIRECT_CALLBACKS=$1 "$FRANZ" --no-cache $OPT "$2"
+}
+
+bench_banner "Franz map / filter / reduce Callbacks ($OPT)" "Elements: $N"
+
+base=$(run_ms 1 "$WORK/range.franz")
+echo "Building the list: $base ms (subtracted below)"
+echo ""
+printf "%-8s %12s %12s %10s\n" "" "runtime ms" "direct ms" "speedup"
+for op in map filter reduce; do
+  runtime=$(( $(run_ms 0 "$WORK/$op.franz") - base ))
+  direct=$(( $(run_ms 1 "$WORK/$op.franz") - base ))
+  [ "$direct" -lt 0 ] && direct=0  # within the noise of the list build
+  printf "%-8s %12d %12d %10s\n" "$op" "$runtime" "$direct" \
+    "$(awk "BEGIN { if ($direct > 0) printf \"%.1fx\", $runtime / $direct; else print \"-\" }")"
+done
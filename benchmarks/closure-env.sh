@@ -0,0 +1,42 @@
+#!/bin/bash
+# Closure environment allocation benchmark
+#
+# Calls a function N times; each call creates a callback that captures a local
+# and passes it to map, filter or reduce over a 3-element list. Escape
+# analysis keeps the callback's closure struct and environment in the
+# function's frame; FRANZ_STACK_CLOSURES=0 mallocs both on every call (and
+# never frees them). Reports the run stage of --time-report: wall time in ms
+# and the growth of peak RSS over the compile stages, which is what the
+# program leaks. Uses --no-cache so every run compiles.
+#
+# Usage: benchmarks/closure-env.sh [N] [opt level]
+#   N defaults to 1000000, opt level to -O2
+
+N=${1:-1000000}
+OPT=${2:--O2}
+
+. "$(dirname "$0")/common.sh"
+bench_franz
+bench_workdir closure-env
+
+# Each callback captures k from the enclosing function
+body() {
+  printf 'run = {n ->\n  k = 3\n  xs = [1, 2, 3]\n  <- %s\n}\n(loop %s {i -> (run i)})\n(println (run 0))\n' "$1" "$N"
+}
+body "(head (map xs {x i -> <- (add x k)}))" > "$WORK/map.franz"
+body "(head (filter xs {x i -> <- (is (remainder x k) 1)}))" > "$WORK/filter.franz"
+body "(reduce xs {acc x i -> <- (add acc (multiply x k))} 0)" > "$WORK/reduce.franz"
+
+# "<run ms> <MB leaked>" with FRANZ_STACK_CLOSURES=$1 on a script ($2)
+run_stats() {
+  FRANZ_STACK_CLOSURES=$1 "$FRANZ" --no-cache $OPT --time-report "$2" 2>&1 >/dev/null |
+    awk '$1 == "jit" { before = $5 } $1 == "run" { printf "%.0f %.1f", $2, $4 - before }'
+}
+
+bench_banner "Franz Closure Environments ($OPT)" "Calls: $N"
+printf "%-8s %10s %10s %10s %10s\n" "" "heap ms" "stack ms" "heap MB" "stack MB"
+for op in map filter reduce; do
+  read -r heap_ms heap_mb <<< "$(run_stats 0 "$WORK/$op.franz")"
+  read -r stack_ms stack_mb <<< "$(run_stats 1 "$WORK/$op.franz")"
+  printf "%-8s %10d %10d %10.1f %10.1f\n" "$op" "$heap_ms" "$stack_ms" "$heap_mb" "$stack_mb"
+done
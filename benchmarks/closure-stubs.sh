@@ -0,0 +1,41 @@
+#!/bin/bash
+# Closure call stub benchmark
+#
+# Runs one map, filter and reduce over (range N) with a closure that captures
+# a local as the callback, so the calls always go through franz_llvm_map /
+# franz_llvm_filter / franz_llvm_reduce. Compares calling the closure's boxed
+# entry through its stub table with the generic franz_call_llvm_closure
+# trampoline (FRANZ_CLOSURE_STUBS=0). Times are wall time of compile + run in
+# ms, minus a script that only builds the list. Uses --no-cache so every run
+# compiles.
+#
+# Usage: benchmarks/closure-stubs.sh [N] [opt level]
+#   N defaults to 1000000, opt level to -O2
+
+N=${1:-1000000}
+OPT=${2:--O2}
+
+. "$(dirname "$0")/common.sh"
+bench_franz
+bench_workdir closure-stubs
+
+bench_closure_scripts "$N"
+
+# Wall time in milliseconds with FRANZ_CLOSURE_STUBS=$1 on a script ($2)
+run_ms() {
+  bench_ms env FRANZ_CLOSURE_STUBS=$1 "$FRANZ" --no-cache $OPT "$2"
+}
+
+bench_banner "Franz Closure Call Stubs ($OPT)" "Elements: $N"
+
+base=$(run_ms 1 "$WORK/range.franz")
+echo "Building the list: $base ms (subtracted below)"
+echo ""
+printf "%-8s %12s %12s %10s\n" "" "generic ms" "stubs ms" "speedup"
+for op in map filter reduce; do
+  generic=$(( $(run_ms 0 "$WORK/$op.franz") - base ))
+  stubs=$(( $(run_ms 1 "$WORK/$op.franz") - base ))
+  [ "$stubs" -lt 1 ] && stubs=1  # within the noise of the list build
+  printf "%-8s %12d %12d %10s\n" "$op" "$generic" "$stubs" \
+    "$(awk "BEGIN { printf \"%.1fx\", $generic / $stubs }")"
+done
@@ -0,0 +1,73 @@
+#!/bin/bash
+# Setup shared by the benchmark scripts: source it, then call what the script needs
+#
+#   bench_franz            FRANZ (default ./franz) must be an executable
+#   bench_runtime          SRC (FRANZ_SRC, default .) must have libfranz_runtime.a; sets CC
+#   bench_workdir NAME     WORK: a private temporary directory, removed on exit
+#   bench_driver [FLAGS]   compiles $WORK/driver.c against $SRC into $WORK/driver
+#   bench_banner TITLE [LINE]
+#   bench_ms CMD...        wall time of CMD in ms (its output is discarded)
+#   bench_closure_scripts N
+
+bench_franz() {
+  FRANZ=${FRANZ:-./franz}
+  if [ ! -x "$FRANZ" ]; then
+    echo "$FRANZ not found (run make first)"
+    exit 1
+  fi
+}
+
+bench_runtime() {
+  SRC=${FRANZ_SRC:-.}
+  CC=${CC:-cc}
+  if [ ! -f "$SRC/libfranz_runtime.a" ]; then
+    echo "$SRC/libfranz_runtime.a not found (run make first)"
+    exit 1
+  fi
+}
+
+bench_workdir() {
+  WORK=$(mktemp -d "${TMPDIR:-/tmp}/franz-$1-XXXXXX")
+  trap 'rm -rf "$WORK"' EXIT
+}
+
+# FLAGS go before the sources: -D defines, or linker options such as -Wl,--wrap
+bench_driver() {
+  if ! $CC -O2 -w "$@" -iquote "$SRC/src" "$WORK/driver.c" "$SRC/libfranz_runtime.a" -lm \
+       -o "$WORK/driver"; then
+    echo "Failed to build the driver against $SRC"
+    exit 1
+  fi
+}
+
+bench_banner() {
+  echo "========================================"
+  echo "$1"
+  echo "========================================"
+  if [ -n "$2" ]; then
+    echo "$2"
+  fi
+  echo ""
+}
+
+# $WORK/range.franz builds (range N); map, filter and reduce.franz also run one of them over
+# it, with a callback that captures a local, so it is called as a closure
+bench_closure_scripts() {
+  local name op
+  while read -r name op; do
+    printf 'run = {n ->\n  k = 3\n  xs = (range n)\n  <- %s\n}\n(println (run %s))\n' "$op" "$1" \
+      > "$WORK/$name.franz"
+  done <<'EOF'
+range (head xs)
+map (head (map xs {x i -> <- (add x k)}))
+filter (head (filter xs {x i -> <- (is (remainder x k) 1)}))
+reduce (reduce xs {acc x i -> <- (add acc (multiply x k))} 0)
+EOF
+}
+
+# Environment settings go through env: bench_ms env FRANZ_TRACE=all "$FRANZ" script.franz
+bench_ms() {
+  local TIMEFORMAT=%R t
+  t=$( { time "$@" >/dev/null 2>&1; } 2>&1 )
+  awk "BEGIN { printf \"%.0f\", $t * 1000 }"
+}
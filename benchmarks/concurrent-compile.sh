@@ -0,0 +1,68 @@
+#!/bin/bash
+# Concurrent compile stress test
+#
+# Starts many franz processes at once, each compiling and running a different
+# script, and checks that every process printed its own script's result.
+# Before per-invocation build directories, --aot processes shared
+# /tmp/franz_output* and ran each other's executables.
+#
+# Usage: benchmarks/concurrent-compile.sh [jobs] [--aot|--jit]
+#   jobs defaults to 4x the number of cores
+
+JOBS=${1:-$(( $(nproc 2>/dev/null || sysctl -n hw.ncpu) * 4 ))}
+MODE=${2:---aot}
+
+. "$(dirname "$0")/common.sh"
+bench_franz
+bench_workdir stress
+
+bench_banner "Franz Concurrent Compile Stress Test" "Jobs: $JOBS   Mode: $MODE"
+
+# One distinct script per job: sum of 0..(100 + job) plus a job marker
+for i in $(seq 1 "$JOBS"); do
+  n=$((100 + i))
+  cat > "$WORK/job-$i.franz" <<EOF
+mut sum = 0
+(loop $n {i ->
+  sum = (add sum i)
+})
+(println "job $i sum" sum)
+EOF
+  echo "job $i sum$(( n * (n - 1) / 2 ))" > "$WORK/job-$i.expected"
+done
+
+run_job() {
+  "$FRANZ" --no-cache "$MODE" "$WORK/job-$1.franz" 2>/dev/null | grep "^job " > "$WORK/job-$1.out"
+}
+
+TIMEFORMAT=%R
+
+# Serial baseline
+serial=$( { time (for i in $(seq 1 "$JOBS"); do run_job "$i"; done); } 2>&1 )
+
+# All jobs at once
+rm -f "$WORK"/*.out
+parallel=$( { time (for i in $(seq 1 "$JOBS"); do run_job "$i" & done; wait); } 2>&1 )
+
+failures=0
+for i in $(seq 1 "$JOBS"); do
+  if ! diff -q "$WORK/job-$i.expected" "$WORK/job-$i.out" >/dev/null; then
+    echo "✗ job $i: expected '$(cat "$WORK/job-$i.expected")', got '$(cat "$WORK/job-$i.out")'"
+    failures=$((failures + 1))
+  fi
+done
+
+leftover=$(find "${TMPDIR:-/tmp}" -maxdepth 1 -name 'franz-??????' -newer "$WORK/job-1.franz" 2>/dev/null | wc -l)
+
+echo "Serial:   ${serial}s"
+echo "Parallel: ${parallel}s"
+echo "Speedup:  $(awk "BEGIN { printf \"%.2f\", $serial / $parallel }")x"
+echo "Leftover build directories: $leftover"
+echo ""
+
+if [ "$failures" -eq 0 ]; then
+  echo "✓ PASS: all $JOBS outputs correct"
+else
+  echo "✗ FAIL: $failures of $JOBS outputs wrong"
+  exit 1
+fi
@@ -0,0 +1,123 @@
+#!/bin/bash
+# Persistent dict benchmark
+#
+# Links a small driver against libfranz_runtime.a and times the dict updates
+# that copied the whole dict before Dict became a persistent hash trie
+# (string keys "key-i", int values):
+#   set      N (dict_set acc key i) from an empty dict, the pattern behind
+#            building a dict in reduce or a loop
+#   update   N (dict_set dict key i) of present keys on one N-key dict, which
+#            stays alive, as with any value still bound in scope
+#   remove   N (dict_remove acc key), in random order, until the dict is empty
+#   merge    N (dict_merge dict small), small being a 4-key dict
+# With a flat table every update copies it, so set and remove are O(n^2).
+#
+# Usage: benchmarks/dict-persistent.sh [keys]
+#   keys defaults to 20000
+#   FRANZ_SRC points at the tree to measure (default: .), so two checkouts
+#   can be compared with the same driver
+
+N=${1:-20000}
+
+. "$(dirname "$0")/common.sh"
+bench_runtime
+bench_workdir dict
+
+cat > "$WORK/driver.c" <<'EOF'
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "generic.h"
+#include "dict.h"
+#include "scope.h"
+#include "stdlib.h"
+
+Generic *StdLib_dict(Scope *, Generic *[], int, int);
+Generic *StdLib_dict_set(Scope *, Generic *[], int, int);
+Generic *StdLib_dict_remove(Scope *, Generic *[], int, int);
+Generic *StdLib_dict_merge(Scope *, Generic *[], int, int);
+
+static double nowMs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void shuffle(Generic **items, int n) {
+  for (int i = n - 1; i > 0; i--) {
+    int j = rand() % (i + 1);
+    Generic *tmp = items[i];
+    items[i] = items[j];
+    items[j] = tmp;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int n = atoi(argv[1]);
+  Scope *scope = newGlobal(0, NULL);
+  srand(1);
+
+  Generic **keys = malloc(sizeof(Generic *) * n);
+  Generic **values = malloc(sizeof(Generic *) * n);
+  for (int i = 0; i < n; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "key-%d", i);
+    keys[i] = Generic_fromString(name);
+    values[i] = Generic_fromInt(i);
+  }
+
+  double start = nowMs();
+  Generic *acc = StdLib_dict(scope, NULL, 0, 0);
+  for (int i = 0; i < n; i++) {
+    Generic *setArgs[] = {acc, keys[i], values[i]};
+    Generic *next = StdLib_dict_set(scope, setArgs, 3, 0);
+    Generic_free(acc);
+    acc = next;
+  }
+  printf("%-8s %10.1f\n", "set", nowMs() - start);
+  Generic *full = acc;
+
+  start = nowMs();
+  for (int i = 0; i < n; i++) {
+    Generic *setArgs[] = {full, keys[rand() % n], values[i]};
+    Generic_free(StdLib_dict_set(scope, setArgs, 3, 0));
+  }
+  printf("%-8s %10.1f\n", "update", nowMs() - start);
+
+  shuffle(keys, n);
+  start = nowMs();
+  acc = Generic_copy(full);
+  for (int i = 0; i < n; i++) {
+    Generic *removeArgs[] = {acc, keys[i]};
+    Generic *next = StdLib_dict_remove(scope, removeArgs, 2, 0);
+    Generic_free(acc);
+    acc = next;
+  }
+  printf("%-8s %10.1f\n", "remove", nowMs() - start);
+  int emptied = Dict_size(acc->p_val);
+  Generic_free(acc);
+
+  Generic *smallArgs[] = {keys[0], values[1], keys[1], values[0],
+                          Generic_fromString("extra-a"), values[2], Generic_fromString("extra-b"), values[3]};
+  Generic *small = StdLib_dict(scope, smallArgs, 8, 0);
+  small->refCount++;
+  start = nowMs();
+  int merged = 0;
+  for (int i = 0; i < n; i++) {
+    Generic *mergeArgs[] = {full, small};
+    Generic *result = StdLib_dict_merge(scope, mergeArgs, 2, 0);
+    merged = Dict_size(result->p_val);
+    Generic_free(result);
+  }
+  printf("%-8s %10.1f\n", "merge", nowMs() - start);
+
+  printf("\nsizes: %d %d %d\n", Dict_size(full->p_val), emptied, merged);
+  return 0;
+}
+EOF
+
+bench_driver
+
+bench_banner "Franz Persistent Dict Benchmark" "Tree: $SRC   Keys: $N"
+printf "%-8s %10s\n" "stage" "ms"
+"$WORK/driver" "$N"
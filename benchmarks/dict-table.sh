@@ -0,0 +1,126 @@
+#!/bin/bash
+# Dict microbenchmark
+#
+# Links a small driver against libfranz_runtime.a and times the Dict_* API
+# directly, for each size N (string keys "key-i", int values):
+#   insert   N Dict_set_inplace into a dict that grows as it goes
+#   presized N Dict_set_inplace into a dict sized for N up front (the same as
+#            insert on trees whose Dict_new takes no size)
+#   lookup   N Dict_get of present keys, in random order
+#   miss     N Dict_get of absent keys
+#   iterate  Dict_keys + Dict_values
+#   delete   N Dict_remove_inplace, in random order (skipped on trees without it)
+# Each cell is ns per key (iterate: per entry).
+#
+# Usage: benchmarks/dict-table.sh [sizes...]
+#   sizes default to 1000 10000 100000 1000000; 10000000 needs about 2 GB
+#   FRANZ_SRC points at the tree to measure (default: .), so two checkouts
+#   can be compared with the same driver
+
+SIZES=${*:-1000 10000 100000 1000000}
+
+. "$(dirname "$0")/common.sh"
+bench_runtime
+bench_workdir dict
+
+cat > "$WORK/driver.c" <<'EOF'
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "generic.h"
+#include "dict.h"
+
+#ifdef HAVE_DICT_NEW_VOID
+#define DICT_NEW(n) Dict_new()
+#else
+#define DICT_NEW(n) Dict_new(n)
+#endif
+
+static double nowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void shuffle(Generic **items, int n) {
+  for (int i = n - 1; i > 0; i--) {
+    int j = rand() % (i + 1);
+    Generic *tmp = items[i];
+    items[i] = items[j];
+    items[j] = tmp;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int n = atoi(argv[1]);
+  srand(1);
+
+  Generic **keys = malloc(sizeof(Generic *) * n);
+  Generic **absent = malloc(sizeof(Generic *) * n);
+  Generic **values = malloc(sizeof(Generic *) * n);
+  for (int i = 0; i < n; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "key-%d", i);
+    keys[i] = Generic_fromString(name);
+    snprintf(name, sizeof(name), "absent-%d", i);
+    absent[i] = Generic_fromString(name);
+    values[i] = Generic_fromInt(i);
+  }
+
+  double start = nowNs();
+  Dict *grown = DICT_NEW(0);
+  for (int i = 0; i < n; i++) Dict_set_inplace(grown, keys[i], values[i]);
+  double insert = (nowNs() - start) / n;
+
+  start = nowNs();
+  Dict *presized = DICT_NEW(n);
+  for (int i = 0; i < n; i++) Dict_set_inplace(presized, keys[i], values[i]);
+  double presize = (nowNs() - start) / n;
+
+  shuffle(keys, n);
+  long long sum = 0;
+  start = nowNs();
+  for (int i = 0; i < n; i++) sum += Dict_get(grown, keys[i])->intVal;
+  double lookup = (nowNs() - start) / n;
+
+  start = nowNs();
+  for (int i = 0; i < n; i++) sum += Dict_get(grown, absent[i]) != NULL;
+  double miss = (nowNs() - start) / n;
+
+  start = nowNs();
+  int count;
+  Generic **allKeys = Dict_keys(grown, &count);
+  Generic **allValues = Dict_values(grown, &count);
+  for (int i = 0; i < count; i++) sum += allValues[i]->intVal + (allKeys[i] != NULL);
+  double iterate = (nowNs() - start) / n;
+
+#ifdef HAVE_REMOVE_INPLACE
+  shuffle(keys, n);
+  start = nowNs();
+  for (int i = 0; i < n; i++) Dict_remove_inplace(presized, keys[i]);
+  printf("%10d %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", n, insert, presize, lookup, miss, iterate,
+         (nowNs() - start) / n);
+#else
+  printf("%10d %9.1f %9.1f %9.1f %9.1f %9.1f %9s\n", n, insert, presize, lookup, miss, iterate, "-");
+#endif
+
+  if (sum == 42) printf("\n");  // keep the loops
+  return 0;
+}
+EOF
+
+DEFS=""
+if grep -q "Dict_remove_inplace" "$SRC/src/dict.h"; then
+  DEFS="-DHAVE_REMOVE_INPLACE"
+fi
+if grep -q "Dict_new(void)" "$SRC/src/dict.h"; then
+  DEFS="$DEFS -DHAVE_DICT_NEW_VOID"
+fi
+
+bench_driver $DEFS
+
+bench_banner "Franz Dict Benchmark (ns per key)" "Tree: $SRC"
+printf "%10s %9s %9s %9s %9s %9s %9s\n" "keys" "insert" "presized" "lookup" "miss" "iterate" "delete"
+for N in $SIZES; do
+  "$WORK/driver" "$N"
+done
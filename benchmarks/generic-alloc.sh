@@ -0,0 +1,100 @@
+#!/bin/bash
+# Generic allocation benchmark
+#
+# Links a small driver against libfranz_runtime.a with malloc/calloc/realloc
+# wrapped, builds an N-element int list and counts the allocations made by
+# map, filter and reduce over it (native add / greater_than callbacks, so only
+# the runtime's own boxing is measured). Before scalars were stored inline in
+# Generic, every boxed int cost two allocations.
+#
+# Usage: benchmarks/generic-alloc.sh [elements]
+#   elements defaults to 1000000
+#   FRANZ_SRC points at the tree to measure (default: .), so two checkouts
+#   can be compared with the same driver
+
+N=${1:-1000000}
+
+. "$(dirname "$0")/common.sh"
+bench_runtime
+bench_workdir alloc
+
+cat > "$WORK/driver.c" <<'EOF'
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "generic.h"
+#include "list.h"
+#include "scope.h"
+#include "stdlib.h"
+
+Generic *StdLib_add(Scope *, Generic *[], int, int);
+Generic *StdLib_greater_than(Scope *, Generic *[], int, int);
+Generic *StdLib_map(Scope *, Generic *[], int, int);
+Generic *StdLib_filter(Scope *, Generic *[], int, int);
+Generic *StdLib_reduce(Scope *, Generic *[], int, int);
+
+static long allocations = 0;
+void *__real_malloc(size_t);
+void *__real_calloc(size_t, size_t);
+void *__real_realloc(void *, size_t);
+void *__wrap_malloc(size_t size) { allocations++; return __real_malloc(size); }
+void *__wrap_calloc(size_t n, size_t size) { allocations++; return __real_calloc(n, size); }
+void *__wrap_realloc(void *p, size_t size) { allocations++; return __real_realloc(p, size); }
+
+static double nowMs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void report(const char *stage, long count, double ms, int n) {
+  printf("%-8s %12ld %14.2f %10.1f\n", stage, count, (double)count / n, ms);
+}
+
+int main(int argc, char *argv[]) {
+  int n = atoi(argv[1]);
+  Scope *scope = newGlobal(0, NULL);
+  // refCount 1, as if bound in scope, so applyFunc does not free them
+  Generic *add = Generic_new(TYPE_NATIVEFUNCTION, &StdLib_add, 1);
+  Generic *greater = Generic_new(TYPE_NATIVEFUNCTION, &StdLib_greater_than, 1);
+
+  long before = allocations;
+  double start = nowMs();
+  Generic **items = malloc(sizeof(Generic *) * n);
+  for (int i = 0; i < n; i++) items[i] = Generic_fromInt(i);
+  Generic *list = Generic_new(TYPE_LIST, List_new(items, n), 0);
+  report("build", allocations - before, nowMs() - start, n);
+
+  // (map list add) -> x + index
+  before = allocations;
+  start = nowMs();
+  Generic *mapArgs[] = {list, add};
+  Generic *mapped = StdLib_map(scope, mapArgs, 2, 0);
+  report("map", allocations - before, nowMs() - start, n);
+
+  // (filter mapped greater_than) -> x > index
+  before = allocations;
+  start = nowMs();
+  Generic *filterArgs[] = {mapped, greater};
+  Generic *filtered = StdLib_filter(scope, filterArgs, 2, 0);
+  report("filter", allocations - before, nowMs() - start, n);
+
+  // (reduce filtered add 0) -> acc + x + index
+  before = allocations;
+  start = nowMs();
+  Generic *reduceArgs[] = {filtered, add, Generic_fromInt(0)};
+  Generic *sum = StdLib_reduce(scope, reduceArgs, 3, 0);
+  report("reduce", allocations - before, nowMs() - start, n);
+
+  printf("\nresult: ");
+  Generic_print(sum);
+  printf("\n");
+  return 0;
+}
+EOF
+
+bench_driver -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+
+bench_banner "Franz Generic Allocation Benchmark" "Tree: $SRC   Elements: $N"
+printf "%-8s %12s %14s %10s\n" "stage" "allocations" "per element" "ms"
+"$WORK/driver" "$N"
@@ -0,0 +1,124 @@
+#!/bin/bash
+# Persistent list benchmark
+#
+# Links a small driver against libfranz_runtime.a and times the list updates
+# that copied the whole list before List became a persistent trie:
+#   append   (reduce list insert (list)), i.e. insert at the end, the pattern
+#            behind unique / flatten / partition in stdlib/list.franz
+#   prepend  N conses onto a growing list (franz_list_cons)
+#   set      N (set list x i) at random indices
+#   get      N (get list i) at random indices
+#   tail     head/tail walk over the list, N (tail list) calls (franz_list_tail)
+#   slice    N (get list start end) at random ranges (franz_get)
+# With a flat array every update is O(n), so the first three stages are O(n^2).
+# tail and slice copied the items they kept until they became views of the trie.
+#
+# Usage: benchmarks/list-persistent.sh [elements]
+#   elements defaults to 20000
+#   FRANZ_SRC points at the tree to measure (default: .), so two checkouts
+#   can be compared with the same driver
+
+N=${1:-20000}
+
+. "$(dirname "$0")/common.sh"
+bench_runtime
+bench_workdir list
+
+cat > "$WORK/driver.c" <<'EOF'
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "generic.h"
+#include "list.h"
+#include "scope.h"
+#include "stdlib.h"
+
+Generic *StdLib_insert(Scope *, Generic *[], int, int);
+Generic *StdLib_set(Scope *, Generic *[], int, int);
+Generic *StdLib_get(Scope *, Generic *[], int, int);
+Generic *StdLib_reduce(Scope *, Generic *[], int, int);
+void *franz_get(Generic *, int64_t, int64_t, int);
+
+static double nowMs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+int main(int argc, char *argv[]) {
+  int n = atoi(argv[1]);
+  Scope *scope = newGlobal(0, NULL);
+  // refCount 1, as if bound in scope, so applyFunc does not free it
+  Generic *insert = Generic_new(TYPE_NATIVEFUNCTION, &StdLib_insert, 1);
+
+  Generic **items = malloc(sizeof(Generic *) * n);
+  for (int i = 0; i < n; i++) items[i] = Generic_fromInt(i);
+  Generic *list = Generic_new(TYPE_LIST, List_new(items, n), 1);
+
+  // reduce calls (insert acc x index), and index is always the length: an append
+  double start = nowMs();
+  Generic *reduceArgs[] = {list, insert, Generic_new(TYPE_LIST, List_new(NULL, 0), 0)};
+  Generic *appended = StdLib_reduce(scope, reduceArgs, 3, 0);
+  printf("%-8s %10.1f\n", "append", nowMs() - start);
+
+  start = nowMs();
+  Generic *consed = Generic_new(TYPE_LIST, List_new(NULL, 0), 0);
+  for (int i = 0; i < n; i++) {
+    Generic *next = franz_list_cons(items[i], consed);
+    Generic_free(consed);
+    consed = next;
+  }
+  printf("%-8s %10.1f\n", "prepend", nowMs() - start);
+
+  srand(1);
+  start = nowMs();
+  Generic *updated = Generic_copy(list);
+  for (int i = 0; i < n; i++) {
+    Generic *setArgs[] = {updated, items[i], items[rand() % n]};
+    Generic *next = StdLib_set(scope, setArgs, 3, 0);
+    Generic_free(updated);
+    updated = next;
+  }
+  printf("%-8s %10.1f\n", "set", nowMs() - start);
+
+  start = nowMs();
+  long long sum = 0;
+  for (int i = 0; i < n; i++) {
+    Generic *getArgs[] = {list, items[rand() % n]};
+    Generic *item = StdLib_get(scope, getArgs, 2, 0);
+    sum += item->intVal;
+    Generic_free(item);
+  }
+  printf("%-8s %10.1f\n", "get", nowMs() - start);
+
+  start = nowMs();
+  Generic *rest = list;
+  while (!franz_list_is_empty(rest)) {
+    sum += franz_list_head(rest)->intVal;
+    Generic *next = franz_list_tail(rest);
+    if (rest != list) Generic_free(rest);
+    rest = next;
+  }
+  Generic_free(rest);
+  printf("%-8s %10.1f\n", "tail", nowMs() - start);
+
+  start = nowMs();
+  for (int i = 0; i < n; i++) {
+    int from = rand() % n;
+    Generic *slice = franz_get(list, from, from + rand() % (n - from + 1), 1);
+    sum += List_length(slice->p_val);
+    Generic_free(slice);
+  }
+  printf("%-8s %10.1f\n", "slice", nowMs() - start);
+
+  printf("\nlengths: %d %d %d   checksum: %lld\n", List_length(appended->p_val),
+         List_length(consed->p_val), List_length(updated->p_val), sum);
+  return 0;
+}
+EOF
+
+bench_driver
+
+bench_banner "Franz Persistent List Benchmark" "Tree: $SRC   Elements: $N"
+printf "%-8s %10s\n" "stage" "ms"
+"$WORK/driver" "$N"
@@ -0,0 +1,44 @@
+#!/bin/bash
+# Monomorphization benchmark
+#
+# Sums (clamp x low high) over N loop iterations in main, with clamp, max and
+# min defined as in stdlib/math.franz, once with ints and once with floats.
+# Each call is made to a clone of clamp specialized for its argument types;
+# FRANZ_MONO_CLONES=0 compiles the calls as before, through clamp's closure
+# and the generic i64 version. Reports the run stage of --time-report in ms
+# and the sum each build printed (the expected sum is in the header). Uses
+# --no-cache so every run compiles.
+#
+# Usage: benchmarks/monomorphization.sh [N] [opt level]
+#   N defaults to 10000000 (a multiple of 100), opt level to -O2
+
+N=${1:-10000000}
+OPT=${2:--O2}
+
+. "$(dirname "$0")/common.sh"
+bench_franz
+bench_workdir monomorphization
+
+# Every 100 iterations add 4960 (ints) or 49.6 (floats)
+body() {
+  printf 'max = {a b -> <- (if (greater_than a b) {<- a} {<- b})}\n'
+  printf 'min = {a b -> <- (if (less_than a b) {<- a} {<- b})}\n'
+  printf 'clamp = {value low high -> <- (max low (min high value))}\n'
+  printf 'mut sum = %s\n(loop %s {i ->\n  sum = (add sum %s)\n})\n(println sum)\n' "$1" "$N" "$2"
+}
+body 0 "(clamp (remainder i 100) 10 90)" > "$WORK/int.franz"
+body 0.0 "(clamp (multiply (remainder i 100) 0.01) 0.1 0.9)" > "$WORK/float.franz"
+
+# "<run ms> <printed sum>" with FRANZ_MONO_CLONES=$1 on a script ($2)
+run_stats() {
+  FRANZ_MONO_CLONES=$1 "$FRANZ" --no-cache $OPT --time-report "$2" 2>&1 |
+    awk '$1 == "run" { ms = $2 } /^-?[0-9.]+$/ { sum = $1 } END { printf "%.0f %s", ms, sum }'
+}
+
+bench_banner "Franz Monomorphization ($OPT)" "Calls: $N (expected sum: $((N / 100 * 4960)) / $((N / 100 * 496 / 10)).0)"
+printf "%-8s %10s %10s %28s %16s\n" "" "off ms" "on ms" "off sum" "on sum"
+for types in int float; do
+  read -r off_ms off_sum <<< "$(run_stats 0 "$WORK/$types.franz")"
+  read -r on_ms on_sum <<< "$(run_stats 8 "$WORK/$types.franz")"
+  printf "%-8s %10d %10d %28s %16s\n" "$types" "$off_ms" "$on_ms" "$off_sum" "$on_sum"
+done
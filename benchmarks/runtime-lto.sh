@@ -0,0 +1,55 @@
+#!/bin/bash
+# Runtime LTO benchmark
+#
+# Compiles each script at -O2 with and without the runtime bitcode linked in
+# (--no-lto) and reports how many calls into the runtime survive optimization
+# and the wall time of compile + run. Uses --no-cache so every run compiles.
+#
+# Usage: benchmarks/runtime-lto.sh [runs] [script.franz ...]
+#   runs defaults to 5; scripts default to test/loop-stress plus a dict workload
+
+RUNS=${1:-5}
+shift
+SCRIPTS=("$@")
+if [ ${#SCRIPTS[@]} -eq 0 ]; then
+  SCRIPTS=(test/loop-stress/stress-test-10000.franz
+           test/loop-stress/stress-test-100000.franz
+           test/dict/dict-comprehensive-test.franz)
+fi
+
+. "$(dirname "$0")/common.sh"
+bench_franz
+
+if [ -z "$FRANZ_RUNTIME_BC" ] && [ ! -f "$(dirname "$FRANZ")/libfranz_runtime.bc" ]; then
+  echo "libfranz_runtime.bc not found next to $FRANZ (make builds it when clang is installed)"
+  echo "or point FRANZ_RUNTIME_BC at a runtime bitcode file"
+  exit 1
+fi
+
+bench_workdir lto
+
+bench_banner "Franz Runtime LTO Benchmark (-O2)" "Runs per configuration: $RUNS"
+
+# Calls to franz_*/Generic_*/Dict_*/List_* left in the optimized module
+runtime_calls() {
+  "$FRANZ" --no-cache -O2 $1 --dump-ir="$WORK/ir" "$2" >/dev/null 2>&1
+  grep -cE "call .*@(franz_|Generic_|Dict_|List_)" "$WORK/ir.post-opt.ll"
+}
+
+# Average wall time in milliseconds
+average_ms() {
+  local total=0
+  for _ in $(seq 1 "$RUNS"); do
+    total=$(( total + $(bench_ms "$FRANZ" --no-cache -O2 $1 "$2") ))
+  done
+  awk "BEGIN { printf \"%.1f\", $total / $RUNS }"
+}
+
+printf "%-45s %16s %16s\n" "Script" "calls (off/on)" "ms (off/on)"
+for script in "${SCRIPTS[@]}"; do
+  calls_off=$(runtime_calls --no-lto "$script")
+  calls_on=$(runtime_calls "" "$script")
+  ms_off=$(average_ms --no-lto "$script")
+  ms_on=$(average_ms "" "$script")
+  printf "%-45s %16s %16s\n" "$(basename "$script")" "$calls_off / $calls_on" "$ms_off / $ms_on"
+done
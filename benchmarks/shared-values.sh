@@ -0,0 +1,119 @@
+#!/bin/bash
+# Shared values benchmark
+#
+# Links a small driver against libfranz_runtime.a, builds N records
+#   {"id": i, "name": "user-i", "tags": [i, "tag"]}
+# in a list and in a dict keyed by name, and times the operations that put
+# existing values into new containers:
+#   build    the record list, and the dict of records
+#   map      (map records list): wraps each record as [record, index]
+#   set      N (set records r i) at random indices
+#   values   (dict_values byName): every record, from the dict
+# When containers copied their items, every stage deep-copied each record
+# (its dict, strings and nested list); with shared values each stage only
+# takes references. Peak RSS after each stage shows the memory side.
+#
+# Usage: benchmarks/shared-values.sh [records]
+#   records defaults to 100000
+#   FRANZ_SRC points at the tree to measure (default: .), so two checkouts
+#   can be compared with the same driver
+
+N=${1:-100000}
+
+. "$(dirname "$0")/common.sh"
+bench_runtime
+bench_workdir shared
+
+cat > "$WORK/driver.c" <<'EOF'
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "generic.h"
+#include "list.h"
+#include "dict.h"
+#include "scope.h"
+#include "stdlib.h"
+
+Generic *StdLib_list(Scope *, Generic *[], int, int);
+Generic *StdLib_dict(Scope *, Generic *[], int, int);
+Generic *StdLib_map(Scope *, Generic *[], int, int);
+Generic *StdLib_set(Scope *, Generic *[], int, int);
+Generic *StdLib_dict_values(Scope *, Generic *[], int, int);
+
+static double nowMs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void report(const char *stage, double ms) {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  printf("%-8s %10.1f %14.1f\n", stage, ms, usage.ru_maxrss / 1024.0);
+}
+
+static Generic *string(const char *text) {
+  return Generic_fromString(text);
+}
+
+int main(int argc, char *argv[]) {
+  int n = atoi(argv[1]);
+  Scope *scope = newGlobal(0, NULL);
+  // refCount 1, as if bound in scope, so applyFunc does not free it
+  Generic *list = Generic_new(TYPE_NATIVEFUNCTION, &StdLib_list, 1);
+
+  double start = nowMs();
+  Generic **records = malloc(sizeof(Generic *) * n);
+  Generic **pairs = malloc(sizeof(Generic *) * n * 2);
+  Generic *idKey = string("id"), *nameKey = string("name"), *tagsKey = string("tags");
+  Generic *tag = string("tag");
+  for (int i = 0; i < n; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "user-%d", i);
+    Generic *tagArgs[] = {Generic_fromInt(i), tag};
+    Generic *fields[] = {idKey, Generic_fromInt(i), nameKey, string(name),
+                         tagsKey, StdLib_list(scope, tagArgs, 2, 0)};
+    records[i] = StdLib_dict(scope, fields, 6, 0);
+    pairs[i * 2] = fields[3];
+    pairs[i * 2 + 1] = records[i];
+  }
+  Generic *recordList = Generic_new(TYPE_LIST, List_new(records, n), 1);
+  Generic *byName = StdLib_dict(scope, pairs, n * 2, 0);
+  byName->refCount++;
+  report("build", nowMs() - start);
+
+  start = nowMs();
+  Generic *mapArgs[] = {recordList, list};
+  Generic *wrapped = StdLib_map(scope, mapArgs, 2, 0);
+  report("map", nowMs() - start);
+
+  srand(1);
+  start = nowMs();
+  Generic *updated = Generic_copy(recordList);
+  for (int i = 0; i < n; i++) {
+    Generic *index = Generic_fromInt(rand() % n);
+    Generic *setArgs[] = {updated, records[rand() % n], index};
+    Generic *next = StdLib_set(scope, setArgs, 3, 0);
+    if (index->refCount == 0) Generic_free(index);
+    Generic_free(updated);
+    updated = next;
+  }
+  report("set", nowMs() - start);
+
+  start = nowMs();
+  Generic *valuesArgs[] = {byName};
+  Generic *values = StdLib_dict_values(scope, valuesArgs, 1, 0);
+  report("values", nowMs() - start);
+
+  printf("\nlengths: %d %d %d %d\n", List_length(wrapped->p_val), List_length(updated->p_val),
+         List_length(values->p_val), Dict_size(byName->p_val));
+  return 0;
+}
+EOF
+
+bench_driver
+
+bench_banner "Franz Shared Values Benchmark" "Tree: $SRC   Records: $N"
+printf "%-8s %10s %14s\n" "stage" "ms" "peak RSS (MB)"
+"$WORK/driver" "$N"
@@ -0,0 +1,124 @@
+#!/bin/bash
+# String interning benchmark
+#
+# Links a small driver against libfranz_runtime.a and times string keys with
+# and without interning, for each size N (keys "record-field-name-i", int values):
+#   lookup     N Dict_get, in random order, with keys that are equal copies of
+#              the stored ones (hashed and compared byte by byte)
+#   interned   the same lookups on a dict built from Intern_string keys, with
+#              the same interned keys (stored hash, pointer compare)
+#   is         N Generic_is of two equal copies of a key
+#   is-intern  N Generic_is of two interned keys
+# Each cell is ns per key. The interned columns show - on trees without src/intern.
+#
+# Usage: benchmarks/string-intern.sh [sizes...]
+#   sizes default to 1000 10000 100000 1000000
+#   FRANZ_SRC points at the tree to measure (default: .), so two checkouts
+#   can be compared with the same driver
+
+SIZES=${*:-1000 10000 100000 1000000}
+
+. "$(dirname "$0")/common.sh"
+bench_runtime
+bench_workdir intern
+
+cat > "$WORK/driver.c" <<'EOF'
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "generic.h"
+#include "dict.h"
+#ifdef HAVE_INTERN
+#include "intern/intern.h"
+#endif
+
+#ifdef HAVE_DICT_NEW_VOID
+#define DICT_NEW() Dict_new()
+#else
+#define DICT_NEW() Dict_new(16)
+#endif
+
+static double nowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void shuffle(int *order, int n) {
+  for (int i = n - 1; i > 0; i--) {
+    int j = rand() % (i + 1);
+    int tmp = order[i];
+    order[i] = order[j];
+    order[j] = tmp;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int n = atoi(argv[1]);
+  srand(1);
+
+  Generic **keys = malloc(sizeof(Generic *) * n);
+  Generic **copies = malloc(sizeof(Generic *) * n);
+  int *order = malloc(sizeof(int) * n);
+  Dict *plain = DICT_NEW();
+  for (int i = 0; i < n; i++) {
+    char name[48];
+    snprintf(name, sizeof(name), "record-field-name-%d", i);
+    keys[i] = Generic_fromString(name);
+    copies[i] = Generic_fromString(name);
+    order[i] = i;
+    Dict_set_inplace(plain, keys[i], Generic_fromInt(i));
+  }
+  shuffle(order, n);
+
+  long sum = 0;
+  double start = nowNs();
+  for (int i = 0; i < n; i++) sum += Dict_get(plain, copies[order[i]])->intVal;
+  double lookup = (nowNs() - start) / n;
+
+  start = nowNs();
+  for (int i = 0; i < n; i++) sum += Generic_is(keys[order[i]], copies[order[i]]);
+  double is = (nowNs() - start) / n;
+
+#ifdef HAVE_INTERN
+  Generic **interned = malloc(sizeof(Generic *) * n);
+  Dict *internDict = DICT_NEW();
+  for (int i = 0; i < n; i++) {
+    interned[i] = Intern_string(keys[i]->strVal);
+    Dict_set_inplace(internDict, interned[i], Generic_fromInt(i));
+  }
+
+  start = nowNs();
+  for (int i = 0; i < n; i++) sum += Dict_get(internDict, interned[order[i]])->intVal;
+  double internLookup = (nowNs() - start) / n;
+
+  // Interning the copy again returns the stored Generic, as a second literal would
+  start = nowNs();
+  for (int i = 0; i < n; i++) sum += Generic_is(interned[order[i]], Intern_generic(interned[order[i]]));
+  double internIs = (nowNs() - start) / n;
+
+  printf("%10d %9.1f %9.1f %9.1f %9.1f\n", n, lookup, internLookup, is, internIs);
+#else
+  printf("%10d %9.1f %9s %9.1f %9s\n", n, lookup, "-", is, "-");
+#endif
+
+  if (sum == 42) printf("\n");  // keep the loops
+  return 0;
+}
+EOF
+
+DEFS=""
+if [ -f "$SRC/src/intern/intern.h" ]; then
+  DEFS="-DHAVE_INTERN"
+fi
+if grep -q "Dict_new(void)" "$SRC/src/dict.h"; then
+  DEFS="$DEFS -DHAVE_DICT_NEW_VOID"
+fi
+
+bench_driver $DEFS
+
+bench_banner "Franz String Interning Benchmark (ns per key)" "Tree: $SRC"
+printf "%10s %9s %9s %9s %9s\n" "keys" "lookup" "interned" "is" "is-intern"
+for N in $SIZES; do
+  "$WORK/driver" "$N"
+done
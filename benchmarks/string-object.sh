@@ -0,0 +1,141 @@
+#!/bin/bash
+# String object benchmark
+#
+# Links a small driver against libfranz_runtime.a and times the string
+# builtins on strings of each length L (bytes), in ns per call:
+#   copy     Generic_copy + Generic_free of a string (what every container
+#            insert and variable read does)
+#   length   (length s)
+#   get      (get s 1 L-1), a slice one byte shorter at each end
+#   join     (join s s)
+#   lookup   Dict_get on a 1,000-key dict with keys of length L, using equal
+#            copies of the stored keys, each looked up 1,000 times
+#
+# Usage: benchmarks/string-object.sh [lengths...]
+#   lengths default to 8 64 1024
+#   FRANZ_SRC points at the tree to measure (default: .), so two checkouts
+#   can be compared with the same driver
+
+LENGTHS=${*:-8 64 1024}
+
+. "$(dirname "$0")/common.sh"
+bench_runtime
+bench_workdir string
+
+cat > "$WORK/driver.c" <<'EOF'
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "generic.h"
+#include "dict.h"
+
+#ifdef HAVE_DICT_NEW_VOID
+#define DICT_NEW() Dict_new()
+#else
+#define DICT_NEW() Dict_new(16)
+#endif
+
+#define OPS 1000000
+#define KEYS 1000
+
+// Builtins are not in stdlib.h; the scope argument is unused by these
+Generic *StdLib_length(void *p_scope, Generic *args[], int length, int lineNumber);
+Generic *StdLib_get(void *p_scope, Generic *args[], int length, int lineNumber);
+Generic *StdLib_join(void *p_scope, Generic *args[], int length, int lineNumber);
+
+static double nowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static char *text(int length, int seed) {
+  char *res = malloc(length + 1);
+  for (int i = 0; i < length; i++) res[i] = 'a' + (i * 7 + seed) % 26;
+  snprintf(res, length + 1, "%d-", seed);
+  res[strlen(res)] = 'k';
+  res[length] = '\0';
+  return res;
+}
+
+int main(int argc, char *argv[]) {
+  int length = atoi(argv[1]);
+  long sum = 0;
+
+  char *raw = text(length, 0);
+  Generic *s = Generic_fromString(raw);
+  Generic_retain(s);
+
+  double start = nowNs();
+  for (int i = 0; i < OPS; i++) {
+    Generic *copy = Generic_copy(s);
+    sum += copy->strVal[0];
+    Generic_free(copy);
+  }
+  double copy = (nowNs() - start) / OPS;
+
+  Generic *lengthArgs[] = {s};
+  start = nowNs();
+  for (int i = 0; i < OPS; i++) {
+    Generic *res = StdLib_length(NULL, lengthArgs, 1, 0);
+    sum += res->intVal;
+    Generic_free(res);
+  }
+  double lengthNs = (nowNs() - start) / OPS;
+
+  Generic *from = Generic_fromInt(1);
+  Generic *to = Generic_fromInt(length - 1);
+  Generic_retain(from);
+  Generic_retain(to);
+  Generic *getArgs[] = {s, from, to};
+  start = nowNs();
+  for (int i = 0; i < OPS; i++) {
+    Generic *res = StdLib_get(NULL, getArgs, 3, 0);
+    sum += res->strVal[0];
+    Generic_free(res);
+  }
+  double get = (nowNs() - start) / OPS;
+
+  Generic *joinArgs[] = {s, s};
+  start = nowNs();
+  for (int i = 0; i < OPS; i++) {
+    Generic *res = StdLib_join(NULL, joinArgs, 2, 0);
+    sum += res->strVal[0];
+    Generic_free(res);
+  }
+  double join = (nowNs() - start) / OPS;
+
+  Dict *dict = DICT_NEW();
+  Generic **copies = malloc(sizeof(Generic *) * KEYS);
+  for (int i = 0; i < KEYS; i++) {
+    char *key = text(length, i);
+    Dict_set_inplace(dict, Generic_fromString(key), Generic_fromInt(i));
+    copies[i] = Generic_fromString(key);
+    free(key);
+  }
+  start = nowNs();
+  for (int round = 0; round < OPS / KEYS; round++) {
+    for (int i = 0; i < KEYS; i++) sum += Dict_get(dict, copies[i])->intVal;
+  }
+  double lookup = (nowNs() - start) / OPS;
+
+  printf("%8d %9.1f %9.1f %9.1f %9.1f %9.1f\n", length, copy, lengthNs, get, join, lookup);
+
+  if (sum == 42) printf("\n");  // keep the loops
+  return 0;
+}
+EOF
+
+DEFS=""
+if grep -q "Dict_new(void)" "$SRC/src/dict.h"; then
+  DEFS="-DHAVE_DICT_NEW_VOID"
+fi
+
+bench_driver $DEFS
+
+bench_banner "Franz String Object Benchmark (ns per call)" "Tree: $SRC"
+printf "%8s %9s %9s %9s %9s %9s\n" "length" "copy" "length" "get" "join" "lookup"
+for L in $LENGTHS; do
+  "$WORK/driver" "$L"
+done
@@ -0,0 +1,49 @@
+#!/bin/bash
+# Runtime tracing benchmark
+#
+# Runs one map, filter and reduce over (range N) through the runtime helpers
+# and franz_call_llvm_closure (a closure that captures a local, compiled with
+# FRANZ_CLOSURE_STUBS=0), the path that used to log every call to stderr.
+# Times are wall time of compile + run in ms, minus a script that only builds
+# the list, with tracing off and with FRANZ_TRACE=all recording every call.
+# Uses --no-cache so every run compiles.
+#
+# Usage: benchmarks/trace.sh [N] [opt level]
+#   N defaults to 1000000, opt level to -O2
+#   FRANZ_BASE=path/to/franz adds a column for another build (e.g. one from
+#   before tracing, whose stderr logging is discarded the same way)
+
+N=${1:-1000000}
+OPT=${2:--O2}
+
+. "$(dirname "$0")/common.sh"
+bench_franz
+bench_workdir trace
+
+bench_closure_scripts "$N"
+
+# Wall time in milliseconds of franz ($1) with FRANZ_TRACE=$2 on a script ($3)
+run_ms() {
+  bench_ms env FRANZ_CLOSURE_STUBS=0 FRANZ_TRACE=$2 "$1" --no-cache $OPT "$3"
+}
+
+bench_banner "Franz Runtime Tracing ($OPT)" "Elements: $N"
+
+base=$(run_ms "$FRANZ" "" "$WORK/range.franz")
+echo "Building the list: $base ms (subtracted below)"
+echo ""
+if [ -n "$FRANZ_BASE" ]; then
+  printf "%-8s %12s %12s %12s\n" "" "base ms" "off ms" "all ms"
+else
+  printf "%-8s %12s %12s\n" "" "off ms" "all ms"
+fi
+for op in map filter reduce; do
+  off=$(( $(run_ms "$FRANZ" "" "$WORK/$op.franz") - base ))
+  all=$(( $(run_ms "$FRANZ" all "$WORK/$op.franz") - base ))
+  if [ -n "$FRANZ_BASE" ]; then
+    old=$(( $(run_ms "$FRANZ_BASE" "" "$WORK/$op.franz") - base ))
+    printf "%-8s %12d %12d %12d\n" "$op" "$old" "$off" "$all"
+  else
+    printf "%-8s %12d %12d\n" "$op" "$off" "$all"
+  fi
+done
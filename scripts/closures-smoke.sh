@@ -14,6 +14,7 @@ main() {
   run "$ROOT_DIR/examples/closures/working/strings.franz"
   run "$ROOT_DIR/examples/closures/working/multi-arg.franz"
   run "$ROOT_DIR/examples/closures/working/captures.franz"
+  run "$ROOT_DIR/examples/closures/working/callbacks.franz"
   echo "All closure smoke tests passed." >&2
 }
 
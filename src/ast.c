@@ -116,6 +116,19 @@ void AstNode_appendChild(AstNode *p_head, AstNode **p_p_lastChild, AstNode *p_ch
   }
 }
 
+// Allocates a new ast node whose value is copied from a token span (not '\0'-terminated)
+AstNode* AstNode_newSpan(const char *start, int length, enum Opcodes opcode, int lineNumber) {
+  AstNode *res = AstNode_new(NULL, opcode, lineNumber);
+
+  if (start != NULL) {
+    res->val = (char *) malloc(sizeof(char) * (length + 1));
+    memcpy(res->val, start, length);
+    res->val[length] = '\0';
+  }
+
+  return res;
+}
+
 // Allocates memory for a new ast node and populates it
 AstNode* AstNode_new(char* val, enum Opcodes opcode, int lineNumber) {
   AstNode *res = (AstNode *) malloc(sizeof(AstNode));
@@ -146,6 +159,10 @@ AstNode* AstNode_new(char* val, enum Opcodes opcode, int lineNumber) {
   //  Initialize mutability flag (default immutable)
   res->isMutable = 0;
 
+  //  Closures escape unless FreeVar_markEscapes proves otherwise
+  res->noEscape = 0;
+  res->nativeCall = 0;
+
   return res;
 }
 
@@ -180,6 +197,9 @@ AstNode* AstNode_copy(AstNode *p_head, int depth) {
   //  Copy optimization fields
   p_res->var_offset = p_head->var_offset;
   p_res->var_depth = p_head->var_depth;
+  p_res->isMutable = p_head->isMutable;
+  p_res->noEscape = p_head->noEscape;
+  p_res->nativeCall = p_head->nativeCall;
 
   return p_res;
 }
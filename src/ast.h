@@ -40,6 +40,12 @@ typedef struct AstNode {
 
   //  Mutability flag for variable declarations
   int isMutable;         // 1 if declared with 'mut', 0 otherwise (for OP_ASSIGNMENT)
+
+  //  Escape analysis result (for OP_FUNCTION, see FreeVar_markEscapes)
+  int noEscape;          // 1 if the closure never outlives the call that creates it
+
+  //  Call compiled straight to a user function (for OP_APPLICATION, see llvm-monomorphize)
+  int nativeCall;        // 1 if its value is the function's own i64 / double, not a Generic*
 } AstNode;
 
 // prototypes
@@ -57,6 +63,7 @@ void AstNode_setChild(AstNode *node, int index, AstNode *child);
 void AstNode_appendChild(AstNode *, AstNode **, AstNode *);
 
 AstNode* AstNode_new(char*, enum Opcodes, int);
+AstNode* AstNode_newSpan(const char *start, int length, enum Opcodes, int);
 AstNode* AstNode_copy(AstNode *, int);
 
 #endif
\ No newline at end of file
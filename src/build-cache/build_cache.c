@@ -0,0 +1,536 @@
+#if !defined(__APPLE__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // fopencookie
+#endif
+#include "build_cache.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <utime.h>
+
+/**
+ * Content-Addressed Build Cache for Franz
+ *
+ * Layout of the cache directory:
+ *   <scriptKey>.deps   manifest: modules the script used, one path per line
+ *   <buildKey>.<ext>   artifact: scriptKey + contents of every listed module
+ *   <buildKey>.stderr  diagnostics printed while building it, replayed on a hit
+ *   .tmp-*             in-flight writes, renamed into place when complete
+ *
+ * Keys are 128-bit FNV-1a hashes printed as hex. The manifest is only a hint
+ * of which files to hash: an artifact is found only if the modules currently
+ * on disk hash to exactly the build that produced it, so a stale or racing
+ * manifest can cause a miss but never a wrong hit.
+ */
+
+#define BUILD_CACHE_KEY_HEX 32
+#define BUILD_CACHE_MANIFEST_HEADER "franz-deps 1"
+#define BUILD_CACHE_TMP_PREFIX ".tmp-"
+#define BUILD_CACHE_TMP_MAX_AGE 3600  // Leftovers of crashed writers, in seconds
+
+typedef unsigned __int128 BuildCacheHash;
+
+// FNV-1a 128-bit parameters
+#define FNV128_OFFSET ((((BuildCacheHash)0x6c62272e07bb0142ULL) << 64) | 0x62b821756295c58dULL)
+#define FNV128_PRIME ((((BuildCacheHash)0x0000000001000000ULL) << 64) | 0x000000000000013bULL)
+
+typedef struct BuildCacheState {
+  int active;
+  char dir[PATH_MAX];
+  BuildCacheHash scriptHash;
+  char scriptKey[BUILD_CACHE_KEY_HEX + 1];
+  BuildCacheHash buildHash;  // scriptHash + recorded modules, updated as they are read
+  char **depPaths;
+  int depCount;
+  int depCapacity;
+  FILE *capture;        // Stands in for stderr while compiling
+  FILE *savedStderr;    // Original stderr while capturing
+  char *diagnostics;    // What the compiler printed to stderr
+  size_t diagnosticsSize;
+} BuildCacheState;
+
+static BuildCacheState buildCache = {0};
+
+// ============================================================================
+// Hashing
+// ============================================================================
+
+static BuildCacheHash BuildCache_hashUpdate(BuildCacheHash hash, const void *data, size_t length) {
+  const unsigned char *bytes = (const unsigned char *)data;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= FNV128_PRIME;
+  }
+  return hash;
+}
+
+// Hash one module: path and length-prefixed content, so boundaries are unambiguous
+static BuildCacheHash BuildCache_hashDependency(BuildCacheHash hash, const char *path, const char *content) {
+  uint64_t length = (uint64_t)strlen(content);
+  hash = BuildCache_hashUpdate(hash, path, strlen(path) + 1);
+  hash = BuildCache_hashUpdate(hash, &length, sizeof(length));
+  return BuildCache_hashUpdate(hash, content, (size_t)length);
+}
+
+// MurmurHash3 finalizer: FNV-1a barely mixes the last bytes it sees
+static uint64_t BuildCache_mix64(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+// Keys are printed after a reversible mix, so similar scripts get unrelated names
+static void BuildCache_hashToHex(BuildCacheHash hash, char *hex) {
+  uint64_t high = (uint64_t)(hash >> 64);
+  uint64_t low = (uint64_t)hash;
+  low ^= BuildCache_mix64(high);
+  high ^= BuildCache_mix64(low);
+  snprintf(hex, BUILD_CACHE_KEY_HEX + 1, "%016llx%016llx",
+           (unsigned long long)high, (unsigned long long)low);
+}
+
+// ============================================================================
+// File Helpers
+// ============================================================================
+
+// mkdir -p
+static int BuildCache_makeDirs(const char *path) {
+  char partial[PATH_MAX];
+  snprintf(partial, sizeof(partial), "%s", path);
+
+  for (char *p = partial + 1; *p; p++) {
+    if (*p != '/') continue;
+    *p = '\0';
+    if (mkdir(partial, 0755) != 0 && errno != EEXIST) return -1;
+    *p = '/';
+  }
+  if (mkdir(partial, 0755) != 0 && errno != EEXIST) return -1;
+  return 0;
+}
+
+// Read a whole file as a NUL-terminated string (caller frees)
+static char *BuildCache_readFile(const char *path, size_t *size) {
+  FILE *file = fopen(path, "rb");
+  if (!file) return NULL;
+
+  if (fseek(file, 0, SEEK_END) != 0) {
+    fclose(file);
+    return NULL;
+  }
+  long length = ftell(file);
+  rewind(file);
+  if (length < 0) {
+    fclose(file);
+    return NULL;
+  }
+
+  char *data = malloc((size_t)length + 1);
+  if (!data) {
+    fclose(file);
+    return NULL;
+  }
+  size_t read = fread(data, 1, (size_t)length, file);
+  fclose(file);
+  data[read] = '\0';
+
+  if (size) *size = read;
+  return data;
+}
+
+// Write to a temporary name in the cache directory, then rename into place
+static int BuildCache_writeAtomic(const char *path, const char *data, size_t size, mode_t mode) {
+  static unsigned int sequence = 0;
+  char tmpPath[PATH_MAX];
+  int length = snprintf(tmpPath, sizeof(tmpPath), "%s/" BUILD_CACHE_TMP_PREFIX "%ld-%u",
+                        buildCache.dir, (long)getpid(), sequence++);
+  if (length < 0 || (size_t)length >= sizeof(tmpPath)) return -1;
+
+  int fd = open(tmpPath, O_WRONLY | O_CREAT | O_EXCL, mode);
+  if (fd < 0) return -1;
+
+  size_t written = 0;
+  while (written < size) {
+    ssize_t n = write(fd, data + written, size - written);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      close(fd);
+      unlink(tmpPath);
+      return -1;
+    }
+    written += (size_t)n;
+  }
+
+  if (close(fd) != 0 || rename(tmpPath, path) != 0) {
+    unlink(tmpPath);
+    return -1;
+  }
+  return 0;
+}
+
+static void BuildCache_manifestPath(char *path, size_t size) {
+  snprintf(path, size, "%s/%s.deps", buildCache.dir, buildCache.scriptKey);
+}
+
+static void BuildCache_artifactPath(BuildCacheHash buildHash, const char *extension,
+                                    char *path, size_t size) {
+  char key[BUILD_CACHE_KEY_HEX + 1];
+  BuildCache_hashToHex(buildHash, key);
+  snprintf(path, size, "%s/%s.%s", buildCache.dir, key, extension);
+}
+
+static void BuildCache_writeAll(int fd, const char *data, size_t size) {
+  size_t written = 0;
+  while (written < size) {
+    ssize_t n = write(fd, data + written, size - written);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return;
+    }
+    written += (size_t)n;
+  }
+}
+
+// ============================================================================
+// LRU Eviction
+// ============================================================================
+
+typedef struct BuildCacheFile {
+  char *name;
+  off_t size;
+  time_t mtime;
+} BuildCacheFile;
+
+static int BuildCache_compareAge(const void *a, const void *b) {
+  const BuildCacheFile *fa = (const BuildCacheFile *)a;
+  const BuildCacheFile *fb = (const BuildCacheFile *)b;
+  if (fa->mtime < fb->mtime) return -1;
+  if (fa->mtime > fb->mtime) return 1;
+  return 0;
+}
+
+static long long BuildCache_sizeLimit(void) {
+  const char *env = getenv("FRANZ_CACHE_SIZE");
+  long long megabytes = BUILD_CACHE_DEFAULT_SIZE_MB;
+  if (env && env[0] != '\0') {
+    megabytes = atoll(env);
+  }
+  return megabytes * 1024 * 1024;
+}
+
+// Hits refresh mtime, so deleting the oldest files first is LRU
+static void BuildCache_evict(void) {
+  DIR *dir = opendir(buildCache.dir);
+  if (!dir) return;
+
+  BuildCacheFile *files = NULL;
+  int count = 0;
+  int capacity = 0;
+  long long total = 0;
+  time_t now = time(NULL);
+  char path[PATH_MAX];
+
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL) {
+    int length = snprintf(path, sizeof(path), "%s/%s", buildCache.dir, entry->d_name);
+    if (length < 0 || (size_t)length >= sizeof(path)) continue;
+
+    struct stat info;
+    if (stat(path, &info) != 0 || !S_ISREG(info.st_mode)) continue;
+
+    if (strncmp(entry->d_name, BUILD_CACHE_TMP_PREFIX, strlen(BUILD_CACHE_TMP_PREFIX)) == 0) {
+      if (now - info.st_mtime > BUILD_CACHE_TMP_MAX_AGE) unlink(path);
+      continue;
+    }
+
+    if (count == capacity) {
+      capacity = capacity ? capacity * 2 : 64;
+      BuildCacheFile *grown = realloc(files, capacity * sizeof(BuildCacheFile));
+      if (!grown) break;
+      files = grown;
+    }
+    files[count].name = strdup(entry->d_name);
+    files[count].size = info.st_size;
+    files[count].mtime = info.st_mtime;
+    total += info.st_size;
+    count++;
+  }
+  closedir(dir);
+
+  long long limit = BuildCache_sizeLimit();
+  if (total > limit) {
+    qsort(files, count, sizeof(BuildCacheFile), BuildCache_compareAge);
+    for (int i = 0; i < count && total > limit; i++) {
+      int length = snprintf(path, sizeof(path), "%s/%s", buildCache.dir, files[i].name);
+      if (length < 0 || (size_t)length >= sizeof(path)) continue;
+      if (unlink(path) == 0) total -= files[i].size;
+    }
+  }
+
+  for (int i = 0; i < count; i++) free(files[i].name);
+  free(files);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+static int BuildCache_resolveDir(char *dir, size_t size) {
+  const char *env = getenv("FRANZ_CACHE_DIR");
+  if (env && env[0] != '\0') {
+    snprintf(dir, size, "%s", env);
+    return 0;
+  }
+
+  env = getenv("XDG_CACHE_HOME");
+  if (env && env[0] != '\0') {
+    snprintf(dir, size, "%s/franz", env);
+    return 0;
+  }
+
+  env = getenv("HOME");
+  if (env && env[0] != '\0') {
+    snprintf(dir, size, "%s/.cache/franz", env);
+    return 0;
+  }
+  return -1;
+}
+
+int BuildCache_begin(const char *code, long length, const char *config) {
+  BuildCache_end();
+
+  if (BuildCache_sizeLimit() <= 0) return -1;  // FRANZ_CACHE_SIZE=0 disables the cache
+  if (BuildCache_resolveDir(buildCache.dir, sizeof(buildCache.dir)) != 0) return -1;
+  if (BuildCache_makeDirs(buildCache.dir) != 0) return -1;
+
+  BuildCacheHash hash = FNV128_OFFSET;
+  hash = BuildCache_hashUpdate(hash, config, strlen(config) + 1);
+  hash = BuildCache_hashUpdate(hash, code, (size_t)length);
+
+  buildCache.scriptHash = hash;
+  buildCache.buildHash = hash;
+  BuildCache_hashToHex(hash, buildCache.scriptKey);
+  buildCache.active = 1;
+  return 0;
+}
+
+void BuildCache_recordDependency(const char *path, const char *content) {
+  if (!buildCache.active) return;
+
+  // A path that cannot be written to the line-based manifest is never cacheable
+  if (strchr(path, '\n')) {
+    buildCache.active = 0;
+    return;
+  }
+
+  if (buildCache.depCount == buildCache.depCapacity) {
+    int capacity = buildCache.depCapacity ? buildCache.depCapacity * 2 : 8;
+    char **grown = realloc(buildCache.depPaths, capacity * sizeof(char *));
+    if (!grown) {
+      buildCache.active = 0;
+      return;
+    }
+    buildCache.depPaths = grown;
+    buildCache.depCapacity = capacity;
+  }
+
+  buildCache.depPaths[buildCache.depCount++] = strdup(path);
+  buildCache.buildHash = BuildCache_hashDependency(buildCache.buildHash, path, content);
+}
+
+int BuildCache_lookup(const char *extension, char *path, size_t size) {
+  if (!buildCache.active) return -1;
+
+  char manifestPath[PATH_MAX];
+  BuildCache_manifestPath(manifestPath, sizeof(manifestPath));
+  char *manifest = BuildCache_readFile(manifestPath, NULL);
+  if (!manifest) return -1;
+
+  // Re-hash the modules the last build of this script used, as they are now
+  BuildCacheHash hash = buildCache.scriptHash;
+  int valid = strncmp(manifest, BUILD_CACHE_MANIFEST_HEADER "\n",
+                      strlen(BUILD_CACHE_MANIFEST_HEADER) + 1) == 0;
+  char *line = manifest + strlen(BUILD_CACHE_MANIFEST_HEADER) + 1;
+
+  while (valid && *line) {
+    char *end = strchr(line, '\n');
+    if (!end) {
+      valid = 0;
+      break;
+    }
+    *end = '\0';
+
+    char *content = BuildCache_readFile(line, NULL);
+    if (!content) {
+      valid = 0;
+      break;
+    }
+    hash = BuildCache_hashDependency(hash, line, content);
+    free(content);
+    line = end + 1;
+  }
+  free(manifest);
+  if (!valid) return -1;
+
+  BuildCache_artifactPath(hash, extension, path, size);
+  if (access(path, R_OK) != 0) return -1;
+
+  char diagnosticsPath[PATH_MAX];
+  BuildCache_artifactPath(hash, "stderr", diagnosticsPath, sizeof(diagnosticsPath));
+  size_t diagnosticsSize = 0;
+  char *diagnostics = BuildCache_readFile(diagnosticsPath, &diagnosticsSize);
+  if (!diagnostics) return -1;
+
+  // A hit looks like the build it replaces: same warnings and errors
+  fflush(stderr);
+  BuildCache_writeAll(STDERR_FILENO, diagnostics, diagnosticsSize);
+  free(diagnostics);
+
+  // Mark as recently used for eviction
+  utime(path, NULL);
+  utime(diagnosticsPath, NULL);
+  utime(manifestPath, NULL);
+  return 0;
+}
+
+// Every write to the capture stream goes straight to the real stderr and is kept
+static size_t BuildCache_teeDiagnostics(const char *data, size_t size) {
+  BuildCache_writeAll(STDERR_FILENO, data, size);
+
+  char *grown = realloc(buildCache.diagnostics, buildCache.diagnosticsSize + size);
+  if (!grown) {
+    buildCache.active = 0;  // Cannot store the build without its diagnostics
+    return size;
+  }
+  memcpy(grown + buildCache.diagnosticsSize, data, size);
+  buildCache.diagnostics = grown;
+  buildCache.diagnosticsSize += size;
+  return size;
+}
+
+#ifdef __APPLE__
+static int BuildCache_captureWrite(void *cookie, const char *data, int size) {
+  (void)cookie;
+  return (int)BuildCache_teeDiagnostics(data, (size_t)size);
+}
+#else
+static ssize_t BuildCache_captureWrite(void *cookie, const char *data, size_t size) {
+  (void)cookie;
+  return (ssize_t)BuildCache_teeDiagnostics(data, size);
+}
+#endif
+
+void BuildCache_captureDiagnostics(void) {
+  if (!buildCache.active || buildCache.capture) return;
+
+#ifdef __APPLE__
+  FILE *capture = funopen(NULL, NULL, BuildCache_captureWrite, NULL, NULL);
+#else
+  cookie_io_functions_t io = {.read = NULL, .write = BuildCache_captureWrite, .seek = NULL, .close = NULL};
+  FILE *capture = fopencookie(NULL, "w", io);
+#endif
+  if (!capture) {
+    buildCache.active = 0;
+    return;
+  }
+  setvbuf(capture, NULL, _IONBF, 0);  // Interleave with stdout as stderr would
+
+  fflush(stderr);
+  free(buildCache.diagnostics);
+  buildCache.diagnostics = NULL;
+  buildCache.diagnosticsSize = 0;
+  buildCache.savedStderr = stderr;
+  buildCache.capture = capture;
+  stderr = capture;
+}
+
+void BuildCache_releaseDiagnostics(void) {
+  if (!buildCache.capture) return;
+
+  stderr = buildCache.savedStderr;
+  fclose(buildCache.capture);
+  buildCache.capture = NULL;
+  buildCache.savedStderr = NULL;
+}
+
+static int BuildCache_store(const char *extension, const char *data, size_t size, mode_t mode) {
+  if (!buildCache.active) return -1;
+
+  // Manifest: header + one module path per line
+  size_t manifestSize = strlen(BUILD_CACHE_MANIFEST_HEADER) + 2;
+  for (int i = 0; i < buildCache.depCount; i++) {
+    manifestSize += strlen(buildCache.depPaths[i]) + 1;
+  }
+  char *manifest = malloc(manifestSize);
+  if (!manifest) return -1;
+
+  char *cursor = manifest;
+  cursor += sprintf(cursor, "%s\n", BUILD_CACHE_MANIFEST_HEADER);
+  for (int i = 0; i < buildCache.depCount; i++) {
+    cursor += sprintf(cursor, "%s\n", buildCache.depPaths[i]);
+  }
+
+  char manifestPath[PATH_MAX];
+  BuildCache_manifestPath(manifestPath, sizeof(manifestPath));
+  char artifactPath[PATH_MAX];
+  BuildCache_artifactPath(buildCache.buildHash, extension, artifactPath, sizeof(artifactPath));
+
+  char diagnosticsPath[PATH_MAX];
+  BuildCache_artifactPath(buildCache.buildHash, "stderr", diagnosticsPath, sizeof(diagnosticsPath));
+
+  // Diagnostics, then artifact, then the manifest that leads lookups to them
+  int result = BuildCache_writeAtomic(diagnosticsPath,
+                                      buildCache.diagnostics ? buildCache.diagnostics : "",
+                                      buildCache.diagnosticsSize, 0644);
+  if (result == 0) {
+    result = BuildCache_writeAtomic(artifactPath, data, size, mode);
+  }
+  if (result == 0) {
+    result = BuildCache_writeAtomic(manifestPath, manifest, (size_t)(cursor - manifest), 0644);
+  }
+  free(manifest);
+
+  BuildCache_evict();
+  return result;
+}
+
+int BuildCache_storeBuffer(const char *extension, const char *data, size_t size) {
+  return BuildCache_store(extension, data, size, 0644);
+}
+
+int BuildCache_storeFile(const char *extension, const char *sourcePath) {
+  if (!buildCache.active) return -1;
+
+  size_t size = 0;
+  char *data = BuildCache_readFile(sourcePath, &size);
+  if (!data) return -1;
+
+  int result = BuildCache_store(extension, data, size, 0755);
+  free(data);
+  return result;
+}
+
+void BuildCache_end(void) {
+  BuildCache_releaseDiagnostics();
+  free(buildCache.diagnostics);
+  buildCache.diagnostics = NULL;
+  buildCache.diagnosticsSize = 0;
+
+  for (int i = 0; i < buildCache.depCount; i++) {
+    free(buildCache.depPaths[i]);
+  }
+  free(buildCache.depPaths);
+  buildCache.depPaths = NULL;
+  buildCache.depCount = 0;
+  buildCache.depCapacity = 0;
+  buildCache.active = 0;
+}
@@ -0,0 +1,97 @@
+#ifndef BUILD_CACHE_H
+#define BUILD_CACHE_H
+
+#include <stddef.h>
+
+/**
+ * Content-Addressed Build Cache for Franz
+ *
+ * Lets repeated runs of an unchanged script skip lexing, parsing, IR
+ * generation, optimization and linking:
+ * - The script is identified by a hash of its source text plus a
+ *   configuration string (compiler identity, target, -O level, flags)
+ * - Modules pulled in with use()/use_as()/use_with() are recorded while
+ *   compiling and listed in a per-script manifest
+ * - The artifact (JIT object or --aot executable) is stored under a hash of
+ *   the script key and the current contents of every recorded module
+ *
+ * On lookup the manifest's modules are re-read and re-hashed, so editing any
+ * transitively used module is a miss. Whatever the compiler printed to
+ * stderr is stored with the artifact and printed again on a hit. Artifacts
+ * are immutable files written with rename(), which makes concurrent franz
+ * processes safe.
+ *
+ * Cache directory: $FRANZ_CACHE_DIR, else $XDG_CACHE_HOME/franz, else
+ * ~/.cache/franz. The directory is kept under $FRANZ_CACHE_SIZE megabytes
+ * (default 256) by evicting least recently used files after each store.
+ */
+
+// Default size bound of the cache directory, in megabytes
+#define BUILD_CACHE_DEFAULT_SIZE_MB 256
+
+/**
+ * Start a cached build for one script
+ *
+ * @param code Source text of the script
+ * @param length Length of the source text
+ * @param config Everything besides the source that affects generated code
+ * @return 0 if the cache is usable, -1 if it is disabled for this run
+ */
+int BuildCache_begin(const char *code, long length, const char *config);
+
+/**
+ * Record a module read while compiling the current script
+ * No-op when no cached build is active.
+ *
+ * @param path Module path as passed to use() (normalized)
+ * @param content Module source text that was compiled
+ */
+void BuildCache_recordDependency(const char *path, const char *content);
+
+/**
+ * Find the artifact built for the current script and module contents
+ * On a hit the diagnostics of the original build are written to stderr.
+ *
+ * @param extension Artifact kind ("o" for JIT objects, "exe" for --aot)
+ * @param path Output buffer for the artifact path
+ * @param size Size of the output buffer
+ * @return 0 on a hit, -1 on a miss
+ */
+int BuildCache_lookup(const char *extension, char *path, size_t size);
+
+/**
+ * Record what the compiler prints to stderr while compiling after a miss
+ * stderr is swapped for a stream that writes through to file descriptor 2 and
+ * keeps a copy, so nothing is held back if the compiler crashes. Output written
+ * to the descriptor directly (LLVM's own messages) is not recorded.
+ * No-op when no cached build is active.
+ */
+void BuildCache_captureDiagnostics(void);
+
+/**
+ * Put the original stderr back
+ * The recorded text is stored alongside the artifact.
+ */
+void BuildCache_releaseDiagnostics(void);
+
+/**
+ * Store an in-memory artifact (JIT object) for the current script
+ *
+ * @return 0 on success, -1 if nothing was stored
+ */
+int BuildCache_storeBuffer(const char *extension, const char *data, size_t size);
+
+/**
+ * Store a file artifact (--aot executable) for the current script
+ * The cached copy keeps the executable bit.
+ *
+ * @return 0 on success, -1 if nothing was stored
+ */
+int BuildCache_storeFile(const char *extension, const char *sourcePath);
+
+/**
+ * Finish the cached build: restore stderr and release recorded state
+ */
+void BuildCache_end(void);
+
+#endif // BUILD_CACHE_H
@@ -7,6 +7,7 @@
 #include "../dict.h"
 #include "../freevar/freevar.h"
 #include "../generic.h"
+#include "../string-object/string_object.h"
 
 //  Snapshot-Based Closure Implementation (Zero Leaks)
 
@@ -36,17 +37,11 @@ Closure *Closure_new(AstNode *p_fn, Scope *p_scope) {
 
     if (val != NULL) {
       // Create Generic string key for Dict
-      char **keyPtr = (char **) malloc(sizeof(char *));
-      *keyPtr = (char *) malloc(strlen(varName) + 1);
-      strcpy(*keyPtr, varName);
-      Generic *key = Generic_new(TYPE_STRING, keyPtr, 0);
+      Generic *key = Generic_newString(String_fromText(varName), 0);
 
-      // Store in snapshot (Dict_set_inplace makes copies of both key and value)
-      // No need to increment refCount - Dict_set_inplace creates its own copies
+      // Store in snapshot (Dict_set_inplace takes a reference to both key and value,
+      // so the snapshot shares the captured value instead of copying it)
       Dict_set_inplace(p_closure->p_snapshot, key, val);
-
-      // Free the original key (Dict_set_inplace made a copy)
-      Generic_free(key);
     }
     // If variable not found, it's probably a builtin (like "add", "print")
     // We don't snapshot builtins - they're looked up at runtime from global scope
@@ -94,7 +89,7 @@ Closure *Closure_copy(Closure *p_closure) {
   // Copy the function AST
   p_new->p_fn = AstNode_copy(p_closure->p_fn, 0);
 
-  // Copy the snapshot Dict (Dict_copy handles refCount increment)
+  // Share the snapshot Dict (Dict_copy increments its refCount)
   p_new->p_snapshot = Dict_copy(p_closure->p_snapshot);
 
   return p_new;
@@ -4,27 +4,37 @@
 #include "dict.h"
 #include "generic.h"
 #include "list.h"
+#include "slab/slab.h"
+#include "string-object/string_object.h"
 
-#define DICT_INITIAL_CAPACITY 16
-#define DICT_LOAD_FACTOR 0.75
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define DICT_GROUP 16        // Slots probed at once
+#define DICT_EMPTY 0x80      // Control byte of a slot never used
+#define DICT_DELETED 0xFE    // Control byte of a slot whose pair was removed
+                             // (a full slot holds 0x00-0x7F, the low 7 bits of the hash)
+
+// Most entries a table of capacity slots holds before it grows (load factor 7/8)
+#define DICT_MAX_ENTRIES(capacity) ((capacity) / 8 * 7)
 
 // Hash function for Generic keys
-// Uses FNV-1a hash algorithm
-unsigned int Dict_hash(Generic *key, int capacity) {
+// FNV-1a over the key, then a final mix so every bit of the hash depends on every
+// bit of the key (the table takes the low 7 bits for the control byte and the rest
+// for the group; each trie level uses the next DICT_BITS bits)
+// A string hashes the same way, once: the String caches it (String_hash)
+unsigned int Dict_hash(Generic *key) {
+  if (key->type == TYPE_STRING) return String_hash(key->strVal);
+
   unsigned int hash = 2166136261u;
 
-  if (key->type == TYPE_STRING) {
-    char *str = *((char **) key->p_val);
-    for (int i = 0; str[i] != '\0'; i++) {
-      hash ^= (unsigned char)str[i];
-      hash *= 16777619u;
-    }
-  } else if (key->type == TYPE_INT) {
-    int val = *((int *) key->p_val);
-    hash ^= val;
+  if (key->type == TYPE_INT) {
+    int64_t val = key->intVal;
+    hash ^= (unsigned int) (val ^ (val >> 32));
     hash *= 16777619u;
   } else if (key->type == TYPE_FLOAT) {
-    double val = *((double *) key->p_val);
+    double val = key->floatVal;
     // Hash the bytes of the double
     unsigned char *bytes = (unsigned char *)&val;
     for (size_t i = 0; i < sizeof(double); i++) {
@@ -35,272 +45,671 @@ unsigned int Dict_hash(Generic *key, int capacity) {
   // For other types, use pointer address as hash
   else {
     unsigned long addr = (unsigned long)key->p_val;
-    hash ^= (unsigned int)addr;
+    hash ^= (unsigned int)(addr ^ (addr >> 32));
     hash *= 16777619u;
   }
 
-  return hash % capacity;
+  // Final mix (from MurmurHash3)
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
 }
 
-// Create new dictionary with specified capacity
-Dict *Dict_new(int initial_capacity) {
-  if (initial_capacity <= 0) {
-    initial_capacity = DICT_INITIAL_CAPACITY;
+// ============================================================================
+// Flat table (fresh dicts)
+// ============================================================================
+
+// Bit i set for each control byte in the group equal to byte
+static inline unsigned int Dict_match(const unsigned char *group, unsigned char byte) {
+#if defined(__SSE2__)
+  __m128i ctrl = _mm_loadu_si128((const __m128i *) group);
+  return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char) byte)));
+#else
+  unsigned int bits = 0;
+  for (int i = 0; i < DICT_GROUP; i++) {
+    if (group[i] == byte) bits |= 1u << i;
   }
+  return bits;
+#endif
+}
 
-  Dict *dict = (Dict *) malloc(sizeof(Dict));
-  dict->capacity = initial_capacity;
-  dict->size = 0;
-  dict->buckets = (DictEntry **) calloc(initial_capacity, sizeof(DictEntry *));
+// Bit i set for each empty or deleted slot in the group (the bytes with the top bit set)
+static inline unsigned int Dict_matchFree(const unsigned char *group) {
+#if defined(__SSE2__)
+  return (unsigned int) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#else
+  unsigned int bits = 0;
+  for (int i = 0; i < DICT_GROUP; i++) {
+    if (group[i] & 0x80) bits |= 1u << i;
+  }
+  return bits;
+#endif
+}
 
-  return dict;
+// Allocate empty slots and room for DICT_MAX_ENTRIES(capacity) entries
+static void Dict_allocTable(Dict *dict, int capacity) {
+  dict->capacity = capacity;
+  dict->ctrl = (unsigned char *) malloc(capacity);
+  memset(dict->ctrl, DICT_EMPTY, capacity);
+  dict->slots = (int *) malloc(sizeof(int) * capacity);
+  dict->entries = (DictEntry *) malloc(sizeof(DictEntry) * DICT_MAX_ENTRIES(capacity));
 }
 
-// Free dictionary and all entries
-void Dict_free(Dict *dict) {
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      DictEntry *next = entry->next;
+// Slot holding key, or -1
+// Groups are probed in triangular order (g, g+1, g+3, g+6, ...), which visits every
+// group of a power-of-two table; a group with an empty slot ends the search
+static int Dict_findSlot(Dict *dict, Generic *key, unsigned int hash) {
+  unsigned char h2 = hash & 0x7F;
+  int groupMask = dict->capacity / DICT_GROUP - 1;
+  int group = (hash >> 7) & groupMask;
+
+  for (int step = 1; ; step++) {
+    unsigned char *ctrl = dict->ctrl + group * DICT_GROUP;
+
+    unsigned int bits = Dict_match(ctrl, h2);
+    while (bits) {
+      int slot = group * DICT_GROUP + __builtin_ctz(bits);
+      DictEntry *entry = &dict->entries[dict->slots[slot]];
+      if (entry->hash == hash && Generic_is(entry->key, key)) return slot;
+      bits &= bits - 1;
+    }
 
-      // Decrement refCounts (Dict was owning them)
-      entry->key->refCount--;
-      entry->value->refCount--;
+    if (Dict_match(ctrl, DICT_EMPTY)) return -1;
+    group = (group + step) & groupMask;
+  }
+}
 
-      // Free key and value if no more references
-      if (entry->key->refCount == 0) Generic_free(entry->key);
-      if (entry->value->refCount == 0) Generic_free(entry->value);
+// First empty or deleted slot on the probe sequence of hash
+static int Dict_findFree(Dict *dict, unsigned int hash) {
+  int groupMask = dict->capacity / DICT_GROUP - 1;
+  int group = (hash >> 7) & groupMask;
 
-      free(entry);
-      entry = next;
-    }
+  for (int step = 1; ; step++) {
+    unsigned int bits = Dict_matchFree(dict->ctrl + group * DICT_GROUP);
+    if (bits) return group * DICT_GROUP + __builtin_ctz(bits);
+    group = (group + step) & groupMask;
   }
+}
 
-  free(dict->buckets);
-  free(dict);
+// Point a free slot at entry index (the caller checked there is room)
+static void Dict_place(Dict *dict, int index) {
+  unsigned int hash = dict->entries[index].hash;
+  int slot = Dict_findFree(dict, hash);
+  dict->ctrl[slot] = hash & 0x7F;
+  dict->slots[slot] = index;
 }
 
-// Deep copy dictionary
-Dict *Dict_copy(Dict *dict) {
-  Dict *new_dict = Dict_new(dict->capacity);
-
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      // Copy key and value and insert into new dict using in-place
-      Dict_set_inplace(new_dict, entry->key, entry->value);
-      entry = entry->next;
-    }
+// Rebuild the slots for capacity, dropping removed entries
+// Uses the stored hashes: no key is hashed or compared again
+static void Dict_rebuild(Dict *dict, int capacity) {
+  DictEntry *old = dict->entries;
+  int count = dict->count;
+
+  free(dict->ctrl);
+  free(dict->slots);
+  Dict_allocTable(dict, capacity);
+
+  dict->count = 0;
+  for (int i = 0; i < count; i++) {
+    if (old[i].key == NULL) continue;
+    dict->entries[dict->count] = old[i];
+    Dict_place(dict, dict->count);
+    dict->count++;
   }
-
-  return new_dict;
+  free(old);
 }
 
-// Print dictionary in {key: value, ...} format
-void Dict_print(Dict *dict) {
-  printf("{");
+// Append a pair known not to be in the dict (takes references to key and value)
+static void Dict_append(Dict *dict, Generic *key, Generic *value, unsigned int hash) {
+  if (dict->count == DICT_MAX_ENTRIES(dict->capacity)) {
+    // Full: grow, or only clear out removed entries if they take up half the room
+    int capacity = dict->size >= dict->count / 2 ? dict->capacity * 2 : dict->capacity;
+    Dict_rebuild(dict, capacity);
+  }
 
-  int printed = 0;
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      if (printed > 0) printf(", ");
+  Generic_retain(key);
+  Generic_retain(value);
+
+  DictEntry *entry = &dict->entries[dict->count];
+  entry->key = key;
+  entry->value = value;
+  entry->hash = hash;
+  Dict_place(dict, dict->count);
+  dict->count++;
+  dict->size++;
+}
 
-      Generic_print(entry->key);
-      printf(": ");
-      Generic_print(entry->value);
+// Release the flat table's pairs and arrays
+static void Dict_freeTable(Dict *dict) {
+  for (int i = 0; i < dict->count; i++) {
+    DictEntry *entry = &dict->entries[i];
+    if (entry->key == NULL) continue;
 
-      printed++;
-      entry = entry->next;
-    }
+    // Drop the entry's references (freed if it was the last holder)
+    Generic_release(entry->key);
+    Generic_release(entry->value);
   }
 
-  printf("}");
-  fflush(stdout);
+  free(dict->ctrl);
+  free(dict->slots);
+  free(dict->entries);
+  dict->ctrl = NULL;
+  dict->slots = NULL;
+  dict->entries = NULL;
+  dict->capacity = 0;
+  dict->count = 0;
 }
 
-// Get value for key (returns NULL if not found)
-Generic *Dict_get(Dict *dict, Generic *key) {
-  unsigned int index = Dict_hash(key, dict->capacity);
-  DictEntry *entry = dict->buckets[index];
+// ============================================================================
+// Hash trie (shared dicts)
+// ============================================================================
 
-  while (entry != NULL) {
-    if (Generic_is(entry->key, key)) {
-      return entry->value;
-    }
-    entry = entry->next;
+// slot bit of hash at a trie level
+static inline unsigned int Dict_bit(unsigned int hash, int shift) {
+  return 1u << ((hash >> shift) & DICT_MASK);
+}
+
+// position of the slot bit among the used slots of map
+static inline int Dict_index(unsigned int map, unsigned int bit) {
+  return __builtin_popcount(map & (bit - 1));
+}
+
+static inline int DictNode_childCount(DictNode *node) {
+  return __builtin_popcount(node->nodeMap);
+}
+
+// child pointers, stored after the entries
+static inline DictNode **DictNode_children(DictNode *node) {
+  return (DictNode **) (node->entries + node->entryCount);
+}
+
+static inline size_t DictNode_bytes(int entries, int children) {
+  return sizeof(DictNode) + entries * sizeof(DictEntry) + children * sizeof(DictNode *);
+}
+
+// new node with room for the given number of entries and children, maps empty
+static DictNode *DictNode_alloc(int entries, int children) {
+  DictNode *node = (DictNode *) Slab_alloc(DictNode_bytes(entries, children), SLAB_DICT_NODE);
+  node->refCount = 1;
+  node->entryCount = entries;
+  node->entryMap = 0;
+  node->nodeMap = 0;
+  return node;
+}
+
+// give back a node's memory; its entries and children have moved elsewhere
+static void DictNode_dispose(DictNode *node) {
+  Slab_free(node, DictNode_bytes(node->entryCount, DictNode_childCount(node)), SLAB_DICT_NODE);
+}
+
+// drop one reference to a node, the last one frees the subtree and releases its keys and values
+static void DictNode_release(DictNode *node) {
+  if (node == NULL) return;
+
+  node->refCount -= 1;
+  if (node->refCount > 0) return;
+
+  for (int i = 0; i < node->entryCount; i++) {
+    Generic_release(node->entries[i].key);
+    Generic_release(node->entries[i].value);
+  }
+  DictNode **children = DictNode_children(node);
+  for (int i = 0; i < DictNode_childCount(node); i++) {
+    DictNode_release(children[i]);
   }
 
-  return NULL;
+  DictNode_dispose(node);
 }
 
-// Check if key exists
-int Dict_has(Dict *dict, Generic *key) {
-  return Dict_get(dict, key) != NULL ? 1 : 0;
+// returns a node only the caller references: the node itself if it is not shared,
+// else a copy that takes over the caller's reference (children, keys and values are shared)
+static DictNode *DictNode_unshare(DictNode *node) {
+  if (node->refCount == 1) return node;
+
+  size_t bytes = DictNode_bytes(node->entryCount, DictNode_childCount(node));
+  DictNode *res = (DictNode *) Slab_alloc(bytes, SLAB_DICT_NODE);
+  memcpy(res, node, bytes);
+  res->refCount = 1;
+
+  for (int i = 0; i < res->entryCount; i++) {
+    Generic_retain(res->entries[i].key);
+    Generic_retain(res->entries[i].value);
+  }
+  DictNode **children = DictNode_children(res);
+  for (int i = 0; i < DictNode_childCount(res); i++) {
+    children[i]->refCount += 1;
+  }
+
+  node->refCount -= 1;
+  return res;
 }
 
-// Resize dictionary when load factor exceeded (mutates in place)
-static void Dict_resize_inplace(Dict *dict) {
-  int new_capacity = dict->capacity * 2;
-  DictEntry **new_buckets = (DictEntry **) calloc(new_capacity, sizeof(DictEntry *));
+// copy count items of width bytes, inserting *item at index at, or leaving out src[at] if
+// item is NULL (at < 0: plain copy)
+static void Dict_splice(void *dst, const void *src, int count, size_t width, int at, const void *item) {
+  char *d = (char *) dst;
+  const char *s = (const char *) src;
+
+  if (at < 0) {
+    memcpy(d, s, count * width);
+  } else if (item != NULL) {
+    memcpy(d, s, at * width);
+    memcpy(d + at * width, item, width);
+    memcpy(d + (at + 1) * width, s + at * width, (count - at) * width);
+  } else {
+    memcpy(d, s, at * width);
+    memcpy(d + at * width, s + (at + 1) * width, (count - at - 1) * width);
+  }
+}
 
-  // Rehash all entries
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      DictEntry *next = entry->next;
+// an owned node with one entry inserted (entry) or removed (entry NULL) at entryAt, and one
+// child inserted or removed at childAt (-1: unchanged); contents move, nothing is retained
+// the maps are copied as they are, the caller updates them
+static DictNode *DictNode_resize(DictNode *node, int entryAt, DictEntry *entry,
+                                 int childAt, DictNode *child) {
+  int children = DictNode_childCount(node);
+  DictNode *res = DictNode_alloc(
+    node->entryCount + (entry != NULL ? 1 : entryAt >= 0 ? -1 : 0),
+    children + (child != NULL ? 1 : childAt >= 0 ? -1 : 0)
+  );
+  res->entryMap = node->entryMap;
+  res->nodeMap = node->nodeMap;
+
+  Dict_splice(res->entries, node->entries, node->entryCount, sizeof(DictEntry), entryAt, entry);
+  Dict_splice(DictNode_children(res), DictNode_children(node), children, sizeof(DictNode *),
+              childAt, child != NULL ? &child : NULL);
+
+  DictNode_dispose(node);
+  return res;
+}
 
-      // Rehash
-      unsigned int new_index = Dict_hash(entry->key, new_capacity);
+// new node holding two entries whose hashes agree below shift (their references move in)
+static DictNode *DictNode_pair(DictEntry *a, DictEntry *b, int shift) {
+  if (shift >= DICT_HASH_BITS) {
+    DictNode *node = DictNode_alloc(2, 0);
+    node->entries[0] = *a;
+    node->entries[1] = *b;
+    return node;
+  }
 
-      // Insert at head of new bucket
-      entry->next = new_buckets[new_index];
-      new_buckets[new_index] = entry;
+  unsigned int bitA = Dict_bit(a->hash, shift);
+  unsigned int bitB = Dict_bit(b->hash, shift);
 
-      entry = next;
-    }
+  if (bitA == bitB) {
+    DictNode *node = DictNode_alloc(0, 1);
+    node->nodeMap = bitA;
+    DictNode_children(node)[0] = DictNode_pair(a, b, shift + DICT_BITS);
+    return node;
   }
 
-  free(dict->buckets);
-  dict->buckets = new_buckets;
-  dict->capacity = new_capacity;
+  DictNode *node = DictNode_alloc(2, 0);
+  node->entryMap = bitA | bitB;
+  node->entries[bitA < bitB ? 0 : 1] = *a;
+  node->entries[bitA < bitB ? 1 : 0] = *b;
+  return node;
 }
 
-// Resize dictionary when load factor exceeded (returns new dict)
-static Dict *Dict_resize(Dict *dict) {
-  int new_capacity = dict->capacity * 2;
-  DictEntry **new_buckets = (DictEntry **) calloc(new_capacity, sizeof(DictEntry *));
+// set key to value in a node the caller owns, returns the node to store in its place
+// the trie takes a reference to a new key and to the value; added is set if the key is new
+static DictNode *DictNode_set(DictNode *node, int shift, DictEntry *entry, int *added) {
+  // below the hash bits: a list of keys with the same hash
+  if (shift >= DICT_HASH_BITS) {
+    for (int i = 0; i < node->entryCount; i++) {
+      if (Generic_is(node->entries[i].key, entry->key)) {
+        Generic_retain(entry->value);
+        Generic_release(node->entries[i].value);
+        node->entries[i].value = entry->value;
+        return node;
+      }
+    }
 
-  // Rehash all entries
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      DictEntry *next = entry->next;
+    Generic_retain(entry->key);
+    Generic_retain(entry->value);
+    *added = 1;
+    return DictNode_resize(node, node->entryCount, entry, -1, NULL);
+  }
 
-      // Rehash
-      unsigned int new_index = Dict_hash(entry->key, new_capacity);
+  unsigned int bit = Dict_bit(entry->hash, shift);
 
-      // Insert at head of new bucket
-      entry->next = new_buckets[new_index];
-      new_buckets[new_index] = entry;
+  if (node->entryMap & bit) {
+    int at = Dict_index(node->entryMap, bit);
+    DictEntry *old = &node->entries[at];
 
-      entry = next;
+    // same key: take the new value before dropping the old one
+    if (old->hash == entry->hash && Generic_is(old->key, entry->key)) {
+      Generic_retain(entry->value);
+      Generic_release(old->value);
+      old->value = entry->value;
+      return node;
     }
+
+    // another key in the slot: both move down into a new child
+    Generic_retain(entry->key);
+    Generic_retain(entry->value);
+    DictNode *child = DictNode_pair(old, entry, shift + DICT_BITS);
+    node = DictNode_resize(node, at, NULL, Dict_index(node->nodeMap, bit), child);
+    node->entryMap ^= bit;
+    node->nodeMap |= bit;
+    *added = 1;
+    return node;
   }
 
-  free(dict->buckets);
-  dict->buckets = new_buckets;
-  dict->capacity = new_capacity;
+  if (node->nodeMap & bit) {
+    DictNode **slot = &DictNode_children(node)[Dict_index(node->nodeMap, bit)];
+    *slot = DictNode_set(DictNode_unshare(*slot), shift + DICT_BITS, entry, added);
+    return node;
+  }
 
-  return dict;
+  // empty slot
+  Generic_retain(entry->key);
+  Generic_retain(entry->value);
+  node = DictNode_resize(node, Dict_index(node->entryMap, bit), entry, -1, NULL);
+  node->entryMap |= bit;
+  *added = 1;
+  return node;
 }
 
-// Set key-value pair in place (mutates dict, for efficient building)
-void Dict_set_inplace(Dict *dict, Generic *key, Generic *value) {
-  // Check if we need to resize
-  if ((double)dict->size / dict->capacity > DICT_LOAD_FACTOR) {
-    Dict_resize_inplace(dict);
+// remove key, which is in the subtree, from a node the caller owns
+// returns the node to store in its place, NULL if it is now empty
+static DictNode *DictNode_remove(DictNode *node, int shift, Generic *key, unsigned int hash) {
+  if (shift >= DICT_HASH_BITS) {
+    for (int i = 0; i < node->entryCount; i++) {
+      if (Generic_is(node->entries[i].key, key)) {
+        Generic_release(node->entries[i].key);
+        Generic_release(node->entries[i].value);
+        node = DictNode_resize(node, i, NULL, -1, NULL);
+        break;
+      }
+    }
+  } else {
+    unsigned int bit = Dict_bit(hash, shift);
+
+    if (node->entryMap & bit) {
+      int at = Dict_index(node->entryMap, bit);
+      Generic_release(node->entries[at].key);
+      Generic_release(node->entries[at].value);
+      node = DictNode_resize(node, at, NULL, -1, NULL);
+      node->entryMap ^= bit;
+    } else {
+      int at = Dict_index(node->nodeMap, bit);
+      DictNode **children = DictNode_children(node);
+      DictNode *child = DictNode_remove(DictNode_unshare(children[at]), shift + DICT_BITS, key, hash);
+
+      if (child == NULL) {
+        node = DictNode_resize(node, -1, NULL, at, NULL);
+        node->nodeMap ^= bit;
+      } else if (child->entryCount == 1 && child->nodeMap == 0) {
+        // one entry left below: it moves up into this slot
+        DictEntry entry = child->entries[0];
+        DictNode_dispose(child);
+        node = DictNode_resize(node, Dict_index(node->entryMap, bit), &entry, at, NULL);
+        node->nodeMap ^= bit;
+        node->entryMap |= bit;
+      } else {
+        children[at] = child;
+      }
+    }
   }
 
-  unsigned int index = Dict_hash(key, dict->capacity);
-  DictEntry *entry = dict->buckets[index];
+  if (node->entryCount == 0 && node->nodeMap == 0) {
+    DictNode_dispose(node);
+    return NULL;
+  }
+  return node;
+}
 
-  // Check if key already exists
-  while (entry != NULL) {
-    if (Generic_is(entry->key, key)) {
-      // Update existing entry
-      // Decrement old value's refCount first
-      entry->value->refCount--;
-      if (entry->value->refCount == 0) Generic_free(entry->value);
+// trie entry for key, or NULL
+static DictEntry *DictNode_find(DictNode *node, Generic *key, unsigned int hash) {
+  for (int shift = 0; node != NULL; shift += DICT_BITS) {
+    if (shift >= DICT_HASH_BITS) {
+      for (int i = 0; i < node->entryCount; i++) {
+        if (Generic_is(node->entries[i].key, key)) return &node->entries[i];
+      }
+      return NULL;
+    }
 
-      // Set new value and increment refCount (Dict owns the value)
-      entry->value = Generic_copy(value);
-      entry->value->refCount++;
-      return;
+    unsigned int bit = Dict_bit(hash, shift);
+    if (node->entryMap & bit) {
+      DictEntry *entry = &node->entries[Dict_index(node->entryMap, bit)];
+      return entry->hash == hash && Generic_is(entry->key, key) ? entry : NULL;
     }
-    entry = entry->next;
+    if (!(node->nodeMap & bit)) return NULL;
+
+    node = DictNode_children(node)[Dict_index(node->nodeMap, bit)];
   }
 
-  // Key doesn't exist, create new entry
-  DictEntry *new_entry = (DictEntry *) malloc(sizeof(DictEntry));
-  new_entry->key = Generic_copy(key);
-  new_entry->value = Generic_copy(value);
+  return NULL;
+}
+
+// call visit on every entry (a node's entries, then its children); stops when visit returns 0
+typedef int (*DictVisit)(DictEntry *entry, void *context);
 
-  // Dict owns both key and value (increment refCounts)
-  new_entry->key->refCount++;
-  new_entry->value->refCount++;
+static int DictNode_each(DictNode *node, DictVisit visit, void *context) {
+  if (node == NULL) return 1;
 
-  new_entry->next = dict->buckets[index];
-  dict->buckets[index] = new_entry;
-  dict->size++;
+  for (int i = 0; i < node->entryCount; i++) {
+    if (!visit(&node->entries[i], context)) return 0;
+  }
+  DictNode **children = DictNode_children(node);
+  for (int i = 0; i < DictNode_childCount(node); i++) {
+    if (!DictNode_each(children[i], visit, context)) return 0;
+  }
+
+  return 1;
 }
 
-// Set key-value pair (returns new dict, original unchanged for immutability)
-Dict *Dict_set(Dict *dict, Generic *key, Generic *value) {
-  // Create copy for immutability
-  Dict *new_dict = Dict_copy(dict);
+// ============================================================================
+// Dict
+// ============================================================================
+
+// entry for key, or NULL
+static DictEntry *Dict_find(Dict *dict, Generic *key, unsigned int hash) {
+  if (dict->ctrl == NULL) return DictNode_find(dict->root, key, hash);
+
+  int slot = Dict_findSlot(dict, key, hash);
+  return slot < 0 ? NULL : &dict->entries[dict->slots[slot]];
+}
+
+// call visit on every entry: insertion order for a flat dict, trie order otherwise
+static int Dict_each(Dict *dict, DictVisit visit, void *context) {
+  if (dict->ctrl == NULL) return DictNode_each(dict->root, visit, context);
 
-  // Check if we need to resize
-  if ((double)new_dict->size / new_dict->capacity > DICT_LOAD_FACTOR) {
-    new_dict = Dict_resize(new_dict);
+  for (int i = 0; i < dict->count; i++) {
+    if (dict->entries[i].key == NULL) continue;
+    if (!visit(&dict->entries[i], context)) return 0;
   }
+  return 1;
+}
 
-  unsigned int index = Dict_hash(key, new_dict->capacity);
-  DictEntry *entry = new_dict->buckets[index];
+// Give a flat dict its trie, the first time another dict is made from it
+// The pairs go in in insertion order; the table stays for lookups and iteration
+static void Dict_buildTrie(Dict *dict) {
+  if (dict->ctrl == NULL || dict->root != NULL || dict->size == 0) return;
 
-  // Check if key already exists
-  while (entry != NULL) {
-    if (Generic_is(entry->key, key)) {
-      // Update existing entry
-      if (entry->value->refCount == 0) Generic_free(entry->value);
-      entry->value = Generic_copy(value);
-      return new_dict;
-    }
-    entry = entry->next;
+  DictNode *root = DictNode_alloc(0, 0);
+  for (int i = 0; i < dict->count; i++) {
+    DictEntry *entry = &dict->entries[i];
+    if (entry->key == NULL) continue;
+
+    int added = 0;
+    root = DictNode_set(root, 0, entry, &added);
+  }
+  dict->root = root;
+}
+
+// A flat dict changed in place: a trie built from it no longer matches (dicts made from it keep theirs)
+static void Dict_dropTrie(Dict *dict) {
+  DictNode_release(dict->root);
+  dict->root = NULL;
+}
+
+// Create new dictionary with room for expected_size pairs before it has to grow
+Dict *Dict_new(int expected_size) {
+  int capacity = DICT_GROUP;
+  while (DICT_MAX_ENTRIES(capacity) < expected_size) {
+    capacity *= 2;
   }
 
-  // Key doesn't exist, create new entry
-  DictEntry *new_entry = (DictEntry *) malloc(sizeof(DictEntry));
-  new_entry->key = Generic_copy(key);
-  new_entry->value = Generic_copy(value);
-  new_entry->next = new_dict->buckets[index];
-  new_dict->buckets[index] = new_entry;
-  new_dict->size++;
+  Dict *dict = (Dict *) Slab_alloc(sizeof(Dict), SLAB_DICT);
+  dict->count = 0;
+  dict->root = NULL;
+  dict->size = 0;
+  dict->refCount = 1;
+  Dict_allocTable(dict, capacity);
+
+  return dict;
+}
+
+// Free dictionary and all entries
+// Drops one reference; the last holder releases the table and the trie (nodes other
+// dicts share survive)
+void Dict_free(Dict *dict) {
+  dict->refCount--;
+  if (dict->refCount > 0) return;
+
+  if (dict->ctrl != NULL) Dict_freeTable(dict);
+  DictNode_release(dict->root);
+  Slab_free(dict, sizeof(Dict), SLAB_DICT);
+}
 
+// Copy dictionary
+// Dicts are immutable once built, so the copy is the same dict with one more holder
+Dict *Dict_copy(Dict *dict) {
+  dict->refCount++;
+  return dict;
+}
+
+// New trie dict on the same trie, for the operations that return a changed dict:
+// O(1) once dict has its trie; nodes are copied later, and only those on the path of a change
+static Dict *Dict_share(Dict *dict) {
+  Dict_buildTrie(dict);
+
+  Dict *new_dict = (Dict *) Slab_alloc(sizeof(Dict), SLAB_DICT);
+  new_dict->ctrl = NULL;
+  new_dict->slots = NULL;
+  new_dict->capacity = 0;
+  new_dict->entries = NULL;
+  new_dict->count = 0;
+  new_dict->root = dict->root;
+  new_dict->size = dict->size;
+  new_dict->refCount = 1;
+  if (new_dict->root != NULL) new_dict->root->refCount++;
   return new_dict;
 }
 
-// Remove key (returns new dict, original unchanged)
-Dict *Dict_remove(Dict *dict, Generic *key) {
-  // Create copy for immutability
-  Dict *new_dict = Dict_copy(dict);
-
-  unsigned int index = Dict_hash(key, new_dict->capacity);
-  DictEntry *entry = new_dict->buckets[index];
-  DictEntry *prev = NULL;
-
-  while (entry != NULL) {
-    if (Generic_is(entry->key, key)) {
-      // Remove entry
-      if (prev == NULL) {
-        new_dict->buckets[index] = entry->next;
-      } else {
-        prev->next = entry->next;
-      }
+static int Dict_printEntry(DictEntry *entry, void *context) {
+  int *printed = (int *) context;
+  if (*printed > 0) printf(", ");
+
+  Generic_print(entry->key);
+  printf(": ");
+  Generic_print(entry->value);
+
+  (*printed)++;
+  return 1;
+}
+
+// Print dictionary in {key: value, ...} format
+void Dict_print(Dict *dict) {
+  printf("{");
+
+  int printed = 0;
+  Dict_each(dict, Dict_printEntry, &printed);
+
+  printf("}");
+  fflush(stdout);
+}
+
+// Get value for key (returns NULL if not found)
+Generic *Dict_get(Dict *dict, Generic *key) {
+  DictEntry *entry = Dict_find(dict, key, Dict_hash(key));
+  return entry != NULL ? entry->value : NULL;
+}
 
-      // Free entry
-      if (entry->key->refCount == 0) Generic_free(entry->key);
-      if (entry->value->refCount == 0) Generic_free(entry->value);
-      free(entry);
+// Check if key exists
+int Dict_has(Dict *dict, Generic *key) {
+  return Dict_get(dict, key) != NULL ? 1 : 0;
+}
 
-      new_dict->size--;
-      return new_dict;
+// Set key-value pair in place (mutates dict, for efficient building)
+// Only for a dict the caller just created: copies share the dict (see Dict_copy).
+// A flat dict takes the pair in its table; a trie dict copies the nodes it shares
+// with others first, so those dicts are unaffected
+void Dict_set_inplace(Dict *dict, Generic *key, Generic *value) {
+  unsigned int hash = Dict_hash(key);
+
+  if (dict->ctrl != NULL) {
+    Dict_dropTrie(dict);
+
+    int slot = Dict_findSlot(dict, key, hash);
+    if (slot >= 0) {
+      // Update existing entry: take the new value before dropping the old one
+      DictEntry *entry = &dict->entries[dict->slots[slot]];
+      Generic_retain(value);
+      Generic_release(entry->value);
+      entry->value = value;
+      return;
     }
-    prev = entry;
-    entry = entry->next;
+
+    // Key doesn't exist: the dict holds a reference to both key and value, no copies
+    Dict_append(dict, key, value, hash);
+    return;
+  }
+
+  DictEntry entry = {key, value, hash};
+  int added = 0;
+
+  DictNode *root = dict->root != NULL ? DictNode_unshare(dict->root) : DictNode_alloc(0, 0);
+  dict->root = DictNode_set(root, 0, &entry, &added);
+  dict->size += added;
+}
+
+// Remove key in place (mutates dict), same rules as Dict_set_inplace
+// In the table the slot becomes deleted so probes continue past it; the entry is
+// dropped on the next rebuild
+void Dict_remove_inplace(Dict *dict, Generic *key) {
+  unsigned int hash = Dict_hash(key);
+
+  if (dict->ctrl != NULL) {
+    int slot = Dict_findSlot(dict, key, hash);
+    if (slot < 0) return;
+
+    Dict_dropTrie(dict);
+    DictEntry *entry = &dict->entries[dict->slots[slot]];
+    Generic_release(entry->key);
+    Generic_release(entry->value);
+    entry->key = NULL;
+    entry->value = NULL;
+
+    dict->ctrl[slot] = DICT_DELETED;
+    dict->size--;
+    return;
   }
 
-  // Key not found, return unchanged dict
+  if (DictNode_find(dict->root, key, hash) == NULL) return;
+
+  dict->root = DictNode_remove(DictNode_unshare(dict->root), 0, key, hash);
+  dict->size--;
+}
+
+// Set key-value pair (returns new dict, original unchanged for immutability)
+// O(log n): the new dict shares every node off the path to key
+Dict *Dict_set(Dict *dict, Generic *key, Generic *value) {
+  Dict *new_dict = Dict_share(dict);
+  Dict_set_inplace(new_dict, key, value);
+  return new_dict;
+}
+
+// Remove key (returns new dict, original unchanged)
+Dict *Dict_remove(Dict *dict, Generic *key) {
+  // Key not found: nothing changes, so share the dict
+  if (Dict_find(dict, key, Dict_hash(key)) == NULL) return Dict_copy(dict);
+
+  Dict *new_dict = Dict_share(dict);
+  Dict_remove_inplace(new_dict, key);
   return new_dict;
 }
 
@@ -309,72 +718,87 @@ int Dict_size(Dict *dict) {
   return dict->size;
 }
 
-// Get all keys as array (caller must free array but not contents)
-Generic **Dict_keys(Dict *dict, int *count) {
-  *count = dict->size;
-  Generic **keys = (Generic **) malloc(sizeof(Generic *) * dict->size);
-
-  int idx = 0;
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      keys[idx++] = entry->key;
-      entry = entry->next;
-    }
+typedef struct DictCollect {
+  void *items;
+  int count;
+  int part;  // 0: keys, 1: values, 2: whole entries
+} DictCollect;
+
+static int Dict_collectEntry(DictEntry *entry, void *context) {
+  DictCollect *collect = (DictCollect *) context;
+  if (collect->part == 2) {
+    ((DictEntry *) collect->items)[collect->count++] = *entry;
+  } else {
+    ((Generic **) collect->items)[collect->count++] = collect->part == 0 ? entry->key : entry->value;
   }
+  return 1;
+}
+
+static void *Dict_collect(Dict *dict, int part, size_t width, int *count) {
+  DictCollect collect = {malloc(width * (dict->size > 0 ? dict->size : 1)), 0, part};
+  Dict_each(dict, Dict_collectEntry, &collect);
+  *count = collect.count;
+  return collect.items;
+}
 
-  return keys;
+// Get all keys as array (caller must free array but not contents)
+// Insertion order for a flat dict, hash order for a trie dict
+Generic **Dict_keys(Dict *dict, int *count) {
+  return (Generic **) Dict_collect(dict, 0, sizeof(Generic *), count);
 }
 
-// Get all values as array (caller must free array but not contents)
+// Get all values as array, in the order of Dict_keys (caller must free array but not contents)
 Generic **Dict_values(Dict *dict, int *count) {
-  *count = dict->size;
-  Generic **values = (Generic **) malloc(sizeof(Generic *) * dict->size);
-
-  int idx = 0;
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      values[idx++] = entry->value;
-      entry = entry->next;
-    }
-  }
+  return (Generic **) Dict_collect(dict, 1, sizeof(Generic *), count);
+}
 
-  return values;
+// Get all entries as array, in the order of Dict_keys (caller must free array but not contents)
+DictEntry *Dict_entries(Dict *dict, int *count) {
+  return (DictEntry *) Dict_collect(dict, 2, sizeof(DictEntry), count);
 }
 
 // Merge two dictionaries (dict2 values overwrite dict1 on conflict)
+// The result starts as the larger dict's trie, so its untouched subtrees are shared
 Dict *Dict_merge(Dict *dict1, Dict *dict2) {
-  // Start with copy of dict1
-  Dict *result = Dict_copy(dict1);
-
-  // Add all entries from dict2 using in-place mutation
-  for (int i = 0; i < dict2->capacity; i++) {
-    DictEntry *entry = dict2->buckets[i];
-    while (entry != NULL) {
-      Dict_set_inplace(result, entry->key, entry->value);
-      entry = entry->next;
+  if (dict2->size == 0) return Dict_copy(dict1);
+  if (dict1->size == 0) return Dict_copy(dict2);
+
+  int count;
+  DictEntry *entries;
+  Dict *result;
+
+  if (dict1->size >= dict2->size) {
+    // dict1 plus every entry of dict2
+    result = Dict_share(dict1);
+    entries = Dict_entries(dict2, &count);
+    for (int i = 0; i < count; i++) {
+      Dict_set_inplace(result, entries[i].key, entries[i].value);
+    }
+  } else {
+    // dict2 plus the entries of dict1 it does not override
+    result = Dict_share(dict2);
+    entries = Dict_entries(dict1, &count);
+    for (int i = 0; i < count; i++) {
+      if (Dict_find(result, entries[i].key, entries[i].hash) == NULL) {
+        Dict_set_inplace(result, entries[i].key, entries[i].value);
+      }
     }
   }
 
+  free(entries);
   return result;
 }
 
+static int Dict_compareEntry(DictEntry *entry, void *context) {
+  DictEntry *other = Dict_find((Dict *) context, entry->key, entry->hash);
+  return other != NULL && Generic_is(entry->value, other->value);
+}
+
 // Compare two dicts for equality
 int Dict_compare(Dict *dict1, Dict *dict2) {
   if (dict1->size != dict2->size) return 0;
+  if (dict1->ctrl == NULL && dict2->ctrl == NULL && dict1->root == dict2->root) return 1;
 
   // Check all entries in dict1 exist in dict2 with same values
-  for (int i = 0; i < dict1->capacity; i++) {
-    DictEntry *entry = dict1->buckets[i];
-    while (entry != NULL) {
-      Generic *value2 = Dict_get(dict2, entry->key);
-      if (value2 == NULL || !Generic_is(entry->value, value2)) {
-        return 0;
-      }
-      entry = entry->next;
-    }
-  }
-
-  return 1;
+  return Dict_each(dict1, Dict_compareEntry, dict2);
 }
@@ -2,37 +2,81 @@
 #define DICT_H
 #include "generic.h"
 
-// Hash table entry (key-value pair with collision chaining)
+#define DICT_BITS 5
+#define DICT_WIDTH (1 << DICT_BITS)
+#define DICT_MASK (DICT_WIDTH - 1)
+#define DICT_HASH_BITS 32  // trie levels stop here: deeper nodes hold keys whose whole hash collides
+
+// Key-value pair
+// hash: Dict_hash(key), kept so probing, resizing and moving an entry down the trie
+// never rehash the key
+// In the flat table's entries, key is NULL once the pair has been removed (until the
+// table is rebuilt)
 typedef struct DictEntry {
   Generic *key;
   Generic *value;
-  struct DictEntry *next;  // For collision resolution via chaining
+  unsigned int hash;
 } DictEntry;
 
-// Hash table dictionary
+// hash array mapped trie node
+// Each level takes DICT_BITS bits of the hash. A slot holds either an entry (its bit set
+// in entryMap) or a child node (bit set in nodeMap); only used slots are stored, packed:
+// entryCount entries, then popcount(nodeMap) child pointers, in slot order.
+// Below DICT_HASH_BITS a node is a plain list of entries with the same hash (nodeMap 0).
+// refCount: number of parents (Dict headers or nodes) pointing at it
+typedef struct DictNode {
+  int refCount;
+  int entryCount;
+  unsigned int entryMap;
+  unsigned int nodeMap;
+  DictEntry entries[];
+} DictNode;
+
+// Dictionary: a flat hash table while it is fresh, a persistent hash trie once shared
+//
+// A new dict is an open-addressing table with Swiss-table control bytes: ctrl has one
+// byte per slot (empty, deleted, or the low 7 bits of the hash), slots are probed 16 at
+// a time (one SSE2 compare), and pairs sit densely in entries, in insertion order.
+// Dict_set_inplace builds it.
+//
+// The first time a dict is the base of another one (Dict_set, Dict_remove, Dict_merge)
+// its pairs are also put in a trie, kept in root, and the new dict is only a header on
+// that trie. Updates then copy only the nodes on the path to the changed key, and only if
+// another dict shares them, so a chain of dict_set is O(log n) per step. A trie dict has
+// ctrl NULL and iterates in hash order.
+//
+// Entries hold a reference to their key and value. A dict is not changed once built, so
+// copies share it: refCount counts the generics (and closures) using this header
 typedef struct Dict {
-  DictEntry **buckets;  // Array of bucket chains
-  int capacity;         // Number of buckets
-  int size;            // Number of key-value pairs
+  unsigned char *ctrl;  // Control byte per slot, NULL for a trie dict
+  int *slots;           // Index into entries for each full slot
+  int capacity;         // Number of slots (a power of two, at least 16)
+  DictEntry *entries;   // Pairs in insertion order, removed ones have key NULL
+  int count;            // Entries used, including removed ones
+  DictNode *root;       // Trie (NULL when empty, or for a flat dict not yet shared)
+  int size;             // Number of key-value pairs
+  int refCount;         // Holders sharing this dict
 } Dict;
 
 // Prototypes
-Dict *Dict_new(int initial_capacity);
+Dict *Dict_new(int expected_size);
 void Dict_free(Dict *dict);
 Dict *Dict_copy(Dict *dict);
 void Dict_print(Dict *dict);
 
-unsigned int Dict_hash(Generic *key, int capacity);
+unsigned int Dict_hash(Generic *key);
 Generic *Dict_get(Dict *dict, Generic *key);
 void Dict_set_inplace(Dict *dict, Generic *key, Generic *value);
+void Dict_remove_inplace(Dict *dict, Generic *key);
 Dict *Dict_set(Dict *dict, Generic *key, Generic *value);
 Dict *Dict_remove(Dict *dict, Generic *key);
 int Dict_has(Dict *dict, Generic *key);
 int Dict_size(Dict *dict);
 
-// Helper to get all keys/values as lists
+// Helper to get all keys/values/entries as arrays, in the same order
 Generic **Dict_keys(Dict *dict, int *count);
 Generic **Dict_values(Dict *dict, int *count);
+DictEntry *Dict_entries(Dict *dict, int *count);
 
 // Merge two dicts
 Dict *Dict_merge(Dict *dict1, Dict *dict2);
@@ -1,6 +1,7 @@
 #include "file_advanced.h"
 #include "../generic.h"
 #include "../list.h"
+#include "../string-object/string_object.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -119,15 +120,7 @@ List *listFiles(char *dirpath, int lineNumber) {
     }
 
     // Create string Generic for filename
-    // Allocate string on heap
-    char *filename = malloc(strlen(entry->d_name) + 1);
-    strcpy(filename, entry->d_name);
-
-    // Allocate char** on heap (Generic stores char** for strings, not char*)
-    char **filenamePtr = malloc(sizeof(char *));
-    *filenamePtr = filename;
-
-    Generic *filenameGeneric = Generic_new(TYPE_STRING, filenamePtr, 0);
+    Generic *filenameGeneric = Generic_newString(String_fromText(entry->d_name), 0);
 
     items[index++] = filenameGeneric;
   }
@@ -76,6 +76,7 @@ int FreeVar_is_global_builtin(const char *name) {
   if (strcmp(name, "format-int") == 0) return 1;
   if (strcmp(name, "format-float") == 0) return 1;
   if (strcmp(name, "join") == 0) return 1;
+  if (strcmp(name, "intern") == 0) return 1;
   if (strcmp(name, "get") == 0) return 1;  //  Substring/list indexing
 
   // Dict operations ()
@@ -313,3 +314,121 @@ int FreeVar_analyze(AstNode *p_fn) {
 
   return freeVarsCount;
 }
+
+//  Escape analysis
+
+// Argument index (in the OP_APPLICATION) of the callback of a runtime helper that
+// calls it while it runs and keeps no reference to it; -1 for anything else
+static int FreeVar_callbackIndex(AstNode *callee) {
+  if (!callee || callee->opcode != OP_IDENTIFIER || !callee->val) return -1;
+  const char *name = callee->val;
+
+  if (strcmp(name, "map") == 0 || strcmp(name, "filter") == 0 ||
+      strcmp(name, "reduce") == 0 || strcmp(name, "dict_map") == 0 ||
+      strcmp(name, "dict_filter") == 0) {
+    return 2;
+  }
+  if (strcmp(name, "map2") == 0) return 3;
+  return -1;
+}
+
+// Does name appear anywhere under node?
+static int FreeVar_mentions(AstNode *node, const char *name) {
+  if (!node) return 0;
+  if (node->opcode == OP_IDENTIFIER && node->val && strcmp(node->val, name) == 0) return 1;
+  for (int i = 0; i < node->childCount; i++) {
+    if (FreeVar_mentions(node->children[i], name)) return 1;
+  }
+  return 0;
+}
+
+// Count the uses of name under node that could let the closure it holds escape
+// (everything but calling it and passing it as a runtime callback), and its assignments
+static int FreeVar_escapingUses(AstNode *node, const char *name, int *assignments) {
+  if (!node) return 0;
+
+  switch (node->opcode) {
+    case OP_IDENTIFIER:
+      return node->val && strcmp(node->val, name) == 0;
+
+    case OP_FUNCTION:
+      // Captured by another closure: its environment would hold our pointer
+      return FreeVar_mentions(node, name);
+
+    case OP_ASSIGNMENT: {
+      AstNode *target = node->childCount > 0 ? node->children[0] : NULL;
+      if (target && target->val && strcmp(target->val, name) == 0) (*assignments)++;
+      return node->childCount >= 2 ? FreeVar_escapingUses(node->children[1], name, assignments) : 0;
+    }
+
+    case OP_APPLICATION: {
+      if (node->childCount == 0) return 0;
+      int callbackIndex = FreeVar_callbackIndex(node->children[0]);
+      int uses = 0;
+      for (int i = 0; i < node->childCount; i++) {
+        AstNode *child = node->children[i];
+        int isName = child->opcode == OP_IDENTIFIER && child->val && strcmp(child->val, name) == 0;
+        if (isName && (i == 0 || i == callbackIndex)) continue;
+        uses += FreeVar_escapingUses(child, name, assignments);
+      }
+      return uses;
+    }
+
+    default: {
+      int uses = 0;
+      for (int i = 0; i < node->childCount; i++) {
+        uses += FreeVar_escapingUses(node->children[i], name, assignments);
+      }
+      return uses;
+    }
+  }
+}
+
+static void FreeVar_markEscapes_rec(AstNode *node, AstNode *p_fn, int paramCount) {
+  if (node == NULL || node->opcode == OP_FUNCTION) return;
+
+  if (node->opcode == OP_APPLICATION && node->childCount > 0) {
+    int callbackIndex = FreeVar_callbackIndex(node->children[0]);
+    if (callbackIndex > 0 && callbackIndex < node->childCount &&
+        node->children[callbackIndex]->opcode == OP_FUNCTION) {
+      node->children[callbackIndex]->noEscape = 1;
+    }
+  } else if (node->opcode == OP_ASSIGNMENT && node->childCount >= 2 &&
+             node->children[1]->opcode == OP_FUNCTION && !node->isMutable) {
+    AstNode *target = node->children[0];
+    char *name = target->val;
+
+    if (target->opcode == OP_IDENTIFIER && name) {
+      int isParam = 0;
+      for (int i = 0; i < paramCount; i++) {
+        if (p_fn->children[i]->val && strcmp(p_fn->children[i]->val, name) == 0) isParam = 1;
+      }
+
+      int assignments = 0;
+      int uses = 0;
+      for (int i = paramCount; i < p_fn->childCount; i++) {
+        uses += FreeVar_escapingUses(p_fn->children[i], name, &assignments);
+      }
+      if (!isParam && uses == 0 && assignments == 1) {
+        node->children[1]->noEscape = 1;
+      }
+    }
+  }
+
+  for (int i = 0; i < node->childCount; i++) {
+    FreeVar_markEscapes_rec(node->children[i], p_fn, paramCount);
+  }
+}
+
+void FreeVar_markEscapes(AstNode *p_fn) {
+  if (p_fn == NULL || p_fn->opcode != OP_FUNCTION) return;
+
+  int paramCount = 0;
+  while (paramCount < p_fn->childCount && p_fn->children[paramCount]->opcode == OP_IDENTIFIER) {
+    paramCount++;
+  }
+
+  for (int i = paramCount; i < p_fn->childCount; i++) {
+    FreeVar_markEscapes_rec(p_fn->children[i], p_fn, paramCount);
+  }
+}
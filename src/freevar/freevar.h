@@ -32,4 +32,17 @@ void FreeVar_add_unique(char ***freeVars, int *count, char *name);
 // Returns: 1 if global built-in, 0 if local variable
 int FreeVar_is_global_builtin(const char *name);
 
+//  Escape analysis for closure environments
+// Marks the function literals in p_fn's body that never outlive a call to p_fn
+// (noEscape = 1), so their closure and environment can live in p_fn's frame:
+//
+//   (map xs {x -> <- (add x k)})      literal passed straight to map/filter/reduce/...
+//   f = {x -> <- (add x k)}           local that is only called, or passed to them
+//   (println (f 1) (filter xs f))
+//
+// Anything else escapes: returning it, storing it, passing it to a user function,
+// mentioning it from another closure. Nested bodies are marked when compiled.
+// p_fn: OP_FUNCTION node whose body to scan
+void FreeVar_markEscapes(AstNode *p_fn);
+
 #endif
@@ -9,15 +9,17 @@
 #include "closure/closure.h"  //  Closure support
 #include "mutable-refs/ref.h"  //  Mutable reference support
 #include "bytecode_stub.h"     //  Stub for removed bytecode closures
+#include "slab/slab.h"         //  Size-class allocator for Generic headers
+#include "string-object/string_object.h"  //  Length-prefixed shared strings
 
 // print generic nicely
 void Generic_print(Generic *in) {
   if (in->type == TYPE_INT) {
-    printf("%i", *((int *) in->p_val));
+    printf("%lld", (long long) in->intVal);
   } else if (in->type == TYPE_FLOAT) {
-    printf("%f", *((double *) in->p_val));
+    printf("%f", in->floatVal);
   } else if (in->type == TYPE_STRING) {
-    printf("%s", *((char **) in->p_val));
+    fwrite(in->strVal, 1, String_length(in->strVal), stdout);
   } else if (in->type == TYPE_VOID) {
     printf("[Void]");
   } else if (in->type == TYPE_FUNCTION) {
@@ -41,27 +43,76 @@ void Generic_print(Generic *in) {
   fflush(stdout);
 }
 
+// Immortal singletons: void and the small ints, never allocated or freed
+#define IMMORTAL_INT(n) { .type = TYPE_INT, .intVal = (n), .refCount = GENERIC_IMMORTAL, .isMutable = 0, .isInterned = 0 }
+#define IMMORTAL_INT4(n) IMMORTAL_INT(n), IMMORTAL_INT(n + 1), IMMORTAL_INT(n + 2), IMMORTAL_INT(n + 3)
+#define IMMORTAL_INT16(n) IMMORTAL_INT4(n), IMMORTAL_INT4(n + 4), IMMORTAL_INT4(n + 8), IMMORTAL_INT4(n + 12)
+
+static Generic genericVoid = { .type = TYPE_VOID, .p_val = NULL, .refCount = GENERIC_IMMORTAL, .isMutable = 0, .isInterned = 0 };
+
+static Generic genericSmallInts[GENERIC_SMALL_INT_MAX - GENERIC_SMALL_INT_MIN + 1] = {
+  IMMORTAL_INT16(-16),
+  IMMORTAL_INT16(0), IMMORTAL_INT16(16), IMMORTAL_INT16(32), IMMORTAL_INT16(48),
+  IMMORTAL_INT16(64), IMMORTAL_INT16(80), IMMORTAL_INT16(96), IMMORTAL_INT16(112),
+  IMMORTAL_INT16(128), IMMORTAL_INT16(144), IMMORTAL_INT16(160), IMMORTAL_INT16(176),
+  IMMORTAL_INT16(192), IMMORTAL_INT16(208), IMMORTAL_INT16(224), IMMORTAL_INT16(240)
+};
+
+// the shared void value
+Generic *Generic_void(void) {
+  return &genericVoid;
+}
+
 // create a new generic and return
+// p_val is the heap object of the new generic (NULL for void); scalars use Generic_newInt/Float/String
 Generic* Generic_new(enum Type type, void *p_val, int refCount) {
-  Generic *res = malloc(sizeof(Generic));
+  Generic *res = Slab_alloc(sizeof(Generic), SLAB_GENERIC);
   res->type = type;
   res->p_val = p_val;
   res->refCount = refCount;
   res->isMutable = 1;  // Default: mutable (backward compatible)
+  res->isInterned = 0;
+  return res;
+}
+
+// create a new int generic, the value is stored inline
+// small ints return the shared immortal instead, refCount is then irrelevant
+Generic *Generic_newInt(int64_t value, int refCount) {
+  if (value >= GENERIC_SMALL_INT_MIN && value <= GENERIC_SMALL_INT_MAX) {
+    return &genericSmallInts[value - GENERIC_SMALL_INT_MIN];
+  }
+  Generic *res = Generic_new(TYPE_INT, NULL, refCount);
+  res->intVal = value;
+  return res;
+}
+
+// create a new float generic, the value is stored inline
+Generic *Generic_newFloat(double value, int refCount) {
+  Generic *res = Generic_new(TYPE_FLOAT, NULL, refCount);
+  res->floatVal = value;
+  return res;
+}
+
+// create a new string generic holding value, the text of a String; the generic takes
+// over the caller's reference and releases it when freed
+Generic *Generic_newString(char *value, int refCount) {
+  Generic *res = Generic_new(TYPE_STRING, NULL, refCount);
+  res->strVal = value;
   return res;
 }
 
 // frees p_val of generic
 void Generic_free(Generic *target) {
+  if (Generic_isImmortal(target)) return;
+
   #ifdef DEBUG_GENERIC_FREE
   fprintf(stderr, "[DEBUG] Generic_free: Freeing type %s (refCount was %d)\n",
           getTypeString(target->type), target->refCount);
   #endif
 
-  // if string, free contents as well
-  if (target->type == TYPE_STRING) free(*((char **) target->p_val));
-
-  if (target->type == TYPE_LIST) {
+  if (target->type == TYPE_STRING) {
+    String_release(target->strVal); // shared by copies, freed with the last one
+  } else if (target->type == TYPE_LIST) {
     List_free((List *) (target->p_val)); // use list's own free function
   } else if (target->type == TYPE_DICT) {
     Dict_free((Dict *) (target->p_val)); // use dict's own free function
@@ -80,15 +131,13 @@ void Generic_free(Generic *target) {
     fprintf(stderr, "[DEBUG] Generic_free: Calling Ref_release\n");
     #endif
     Ref_release((Ref *) target->p_val); //  mutable references have their own free function
-  } else if (target->type != TYPE_NATIVEFUNCTION) {
-    // dont free native functions, as their void pointers are not allocated to heap
-    free(target->p_val);
   }
+  // ints, floats and void are inline, native functions are not allocated to heap
 
   target->p_val = NULL;
 
   // free generic itself
-  free(target);
+  Slab_free(target, sizeof(Generic), SLAB_GENERIC);
 }
 
 // returns type as a string given enum
@@ -109,16 +158,22 @@ char *getTypeString(enum Type type) {
   }
 }
 
+// shallow copy: a new generic the caller owns, sharing the payload where it is immutable
+// (strings and dicts are shared whole, lists share their trie), so copying a nested structure is O(1)
 Generic *Generic_copy(Generic *target) {
-  Generic *res = (Generic *) malloc(sizeof(Generic));
+  // immortals are never freed, so they can be shared as they are
+  if (Generic_isImmortal(target)) return target;
+
+  Generic *res = (Generic *) Slab_alloc(sizeof(Generic), SLAB_GENERIC);
   res->type = target->type;
   res->refCount = 0;
   res->isMutable = target->isMutable;  // Preserve mutability
+  res->isInterned = 0;
 
   if (res->type == TYPE_STRING) {
-    res->p_val = (char **) malloc(sizeof(char *));
-    *((char **) res->p_val) = malloc(sizeof(char) * (strlen(*((char **) target->p_val)) + 1));
-    strcpy(*((char **) res->p_val), *((char **) target->p_val));
+    // strings are never changed once built, so the copy shares the bytes
+    res->strVal = target->strVal;
+    String_retain(res->strVal);
   } else if (res->type == TYPE_FUNCTION) {
     res->p_val = AstNode_copy(target->p_val, 0);
   } else if (res->type == TYPE_BYTECODE_CLOSURE) {
@@ -129,11 +184,9 @@ Generic *Generic_copy(Generic *target) {
   } else if (res->type == TYPE_VOID) {
     res->p_val = NULL;
   } else if (res->type == TYPE_INT) {
-    res->p_val = (int *) malloc(sizeof(int));
-    *((int *) res->p_val) = *((int *) target->p_val);
+    res->intVal = target->intVal;
   } else if (res->type == TYPE_FLOAT) {
-    res->p_val = (double *) malloc(sizeof(double));
-    *((double *) res->p_val) = *((double *) target->p_val);
+    res->floatVal = target->floatVal;
   } else if (res->type == TYPE_LIST) {
     res->p_val = List_copy((List *) target->p_val);
   } else if (res->type == TYPE_DICT) {
@@ -159,8 +212,8 @@ int Generic_is(Generic *a, Generic *b) {
     && (b->type == TYPE_INT || b->type == TYPE_FLOAT)
   ) {
     return (
-      (a->type == TYPE_FLOAT ? *((double *) a->p_val) : *((int *) a->p_val))
-      == (b->type == TYPE_FLOAT ? *((double *) b->p_val) : *((int *) b->p_val))
+      (a->type == TYPE_FLOAT ? a->floatVal : a->intVal)
+      == (b->type == TYPE_FLOAT ? b->floatVal : b->intVal)
     );
   }
 
@@ -170,13 +223,16 @@ int Generic_is(Generic *a, Generic *b) {
     // do type conversions and check data
     switch (a->type) {
       case TYPE_FLOAT:
-        if (*((double *) a->p_val) == *((double *) b->p_val)) res = 1;
+        if (a->floatVal == b->floatVal) res = 1;
         break;
       case TYPE_INT:
-        if (*((int *) a->p_val) == *((int *) b->p_val)) res = 1;
+        if (a->intVal == b->intVal) res = 1;
         break;
       case TYPE_STRING:
-        if (strcmp(*((char **) a->p_val), *((char **) b->p_val)) == 0) res = 1;
+        // interned strings are unique per text, so two of them compare by pointer
+        if (a == b) res = 1;
+        else if (a->isInterned && b->isInterned) res = 0;
+        else res = String_equals(a->strVal, b->strVal);
         break;
       case TYPE_VOID:
         res = 1;
@@ -208,38 +264,31 @@ int Generic_is(Generic *a, Generic *b) {
 }
 
 //  Convenience constructors for bytecode compiler/VM
-Generic *Generic_fromInt(int value) {
-  int *p_int = malloc(sizeof(int));
-  *p_int = value;
-  return Generic_new(TYPE_INT, p_int, 1);
+Generic *Generic_fromInt(int64_t value) {
+  return Generic_newInt(value, 1);
 }
 
 Generic *Generic_fromFloat(double value) {
-  double *p_float = malloc(sizeof(double));
-  *p_float = value;
-  return Generic_new(TYPE_FLOAT, p_float, 1);
+  return Generic_newFloat(value, 1);
 }
 
 Generic *Generic_fromString(const char *value) {
-  char **p_str = malloc(sizeof(char *));
-  *p_str = malloc(strlen(value) + 1);
-  strcpy(*p_str, value);
-  return Generic_new(TYPE_STRING, p_str, 1);
+  return Generic_newString(String_fromText(value), 1);
 }
 
 Generic *Generic_fromVoid(void) {
-  return Generic_new(TYPE_VOID, NULL, 1);
+  return Generic_void();
 }
 
 //  Reference counting helpers for bytecode VM
 void Generic_retain(Generic *target) {
-  if (target != NULL) {
+  if (target != NULL && !Generic_isImmortal(target)) {
     target->refCount++;
   }
 }
 
 void Generic_release(Generic *target) {
-  if (target == NULL) return;
+  if (target == NULL || Generic_isImmortal(target)) return;
 
   target->refCount--;
   if (target->refCount == 0) {
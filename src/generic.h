@@ -1,5 +1,6 @@
 #ifndef GENERIC_H
 #define GENERIC_H
+#include <stdint.h>
 
 // types for generic
 enum Type {
@@ -17,27 +18,59 @@ enum Type {
 };
 
 // generic struct
-// p_val: a void pointer to the value
-// type: the type of *p_val
-// refCount: reference count for garbage collection
+// type: selects the union member that holds the value
+// refCount: reference count for garbage collection (scope bindings, list
+//   and dict entries and refs each hold one reference; 0 is a temporary)
 // isMutable: 1 if the value can be modified, 0 if immutable
+// isInterned: 1 for a string from the intern table (src/intern), which is
+//   immortal and the only Generic with its text
+// Scalars are stored inline, so boxing one is a single allocation:
+//   intVal   (TYPE_INT)    64-bit, same width as the i64 the LLVM backend uses
+//   floatVal (TYPE_FLOAT)
+//   strVal   (TYPE_STRING) text of a String (src/string-object), which holds its
+//            length, hash and refcount; copies of the generic share it
+//   p_val    (every other type) pointer to the List, Dict, AstNode, Ref, ...
 typedef struct Generic {
   enum Type type;
-  void *p_val;
+  union {
+    int64_t intVal;
+    double floatVal;
+    char *strVal;
+    void *p_val;
+  };
   int refCount;
-  int isMutable;
+  unsigned char isMutable;
+  unsigned char isInterned;
 } Generic;
 
+// Immortal generics: statically allocated, shared by every user and never freed.
+// Void, the small ints (0/1 are also the booleans) and the literals the LLVM
+// backend emits as global data are immortal. Their refCount starts at
+// GENERIC_IMMORTAL; the runtime's plain refCount++/-- may move it, but never
+// anywhere near 0, so Generic_free/Generic_copy/Generic_release just check the
+// range and leave them alone.
+#define GENERIC_IMMORTAL (1 << 30)
+#define GENERIC_SMALL_INT_MIN -16
+#define GENERIC_SMALL_INT_MAX 255
+
+static inline int Generic_isImmortal(Generic *target) {
+  return target->refCount >= GENERIC_IMMORTAL / 2;
+}
+
 // prototypes
 char* getTypeString(enum Type);
 void Generic_print(Generic *);
-Generic *Generic_new(enum Type, void *, int refCount);
+Generic *Generic_new(enum Type, void *, int refCount);  // heap types
+Generic *Generic_newInt(int64_t value, int refCount);   // small ints are shared immortals
+Generic *Generic_newFloat(double value, int refCount);
+Generic *Generic_newString(char *value, int refCount);  // takes over a String (String_new, String_fromText, ...)
+Generic *Generic_void(void);                            // the shared immortal void
 void Generic_free(Generic *);
 Generic *Generic_copy(Generic *);
 int Generic_is(Generic *, Generic *);
 
 //  Convenience constructors for bytecode compiler/VM
-Generic *Generic_fromInt(int value);
+Generic *Generic_fromInt(int64_t value);
 Generic *Generic_fromFloat(double value);
 Generic *Generic_fromString(const char *value);
 Generic *Generic_fromVoid(void);
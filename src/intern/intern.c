@@ -0,0 +1,164 @@
+#include "intern.h"
+#include "../slab/slab.h"
+#include "../string-object/string_object.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/**
+ * String Interning
+ *
+ * Two open-addressing tables of the same interned Generics, both linear
+ * probing over a power-of-two array kept at most half full:
+ *   byHash  probed by the text's hash, for Intern_string / Intern_find
+ *   byText  probed by the address of the text, for Intern_fromText
+ * An interned string is an immortal Generic holding an immortal String, whose
+ * header keeps the hash the table probes with.
+ */
+
+#define INTERN_INITIAL_CAPACITY 256
+
+static Generic **internByHash = NULL;
+static Generic **internByText = NULL;
+static int internCapacity = 0;
+static int internCount = 0;
+static atomic_flag internLock = ATOMIC_FLAG_INIT;
+
+static inline void Intern_lock(void) {
+  while (atomic_flag_test_and_set_explicit(&internLock, memory_order_acquire)) {
+  }
+}
+
+static inline void Intern_unlock(void) {
+  atomic_flag_clear_explicit(&internLock, memory_order_release);
+}
+
+// Pointer hash for byText (the MurmurHash3 64-bit final mix)
+static inline unsigned int Intern_addressHash(const char *text) {
+  uint64_t bits = (uint64_t) (uintptr_t) text;
+  bits ^= bits >> 33;
+  bits *= 0xff51afd7ed558ccdULL;
+  bits ^= bits >> 33;
+  return (unsigned int) bits;
+}
+
+// byHash slot holding text, or the empty slot where it belongs
+static int Intern_probe(const char *text, unsigned int hash) {
+  int mask = internCapacity - 1;
+  int slot = hash & mask;
+  while (internByHash[slot] != NULL) {
+    Generic *found = internByHash[slot];
+    if (String_hash(found->strVal) == hash && strcmp(found->strVal, text) == 0) return slot;
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+static void Intern_insertText(Generic *interned) {
+  int mask = internCapacity - 1;
+  int slot = Intern_addressHash(interned->strVal) & mask;
+  while (internByText[slot] != NULL) slot = (slot + 1) & mask;
+  internByText[slot] = interned;
+}
+
+// Double both tables (or create them), reinserting from the stored hashes
+static void Intern_grow(void) {
+  Generic **oldByHash = internByHash;
+  int oldCapacity = internCapacity;
+
+  internCapacity = oldCapacity ? oldCapacity * 2 : INTERN_INITIAL_CAPACITY;
+  internByHash = (Generic **) calloc(internCapacity, sizeof(Generic *));
+  free(internByText);
+  internByText = (Generic **) calloc(internCapacity, sizeof(Generic *));
+
+  for (int i = 0; i < oldCapacity; i++) {
+    Generic *interned = oldByHash[i];
+    if (interned == NULL) continue;
+
+    int slot = String_hash(interned->strVal) & (internCapacity - 1);
+    while (internByHash[slot] != NULL) slot = (slot + 1) & (internCapacity - 1);
+    internByHash[slot] = interned;
+    Intern_insertText(interned);
+  }
+
+  free(oldByHash);
+}
+
+// Interned Generic for text with this hash, NULL if absent (table locked by the caller)
+static Generic *Intern_lookup(const char *text, unsigned int hash) {
+  if (internCount == 0) return NULL;
+  return internByHash[Intern_probe(text, hash)];
+}
+
+Generic *Intern_string(const char *text) {
+  // Hash the text the same way Dict_hash hashes a string key
+  unsigned int hash = String_hashBytes(text, (int) strlen(text));
+
+  Intern_lock();
+
+  Generic *found = Intern_lookup(text, hash);
+  if (found != NULL) {
+    Intern_unlock();
+    return found;
+  }
+
+  if ((internCount + 1) * 2 > internCapacity) Intern_grow();
+
+  char *copy = String_fromText(text);
+  String_of(copy)->refCount = STRING_IMMORTAL;
+  String_of(copy)->hash = hash;
+
+  Generic *res = (Generic *) Slab_alloc(sizeof(Generic), SLAB_GENERIC);
+  res->type = TYPE_STRING;
+  res->strVal = copy;
+  res->refCount = GENERIC_IMMORTAL;
+  res->isMutable = 0;
+  res->isInterned = 1;
+
+  internByHash[Intern_probe(text, hash)] = res;
+  Intern_insertText(res);
+  internCount++;
+
+  Intern_unlock();
+  return res;
+}
+
+Generic *Intern_generic(Generic *string) {
+  if (string->isInterned) return string;
+  return Intern_string(string->strVal);
+}
+
+Generic *Intern_find(Generic *string) {
+  if (string->isInterned) return string;
+
+  unsigned int hash = String_hash(string->strVal);
+  Intern_lock();
+  Generic *found = Intern_lookup(string->strVal, hash);
+  Intern_unlock();
+  return found;
+}
+
+Generic *Intern_fromText(const char *text) {
+  Generic *found = NULL;
+
+  Intern_lock();
+  if (internCount > 0) {
+    int mask = internCapacity - 1;
+    int slot = Intern_addressHash(text) & mask;
+    while (internByText[slot] != NULL) {
+      if (internByText[slot]->strVal == text) {
+        found = internByText[slot];
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+  Intern_unlock();
+
+  return found;
+}
+
+int Intern_count(void) {
+  return internCount;
+}
@@ -0,0 +1,64 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "../generic.h"
+
+/**
+ * String Interning
+ *
+ * The intern table keeps one immortal string Generic per distinct text, with
+ * isInterned set. Its String's hash is computed once, when it is interned. Two
+ * interned strings are equal exactly when they are the same Generic, so:
+ *   - Generic_is compares two interned strings by pointer
+ *   - Dict_hash finds the hash already in the String
+ *   - a dict lookup with an interned key never compares bytes
+ *
+ * The LLVM backend interns string literals used as dict keys, variant tags
+ * and match patterns, once per use site (see LLVMConstants_internedString).
+ * Runtime strings are interned only on request, with the intern builtin:
+ * interned strings are never freed, so interning every string a program
+ * builds would keep all of them alive.
+ *
+ * Franz programs run on one thread; a spin lock keeps the table consistent
+ * if the runtime is ever called from more than one.
+ */
+
+/**
+ * Interned Generic for a text, added to the table if new
+ *
+ * @param text NUL-terminated text (copied when it is new)
+ * @return Immortal string Generic, the same pointer for every equal text
+ */
+Generic *Intern_string(const char *text);
+
+/**
+ * Interned Generic for a string Generic
+ *
+ * @param string A TYPE_STRING Generic; an interned one is returned as it is
+ * @return Immortal string Generic with the same text
+ */
+Generic *Intern_generic(Generic *string);
+
+/**
+ * Interned Generic for a string's text, without adding it
+ *
+ * @param string A TYPE_STRING Generic
+ * @return The interned Generic with the same text, or NULL if the text is not interned
+ */
+Generic *Intern_find(Generic *string);
+
+/**
+ * Interned Generic whose strVal is exactly this pointer
+ *
+ * LLVM code passes strings around as raw char*; this lets franz_box_string hand
+ * back the interned Generic for an interned text without looking at its bytes.
+ *
+ * @param text Any char*
+ * @return The interned Generic holding text, or NULL
+ */
+Generic *Intern_fromText(const char *text);
+
+// Number of interned strings
+int Intern_count(void);
+
+#endif
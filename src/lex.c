@@ -21,18 +21,19 @@ void handleStringError(char c, int lineNumber) {
 }
 
 //  Lex code into array-based token list
-TokenArray* lex(char *code, int fileLength) {
+//  Tokens reference spans of code instead of copying them, so code must outlive the tokens
+TokenArray* lex(const char *code, long fileLength) {
   // Create new token array
   TokenArray *tokens = TokenArray_new();
 
   // Add START token
-  TokenArray_push(tokens, NULL, TOK_START, 1);
+  TokenArray_push(tokens, NULL, 0, TOK_START, 1);
 
   // line number
   int lineNumber = 1;
 
   // for each char (including terminator, helps us not need to push number tokens if they are last)
-  int i = 0;
+  long i = 0;
   while (i < fileLength) {
     char c = code[i];
 
@@ -43,34 +44,35 @@ TokenArray* lex(char *code, int fileLength) {
       while (code[i] != '\n' && i < fileLength) i++;
       lineNumber++;
     } else if (c == '(') {
-      TokenArray_push(tokens, NULL, TOK_APPLYOPEN, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_APPLYOPEN, lineNumber);
     } else if (c == ')') {
-      TokenArray_push(tokens, NULL, TOK_APPLYCLOSE, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_APPLYCLOSE, lineNumber);
     } else if (c == '[') {
       // : List literal syntax
-      TokenArray_push(tokens, NULL, TOK_LBRACKET, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_LBRACKET, lineNumber);
     } else if (c == ']') {
       // : List literal syntax
-      TokenArray_push(tokens, NULL, TOK_RBRACKET, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_RBRACKET, lineNumber);
     } else if (c == ',') {
       // : Comma separator for list elements
-      TokenArray_push(tokens, NULL, TOK_COMMA, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_COMMA, lineNumber);
     } else if (c == '=') {
-      TokenArray_push(tokens, NULL, TOK_ASSIGNMENT, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_ASSIGNMENT, lineNumber);
     } else if (c == '{') {
-      TokenArray_push(tokens, NULL, TOK_FUNCOPEN, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_FUNCOPEN, lineNumber);
     } else if (c == '}') {
-      TokenArray_push(tokens, NULL, TOK_FUNCCLOSE, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_FUNCCLOSE, lineNumber);
     } else if (c == '-' && code[i + 1] == '>') {
-      TokenArray_push(tokens, NULL, TOK_ARROW, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_ARROW, lineNumber);
       i++;
     } else if (c == '<' && code[i + 1] == '-') {
-      TokenArray_push(tokens, NULL, TOK_RETURN, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_RETURN, lineNumber);
       i++;
     } else if (c == '"') {
       
       // record first char in string
-      int stringStart = i + 1;
+      long stringStart = i + 1;
+      bool hasEscape = false;
 
       // go to first char after quotes
       i++;
@@ -83,6 +85,7 @@ TokenArray* lex(char *code, int fileLength) {
         
         // skip escape codes
         if (code[i] == '\\') {
+          hasEscape = true;
           i++;
           handleStringError(code[i], lineNumber);
         }
@@ -90,18 +93,23 @@ TokenArray* lex(char *code, int fileLength) {
         i++;
       }
 
-      // get substring and add token
-      char *val = malloc(i - stringStart + 1);
-      strncpy(val, &code[stringStart], i - stringStart);
-      val[i - stringStart] = '\0';
+      if (hasEscape) {
+        // decode escape codes into a string owned by the token
+        char *val = malloc(i - stringStart + 1);
+        memcpy(val, &code[stringStart], i - stringStart);
+        val[i - stringStart] = '\0';
 
-      TokenArray_push(tokens, parseString(val), TOK_STRING, lineNumber);
+        TokenArray_pushOwned(tokens, parseString(val), TOK_STRING, lineNumber);
 
-      free(val);
+        free(val);
+      } else {
+        // plain string: the token is the span between the quotes
+        TokenArray_push(tokens, &code[stringStart], i - stringStart, TOK_STRING, lineNumber);
+      }
 
     } else if (c == '0' && (code[i + 1] == 'x' || code[i + 1] == 'X')) {
       //  Hexadecimal integer or float literal (0x1A or 0x1.5p2)
-      int numStart = i;
+      long numStart = i;
       i += 2;  // Skip '0x'
 
       bool isHexFloat = false;
@@ -148,22 +156,17 @@ TokenArray* lex(char *code, int fileLength) {
         exit(0);
       }
 
-      // Extract the hex literal
-      char *val = malloc(i - numStart + 1);
-      strncpy(val, &code[numStart], i - numStart);
-      val[i - numStart] = '\0';
-
       if (isHexFloat) {
-        TokenArray_push(tokens, val, TOK_FLOAT, lineNumber);
+        TokenArray_push(tokens, &code[numStart], i - numStart, TOK_FLOAT, lineNumber);
       } else {
-        TokenArray_push(tokens, val, TOK_INT, lineNumber);
+        TokenArray_push(tokens, &code[numStart], i - numStart, TOK_INT, lineNumber);
       }
 
       i--;
 
     } else if (c == '0' && (code[i + 1] == 'b' || code[i + 1] == 'B')) {
       //  Binary integer literal (0b1010)
-      int numStart = i;
+      long numStart = i;
       i += 2;  // Skip '0b'
 
       bool hasDigits = false;
@@ -177,16 +180,12 @@ TokenArray* lex(char *code, int fileLength) {
         exit(0);
       }
 
-      char *val = malloc(i - numStart + 1);
-      strncpy(val, &code[numStart], i - numStart);
-      val[i - numStart] = '\0';
-
-      TokenArray_push(tokens, val, TOK_INT, lineNumber);
+      TokenArray_push(tokens, &code[numStart], i - numStart, TOK_INT, lineNumber);
       i--;
 
     } else if (c == '0' && (code[i + 1] == 'o' || code[i + 1] == 'O')) {
       //  Octal integer literal (0o17)
-      int numStart = i;
+      long numStart = i;
       i += 2;  // Skip '0o'
 
       bool hasDigits = false;
@@ -200,17 +199,13 @@ TokenArray* lex(char *code, int fileLength) {
         exit(0);
       }
 
-      char *val = malloc(i - numStart + 1);
-      strncpy(val, &code[numStart], i - numStart);
-      val[i - numStart] = '\0';
-
-      TokenArray_push(tokens, val, TOK_INT, lineNumber);
+      TokenArray_push(tokens, &code[numStart], i - numStart, TOK_INT, lineNumber);
       i--;
 
     } else if (isdigit((unsigned char) c) > 0 || (c == '-' && isdigit((unsigned char) code[i + 1]) > 0)) {
 
       // record first char in int
-      int numStart = i;
+      long numStart = i;
 
       // float flag
       bool isFloat = false;
@@ -267,20 +262,16 @@ TokenArray* lex(char *code, int fileLength) {
         }
       }
 
-      // get substring and add token
-      char *val = malloc(i - numStart + 1);
-      strncpy(val, &code[numStart], i - numStart);
-      val[i - numStart] = '\0';
-
-      if (isFloat) TokenArray_push(tokens, val, TOK_FLOAT, lineNumber);
-      else TokenArray_push(tokens, val, TOK_INT, lineNumber);
+      // add token spanning the number
+      if (isFloat) TokenArray_push(tokens, &code[numStart], i - numStart, TOK_FLOAT, lineNumber);
+      else TokenArray_push(tokens, &code[numStart], i - numStart, TOK_INT, lineNumber);
 
       // make sure to go back to last char of number
       i--;
 
     } else if (c == '.' && !isdigit((unsigned char) code[i + 1])) {
       // Dot that is NOT part of a float (member access operator)
-      TokenArray_push(tokens, NULL, TOK_DOT, lineNumber);
+      TokenArray_push(tokens, NULL, 0, TOK_DOT, lineNumber);
 
     } else if (
       strchr(" \n\r\t\f\v{}()[]\"=.,", c) == NULL  // : Added [] and ,
@@ -289,7 +280,7 @@ TokenArray* lex(char *code, int fileLength) {
       && !(c == '/' && code[i + 1] == '/')
     ) {
       // case of identifier
-      int identifierStart = i;
+      long identifierStart = i;
 
       // while valid identifier char (now stops at dots, brackets, commas)
       while (
@@ -299,23 +290,19 @@ TokenArray* lex(char *code, int fileLength) {
         && !(code[i] == '/' && code[i + 1] == '/')
       ) i++;
 
-      // get substring and add token
-      char *val = malloc(i - identifierStart + 1);
-      strncpy(val, &code[identifierStart], i - identifierStart);
-      val[i - identifierStart] = '\0';
+      // span of the identifier
+      const char *val = &code[identifierStart];
+      int length = i - identifierStart;
 
       // Check if this is the 'sig', 'as', or 'mut' keyword
-      if (strcmp(val, "sig") == 0) {
-        TokenArray_push(tokens, NULL, TOK_SIG, lineNumber);
-        free(val);  // Free since we don't need the string value
-      } else if (strcmp(val, "as") == 0) {
-        TokenArray_push(tokens, NULL, TOK_AS, lineNumber);
-        free(val);  // Free since we don't need the string value
-      } else if (strcmp(val, "mut") == 0) {
-        TokenArray_push(tokens, NULL, TOK_MUT, lineNumber);
-        free(val);  // Free since we don't need the string value
+      if (length == 3 && memcmp(val, "sig", 3) == 0) {
+        TokenArray_push(tokens, NULL, 0, TOK_SIG, lineNumber);
+      } else if (length == 2 && memcmp(val, "as", 2) == 0) {
+        TokenArray_push(tokens, NULL, 0, TOK_AS, lineNumber);
+      } else if (length == 3 && memcmp(val, "mut", 3) == 0) {
+        TokenArray_push(tokens, NULL, 0, TOK_MUT, lineNumber);
       } else {
-        TokenArray_push(tokens, val, TOK_IDENTIFIER, lineNumber);
+        TokenArray_push(tokens, val, length, TOK_IDENTIFIER, lineNumber);
       }
       
       // make sure to go back to last char of identifier
@@ -330,7 +317,7 @@ TokenArray* lex(char *code, int fileLength) {
   }
 
   // Add END token
-  TokenArray_push(tokens, NULL, TOK_END, lineNumber);
+  TokenArray_push(tokens, NULL, 0, TOK_END, lineNumber);
 
   return tokens;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "tokens.h"
 
 //  Array-based lexer prototype
-TokenArray* lex(char *code, int fileLength);
+//  Tokens point into code, which must stay alive until the tokens are freed
+TokenArray* lex(const char *code, long fileLength);
 
 #endif
\ No newline at end of file
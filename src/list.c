@@ -1,60 +1,201 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "list.h"
 #include "generic.h"
+#include "slab/slab.h"
 
 void List_print(List *p_target) {
   printf("[List: ");
 
   for (int i = 0; i < p_target->len; i += 1) {
-    Generic_print(p_target->vals[i]);
+    Generic_print(List_at(p_target, i));
     if (i != p_target->len - 1)  printf(", ");
   }
 
   printf("]");
 }
 
+// new trie node with every slot empty
+static ListNode *ListNode_new(void) {
+  ListNode *res = (ListNode *) Slab_alloc(sizeof(ListNode), SLAB_LIST_NODE);
+  res->refCount = 1;
+  memset(res->slots, 0, sizeof(res->slots));
+  return res;
+}
+
+// drop one reference to a node, the last one frees the subtree and releases the items in its leaves
+static void ListNode_release(ListNode *p_node, int shift) {
+  if (p_node == NULL) return;
+
+  p_node->refCount -= 1;
+  if (p_node->refCount > 0) return;
+
+  for (int i = 0; i < LIST_WIDTH; i += 1) {
+    if (p_node->slots[i] == NULL) continue;
+
+    if (shift > 0) {
+      ListNode_release((ListNode *) p_node->slots[i], shift - LIST_BITS);
+    } else {
+      Generic_release((Generic *) p_node->slots[i]);
+    }
+  }
+
+  Slab_free(p_node, sizeof(ListNode), SLAB_LIST_NODE);
+}
+
+// returns a node only the caller references: the node itself if it is not shared,
+// else a copy that takes over the caller's reference (children and leaf items are shared)
+static ListNode *ListNode_unshare(ListNode *p_node, int shift) {
+  if (p_node->refCount == 1) return p_node;
+
+  ListNode *res = ListNode_new();
+  for (int i = 0; i < LIST_WIDTH; i += 1) {
+    if (p_node->slots[i] == NULL) continue;
+
+    if (shift > 0) {
+      ((ListNode *) p_node->slots[i])->refCount += 1;
+    } else {
+      Generic_retain((Generic *) p_node->slots[i]);
+    }
+    res->slots[i] = p_node->slots[i];
+  }
+
+  p_node->refCount -= 1;
+  return res;
+}
+
+// allocate an empty list header
+static List *List_alloc(void) {
+  List *res = (List *) Slab_alloc(sizeof(List), SLAB_LIST);
+  res->len = 0;
+  res->offset = 0;
+  res->shift = 0;
+  res->root = NULL;
+  return res;
+}
+
+// new header on the same trie, O(1): nodes are copied later, and only those that change
+static List *List_share(List *p_target) {
+  List *res = (List *) Slab_alloc(sizeof(List), SLAB_LIST);
+  *res = *p_target;
+  if (res->root != NULL) res->root->refCount += 1;
+  return res;
+}
+
+// returns the slot at trie index, copying the nodes on its path that other lists share
+static Generic **List_slot(List *p_target, int index) {
+  // add levels on top until the index fits
+  while ((size_t) index >= ((size_t) 1 << (p_target->shift + LIST_BITS))) {
+    if (p_target->root != NULL) {
+      ListNode *root = ListNode_new();
+      root->slots[0] = p_target->root;
+      p_target->root = root;
+    }
+    p_target->shift += LIST_BITS;
+  }
+
+  if (p_target->root == NULL) {
+    p_target->root = ListNode_new();
+  } else {
+    p_target->root = ListNode_unshare(p_target->root, p_target->shift);
+  }
+
+  ListNode *p_node = p_target->root;
+  for (int shift = p_target->shift; shift > 0; shift -= LIST_BITS) {
+    int i = (index >> shift) & LIST_MASK;
+    ListNode *p_child = (ListNode *) p_node->slots[i];
+    p_child = p_child == NULL ? ListNode_new() : ListNode_unshare(p_child, shift - LIST_BITS);
+    p_node->slots[i] = p_child;
+    p_node = p_child;
+  }
+
+  return (Generic **) &p_node->slots[index & LIST_MASK];
+}
+
+// store p_val at trie index, releasing what was there
+// the list holds a reference to its items instead of a copy: values are immutable
+static void List_store(List *p_target, int index, Generic *p_val) {
+  Generic **p_slot = List_slot(p_target, index);
+  Generic_retain(p_val);
+  if (*p_slot != NULL) Generic_release(*p_slot);
+  *p_slot = p_val;
+}
+
+// append p_val
+static void List_push(List *p_target, Generic *p_val) {
+  List_store(p_target, p_target->offset + p_target->len, p_val);
+  p_target->len += 1;
+}
+
 // copy a given list
+// lists are immutable, so the copy shares the whole trie
 List *List_copy(List *p_target) {
-  return List_new(p_target->vals, p_target->len);
+  return List_share(p_target);
 }
 
 // make a new list struct, given a list of generics
+// the list takes a reference to each item, so a temporary (refCount 0) is not freed by the caller
 List *List_new(Generic **items, int length) {
-  List *res = (List *) malloc(sizeof(List));
-  res->vals = (Generic **) malloc(sizeof(Generic *) * length);
-  res->len = length;
-  
-  for (int i = 0; i < res->len; i += 1) {
-    res->vals[i] = Generic_copy(items[i]);
+  List *res = List_alloc();
+
+  for (int i = 0; i < length; i += 1) {
+    List_push(res, items[i]);
   }
 
   return res;
 }
 
+// get item from list without copying it, the list still owns it
+Generic *List_at(List *p_target, int index) {
+  int i = p_target->offset + index;
+
+  ListNode *p_node = p_target->root;
+  for (int shift = p_target->shift; shift > 0; shift -= LIST_BITS) {
+    p_node = (ListNode *) p_node->slots[(i >> shift) & LIST_MASK];
+  }
+
+  return (Generic *) p_node->slots[i & LIST_MASK];
+}
+
 // get item from list
 Generic *List_get(List *p_target, int index) {
-  // return copy of generic
-  return Generic_copy(p_target->vals[index]);
+  // return copy of generic, the caller owns it (cheap: a list or dict payload is shared)
+  return Generic_copy(List_at(p_target, index));
 }
 
 // insert item at index
 List *List_insert(List *p_target, Generic *p_val, int index) {
-  List *res = (List *) malloc(sizeof(List));
-  res->vals = (Generic **) malloc(sizeof(Generic *) * (p_target->len + 1));
-  res->len = p_target->len + 1;
-  
-  // resIndex is the index in the resulting list
-  // targetIndex is the index in the provided list
-  int targetIndex = 0;
-  for (int resIndex = 0; resIndex < res->len; resIndex += 1) {
-    if (resIndex == index) {
-      res->vals[index] = Generic_copy(p_val);
-      continue;
+  if (index == 0 && p_target->offset > 0) {
+    // room in front (after a previous prepend, or a view): O(log n)
+    List *res = List_share(p_target);
+    List_store(res, res->offset - 1, p_val);
+    res->offset -= 1;
+    res->len += 1;
+    return res;
+  }
+
+  if (index == 0 && p_target->len > 0) {
+    // no room in front: rebuild with as many free slots in front as there are items,
+    // so the next prepends take the branch above
+    List *res = List_alloc();
+    res->offset = p_target->len > LIST_WIDTH ? p_target->len : LIST_WIDTH;
+    for (int i = 0; i < p_target->len; i += 1) {
+      List_push(res, List_at(p_target, i));
     }
 
-    res->vals[resIndex] = Generic_copy(p_target->vals[targetIndex]);
-    targetIndex += 1;
+    List_store(res, res->offset - 1, p_val);
+    res->offset -= 1;
+    res->len += 1;
+    return res;
+  }
+
+  // the items before index stay shared, the rest are pushed after p_val
+  // (appending pushes nothing else: O(log n))
+  List *res = List_sublist(p_target, 0, index);
+  List_push(res, p_val);
+  for (int i = index; i < p_target->len; i += 1) {
+    List_push(res, List_at(p_target, i));
   }
 
   return res;
@@ -62,48 +203,26 @@ List *List_insert(List *p_target, Generic *p_val, int index) {
 
 // delete item from list
 List *List_delete(List *p_target, int index) {
-  List *res = (List *) malloc(sizeof(List));
-  res->vals = (Generic **) malloc(sizeof(Generic *) * (p_target->len - 1));
-  res->len = p_target->len - 1;
-
-  // resIndex is the index in the resulting list
-  // targetIndex is the index in the provided list
-  int resIndex = 0;
-  for (int targetIndex = 0; targetIndex < p_target->len; targetIndex += 1) {
-    if (targetIndex == index) continue;
-    res->vals[resIndex] = Generic_copy(p_target->vals[targetIndex]);
-    resIndex += 1;
-  }
-
-  return res;
+  return List_deleteMultiple(p_target, index, index + 1);
 }
 
 // free list
+// the trie is freed with the last list sharing it, and each item with its last holder
 void List_free(List *p_target) {
-  for (int i = 0; i < p_target->len; i += 1) {
-    Generic_free(p_target->vals[i]);
-  }
-
-  free(p_target->vals);
-  free(p_target);
+  ListNode_release(p_target->root, p_target->shift);
+  Slab_free(p_target, sizeof(List), SLAB_LIST);
 }
 
 // joins all lists into a single one, and returns
 List *List_join(List *lists[], int count) {
-  List *res = (List *) malloc(sizeof(List));
-  res->len = 0;
+  if (count == 0) return List_alloc();
 
-  for (int i = 0; i < count; i += 1) {
-    res->len += lists[i]->len;
-  }
+  // the first list is shared, the others are appended to it
+  List *res = List_share(lists[0]);
 
-  res->vals = (Generic **) malloc(sizeof(Generic *) * res->len);
-  
-  int i = 0;
-  for (int listIndex = 0; listIndex < count; listIndex += 1) {
+  for (int listIndex = 1; listIndex < count; listIndex += 1) {
     for (int itemIndex = 0; itemIndex < lists[listIndex]->len; itemIndex += 1) {
-      res->vals[i] = Generic_copy(lists[listIndex]->vals[itemIndex]);
-      i += 1;
+      List_push(res, List_at(lists[listIndex], itemIndex));
     }
   }
 
@@ -111,32 +230,18 @@ List *List_join(List *lists[], int count) {
 }
 
 // returns the sublist from index1 to index2
+// the sublist is a view on the same trie, O(1)
 List *List_sublist(List *p_target, int index1, int index2) {
-  List *res = (List *) malloc(sizeof(List));
-  res->vals = (Generic **) malloc(sizeof(Generic *) * (index2 - index1));
+  List *res = List_share(p_target);
+  res->offset += index1;
   res->len = index2 - index1;
-  
-  for (int i = index1; i < index2; i += 1) {
-    res->vals[i - index1] = Generic_copy(p_target->vals[i]);
-  }
-
   return res;
 }
 
 // set item in list
 List *List_set(List *p_target, Generic *p_val, int index) {
-  List *res = (List *) malloc(sizeof(List));
-  res->vals = (Generic **) malloc(sizeof(Generic *) * p_target->len);
-  res->len = p_target->len;
-  
-  for (int i = 0; i < res->len; i += 1) {
-    if (i != index) {
-      res->vals[i] = Generic_copy(p_target->vals[i]);
-    } else {
-      res->vals[i] = Generic_copy(p_val);
-    }
-  }
-
+  List *res = List_share(p_target);
+  List_store(res, res->offset + index, p_val);
   return res;
 }
 
@@ -147,16 +252,18 @@ int List_length(List *p_target) {
 
 // delete multiple items from list from index1 to index2
 List *List_deleteMultiple(List *p_target, int index1, int index2) {
-  List *res = (List *) malloc(sizeof(List));
-  res->len = p_target->len - index2 + index1;
-  res->vals = (Generic **) malloc(sizeof(Generic *) * (res->len));
-
-  for (int i = 0; i < index1; i += 1) {
-    res->vals[i] = Generic_copy(p_target->vals[i]);
+  // from the front or to the end: a view
+  if (index1 == 0 || index2 == p_target->len) {
+    List *res = List_share(p_target);
+    res->offset += index1 == 0 ? index2 : 0;
+    res->len -= index2 - index1;
+    return res;
   }
 
+  // the items before index1 stay shared, the ones after index2 are pushed
+  List *res = List_sublist(p_target, 0, index1);
   for (int i = index2; i < p_target->len; i += 1) {
-    res->vals[i - index2 + index1] = Generic_copy(p_target->vals[i]);
+    List_push(res, List_at(p_target, i));
   }
 
   return res;
@@ -168,7 +275,7 @@ int List_compare(List *p_target1, List *p_target2) {
   if (p_target1->len != p_target2->len) return 0;
 
   for(int i = 0; i < p_target1->len; i += 1) {
-    if (!Generic_is(p_target1->vals[i], p_target2->vals[i])) return 0;
+    if (!Generic_is(List_at(p_target1, i), List_at(p_target2, i))) return 0;
   }
 
   return 1;
@@ -2,16 +2,39 @@
 #define LIST_H
 #include "generic.h"
 
+// lists are persistent vectors: a 32-way trie of nodes shared between versions
+// (Clojure/Scala style). Every List_* operation returns a new list and leaves its
+// input untouched, but the new list shares every trie node it did not change, so
+// append, prepend, set and get are O(log32 n) instead of copying the whole list.
+#define LIST_BITS 5
+#define LIST_WIDTH (1 << LIST_BITS)
+#define LIST_MASK (LIST_WIDTH - 1)
+
+// trie node: branches hold child ListNode*, leaves hold the Generic* items
+// (a leaf holds one reference to each item, it does not copy them)
+// refCount: number of parents (List headers or branch nodes) pointing at it
+typedef struct ListNode {
+  int refCount;
+  void *slots[LIST_WIDTH];
+} ListNode;
+
 // list container
+// len: number of items
+// offset: trie index of item 0, > 0 for views made by sublist/delete and after cons
+// shift: LIST_BITS * levels above the leaves (0 when root is a leaf)
+// root: NULL for a list that never held items
 typedef struct List {
-  Generic **vals;
   int len;
+  int offset;
+  int shift;
+  ListNode *root;
 } List;
 
 // prototypes
 void List_print(List *);
 List *List_new(Generic **, int);
 List *List_copy(List *);
+Generic *List_at(List *, int);  // borrowed item, no copy
 Generic *List_get(List *, int);
 List *List_insert(List *, Generic *, int);
 List *List_delete(List *, int);
@@ -1,5 +1,6 @@
 #include "llvm_adt.h"
 #include "../stdlib.h"
+#include "../llvm-constants/llvm_constants.h"
 #include "../llvm-lists/llvm_lists.h"
 #include "../llvm-list-ops/llvm_list_ops.h"
 #include "../llvm-closures/llvm_closures.h"
@@ -76,11 +77,11 @@ static void declareRuntimeFunctions(LLVMCodeGen *gen) {
     LLVMAddFunction(gen->module, "franz_unbox_string", funcType);
   }
 
-  // strcmp(i8*, i8*) -> int
-  if (!LLVMGetNamedFunction(gen->module, "strcmp")) {
-    LLVMTypeRef params[] = { gen->stringType, gen->stringType };
-    LLVMTypeRef funcType = LLVMFunctionType(LLVMInt32TypeInContext(gen->context), params, 2, 0);
-    LLVMAddFunction(gen->module, "strcmp", funcType);
+  // franz_intern_find(Generic*) -> Generic*
+  if (!LLVMGetNamedFunction(gen->module, "franz_intern_find")) {
+    LLVMTypeRef params[] = { genericPtrType };
+    LLVMTypeRef funcType = LLVMFunctionType(genericPtrType, params, 1, 0);
+    LLVMAddFunction(gen->module, "franz_intern_find", funcType);
   }
 }
 
@@ -116,31 +117,37 @@ LLVMValueRef LLVMAdt_compileVariant(LLVMCodeGen *gen, AstNode *node, int lineNum
     fprintf(stderr, "[ADT DEBUG] Compiling tag (arg 0)\n");
   }
 
-  LLVMValueRef tagValue = LLVMCodeGen_compileNode(gen, args[0]);
-  if (!tagValue) {
-    fprintf(stderr, "ERROR: Failed to compile variant tag at line %d\n", lineNumber);
-    return NULL;
-  }
+  // Literal tags are interned, so match compares them by pointer
+  LLVMValueRef tagBoxed;
+  if (args[0]->opcode == OP_STRING && args[0]->val) {
+    tagBoxed = LLVMConstants_internedString(gen, args[0]->val);
+  } else {
+    LLVMValueRef tagValue = LLVMCodeGen_compileNode(gen, args[0]);
+    if (!tagValue) {
+      fprintf(stderr, "ERROR: Failed to compile variant tag at line %d\n", lineNumber);
+      return NULL;
+    }
 
-  if (gen->debugMode) {
-    fprintf(stderr, "[ADT DEBUG] Tag compiled successfully, boxing...\n");
-  }
+    if (gen->debugMode) {
+      fprintf(stderr, "[ADT DEBUG] Tag compiled successfully, boxing...\n");
+    }
 
-  // Box tag as Generic*
-  LLVMValueRef boxStringFunc = LLVMGetNamedFunction(gen->module, "franz_box_string");
-  if (!boxStringFunc) {
-    fprintf(stderr, "ERROR: franz_box_string function not found!\n");
-    return NULL;
-  }
+    // Box tag as Generic*
+    LLVMValueRef boxStringFunc = LLVMGetNamedFunction(gen->module, "franz_box_string");
+    if (!boxStringFunc) {
+      fprintf(stderr, "ERROR: franz_box_string function not found!\n");
+      return NULL;
+    }
 
-  LLVMValueRef tagBoxed = LLVMBuildCall2(
-    gen->builder,
-    LLVMGlobalGetValueType(boxStringFunc),
-    boxStringFunc,
-    &tagValue,
-    1,
-    "variant_tag"
-  );
+    tagBoxed = LLVMBuildCall2(
+      gen->builder,
+      LLVMGlobalGetValueType(boxStringFunc),
+      boxStringFunc,
+      &tagValue,
+      1,
+      "variant_tag"
+    );
+  }
 
   // Compile values (remaining arguments) into a list
   LLVMValueRef valuesListBoxed;
@@ -331,10 +338,28 @@ LLVMValueRef LLVMAdt_compileMatch(LLVMCodeGen *gen, AstNode *node, int lineNumbe
     return NULL;
   }
 
+  // Check if there's a default handler (odd argument count)
+  int hasDefault = (argCount - 1) % 2 == 1;
+  int pairCount = (argCount - 1) / 2;
+
+  // Check and intern the tag patterns (must be string literals) before looking
+  // up the tag, so a tag equal to a pattern is always found in the intern table
+  LLVMValueRef *patterns = malloc(sizeof(LLVMValueRef) * pairCount);
+  for (int i = 0; i < pairCount; i++) {
+    AstNode *tagPatternNode = args[1 + i * 2];
+    if (tagPatternNode->opcode != OP_STRING || !tagPatternNode->val) {
+      fprintf(stderr, "ERROR: match tag patterns must be string literals at line %d\n", lineNumber);
+      free(patterns);
+      return NULL;
+    }
+    patterns[i] = LLVMConstants_internedString(gen, tagPatternNode->val);
+  }
+
   // Extract tag from variant
   LLVMValueRef tagValue = LLVMAdt_extractTag(gen, variantValue);
   if (!tagValue) {
     fprintf(stderr, "ERROR: Failed to extract tag from variant at line %d\n", lineNumber);
+    free(patterns);
     return NULL;
   }
 
@@ -342,6 +367,7 @@ LLVMValueRef LLVMAdt_compileMatch(LLVMCodeGen *gen, AstNode *node, int lineNumbe
   LLVMValueRef valuesValue = LLVMAdt_extractValues(gen, variantValue);
   if (!valuesValue) {
     fprintf(stderr, "ERROR: Failed to extract values from variant at line %d\n", lineNumber);
+    free(patterns);
     return NULL;
   }
 
@@ -349,10 +375,6 @@ LLVMValueRef LLVMAdt_compileMatch(LLVMCodeGen *gen, AstNode *node, int lineNumbe
   LLVMValueRef currentFunc = LLVMGetBasicBlockParent(LLVMGetInsertBlock(gen->builder));
   LLVMBasicBlockRef mergeBlock = LLVMAppendBasicBlockInContext(gen->context, currentFunc, "match_merge");
 
-  // Check if there's a default handler (odd argument count)
-  int hasDefault = (argCount - 1) % 2 == 1;
-  int pairCount = (argCount - 1) / 2;
-
   LLVMBasicBlockRef *caseBlocks = malloc(sizeof(LLVMBasicBlockRef) * pairCount);
 
   // Always create a default block for proper control flow
@@ -373,34 +395,12 @@ LLVMValueRef LLVMAdt_compileMatch(LLVMCodeGen *gen, AstNode *node, int lineNumbe
       LLVMPositionBuilderAtEnd(gen->builder, nextCheckBlock);
     }
 
-    // Compile tag pattern (must be string literal)
-    AstNode *tagPatternNode = args[1 + i * 2];
-    if (tagPatternNode->opcode != OP_STRING) {
-      fprintf(stderr, "ERROR: match tag patterns must be string literals at line %d\n", lineNumber);
-      free(caseBlocks);
-      return NULL;
-    }
-
-    LLVMValueRef patternString = LLVMBuildGlobalStringPtr(gen->builder, tagPatternNode->val, "tag_pattern");
-
-    // Compare tag with pattern using strcmp
-    LLVMValueRef strcmpFunc = LLVMGetNamedFunction(gen->module, "strcmp");
-    LLVMValueRef cmpArgs[] = { tagValue, patternString };
-    LLVMValueRef cmpResult = LLVMBuildCall2(
-      gen->builder,
-      LLVMGlobalGetValueType(strcmpFunc),
-      strcmpFunc,
-      cmpArgs,
-      2,
-      "tag_cmp"
-    );
-
-    // Check if equal (strcmp returns 0)
+    // Tag and pattern are both interned: equal text means the same Generic
     LLVMValueRef isEqual = LLVMBuildICmp(
       gen->builder,
       LLVMIntEQ,
-      cmpResult,
-      LLVMConstInt(LLVMInt32TypeInContext(gen->context), 0, 0),
+      tagValue,
+      patterns[i],
       "tag_eq"
     );
 
@@ -416,6 +416,7 @@ LLVMValueRef LLVMAdt_compileMatch(LLVMCodeGen *gen, AstNode *node, int lineNumbe
     // Branch to case or next check
     LLVMBuildCondBr(gen->builder, isEqual, caseBlocks[i], nextCheckBlock);
   }
+  free(patterns);
 
   // Compile case handlers
   LLVMValueRef *caseResults = malloc(sizeof(LLVMValueRef) * pairCount);
@@ -660,18 +661,18 @@ LLVMValueRef LLVMAdt_extractTag(LLVMCodeGen *gen, LLVMValueRef variantValue) {
     "tag_generic"
   );
 
-  // Extract string from Generic*
-  LLVMValueRef stringUnboxFunc = LLVMGetNamedFunction(gen->module, "franz_unbox_string");
-  LLVMValueRef tagString = LLVMBuildCall2(
+  // Interned copy of the tag (null if its text was never interned)
+  LLVMValueRef internFindFunc = LLVMGetNamedFunction(gen->module, "franz_intern_find");
+  LLVMValueRef tagInterned = LLVMBuildCall2(
     gen->builder,
-    LLVMGlobalGetValueType(stringUnboxFunc),
-    stringUnboxFunc,
+    LLVMGlobalGetValueType(internFindFunc),
+    internFindFunc,
     &tagGeneric,
     1,
-    "tag_string"
+    "tag_interned"
   );
 
-  return tagString;
+  return tagInterned;
 }
 
 LLVMValueRef LLVMAdt_extractValues(LLVMCodeGen *gen, LLVMValueRef variantValue) {
@@ -62,9 +62,12 @@ LLVMValueRef LLVMAdt_compileMatch(LLVMCodeGen *gen, AstNode *node, int lineNumbe
 /**
  * @brief Extract variant tag (string) from variant structure
  *
+ * The tag is looked up in the intern table (franz_intern_find), so match can
+ * compare it with its interned patterns by pointer.
+ *
  * @param gen LLVM code generator context
  * @param variantValue LLVM value representing the variant (Generic*)
- * @return LLVM value representing the tag string (Generic*)
+ * @return LLVM value representing the interned tag (Generic*), null if the tag text was never interned
  */
 LLVMValueRef LLVMAdt_extractTag(LLVMCodeGen *gen, LLVMValueRef variantValue);
 
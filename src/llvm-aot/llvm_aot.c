@@ -0,0 +1,258 @@
+#include "llvm_aot.h"
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+#include <dirent.h>
+#include <errno.h>
+#include <limits.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../time-report/time_report.h"
+
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+
+extern char **environ;
+
+/**
+ * LLVM Ahead-of-Time Native Executables (--aot)
+ *
+ * Pipeline: module → .o (in-process, LLVMTargetMachineEmitToFile)
+ *           → linker driver (+ libfranz_runtime.a) → executable
+ *
+ * `franz --aot` links into the work directory and runs the result;
+ * `franz build` links a stripped executable to a path of the user's choice.
+ *
+ * The linker is started once with posix_spawnp() and a prebuilt argument
+ * vector - no shell, no llc process, no textual IR round trip.
+ *
+ * All intermediate files live in a private mkdtemp() directory per franz
+ * process, so any number of concurrent compiles never share a path.
+ */
+
+// Per-invocation work directory ("" until the first build)
+static char workDir[PATH_MAX] = "";
+static int workDirCleanupRegistered = 0;
+
+void LLVMAot_removeWorkDir(void) {
+  if (workDir[0] == '\0') return;
+
+  // Flat directory: only files this process created
+  DIR *dir = opendir(workDir);
+  if (dir) {
+    struct dirent *entry;
+    char path[PATH_MAX];
+    while ((entry = readdir(dir)) != NULL) {
+      if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+      int length = snprintf(path, sizeof(path), "%s/%s", workDir, entry->d_name);
+      if (length < 0 || (size_t)length >= sizeof(path)) continue;
+      unlink(path);
+    }
+    closedir(dir);
+  }
+  rmdir(workDir);
+  workDir[0] = '\0';
+}
+
+// Create the work directory under $TMPDIR (default /tmp)
+static const char *LLVMAot_workDir(void) {
+  if (workDir[0] != '\0') return workDir;
+
+  const char *tmp = getenv("TMPDIR");
+  if (!tmp || tmp[0] == '\0') tmp = "/tmp";
+
+  char template[PATH_MAX];
+  snprintf(template, sizeof(template), "%s/franz-XXXXXX", tmp);
+  if (!mkdtemp(template)) {
+    perror("ERROR: Failed to create build directory");
+    return NULL;
+  }
+  snprintf(workDir, sizeof(workDir), "%s", template);
+
+  // Also clean up when the program or a signal handler calls exit()
+  if (!workDirCleanupRegistered) {
+    atexit(LLVMAot_removeWorkDir);
+    workDirCleanupRegistered = 1;
+  }
+  return workDir;
+}
+
+int LLVMAot_executablePath(char *path, size_t size) {
+#ifdef __APPLE__
+  char raw[PATH_MAX];
+  uint32_t rawSize = sizeof(raw);
+  if (_NSGetExecutablePath(raw, &rawSize) != 0) return -1;
+  char resolved[PATH_MAX];
+  if (!realpath(raw, resolved)) return -1;
+  snprintf(path, size, "%s", resolved);
+  return 0;
+#else
+  ssize_t length = readlink("/proc/self/exe", path, size - 1);
+  if (length <= 0) return -1;
+  path[length] = '\0';
+  return 0;
+#endif
+}
+
+int LLVMAot_findRuntimeLibrary(char *path, size_t size) {
+  const char *override = getenv("FRANZ_RUNTIME_LIB");
+  if (override && override[0] != '\0') {
+    snprintf(path, size, "%s", override);
+    return access(path, R_OK) == 0 ? 0 : -1;
+  }
+
+  char exePath[PATH_MAX];
+  if (LLVMAot_executablePath(exePath, sizeof(exePath)) != 0) {
+    snprintf(path, size, "%s", FRANZ_RUNTIME_LIB_NAME);
+    return -1;
+  }
+
+  // Strip the executable name, keep its directory
+  char *slash = strrchr(exePath, '/');
+  if (slash) {
+    *slash = '\0';
+  } else {
+    snprintf(exePath, sizeof(exePath), ".");
+  }
+
+  snprintf(path, size, "%s/%s", exePath, FRANZ_RUNTIME_LIB_NAME);
+  return access(path, R_OK) == 0 ? 0 : -1;
+}
+
+// Run a program directly (no shell) and wait for it
+// Returns its exit status, 128+N if it was killed by signal N, or -1 if it could not start
+static int LLVMAot_spawn(char *const argv[]) {
+  pid_t pid;
+  int spawnResult = posix_spawnp(&pid, argv[0], NULL, NULL, argv, environ);
+  if (spawnResult != 0) {
+    fprintf(stderr, "ERROR: Failed to start %s: %s\n", argv[0], strerror(spawnResult));
+    return -1;
+  }
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) return -1;
+  }
+  if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+  return WEXITSTATUS(status);
+}
+
+int LLVMAot_emitFile(LLVMModuleRef module, LLVMTargetMachineRef tm, LLVMCodeGenFileType kind, const char *path) {
+  // Machine code straight from the in-memory module, same target machine the optimizer used
+  TimeReport_begin("emit");
+  char *error = NULL;
+  int emitFailed = LLVMTargetMachineEmitToFile(tm, module, (char *)path, kind, &error);
+  TimeReport_end("emit");
+  if (emitFailed) {
+    fprintf(stderr, "ERROR: Failed to generate %s: %s\n",
+            kind == LLVMAssemblyFile ? "assembly" : "object file", error ? error : "unknown error");
+    if (error) LLVMDisposeMessage(error);
+    return -1;
+  }
+  return 0;
+}
+
+// Emit the object into the work directory and link it with the runtime into exePath
+// strip: drop unreferenced runtime sections and symbol tables (franz build)
+static int LLVMAot_link(LLVMModuleRef module, LLVMTargetMachineRef tm, const char *exePath, int strip, int debug) {
+  // Locate the runtime first - no point in generating code if we cannot link
+  char runtimeLib[PATH_MAX];
+  if (LLVMAot_findRuntimeLibrary(runtimeLib, sizeof(runtimeLib)) != 0) {
+    fprintf(stderr, "ERROR: Franz runtime library not found at %s\n", runtimeLib);
+    fprintf(stderr, "Hint: run 'make' to build it, or set FRANZ_RUNTIME_LIB\n");
+    return -1;
+  }
+
+  const char *dir = LLVMAot_workDir();
+  if (!dir) return -1;
+
+  char objFilename[PATH_MAX];
+  snprintf(objFilename, sizeof(objFilename), "%s/franz_output.o", dir);
+
+  if (debug) {
+    printf("[DEBUG] Emitting object file %s\n", objFilename);
+    fflush(stdout);
+  }
+
+  if (LLVMAot_emitFile(module, tm, LLVMObjectFile, objFilename) != 0) return -1;
+
+  // Link object file + prebuilt runtime library with one linker driver process
+  const char *linker = getenv("FRANZ_LINKER");
+  if (!linker || linker[0] == '\0') linker = FRANZ_DEFAULT_LINKER;
+
+  char *linkArgs[10];
+  int argCount = 0;
+  linkArgs[argCount++] = (char *)linker;
+  linkArgs[argCount++] = objFilename;
+  linkArgs[argCount++] = runtimeLib;
+  linkArgs[argCount++] = "-lm";
+  if (strip) {
+    // The runtime is compiled with -ffunction-sections: keep only what the program reaches
+#ifdef __APPLE__
+    linkArgs[argCount++] = "-Wl,-dead_strip";
+    linkArgs[argCount++] = "-Wl,-x";
+#else
+    linkArgs[argCount++] = "-Wl,--gc-sections";
+    linkArgs[argCount++] = "-s";
+#endif
+  }
+  linkArgs[argCount++] = "-o";
+  linkArgs[argCount++] = (char *)exePath;
+  linkArgs[argCount] = NULL;
+
+  if (debug) {
+    printf("[DEBUG] Linking:");
+    for (int i = 0; i < argCount; i++) printf(" %s", linkArgs[i]);
+    printf("\n");
+    fflush(stdout);
+  }
+
+  TimeReport_begin("link");
+  int linkResult = LLVMAot_spawn(linkArgs);
+  TimeReport_end("link");
+
+  if (linkResult != 0) {
+    fprintf(stderr, "ERROR: Failed to link executable\n");
+    return -1;
+  }
+  return 0;
+}
+
+const char *LLVMAot_buildExecutable(LLVMModuleRef module, LLVMTargetMachineRef tm, int debug) {
+  const char *dir = LLVMAot_workDir();
+  if (!dir) return NULL;
+
+  static char exeFilename[PATH_MAX];
+  snprintf(exeFilename, sizeof(exeFilename), "%s/franz_output", dir);
+
+  if (LLVMAot_link(module, tm, exeFilename, 0, debug) != 0) return NULL;
+  return exeFilename;
+}
+
+int LLVMAot_writeExecutable(LLVMModuleRef module, LLVMTargetMachineRef tm, const char *outputPath, int debug) {
+  int result = LLVMAot_link(module, tm, outputPath, 1, debug);
+
+  // Only the output survives; the object file was scratch
+  LLVMAot_removeWorkDir();
+  return result;
+}
+
+int LLVMAot_runExecutable(const char *path, int debug) {
+  if (debug) {
+    printf("[DEBUG] Executing native binary: %s\n", path);
+  }
+
+  // The child shares our terminal, so flush compiler output first
+  fflush(stdout);
+  fflush(stderr);
+
+  char *runArgs[] = {(char *)path, NULL};
+  TimeReport_begin("run");
+  int exitCode = LLVMAot_spawn(runArgs);
+  TimeReport_end("run");
+  return exitCode < 0 ? 1 : exitCode;
+}
@@ -0,0 +1,109 @@
+#ifndef LLVM_AOT_H
+#define LLVM_AOT_H
+
+#include <stddef.h>
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+
+/**
+ * LLVM Ahead-of-Time Native Executables (--aot)
+ *
+ * Emits the optimized module as an object file in-process and links it
+ * against the prebuilt runtime library into a native executable, which is
+ * then run as a child process. The linker driver ($FRANZ_LINKER, default
+ * clang) is the only helper process, started directly with posix_spawnp().
+ *
+ * Build files go to a private directory created with mkdtemp() under
+ * $TMPDIR (default /tmp) the first time a franz process builds, and removed
+ * by LLVMAot_removeWorkDir() or at exit - concurrent franz processes never
+ * touch each other's files.
+ *
+ * The runtime (stdlib.c, dict.c, list.c, ... - everything generated code
+ * calls into) is archived once by `make` as libfranz_runtime.a next to the
+ * franz executable, so running a script never compiles C code.
+ */
+
+// Runtime archive name, installed next to the franz executable
+#define FRANZ_RUNTIME_LIB_NAME "libfranz_runtime.a"
+
+// Linker driver used when $FRANZ_LINKER is not set
+#define FRANZ_DEFAULT_LINKER "clang"
+
+/**
+ * Absolute path of the running franz executable
+ *
+ * @param path Output buffer
+ * @param size Size of the output buffer
+ * @return 0 on success, -1 if it cannot be determined
+ */
+int LLVMAot_executablePath(char *path, size_t size);
+
+/**
+ * Locate the prebuilt runtime library
+ *
+ * Search order:
+ * 1. $FRANZ_RUNTIME_LIB (explicit override)
+ * 2. libfranz_runtime.a in the directory of the running franz executable
+ *
+ * The current working directory is deliberately not consulted, so scripts
+ * can be run from anywhere.
+ *
+ * @param path Output buffer for the absolute library path
+ * @param size Size of the output buffer
+ * @return 0 if found, -1 otherwise (path holds the location that was tried)
+ */
+int LLVMAot_findRuntimeLibrary(char *path, size_t size);
+
+/**
+ * Compile the module to a native executable
+ *
+ * @param module Optimized module with main()
+ * @param tm Target machine the module was optimized for (not disposed)
+ * @param debug Print each pipeline step
+ * @return Path of the executable inside the work directory (valid until
+ *         LLVMAot_removeWorkDir()), or NULL if building it failed
+ */
+const char *LLVMAot_buildExecutable(LLVMModuleRef module, LLVMTargetMachineRef tm, int debug);
+
+/**
+ * Link the module into a standalone executable (franz build)
+ *
+ * Same pipeline as LLVMAot_buildExecutable(), but the output goes to
+ * outputPath and is linked with --gc-sections and stripped, so runtime
+ * code the program never calls (parser, module loader, ...) is left out.
+ *
+ * @param module Optimized module with main()
+ * @param tm Target machine the module was optimized for (not disposed)
+ * @param outputPath Where to write the executable
+ * @param debug Print each pipeline step
+ * @return 0 on success, -1 on failure
+ */
+int LLVMAot_writeExecutable(LLVMModuleRef module, LLVMTargetMachineRef tm, const char *outputPath, int debug);
+
+/**
+ * Write the module as an object file or assembly listing
+ *
+ * @param module Optimized module
+ * @param tm Target machine the module was optimized for (not disposed)
+ * @param kind LLVMObjectFile or LLVMAssemblyFile
+ * @param path Output path
+ * @return 0 on success, -1 on failure
+ */
+int LLVMAot_emitFile(LLVMModuleRef module, LLVMTargetMachineRef tm, LLVMCodeGenFileType kind, const char *path);
+
+/**
+ * Run a native executable (freshly built or from the build cache)
+ *
+ * @param path Executable to run
+ * @param debug Print the path being run
+ * @return Exit status of the executable, 128+N if killed by signal N
+ */
+int LLVMAot_runExecutable(const char *path, int debug);
+
+/**
+ * Delete this process's build directory and everything in it
+ * Safe to call repeatedly; also registered with atexit().
+ */
+void LLVMAot_removeWorkDir(void);
+
+#endif // LLVM_AOT_H
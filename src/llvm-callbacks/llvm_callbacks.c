@@ -0,0 +1,267 @@
+#include "llvm_callbacks.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Direct Callbacks for map / filter / reduce
+ *
+ * Shared by llvm-map, llvm-filter and llvm-reduce: decides whether a callback
+ * can be called directly, and emits the pieces of the inlined loop (list length,
+ * element access, unboxing, boxing, the counted loop itself).
+ */
+
+static LLVMValueRef ensureFunction(LLVMCodeGen *gen, const char *name, LLVMTypeRef returnType,
+                                   LLVMTypeRef *params, int paramCount) {
+  LLVMValueRef func = LLVMGetNamedFunction(gen->module, name);
+  if (!func) {
+    LLVMTypeRef funcType = LLVMFunctionType(returnType, params, paramCount, 0);
+    func = LLVMAddFunction(gen->module, name, funcType);
+  }
+  return func;
+}
+
+static int isNumericType(LLVMCodeGen *gen, LLVMTypeRef type) {
+  return type == gen->intType || type == gen->floatType;
+}
+
+static const char *numericBuiltins[] = {
+  "add", "subtract", "multiply", "divide", "remainder", "power", "abs", "min", "max",
+  "sqrt", "floor", "ceil", "round", "less_than", "greater_than", NULL
+};
+
+// Whether name is passed straight to an arithmetic builtin somewhere in node
+static int usedAsNumber(AstNode *node, const char *name) {
+  if (!node || !name) return 0;
+  if (node->opcode == OP_APPLICATION && node->childCount > 1 &&
+      node->children[0]->opcode == OP_IDENTIFIER && node->children[0]->val) {
+    for (int b = 0; numericBuiltins[b]; b++) {
+      if (strcmp(node->children[0]->val, numericBuiltins[b]) != 0) continue;
+      for (int i = 1; i < node->childCount; i++) {
+        AstNode *arg = node->children[i];
+        if (arg->opcode == OP_IDENTIFIER && arg->val && strcmp(arg->val, name) == 0) return 1;
+      }
+    }
+  }
+  for (int i = 0; i < node->childCount; i++) {
+    if (usedAsNumber(node->children[i], name)) return 1;
+  }
+  return 0;
+}
+
+// FRANZ_DIRECT_CALLBACKS=0 sends every callback through the runtime (to compare the two paths)
+static int directCallbacksEnabled(void) {
+  static int enabled = -1;
+  if (enabled < 0) {
+    const char *env = getenv("FRANZ_DIRECT_CALLBACKS");
+    enabled = !(env && strcmp(env, "0") == 0);
+  }
+  return enabled;
+}
+
+LLVMValueRef LLVMCallbacks_compile(LLVMCodeGen *gen, AstNode *node, int minParams, int maxParams,
+                                   int indexParam, LLVMCallback *direct) {
+  direct->function = NULL;
+  direct->type = NULL;
+  direct->paramCount = 0;
+
+  // A top-level function literal is compiled to a typed function plus a closure
+  // wrapping it; LLVMCodeGen_compileFunction_impl leaves the typed one in lastFunction.
+  // Literals inside a function body become closures with an environment and leave it NULL
+  gen->lastFunction = NULL;
+  LLVMValueRef value = LLVMCodeGen_compileNode(gen, node);
+  if (!value) return NULL;
+
+  LLVMValueRef function = NULL;
+  AstNode *functionNode = NULL;
+  if (node->opcode == OP_FUNCTION) {
+    function = gen->lastFunction;
+    functionNode = node;
+  } else if (node->opcode == OP_IDENTIFIER && node->val) {
+    // Name of a top-level function (gen->functions). In main its variable holds the
+    // closure wrapping that same function; inside a function body a local of the
+    // same name (a parameter, say) shadows it
+    LLVMValueRef named = LLVMVariableMap_get(gen->functions, node->val);
+    int shadowed = LLVMVariableMap_get(gen->variables, node->val) != NULL &&
+                   gen->currentFunction != LLVMGetNamedFunction(gen->module, "main");
+    if (named && LLVMIsAFunction(named) && !shadowed) {
+      function = named;
+      functionNode = (AstNode *) LLVMVariableMap_get(gen->functionNodes, node->val);
+    }
+  }
+  gen->lastFunction = NULL;
+  if (!directCallbacksEnabled()) return value;
+
+  // A forward declaration whose body comes later in the file cannot be inspected yet
+  if (!function || !functionNode || LLVMCountBasicBlocks(function) == 0) return value;
+
+  LLVMTypeRef type = LLVMGlobalGetValueType(function);
+  int paramCount = (int) LLVMCountParamTypes(type);
+  if (paramCount < minParams || paramCount > maxParams || paramCount > 8) return value;
+  if (!isNumericType(gen, LLVMGetReturnType(type))) return value;
+
+  // Untyped parameters are compiled as i64 too, so an i64 parameter only means the
+  // element is a number if the body does arithmetic on it ({x -> <- x} over strings
+  // must keep getting its Generic)
+  AstNode *body = functionNode->children[functionNode->childCount - 1];
+  LLVMTypeRef paramTypes[8];
+  LLVMGetParamTypes(type, paramTypes);
+  for (int i = 0; i < paramCount; i++) {
+    direct->ignored[i] = 0;
+    if (!isNumericType(gen, paramTypes[i])) return value;
+    if (i == indexParam || usedAsNumber(body, functionNode->children[i]->val)) continue;
+    if (LLVMGetFirstUse(LLVMGetParam(function, i))) return value;
+    direct->ignored[i] = 1;
+  }
+
+  direct->function = function;
+  direct->type = type;
+  direct->paramCount = paramCount;
+  return value;
+}
+
+LLVMTypeRef LLVMCallbacks_paramType(LLVMCallback *callback, int i) {
+  LLVMTypeRef paramTypes[8];
+  LLVMGetParamTypes(callback->type, paramTypes);
+  return paramTypes[i];
+}
+
+LLVMValueRef LLVMCallbacks_call(LLVMCodeGen *gen, LLVMCallback *callback, LLVMValueRef *args) {
+  LLVMValueRef callArgs[8];
+  for (int i = 0; i < callback->paramCount; i++) {
+    LLVMTypeRef type = LLVMCallbacks_paramType(callback, i);
+    callArgs[i] = callback->ignored[i] ? LLVMConstNull(type) : LLVMCallbacks_convert(gen, args[i], type);
+  }
+  return LLVMBuildCall2(gen->builder, callback->type, callback->function,
+                        callArgs, callback->paramCount, "callback_result");
+}
+
+LLVMValueRef LLVMCallbacks_convert(LLVMCodeGen *gen, LLVMValueRef value, LLVMTypeRef type) {
+  LLVMTypeRef valueType = LLVMTypeOf(value);
+  if (valueType == type) return value;
+
+  if (LLVMGetTypeKind(valueType) == LLVMPointerTypeKind) {
+    // Generic* - unbox (ints and floats convert into each other, anything else is a runtime error)
+    LLVMTypeRef params[] = { gen->genericType };
+    const char *name = type == gen->floatType ? "franz_unbox_float" : "franz_unbox_int";
+    LLVMValueRef unboxFunc = ensureFunction(gen, name, type, params, 1);
+    LLVMValueRef unboxArgs[] = { value };
+    return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(unboxFunc),
+                          unboxFunc, unboxArgs, 1, "unboxed");
+  }
+
+  if (type == gen->floatType) {
+    return LLVMBuildSIToFP(gen->builder, value, gen->floatType, "int_to_float");
+  }
+  return LLVMBuildFPToSI(gen->builder, value, gen->intType, "float_to_int");
+}
+
+LLVMValueRef LLVMCallbacks_box(LLVMCodeGen *gen, LLVMValueRef value) {
+  LLVMTypeRef type = LLVMTypeOf(value);
+  LLVMTypeRef params[] = { type };
+  const char *name = type == gen->floatType ? "franz_box_float" : "franz_box_int";
+  LLVMValueRef boxFunc = ensureFunction(gen, name, gen->genericType, params, 1);
+  LLVMValueRef boxArgs[] = { value };
+  return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxFunc),
+                        boxFunc, boxArgs, 1, "boxed");
+}
+
+LLVMValueRef LLVMCallbacks_listLength(LLVMCodeGen *gen, LLVMValueRef list, const char *caller,
+                                      int lineNumber) {
+  // franz_callback_list_length(Generic* list, char* caller, i64 lineNumber) -> i64
+  LLVMTypeRef params[] = { gen->genericType, gen->stringType, gen->intType };
+  LLVMValueRef lengthFunc = ensureFunction(gen, "franz_callback_list_length", gen->intType, params, 3);
+
+  if (LLVMGetTypeKind(LLVMTypeOf(list)) == LLVMIntegerTypeKind) {
+    list = LLVMBuildIntToPtr(gen->builder, list, gen->genericType, "list_ptr");
+  }
+
+  LLVMValueRef args[] = {
+    list,
+    LLVMBuildGlobalStringPtr(gen->builder, caller, "callback_caller"),
+    LLVMConstInt(gen->intType, lineNumber, 0)
+  };
+  return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(lengthFunc),
+                        lengthFunc, args, 3, "list_length");
+}
+
+LLVMValueRef LLVMCallbacks_element(LLVMCodeGen *gen, LLVMValueRef list, LLVMValueRef index) {
+  // franz_list_nth(Generic*, i64) -> Generic*
+  LLVMTypeRef params[] = { gen->genericType, gen->intType };
+  LLVMValueRef nthFunc = ensureFunction(gen, "franz_list_nth", gen->genericType, params, 2);
+
+  if (LLVMGetTypeKind(LLVMTypeOf(list)) == LLVMIntegerTypeKind) {
+    list = LLVMBuildIntToPtr(gen->builder, list, gen->genericType, "list_ptr");
+  }
+
+  LLVMValueRef args[] = { list, index };
+  return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(nthFunc),
+                        nthFunc, args, 2, "element");
+}
+
+LLVMValueRef LLVMCallbacks_newItems(LLVMCodeGen *gen, LLVMValueRef count) {
+  LLVMValueRef size = LLVMBuildMul(gen->builder, count, LLVMConstInt(gen->intType, sizeof(void *), 0),
+                                   "items_size");
+  LLVMValueRef mallocArgs[] = { size };
+  LLVMValueRef items = LLVMBuildCall2(gen->builder, gen->mallocType, gen->mallocFunc,
+                                      mallocArgs, 1, "items");
+  return LLVMBuildBitCast(gen->builder, items, LLVMPointerType(gen->genericType, 0), "items_array");
+}
+
+LLVMValueRef LLVMCallbacks_finishItems(LLVMCodeGen *gen, LLVMValueRef items, LLVMValueRef count) {
+  // franz_list_new(Generic**, i64) -> Generic* (declared the same way in llvm-lists)
+  LLVMTypeRef listNewParams[] = { LLVMPointerType(gen->genericType, 0), gen->intType };
+  LLVMValueRef listNewFunc = ensureFunction(gen, "franz_list_new", gen->genericType, listNewParams, 2);
+  LLVMValueRef listArgs[] = { items, count };
+  LLVMValueRef list = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(listNewFunc),
+                                     listNewFunc, listArgs, 2, "callback_list");
+
+  // free(i8*)
+  LLVMTypeRef freeParams[] = { gen->stringType };
+  LLVMValueRef freeFunc = ensureFunction(gen, "free", gen->voidType, freeParams, 1);
+  LLVMValueRef freeArgs[] = { LLVMBuildBitCast(gen->builder, items, gen->stringType, "items_raw") };
+  LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(freeFunc), freeFunc, freeArgs, 1, "");
+  return list;
+}
+
+LLVMValueRef LLVMCallbacks_alloca(LLVMCodeGen *gen, LLVMTypeRef type, const char *name) {
+  LLVMBasicBlockRef entry = LLVMGetEntryBasicBlock(gen->currentFunction);
+  LLVMBuilderRef builder = LLVMCreateBuilderInContext(gen->context);
+  LLVMValueRef first = LLVMGetFirstInstruction(entry);
+  if (first) {
+    LLVMPositionBuilderBefore(builder, first);
+  } else {
+    LLVMPositionBuilderAtEnd(builder, entry);
+  }
+  LLVMValueRef slot = LLVMBuildAlloca(builder, type, name);
+  LLVMDisposeBuilder(builder);
+  return slot;
+}
+
+void LLVMCallbacks_beginLoop(LLVMCodeGen *gen, LLVMValueRef count, LLVMCallbackLoop *loop) {
+  loop->counterPtr = LLVMCallbacks_alloca(gen, gen->intType, "callback_counter");
+  LLVMBuildStore(gen->builder, LLVMConstInt(gen->intType, 0, 0), loop->counterPtr);
+
+  loop->condBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction, "callback_cond");
+  LLVMBasicBlockRef bodyBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction,
+                                                              "callback_body");
+  loop->exitBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction, "callback_exit");
+  LLVMBuildBr(gen->builder, loop->condBlock);
+
+  // callback_cond: i < count
+  LLVMPositionBuilderAtEnd(gen->builder, loop->condBlock);
+  LLVMValueRef index = LLVMBuildLoad2(gen->builder, gen->intType, loop->counterPtr, "callback_index");
+  LLVMValueRef more = LLVMBuildICmp(gen->builder, LLVMIntSLT, index, count, "callback_more");
+  LLVMBuildCondBr(gen->builder, more, bodyBlock, loop->exitBlock);
+
+  LLVMPositionBuilderAtEnd(gen->builder, bodyBlock);
+  loop->index = index;
+}
+
+void LLVMCallbacks_endLoop(LLVMCodeGen *gen, LLVMCallbackLoop *loop) {
+  LLVMValueRef next = LLVMBuildAdd(gen->builder, loop->index, LLVMConstInt(gen->intType, 1, 0),
+                                   "callback_next");
+  LLVMBuildStore(gen->builder, next, loop->counterPtr);
+  LLVMBuildBr(gen->builder, loop->condBlock);
+  LLVMPositionBuilderAtEnd(gen->builder, loop->exitBlock);
+}
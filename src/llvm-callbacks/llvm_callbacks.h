@@ -0,0 +1,95 @@
+#ifndef LLVM_CALLBACKS_H
+#define LLVM_CALLBACKS_H
+
+#include <llvm-c/Core.h>
+#include "../llvm-codegen/llvm_codegen.h"
+#include "../ast.h"
+
+/**
+ * Direct Callbacks for map / filter / reduce
+ *
+ * When the callback of (map list f), (filter list f) or (reduce list f init) is a
+ * function literal written at the top level, or the name of a top-level function,
+ * its typed LLVM function is known at compile time. The iteration loop is then
+ * emitted in IR and calls that function directly with unboxed arguments:
+ *
+ *   (map xs {x i -> <- (multiply x 2)})
+ *
+ *   n = franz_callback_list_length(xs, "map", line)
+ *   for (i = 0; i < n; i++)
+ *     items[i] = franz_box_int(_franz_lambda_0(franz_unbox_int(franz_list_nth(xs, i)), i))
+ *   result = franz_list_new(items, n)
+ *
+ * No closure is boxed, the index is never boxed, and at -O1 and above the call
+ * (and the runtime helpers, through the runtime bitcode) can be inlined into the loop.
+ *
+ * Only functions whose result is an int (i64) or float (double), and whose
+ * parameters are ints or floats the body does arithmetic on (or never reads),
+ * take this path. Anything else (closures with an environment, string or list
+ * parameters, an identity function) still goes through franz_llvm_map /
+ * franz_llvm_filter / franz_llvm_reduce.
+ */
+
+typedef struct {
+  LLVMValueRef function;  // Typed function, NULL if the callback must go through the runtime
+  LLVMTypeRef type;       // Its function type
+  int paramCount;
+  int ignored[8];         // 1 if the function never reads parameter i (it is passed 0)
+} LLVMCallback;
+
+typedef struct {
+  LLVMBasicBlockRef condBlock;
+  LLVMBasicBlockRef exitBlock;
+  LLVMValueRef counterPtr;
+  LLVMValueRef index;     // i64 index of the current iteration (valid in the body)
+} LLVMCallbackLoop;
+
+/**
+ * Compile a callback argument
+ *
+ * @param gen LLVM code generator context
+ * @param node Callback AST node
+ * @param minParams Fewest parameters a direct callback may take
+ * @param maxParams Most parameters a direct callback may take
+ * @param indexParam Position of the index parameter (always an int, whatever was inferred)
+ * @param direct Filled in; direct->function is NULL unless the callback can be called directly
+ * @return The compiled callback value (for the runtime path), NULL on error
+ */
+LLVMValueRef LLVMCallbacks_compile(LLVMCodeGen *gen, AstNode *node, int minParams, int maxParams,
+                                   int indexParam, LLVMCallback *direct);
+
+// Type of parameter i of a direct callback (i64 or double)
+LLVMTypeRef LLVMCallbacks_paramType(LLVMCallback *callback, int i);
+
+// Call a direct callback with the first callback->paramCount of args (converted to its parameter types)
+LLVMValueRef LLVMCallbacks_call(LLVMCodeGen *gen, LLVMCallback *callback, LLVMValueRef *args);
+
+// Convert an i64, double or Generic* value to type (i64 or double)
+LLVMValueRef LLVMCallbacks_convert(LLVMCodeGen *gen, LLVMValueRef value, LLVMTypeRef type);
+
+// Box an i64 or double into a Generic*
+LLVMValueRef LLVMCallbacks_box(LLVMCodeGen *gen, LLVMValueRef value);
+
+// Length of list, exiting with "<caller> requires a list" if it is not one
+LLVMValueRef LLVMCallbacks_listLength(LLVMCodeGen *gen, LLVMValueRef list, const char *caller,
+                                      int lineNumber);
+
+// Borrowed element index of list (Generic*)
+LLVMValueRef LLVMCallbacks_element(LLVMCodeGen *gen, LLVMValueRef list, LLVMValueRef index);
+
+// malloc'd array of count Generic* (i8**) to collect results in
+LLVMValueRef LLVMCallbacks_newItems(LLVMCodeGen *gen, LLVMValueRef count);
+
+// List of the first count items (the list takes a reference to each), then free the array
+LLVMValueRef LLVMCallbacks_finishItems(LLVMCodeGen *gen, LLVMValueRef items, LLVMValueRef count);
+
+// Stack slot in the entry block of the current function (not re-allocated when the code runs in a loop)
+LLVMValueRef LLVMCallbacks_alloca(LLVMCodeGen *gen, LLVMTypeRef type, const char *name);
+
+// Start a loop over [0, count); the builder is left in the body, at loop->index
+void LLVMCallbacks_beginLoop(LLVMCodeGen *gen, LLVMValueRef count, LLVMCallbackLoop *loop);
+
+// Close the loop body; the builder is left after the loop
+void LLVMCallbacks_endLoop(LLVMCodeGen *gen, LLVMCallbackLoop *loop);
+
+#endif // LLVM_CALLBACKS_H
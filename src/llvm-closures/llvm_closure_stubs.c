@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "llvm_closures.h"
+
+/**
+ * Closure Call Stubs
+ *
+ * Every closure struct points (field 4) at a constant table describing how the
+ * runtime calls it:
+ *
+ *   @_franz_closure_3.stubs = private constant { i32, i32, i8* }
+ *                             { i32 arity, i32 returnTypeTag, i8* @_franz_closure_3.boxed }
+ *
+ *   define i8* @_franz_closure_3.boxed(i8* %env, i8** %args)
+ *     ; unbox args[0 .. arity-1] for the closure's own ABI, call it,
+ *     ; box the result the way returnTypeTag says
+ *
+ * The boxed entry is specialized for the closure's arity, parameter types and
+ * return tag when it is emitted, so franz_llvm_map / filter / reduce / dict_map
+ * make one indirect call per element instead of going through the argCount and
+ * returnTypeTag switches of franz_call_llvm_closure.
+ */
+
+// FRANZ_CLOSURE_STUBS=0 leaves the stub table NULL (to compare with franz_call_llvm_closure)
+static int closureStubsEnabled(void) {
+  static int enabled = -1;
+  if (enabled < 0) {
+    const char *env = getenv("FRANZ_CLOSURE_STUBS");
+    enabled = !(env && strcmp(env, "0") == 0);
+  }
+  return enabled;
+}
+
+static LLVMValueRef ensureFunction(LLVMCodeGen *gen, const char *name, LLVMTypeRef returnType,
+                                   LLVMTypeRef *params, int paramCount) {
+  LLVMValueRef func = LLVMGetNamedFunction(gen->module, name);
+  if (!func) {
+    LLVMTypeRef funcType = LLVMFunctionType(returnType, params, paramCount, 0);
+    func = LLVMAddFunction(gen->module, name, funcType);
+  }
+  return func;
+}
+
+static LLVMValueRef callRuntime(LLVMCodeGen *gen, const char *name, LLVMTypeRef returnType,
+                                LLVMTypeRef paramType, LLVMValueRef arg, const char *valueName) {
+  LLVMTypeRef params[] = { paramType };
+  LLVMValueRef func = ensureFunction(gen, name, returnType, params, paramType ? 1 : 0);
+  LLVMValueRef args[] = { arg };
+  return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(func), func, args,
+                        paramType ? 1 : 0, valueName);
+}
+
+// Argument of a typed (top-level) function from a Generic*
+static LLVMValueRef unboxTyped(LLVMCodeGen *gen, LLVMValueRef arg, LLVMTypeRef type) {
+  LLVMTypeRef i8Ptr = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
+  if (type == gen->floatType) {
+    return callRuntime(gen, "franz_closure_arg_float", gen->floatType, i8Ptr, arg, "arg");
+  }
+  if (LLVMGetTypeKind(type) == LLVMPointerTypeKind) {
+    LLVMValueRef ptr = callRuntime(gen, "franz_closure_arg_pointer", i8Ptr, i8Ptr, arg, "arg");
+    return LLVMBuildPointerCast(gen->builder, ptr, type, "arg_ptr");
+  }
+  return callRuntime(gen, "franz_closure_arg_int", gen->intType, i8Ptr, arg, "arg");
+}
+
+// Box a closure's raw result according to its (compile-time) return tag
+static LLVMValueRef boxResult(LLVMCodeGen *gen, LLVMValueRef raw, int returnTypeTag) {
+  LLVMTypeRef i8Ptr = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
+  LLVMTypeRef rawType = LLVMTypeOf(raw);
+
+  if (rawType == gen->floatType) {
+    return callRuntime(gen, "franz_box_float", i8Ptr, gen->floatType, raw, "boxed");
+  }
+
+  // Closure functions return everything as i8*; typed functions return i64 or a pointer
+  LLVMValueRef bits = raw;
+  if (LLVMGetTypeKind(rawType) == LLVMPointerTypeKind) {
+    bits = LLVMBuildPtrToInt(gen->builder, raw, gen->intType, "result_bits");
+  } else if (rawType != gen->intType) {
+    bits = LLVMBuildIntCast2(gen->builder, raw, gen->intType, 1, "result_bits");
+  }
+
+  switch (returnTypeTag) {
+    case CLOSURE_RETURN_INT:
+      return callRuntime(gen, "franz_box_int", i8Ptr, gen->intType, bits, "boxed");
+    case CLOSURE_RETURN_FLOAT: {
+      LLVMValueRef value = LLVMBuildBitCast(gen->builder, bits, gen->floatType, "result_float");
+      return callRuntime(gen, "franz_box_float", i8Ptr, gen->floatType, value, "boxed");
+    }
+    case CLOSURE_RETURN_CLOSURE: {
+      LLVMValueRef ptr = LLVMBuildIntToPtr(gen->builder, bits, i8Ptr, "result_ptr");
+      return callRuntime(gen, "franz_box_closure", i8Ptr, i8Ptr, ptr, "boxed");
+    }
+    case CLOSURE_RETURN_VOID:
+      return callRuntime(gen, "Generic_void", i8Ptr, NULL, NULL, "boxed");
+    default: {
+      // A Generic* or a bare string
+      LLVMValueRef ptr = LLVMBuildIntToPtr(gen->builder, bits, i8Ptr, "result_ptr");
+      return callRuntime(gen, "franz_box_pointer_smart", i8Ptr, i8Ptr, ptr, "boxed");
+    }
+  }
+}
+
+int LLVMClosures_returnedParam(AstNode *node, int paramCount) {
+  if (!node || node->childCount <= paramCount) return -1;
+
+  AstNode *last = node->children[node->childCount - 1];
+  if (last && last->opcode == OP_STATEMENT && last->childCount > 0) {
+    last = last->children[last->childCount - 1];
+  }
+  if (last && last->opcode == OP_RETURN && last->childCount > 0) {
+    last = last->children[0];
+  }
+  if (!last || last->opcode != OP_IDENTIFIER || !last->val) return -1;
+
+  for (int i = 0; i < paramCount; i++) {
+    if (node->children[i]->val && strcmp(node->children[i]->val, last->val) == 0) return i;
+  }
+  return -1;
+}
+
+LLVMValueRef LLVMClosures_emitStubs(LLVMCodeGen *gen, LLVMValueRef callee, int tagged,
+                                    int returnTypeTag, int returnedParam) {
+  LLVMTypeRef i8Ptr = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
+  LLVMTypeRef i32 = LLVMInt32TypeInContext(gen->context);
+  if (!closureStubsEnabled()) return LLVMConstPointerNull(i8Ptr);
+
+  LLVMTypeRef calleeType = LLVMGlobalGetValueType(callee);
+  int calleeParamCount = (int) LLVMCountParamTypes(calleeType);
+  int arity = tagged ? (calleeParamCount - 1) / 2 : calleeParamCount;
+
+  LLVMTypeRef *calleeParams = malloc(sizeof(LLVMTypeRef) * (calleeParamCount + 1));
+  LLVMGetParamTypes(calleeType, calleeParams);
+
+  // Boxed entry: Generic *(void *env, Generic **args)
+  const char *calleeName = LLVMGetValueName(callee);
+  char name[128];
+  snprintf(name, sizeof(name), "%s.boxed", calleeName);
+  LLVMTypeRef entryParams[] = { i8Ptr, LLVMPointerType(i8Ptr, 0) };
+  LLVMValueRef entry = LLVMAddFunction(gen->module, name, LLVMFunctionType(i8Ptr, entryParams, 2, 0));
+  LLVMSetLinkage(entry, LLVMPrivateLinkage);
+
+  LLVMBasicBlockRef savedBlock = LLVMGetInsertBlock(gen->builder);
+  LLVMPositionBuilderAtEnd(gen->builder, LLVMAppendBasicBlockInContext(gen->context, entry, "entry"));
+
+  LLVMValueRef argsParam = LLVMGetParam(entry, 1);
+  LLVMValueRef *boxedArgs = malloc(sizeof(LLVMValueRef) * (arity + 1));
+  LLVMValueRef *callArgs = malloc(sizeof(LLVMValueRef) * (calleeParamCount + 1));
+  int callArgCount = 0;
+  if (tagged) callArgs[callArgCount++] = LLVMGetParam(entry, 0);
+
+  for (int i = 0; i < arity; i++) {
+    LLVMValueRef index = LLVMConstInt(gen->intType, i, 0);
+    LLVMValueRef slot = LLVMBuildGEP2(gen->builder, i8Ptr, argsParam, &index, 1, "arg_slot");
+    boxedArgs[i] = LLVMBuildLoad2(gen->builder, i8Ptr, slot, "boxed_arg");
+
+    if (tagged) {
+      // (value, tag) pairs, as LLVMClosures_compileClosure's parameters expect
+      callArgs[callArgCount++] = callRuntime(gen, "franz_closure_arg", gen->intType, i8Ptr,
+                                             boxedArgs[i], "arg");
+      callArgs[callArgCount++] = callRuntime(gen, "franz_generic_get_type", i32, i8Ptr,
+                                             boxedArgs[i], "arg_tag");
+    } else {
+      callArgs[callArgCount++] = unboxTyped(gen, boxedArgs[i], calleeParams[i]);
+    }
+  }
+
+  LLVMValueRef raw = LLVMBuildCall2(gen->builder, calleeType, callee, callArgs, callArgCount, "result");
+
+  // An identity-like closure returns one of its arguments unchanged: hand back the
+  // caller's Generic rather than re-boxing it under the (inferred) return tag
+  LLVMValueRef boxed;
+  if (returnedParam >= 0 && returnedParam < arity) {
+    boxed = boxedArgs[returnedParam];
+  } else {
+    boxed = boxResult(gen, raw, returnTypeTag);
+  }
+  LLVMBuildRet(gen->builder, boxed);
+
+  if (savedBlock) {
+    LLVMPositionBuilderAtEnd(gen->builder, savedBlock);
+  } else {
+    LLVMClearInsertionPosition(gen->builder);
+  }
+  free(calleeParams);
+  free(boxedArgs);
+  free(callArgs);
+
+  // Stub table: { i32 arity, i32 returnTypeTag, i8* boxed }
+  LLVMTypeRef tableFields[] = { i32, i32, i8Ptr };
+  LLVMTypeRef tableType = LLVMStructTypeInContext(gen->context, tableFields, 3, 0);
+  LLVMValueRef tableValues[] = {
+    LLVMConstInt(i32, arity, 0),
+    LLVMConstInt(i32, returnTypeTag, 0),
+    LLVMConstBitCast(entry, i8Ptr)
+  };
+  snprintf(name, sizeof(name), "%s.stubs", calleeName);
+  LLVMValueRef table = LLVMAddGlobal(gen->module, tableType, name);
+  LLVMSetInitializer(table, LLVMConstStructInContext(gen->context, tableValues, 3, 0));
+  LLVMSetGlobalConstant(table, 1);
+  LLVMSetLinkage(table, LLVMPrivateLinkage);
+
+  return LLVMConstBitCast(table, i8Ptr);
+}
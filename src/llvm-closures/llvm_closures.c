@@ -5,6 +5,10 @@
 #include "../llvm-codegen/llvm_codegen.h"
 #include "../freevar/freevar.h"
 #include "../type-inference/type_infer.h"
+#include "../llvm-callbacks/llvm_callbacks.h"
+
+// Set on a function that keeps closures in its frame: calls from it can't be tail calls
+#define STACK_CLOSURES_ATTRIBUTE "franz-stack-closures"
 
 static int LLVMClosures_nodeIsVoid(LLVMCodeGen *gen, AstNode *node) {
   if (!node) {
@@ -36,6 +40,34 @@ static void LLVMClosures_restoreParamTagState(LLVMCodeGen *gen,
   gen->paramTypeTags = savedMap;
 }
 
+// FRANZ_STACK_CLOSURES=0 heap-allocates every closure (to compare with escape analysis)
+static int LLVMClosures_stackEnabled(void) {
+  static int enabled = -1;
+  if (enabled < 0) {
+    const char *env = getenv("FRANZ_STACK_CLOSURES");
+    enabled = !(env && strcmp(env, "0") == 0);
+  }
+  return enabled;
+}
+
+// Storage for a closure struct or environment: a slot in the current function's
+// frame when the closure doesn't escape it (FreeVar_markEscapes), the heap otherwise
+static LLVMValueRef LLVMClosures_allocate(LLVMCodeGen *gen, LLVMTypeRef type, int onStack,
+                                          const char *name) {
+  if (!onStack) {
+    return LLVMBuildMalloc(gen->builder, type, name);
+  }
+
+  if (!LLVMGetStringAttributeAtIndex(gen->currentFunction, LLVMAttributeFunctionIndex,
+                                     STACK_CLOSURES_ATTRIBUTE, strlen(STACK_CLOSURES_ATTRIBUTE))) {
+    LLVMAttributeRef attribute = LLVMCreateStringAttribute(gen->context, STACK_CLOSURES_ATTRIBUTE,
+                                                           strlen(STACK_CLOSURES_ATTRIBUTE), "", 0);
+    LLVMAddAttributeAtIndex(gen->currentFunction, LLVMAttributeFunctionIndex, attribute);
+  }
+  // In the entry block, so a closure created in a loop reuses one slot
+  return LLVMCallbacks_alloca(gen, type, name);
+}
+
 //  LLVM Closure Implementation
 // Complete industry-standard closure support with lexical scope capture
 
@@ -85,14 +117,15 @@ int LLVMClosures_getReturnTypeTag(LLVMCodeGen *gen, LLVMTypeRef returnType) {
 LLVMTypeRef LLVMClosures_getClosureType(LLVMContextRef context) {
   //  Enhanced closure struct for polymorphic identity functions
   // Like Rust's dyn Trait or C++'s std::function
-  // Struct: { i8*, i8*, i32, i32 } = { function_ptr, env_ptr, return_type_tag, param_index }
-  LLVMTypeRef fields[4];
+  // Struct: { i8*, i8*, i32, i32, i8* } = { function_ptr, env_ptr, return_type_tag, param_index, stubs }
+  LLVMTypeRef fields[5];
   fields[0] = LLVMPointerType(LLVMInt8TypeInContext(context), 0);  // function pointer (type-erased)
   fields[1] = LLVMPointerType(LLVMInt8TypeInContext(context), 0);  // environment pointer
   fields[2] = LLVMInt32TypeInContext(context);                      // return type tag (0=int, 1=float, 2=ptr, 5=dynamic)
   fields[3] = LLVMInt32TypeInContext(context);                      // parameter index (for DYNAMIC tag, which param to use)
+  fields[4] = LLVMPointerType(LLVMInt8TypeInContext(context), 0);  // stub table (LLVMClosures_emitStubs)
 
-  return LLVMStructTypeInContext(context, fields, 4, 0);  // 0 = not packed
+  return LLVMStructTypeInContext(context, fields, 5, 0);  // 0 = not packed
 }
 
 // ============================================================================
@@ -170,6 +203,11 @@ LLVMValueRef LLVMClosures_compileClosure(LLVMCodeGen *gen, AstNode *node) {
   if (node->freeVarsCount == 0) {
     FreeVar_analyze(node);
   }
+  // Closures this one creates that can live in its frame
+  FreeVar_markEscapes(node);
+
+  // This closure itself lives in the enclosing function's frame if it can't outlive it
+  int onStack = node->noEscape && LLVMClosures_stackEnabled() && gen->currentFunction;
 
   int freeVarsCount = node->freeVarsCount;
   char **freeVars = node->freeVars;
@@ -197,8 +235,8 @@ LLVMValueRef LLVMClosures_compileClosure(LLVMCodeGen *gen, AstNode *node) {
   // Step 1: Create environment struct type
   LLVMTypeRef envType = LLVMClosures_createEnvType(gen, freeVars, freeVarsCount);
 
-  // Step 2: Allocate environment on heap
-  LLVMValueRef envPtr = LLVMBuildMalloc(gen->builder, envType, "closure_env");
+  // Step 2: Allocate environment (heap, or the enclosing frame if it doesn't escape)
+  LLVMValueRef envPtr = LLVMClosures_allocate(gen, envType, onStack, "closure_env");
 
   // Step 3: Store captured variables into environment
   // CRITICAL FIX: Skip variables in gen->functions - they remain accessible
@@ -792,7 +830,7 @@ LLVMValueRef LLVMClosures_compileClosure(LLVMCodeGen *gen, AstNode *node) {
 
   // Step 5: Create closure struct { func_ptr, env_ptr }
   LLVMTypeRef closureType = LLVMClosures_getClosureType(gen->context);
-  LLVMValueRef closurePtr = LLVMBuildMalloc(gen->builder, closureType, "closure");
+  LLVMValueRef closurePtr = LLVMClosures_allocate(gen, closureType, onStack, "closure");
 
   // Cast function pointer to i8*
   LLVMValueRef funcPtrCast = LLVMBuildPointerCast(gen->builder, closureFunc,
@@ -853,6 +891,16 @@ LLVMValueRef LLVMClosures_compileClosure(LLVMCodeGen *gen, AstNode *node) {
   fprintf(stderr, "[CLOSURE DEBUG] Stored paramIndex=%d at field 3\n", returnedParamIndex);
   #endif
 
+  // Store the stub table the runtime calls it through (field 4)
+  LLVMValueRef stubs = LLVMClosures_emitStubs(gen, closureFunc, 1, returnTypeTag,
+                                              returnsParameter ? returnedParamIndex : -1);
+  LLVMValueRef stubsFieldIndices[2] = {
+    LLVMConstInt(LLVMInt32TypeInContext(gen->context), 0, 0),
+    LLVMConstInt(LLVMInt32TypeInContext(gen->context), 4, 0)  // Field 4 = stub table
+  };
+  LLVMValueRef stubsFieldPtr = LLVMBuildGEP2(gen->builder, closureType, closurePtr, stubsFieldIndices, 2, "stubs_field");
+  LLVMBuildStore(gen->builder, stubs, stubsFieldPtr);
+
   #ifdef DEBUG_CLOSURES
   fprintf(stderr, "[DEBUG] Created closure struct with return type tag = %d\n", returnTypeTag);
   #endif
@@ -1043,8 +1091,10 @@ LLVMValueRef LLVMClosures_callClosure(LLVMCodeGen *gen, LLVMValueRef closureValu
   fprintf(stderr, "[CLOSURE CALL] ✓ Call succeeded! rawResult obtained\n");
   #endif
 
-  // TCO: Mark as tail call if in tail position
-  if (gen->enableTCO && gen->inTailPosition) {
+  // TCO: Mark as tail call if in tail position (not if the closure may be in our frame)
+  if (gen->enableTCO && gen->inTailPosition &&
+      !LLVMGetStringAttributeAtIndex(gen->currentFunction, LLVMAttributeFunctionIndex,
+                                     STACK_CLOSURES_ATTRIBUTE, strlen(STACK_CLOSURES_ATTRIBUTE))) {
     LLVMSetTailCall(rawResult, 1);
     if (gen->debugMode) {
       fprintf(stderr, "[TCO] Marked tail call\n");
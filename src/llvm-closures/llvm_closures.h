@@ -10,7 +10,9 @@
 //
 // Architecture (C-style closures, like Rust/C++ lambdas):
 // 1. Closure Struct: { function_ptr, environment_ptr }
-// 2. Environment: Heap-allocated struct with captured variables
+// 2. Environment: Struct with captured variables, on the heap or, when escape
+//    analysis (FreeVar_markEscapes) shows the closure can't outlive its creator,
+//    in the creator's stack frame along with the closure struct
 // 3. Modified Signature: Functions with captures get env* as first parameter
 //
 // Example:
@@ -30,6 +32,7 @@
  * 2. Create environment struct type for captured variables
  * 3. Create function with modified signature: env* as first parameter
  * 4. Allocate environment struct and populate with captured values
+ *    (alloca in the enclosing function if node->noEscape, malloc otherwise)
  * 5. Return closure struct {function_ptr, env_ptr}
  *
  * @param gen LLVM code generator context
@@ -71,12 +74,14 @@ typedef enum {
 /**
  * Creates the closure struct type in LLVM IR.
  *  Enhanced: Now includes return type tag for proper typing
- * Type: { i8*, i8*, i32 } = { function_pointer, environment_pointer, return_type_tag }
+ * Type: { i8*, i8*, i32, i32, i8* } =
+ *       { function_pointer, environment_pointer, return_type_tag, param_index, stubs }
  *
  * This matches industry standards (Rust dyn Trait, C++ std::function):
  * - Function pointer (type-erased)
  * - Captured environment
  * - Runtime type information
+ * - Call stubs for the runtime (see LLVMClosures_emitStubs)
  *
  * @param context LLVM context
  * @return LLVMTypeRef - Closure struct type
@@ -115,4 +120,25 @@ int LLVMClosures_isClosure(AstNode *node);
  */
 int LLVMClosures_getReturnTypeTag(LLVMCodeGen *gen, LLVMTypeRef returnType);
 
+/**
+ * Emits a closure's boxed entry and its stub table (llvm_closure_stubs.c).
+ *
+ * The boxed entry, Generic *(void *env, Generic **args), unboxes the arguments for
+ * callee's ABI, calls it and boxes the result for returnTypeTag. The table,
+ * { i32 arity, i32 returnTypeTag, i8* boxed }, goes in field 4 of the closure struct;
+ * the runtime's higher-order helpers call the entry through it.
+ *
+ * @param gen LLVM code generator context
+ * @param callee Closure function (tagged) or typed top-level function (not tagged)
+ * @param tagged 1 for the (env, value, tag, ...) ABI of LLVMClosures_compileClosure
+ * @param returnTypeTag ClosureReturnTypeTag of the closure
+ * @param returnedParam Parameter the body returns unchanged (its Generic is passed back), -1 if none
+ * @return LLVMValueRef - i8* constant pointing to the stub table (null when FRANZ_CLOSURE_STUBS=0)
+ */
+LLVMValueRef LLVMClosures_emitStubs(LLVMCodeGen *gen, LLVMValueRef callee, int tagged,
+                                    int returnTypeTag, int returnedParam);
+
+// Index of the parameter a function literal's last statement returns, -1 if it returns something else
+int LLVMClosures_returnedParam(AstNode *node, int paramCount);
+
 #endif
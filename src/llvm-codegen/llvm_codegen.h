@@ -79,6 +79,14 @@ typedef struct {
   // Used by isGenericPointerNode to avoid Generic* boxing for int/float returns
   LLVMVariableMap *returnTypeTags;  // Function name → return type tag (cast to void*)
 
+  // Function name → a copy of its OP_FUNCTION AstNode (cast to void*, owned), for re-running
+  // type inference and compiling specialized clones
+  LLVMVariableMap *functionNodes;
+
+  // LLVM name of a polymorphic function → number of specialized clones made (cast to void*),
+  // see llvm-monomorphize
+  LLVMVariableMap *specializations;
+
   // Runtime function declarations ()
   LLVMValueRef printfFunc;      // printf() for output
   LLVMTypeRef printfType;       // printf function type
@@ -169,6 +177,10 @@ typedef struct {
   int enableTCO;                // 1 to enable TCO, 0 to disable (controlled by --tco flag)
   int inTailPosition;           // 1 if currently compiling code in tail position (for tail call detection)
   int currentClosureReturnTag;  // Expected closure return tag (INT/FLOAT) for return conversions
+
+  // Typed function behind the last top-level function literal, so map/filter/reduce
+  // can call a literal callback directly (see llvm-callbacks)
+  LLVMValueRef lastFunction;
 } LLVMCodeGen;
 
 //  Setup and initialization
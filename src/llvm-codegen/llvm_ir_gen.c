@@ -23,6 +23,8 @@
 #include "../llvm-string-ops/llvm_string_ops.h"  //  String operations (get substring)
 #include "../llvm-type/llvm_type.h"  //  Type introspection (type function)
 #include "../llvm-refs/llvm_refs.h"  //  Mutable references (ref, deref, set!)
+#include "../freevar/freevar.h"  //  Escape analysis for closure environments
+#include "../llvm-monomorphize/llvm_monomorphize.h"  //  Specialized clones of polymorphic functions
 #include <llvm-c/Core.h>
 #include <llvm-c/ExecutionEngine.h>
 #include <llvm-c/Target.h>
@@ -116,6 +118,17 @@ static int TypeInfer_toReturnTypeTag(InferredTypeKind kind) {
   }
 }
 
+/**
+ * Record (or with NULL, forget) the function literal bound to a top-level name.
+ * gen->functionNodes keeps its own copy: a module's AST is freed as soon as the
+ * module is compiled, but its functions can be specialized later (llvm-monomorphize).
+ */
+static void setFunctionNode(LLVMCodeGen *gen, const char *name, AstNode *node) {
+  AstNode *previous = (AstNode *) LLVMVariableMap_get(gen->functionNodes, name);
+  if (previous) AstNode_free(previous);
+  LLVMVariableMap_set(gen->functionNodes, name, node ? (LLVMValueRef) AstNode_copy(node, 0) : NULL);
+}
+
 // ============================================================================
 // LLVM Code Generator Initialization
 // ============================================================================
@@ -147,6 +160,7 @@ LLVMCodeGen *LLVMCodeGen_new_impl(const char *moduleName) {
   gen->enableTCO = 1;        // Enabled by default (matching OCaml/Scheme), use --no-tco to disable
   gen->inTailPosition = 0;   // Not in tail position initially
   gen->currentClosureReturnTag = -1;
+  gen->lastFunction = NULL;
 
   //  Initialize loop context (NULL = not in loop)
   gen->loopExitBlock = NULL;
@@ -185,6 +199,8 @@ LLVMCodeGen *LLVMCodeGen_new_impl(const char *moduleName) {
   //  Initialize return type tracking for upstream tagging optimization
   // Maps function name → return type tag (TYPE_INT, TYPE_FLOAT, TYPE_CLOSURE, etc.)
   gen->returnTypeTags = LLVMVariableMap_new();
+  gen->functionNodes = LLVMVariableMap_new();
+  gen->specializations = LLVMVariableMap_new();
 
   // Declare printf for output
   LLVMTypeRef printfParams[] = {gen->stringType};
@@ -420,6 +436,7 @@ LLVMCodeGen *LLVMCodeGen_new_impl(const char *moduleName) {
   LLVMVariableMap_set(gen->globalSymbols, "format-int", marker);
   LLVMVariableMap_set(gen->globalSymbols, "format-float", marker);
   LLVMVariableMap_set(gen->globalSymbols, "join", marker);
+  LLVMVariableMap_set(gen->globalSymbols, "intern", marker);
 
   //  Mutable references
   LLVMVariableMap_set(gen->globalSymbols, "ref", marker);
@@ -441,6 +458,13 @@ void LLVMCodeGen_free_impl(LLVMCodeGen *gen) {
   if (gen->paramTypeTags) LLVMVariableMap_free(gen->paramTypeTags);  //  Free param tag tracking
   if (gen->typeMetadata) LLVMVariableMap_free(gen->typeMetadata);    //  Free type metadata tracking
   if (gen->returnTypeTags) LLVMVariableMap_free(gen->returnTypeTags);  //  Free return type tracking
+  if (gen->functionNodes) {
+    for (int i = 0; i < gen->functionNodes->count; i++) {
+      if (gen->functionNodes->entries[i].value) AstNode_free((AstNode *) gen->functionNodes->entries[i].value);
+    }
+    LLVMVariableMap_free(gen->functionNodes);
+  }
+  if (gen->specializations) LLVMVariableMap_free(gen->specializations);
   if (gen->builder) LLVMDisposeBuilder(gen->builder);
   if (gen->module) LLVMDisposeModule(gen->module);
   if (gen->context) LLVMContextDispose(gen->context);
@@ -649,6 +673,10 @@ LLVMValueRef LLVMCodeGen_compileAssignment_impl(LLVMCodeGen *gen, AstNode *node)
   //  Restore previous function name after compilation
   if (valueNode->opcode == OP_FUNCTION) {
     gen->currentFunctionName = prevFunctionName;
+  } else if (LLVMVariableMap_get(gen->functionNodes, varNode->val) &&
+             gen->currentFunction == LLVMGetNamedFunction(gen->module, "main")) {
+    // The name no longer holds that function literal: calls go through the variable
+    setFunctionNode(gen, varNode->val, NULL);
   }
 
   if (!value) {
@@ -711,9 +739,9 @@ LLVMValueRef LLVMCodeGen_compileAssignment_impl(LLVMCodeGen *gen, AstNode *node)
 
     if (existingVar != NULL) {
       // Variable already exists - this is a reassignment
-      LLVMTypeRef existingType = LLVMTypeOf(existingVar);
-
-      if (LLVMGetTypeKind(existingType) == LLVMPointerTypeKind) {
+      // Only an alloca is storage; an immutable Generic* (a list literal global,
+      // a call result) is a pointer too but must not be stored through
+      if (LLVMIsAAllocaInst(existingVar)) {
         // Existing variable is mutable (alloca pointer) - store new value
         LLVMBuildStore(gen->builder, value, existingVar);
       } else {
@@ -758,7 +786,8 @@ LLVMValueRef LLVMCodeGen_compileAssignment_impl(LLVMCodeGen *gen, AstNode *node)
       int isClosureValue = 0;
       if (value && valueNode->opcode == OP_APPLICATION) {
         // Check if this function has an inferred return type
-        int shouldMarkAsClosure = 1;  // Default: assume closure
+        // A direct call returning an int or float (nativeCall) holds that value itself
+        int shouldMarkAsClosure = !valueNode->nativeCall;  // Default: assume closure
 
         if (valueNode->childCount > 0) {
           AstNode *funcNode = valueNode->children[0];
@@ -901,7 +930,14 @@ LLVMValueRef LLVMCodeGen_compileAssignment_impl(LLVMCodeGen *gen, AstNode *node)
               strcmp(funcName, "multiply") == 0 || strcmp(funcName, "divide") == 0 ||
               strcmp(funcName, "remainder") == 0 || strcmp(funcName, "abs") == 0 ||
               strcmp(funcName, "min") == 0 || strcmp(funcName, "max") == 0 ||
-              strcmp(funcName, "random_int") == 0) {
+              strcmp(funcName, "random_int") == 0 ||
+              // Comparisons, logic and type predicates return 0/1 unboxed
+              strcmp(funcName, "is") == 0 || strcmp(funcName, "less_than") == 0 ||
+              strcmp(funcName, "greater_than") == 0 || strcmp(funcName, "not") == 0 ||
+              strcmp(funcName, "and") == 0 || strcmp(funcName, "or") == 0 ||
+              strcmp(funcName, "is_int") == 0 || strcmp(funcName, "is_float") == 0 ||
+              strcmp(funcName, "is_string") == 0 || strcmp(funcName, "is_list") == 0 ||
+              strcmp(funcName, "is_function") == 0) {
             opcodeToStore = OP_INT;  // Default to integer (may be promoted to float at runtime)
             if (gen->debugMode) {
               #if 0  // Debug output disabled
@@ -931,7 +967,8 @@ LLVMValueRef LLVMCodeGen_compileAssignment_impl(LLVMCodeGen *gen, AstNode *node)
             }
           }
           // String functions return strings
-          else if (strcmp(funcName, "join") == 0 || strcmp(funcName, "repeat") == 0) {
+          else if (strcmp(funcName, "join") == 0 || strcmp(funcName, "repeat") == 0 ||
+                   strcmp(funcName, "intern") == 0) {
             opcodeToStore = OP_STRING;
             if (gen->debugMode) {
               #if 0  // Debug output disabled
@@ -985,8 +1022,8 @@ LLVMValueRef LLVMCodeGen_compileAssignment_impl(LLVMCodeGen *gen, AstNode *node)
           #endif
 
           // ENHANCEMENT: Check if closure returns Generic* or native type
-          int shouldTrackAsGeneric = isClosure;  // Default: assume Generic*
-          if (isClosure) {
+          int shouldTrackAsGeneric = isClosure && !valueNode->nativeCall;  // Default: assume Generic*
+          if (shouldTrackAsGeneric) {
             // Check returnTypeTags to see if it returns INT/FLOAT/VOID
             void *storedTag = LLVMVariableMap_get(gen->returnTypeTags, funcName);
             if (storedTag) {
@@ -1022,6 +1059,7 @@ LLVMValueRef LLVMCodeGen_compileAssignment_impl(LLVMCodeGen *gen, AstNode *node)
           // List operations and refs that return Generic* ( + 6.6 + 6.6.1)
           if (strcmp(funcName, "head") == 0 || strcmp(funcName, "tail") == 0 ||
               strcmp(funcName, "cons") == 0 || strcmp(funcName, "nth") == 0 ||
+              strcmp(funcName, "range") == 0 ||
               strcmp(funcName, "list_files") == 0 || strcmp(funcName, "get") == 0 ||
               strcmp(funcName, "filter") == 0 || strcmp(funcName, "map") == 0 ||
               strcmp(funcName, "reduce") == 0 ||
@@ -1323,6 +1361,11 @@ int isGenericPointerNode(LLVMCodeGen *gen, AstNode *node) {
 
   // List operations and closure applications (function applications)
   if (node->opcode == OP_APPLICATION && node->childCount > 0) {
+    // Compiled as a direct call of a user function that returns an int or float
+    if (node->nativeCall) {
+      return 0;
+    }
+
     AstNode *funcNode = node->children[0];
     if (funcNode->opcode == OP_IDENTIFIER) {
       const char *name = funcNode->val;
@@ -1434,6 +1477,7 @@ int isGenericPointerNode(LLVMCodeGen *gen, AstNode *node) {
       //  + 6.6 + 6.6.1: List operations and refs that return Generic*
       if (strcmp(name, "head") == 0 || strcmp(name, "tail") == 0 ||
           strcmp(name, "cons") == 0 || strcmp(name, "nth") == 0 ||
+          strcmp(name, "range") == 0 ||
           strcmp(name, "list_files") == 0 || strcmp(name, "get") == 0 ||
           strcmp(name, "filter") == 0 || strcmp(name, "map") == 0 ||
           strcmp(name, "reduce") == 0 ||
@@ -1591,8 +1635,10 @@ LLVMValueRef LLVMCodeGen_compilePrintln_impl(LLVMCodeGen *gen, AstNode *node) {
     printGenericFunc = LLVMAddFunction(gen->module, "franz_print_generic", funcType);
   }
 
+  // NULL only when an argument failed to compile; an empty println is a no-op
+  LLVMValueRef printed = LLVMConstInt(LLVMInt32TypeInContext(gen->context), 0, 0);
   int argCount = node->childCount;
-  if (argCount == 0) return NULL;
+  if (argCount == 0) return printed;
 
   PrintlnArgInfo *argInfos = (PrintlnArgInfo *)calloc(argCount, sizeof(PrintlnArgInfo));
 
@@ -1617,6 +1663,7 @@ LLVMValueRef LLVMCodeGen_compilePrintln_impl(LLVMCodeGen *gen, AstNode *node) {
       #if 0  // Debug output disabled
       fprintf(stderr, "[PRINTLN ARG DEBUG] Compilation returned NULL!\n");
       #endif
+      printed = NULL;
       continue;
     }
 
@@ -1688,20 +1735,26 @@ LLVMValueRef LLVMCodeGen_compilePrintln_impl(LLVMCodeGen *gen, AstNode *node) {
   // Add newline at the end (println should end with newline)
   LLVMValueRef newlineStr = LLVMBuildGlobalStringPtr(gen->builder, "\n", ".newline");
   LLVMValueRef printfArgs[] = {newlineStr};
-  LLVMBuildCall2(gen->builder, gen->printfType, gen->printfFunc, printfArgs, 1, "printf_newline");
+  LLVMValueRef newlineCall = LLVMBuildCall2(gen->builder, gen->printfType, gen->printfFunc,
+                                            printfArgs, 1, "printf_newline");
 
   free(argInfos);
-  return lastCall;
+  if (!printed) return NULL;
+  return lastCall ? lastCall : newlineCall;
 }
 
 
 // Compile (print arg1 arg2 ...)
 LLVMValueRef LLVMCodeGen_compilePrint_impl(LLVMCodeGen *gen, AstNode *node) {
   LLVMValueRef lastCall = NULL;
+  int failed = 0;
 
   for (int i = 0; i < node->childCount; i++) {
     LLVMValueRef arg = LLVMCodeGen_compileNode_impl(gen, node->children[i]);
-    if (!arg) continue;
+    if (!arg) {
+      failed = 1;
+      continue;
+    }
 
     LLVMValueRef paramTag = NULL;
     if (node->children[i]->opcode == OP_IDENTIFIER && gen->paramTypeTags) {
@@ -1732,7 +1785,9 @@ LLVMValueRef LLVMCodeGen_compilePrint_impl(LLVMCodeGen *gen, AstNode *node) {
     }
   }
 
-  return lastCall;
+  // NULL only when an argument failed to compile
+  if (failed) return NULL;
+  return lastCall ? lastCall : LLVMConstInt(LLVMInt32TypeInContext(gen->context), 0, 0);
 }
 
 // ============================================================================
@@ -2156,6 +2211,35 @@ LLVMValueRef LLVMCodeGen_compileJoin_impl(LLVMCodeGen *gen, AstNode *node) {
   return result;
 }
 
+// Compile (intern str) - the interned copy of a string (see src/intern)
+// Returns the text of the interned Generic; franz_box_string maps it back to
+// that Generic, so the string keeps its stored hash as a dict key
+LLVMValueRef LLVMCodeGen_compileIntern_impl(LLVMCodeGen *gen, AstNode *node) {
+  if (node->childCount != 1) {
+    fprintf(stderr, "ERROR: intern requires 1 argument at line %d\n", node->lineNumber);
+    return NULL;
+  }
+
+  LLVMValueRef text = LLVMCodeGen_compileNode_impl(gen, node->children[0]);
+  if (!text) return NULL;
+
+  if (LLVMTypeOf(text) != gen->stringType) {
+    fprintf(stderr, "ERROR: intern argument must be a string at line %d\n", node->lineNumber);
+    return NULL;
+  }
+
+  // franz_intern_text(char*) -> char*
+  LLVMValueRef internTextFunc = LLVMGetNamedFunction(gen->module, "franz_intern_text");
+  if (!internTextFunc) {
+    LLVMTypeRef params[] = {gen->stringType};
+    internTextFunc = LLVMAddFunction(gen->module, "franz_intern_text",
+                                     LLVMFunctionType(gen->stringType, params, 1, 0));
+  }
+
+  return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(internTextFunc), internTextFunc,
+                        &text, 1, "interned_text");
+}
+
 // ============================================================================
 //  Get Function (Substring/List Indexing)
 // ============================================================================
@@ -2657,6 +2741,24 @@ LLVMValueRef LLVMCodeGen_compileApplication_impl(LLVMCodeGen *gen, AstNode *node
           #endif
         }
 
+        // In main a top-level function's variable holds its closure; a polymorphic one
+        // returning a number is called directly instead, specialized for these
+        // arguments (llvm-monomorphize)
+        LLVMValueRef specialized = NULL;
+        if (!isGenericPtr && gen->currentFunction == LLVMGetNamedFunction(gen->module, "main")) {
+          specialized = LLVMMonomorphize_function(gen, funcName, args, argNode.childCount);
+        }
+        LLVMTypeRef specializedReturn = specialized
+            ? LLVMGetReturnType(LLVMGlobalGetValueType(specialized)) : NULL;
+        if (specializedReturn == gen->intType || specializedReturn == gen->floatType) {
+          LLVMValueRef result = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(specialized), specialized,
+                                               args, argNode.childCount, "call");
+          node->nativeCall = 1;
+          free(args);
+          return result;
+        }
+        node->nativeCall = 0;
+
         #if 0  // Debug output disabled
         fprintf(stderr, "[CLOSURE CALL DEBUG] Calling LLVMClosures_callClosure with %d args\n", argNode.childCount);
         #endif
@@ -2688,8 +2790,21 @@ LLVMValueRef LLVMCodeGen_compileApplication_impl(LLVMCodeGen *gen, AstNode *node
       fprintf(stderr, "[FUNCTION CALL DEBUG] userFunc value name = '%s'\n", userFuncName ? userFuncName : "(null)");
       #endif
 
-      // Call user-defined function
-      // userFunc is already an LLVMValueRef function, use it directly
+      // Compile arguments
+      LLVMValueRef *args = malloc(argNode.childCount * sizeof(LLVMValueRef));
+      for (int i = 0; i < argNode.childCount; i++) {
+        args[i] = LLVMCodeGen_compileNode_impl(gen, argNode.children[i]);
+        if (!args[i]) {
+          free(args);
+          return NULL;
+        }
+      }
+
+      // A polymorphic function gets a clone specialized for these argument types
+      LLVMValueRef specialized = LLVMMonomorphize_function(gen, funcName, args, argNode.childCount);
+      if (specialized) {
+        userFunc = specialized;
+      }
 
       // Get the function type
       LLVMTypeRef funcType = LLVMGlobalGetValueType(userFunc);
@@ -2708,16 +2823,7 @@ LLVMValueRef LLVMCodeGen_compileApplication_impl(LLVMCodeGen *gen, AstNode *node
         LLVMGetParamTypes(funcType, paramTypes);
       }
 
-      // Compile arguments
-      LLVMValueRef *args = malloc(argNode.childCount * sizeof(LLVMValueRef));
       for (int i = 0; i < argNode.childCount; i++) {
-        args[i] = LLVMCodeGen_compileNode_impl(gen, argNode.children[i]);
-        if (!args[i]) {
-          free(args);
-          if (paramTypes) free(paramTypes);
-          return NULL;
-        }
-
         //  Convert argument to match expected parameter type
         if (paramTypes && i < (int)paramCount) {
           LLVMTypeRef expectedType = paramTypes[i];
@@ -2738,6 +2844,8 @@ LLVMValueRef LLVMCodeGen_compileApplication_impl(LLVMCodeGen *gen, AstNode *node
       }
 
       LLVMValueRef result = LLVMBuildCall2(gen->builder, funcType, userFunc, args, argNode.childCount, "call");
+      node->nativeCall = specialized &&
+                         (LLVMTypeOf(result) == gen->intType || LLVMTypeOf(result) == gen->floatType);
 
       // TCO: Mark as tail call if in tail position
       if (gen->enableTCO && gen->inTailPosition) {
@@ -2827,6 +2935,8 @@ LLVMValueRef LLVMCodeGen_compileApplication_impl(LLVMCodeGen *gen, AstNode *node
       return LLVMCodeGen_compileFormatFloat_impl(gen, &argNode);
     } else if (strcmp(funcName, "join") == 0) {
       return LLVMCodeGen_compileJoin_impl(gen, &argNode);
+    } else if (strcmp(funcName, "intern") == 0) {
+      return LLVMCodeGen_compileIntern_impl(gen, &argNode);
     } else if (strcmp(funcName, "remainder") == 0) {
       return LLVMCodeGen_compileRemainder(gen, &argNode);
     } else if (strcmp(funcName, "power") == 0) {
@@ -2911,6 +3021,9 @@ LLVMValueRef LLVMCodeGen_compileApplication_impl(LLVMCodeGen *gen, AstNode *node
     } else if (strcmp(funcName, "nth") == 0) {
       //  get element at index
       return LLVMListOps_compileNth(gen, &argNode);
+    } else if (strcmp(funcName, "range") == 0) {
+      //  list of 0 .. n - 1
+      return LLVMListOps_compileRange(gen, &argNode);
     } else if (strcmp(funcName, "filter") == 0) {
       // LLVM Filter: filter list with predicate closure
       return LLVMFilter_compileFilter(gen, &argNode);
@@ -3245,6 +3358,9 @@ LLVMValueRef LLVMCodeGen_compileFunction_impl(LLVMCodeGen *gen, AstNode *node) {
   int bodyStmtCount = node->childCount - paramCount;
   int isMultiStatementBody = (bodyStmtCount > 1);
 
+  // Closures created in the body that can live in this function's frame
+  FreeVar_markEscapes(node);
+
   //  Infer function type signature
   InferredFunctionType *inferredType = TypeInfer_inferFunction(node);
   if (!inferredType) {
@@ -3505,12 +3621,36 @@ LLVMValueRef LLVMCodeGen_compileFunction_impl(LLVMCodeGen *gen, AstNode *node) {
     LLVMTypeRef correctFuncType = LLVMFunctionType(actualReturnType, paramTypes, paramCount, 0);
     function = LLVMAddFunction(gen->module, tempFuncName, correctFuncType);
 
-    // Move the entry block to the new function
-    LLVMBasicBlockRef oldEntry = LLVMGetFirstBasicBlock(oldFunction);
-    if (oldEntry) {
-      LLVMRemoveBasicBlockFromParent(oldEntry);
-      LLVMAppendExistingBasicBlock(function, oldEntry);
-      LLVMPositionBuilderAtEnd(gen->builder, oldEntry);
+    // Carry over function attributes (e.g. the body keeping closures in its frame)
+    unsigned attributeCount = LLVMGetAttributeCountAtIndex(oldFunction, LLVMAttributeFunctionIndex);
+    if (attributeCount > 0) {
+      LLVMAttributeRef *attributes = malloc(sizeof(LLVMAttributeRef) * attributeCount);
+      LLVMGetAttributesAtIndex(oldFunction, LLVMAttributeFunctionIndex, attributes);
+      for (unsigned i = 0; i < attributeCount; i++) {
+        LLVMAddAttributeAtIndex(function, LLVMAttributeFunctionIndex, attributes[i]);
+      }
+      free(attributes);
+    }
+
+    // Rewire the already-compiled body to the new parameters (and recursive
+    // calls to the new function) before the old one is deleted - otherwise the
+    // moved instructions keep pointing at freed Arguments, which only works by
+    // accident at -O0 and crashes instruction selection at -O1 and above
+    for (int i = 0; i < paramCount; i++) {
+      LLVMReplaceAllUsesWith(LLVMGetParam(oldFunction, i), LLVMGetParam(function, i));
+    }
+    LLVMReplaceAllUsesWith(oldFunction, LLVMConstBitCast(function, LLVMTypeOf(oldFunction)));
+
+    // Move every block to the new function (an if/else body has more than the
+    // entry block), keeping the builder where it was
+    LLVMBasicBlockRef insertBlock = LLVMGetInsertBlock(gen->builder);
+    LLVMBasicBlockRef oldBlock;
+    while ((oldBlock = LLVMGetFirstBasicBlock(oldFunction)) != NULL) {
+      LLVMRemoveBasicBlockFromParent(oldBlock);
+      LLVMAppendExistingBasicBlock(function, oldBlock);
+    }
+    if (insertBlock) {
+      LLVMPositionBuilderAtEnd(gen->builder, insertBlock);
     }
 
     // Delete the old function
@@ -3595,6 +3735,12 @@ LLVMValueRef LLVMCodeGen_compileFunction_impl(LLVMCodeGen *gen, AstNode *node) {
     LLVMPositionBuilderAtEnd(gen->builder, prevBlock);
   }
 
+  // Left for LLVMCallbacks_compile (direct map/filter/reduce callbacks)
+  gen->lastFunction = function;
+  if (gen->currentFunctionName != NULL) {
+    setFunctionNode(gen, gen->currentFunctionName, node);
+  }
+
   // CRITICAL: Wrap ALL functions in closure structs for uniform representation
   // This ensures dict_map/filter and other higher-order functions work consistently
   // Regular functions get: { funcPtr, NULL env, returnTypeTag }
@@ -3675,6 +3821,17 @@ LLVMValueRef LLVMCodeGen_compileFunction_impl(LLVMCodeGen *gen, AstNode *node) {
   LLVMValueRef tagFieldPtr = LLVMBuildGEP2(gen->builder, closureType, closurePtr, tagIndices, 2, "tag_field");
   LLVMBuildStore(gen->builder, tagValue, tagFieldPtr);
 
+  // Store the stub table in field 4; its boxed entry calls the typed function itself,
+  // not the wrapper
+  LLVMValueRef stubs = LLVMClosures_emitStubs(gen, function, 0, returnTypeTag,
+                                              LLVMClosures_returnedParam(node, paramCount));
+  LLVMValueRef stubsIndices[] = {
+    LLVMConstInt(LLVMInt32TypeInContext(gen->context), 0, 0),
+    LLVMConstInt(LLVMInt32TypeInContext(gen->context), 4, 0)
+  };
+  LLVMValueRef stubsFieldPtr = LLVMBuildGEP2(gen->builder, closureType, closurePtr, stubsIndices, 2, "stubs_field");
+  LLVMBuildStore(gen->builder, stubs, stubsFieldPtr);
+
   // CRITICAL FIX: Update returnTypeTags with the ACTUAL return type tag from PASS 2
   // PASS 1 forward declarations may have incorrect/incomplete type inference (e.g., DYNAMIC for functions
   // that return results of other function calls). PASS 2 has the correct type.
@@ -4082,7 +4239,12 @@ int LLVMCodeGen_compile_impl(LLVMCodeGen *gen, AstNode *ast, Scope *globalScope)
 
   // PASS 1: Compile non-function assignments first
   // This ensures variables like `base = 100` exist before we analyze closures that use them
+  // An immutable binding created here is final; PASS 3 must not compile it again
+  // (that would be a reassignment). A failure here is not final either: the value
+  // may call a function PASS 2 has not declared yet, so PASS 3 retries it.
+  char *bound = NULL;
   if (ast && ast->opcode == OP_STATEMENT) {
+    bound = calloc(ast->childCount > 0 ? ast->childCount : 1, 1);
     for (int i = 0; i < ast->childCount; i++) {
       AstNode *child = ast->children[i];
       // Compile non-function assignments (e.g., base = 100, x = 42)
@@ -4090,7 +4252,12 @@ int LLVMCodeGen_compile_impl(LLVMCodeGen *gen, AstNode *ast, Scope *globalScope)
         AstNode *valueNode = child->children[1];
         // Skip function assignments - they'll be handled in PASS 2
         if (!valueNode || valueNode->opcode != OP_FUNCTION) {
-          LLVMCodeGen_compileNode_impl(gen, child);
+          const char *name = child->children[0] ? child->children[0]->val : NULL;
+          int existed = name && LLVMVariableMap_get(gen->variables, name) != NULL;
+          if (LLVMCodeGen_compileNode_impl(gen, child) && name && !existed) {
+            LLVMValueRef binding = LLVMVariableMap_get(gen->variables, name);
+            bound[i] = binding && !LLVMIsAAllocaInst(binding);
+          }
         }
       }
     }
@@ -4112,7 +4279,23 @@ int LLVMCodeGen_compile_impl(LLVMCodeGen *gen, AstNode *ast, Scope *globalScope)
 
   //  PASS 3 - Compile the AST (including function bodies)
   // Functions can now reference each other because all are declared
-  LLVMCodeGen_compileNode_impl(gen, ast);
+  // A statement that fails to compile has already reported why; the module
+  // is not emitted, since code after it may use values it never produced
+  int failed = 0;
+  if (ast->opcode == OP_STATEMENT) {
+    for (int i = 0; i < ast->childCount; i++) {
+      if (bound[i]) continue;
+      if (!LLVMCodeGen_compileNode_impl(gen, ast->children[i])) failed++;
+    }
+  } else if (!LLVMCodeGen_compileNode_impl(gen, ast)) {
+    failed++;
+  }
+  free(bound);
+
+  if (failed > 0) {
+    fprintf(stderr, "ERROR: %d statement%s failed to compile\n", failed, failed == 1 ? "" : "s");
+    return -1;
+  }
 
   // Return 0
   LLVMBuildRet(gen->builder, LLVMConstInt(LLVMInt32TypeInContext(gen->context), 0, 0));
@@ -4132,7 +4315,7 @@ int LLVMCodeGen_compile_impl(LLVMCodeGen *gen, AstNode *ast, Scope *globalScope)
     return -1;
   }
 
-  printf("✅  LLVM IR generation complete\n");
+  fprintf(stderr, "✅  LLVM IR generation complete\n");
   return 0;
 }
 
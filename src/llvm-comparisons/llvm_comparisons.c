@@ -1,6 +1,7 @@
 #include "llvm_comparisons.h"
 #include "../llvm-closures/llvm_closures.h"
 #include "../llvm-unboxing/llvm_unboxing.h"
+#include "../trace/trace.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -113,22 +114,22 @@ static LLVMValueRef LLVMCodeGen_buildIsStandardComparison(LLVMCodeGen *gen,
   LLVMTypeRef leftType = LLVMTypeOf(left);
   LLVMTypeRef rightType = LLVMTypeOf(right);
 
-  fprintf(stderr, "[IS DEBUG] Comparing types: left kind=%d, right kind=%d\n",
-          LLVMGetTypeKind(leftType), LLVMGetTypeKind(rightType));
-  fprintf(stderr, "[IS DEBUG] leftType == intType: %d, rightType == intType: %d\n",
-          leftType == gen->intType, rightType == gen->intType);
-  fprintf(stderr, "[IS DEBUG] leftType == stringType: %d, rightType == stringType: %d\n",
-          leftType == gen->stringType, rightType == gen->stringType);
+  TRACE(TRACE_VALUES, "is (compile): Comparing types: left kind=%d, right kind=%d",
+      LLVMGetTypeKind(leftType), LLVMGetTypeKind(rightType));
+  TRACE(TRACE_VALUES, "is (compile): leftType == intType: %d, rightType == intType: %d",
+      leftType == gen->intType, rightType == gen->intType);
+  TRACE(TRACE_VALUES, "is (compile): leftType == stringType: %d, rightType == stringType: %d",
+      leftType == gen->stringType, rightType == gen->stringType);
 
   extern int isGenericPointerNode(LLVMCodeGen *gen, AstNode *node);
 
   int leftIsGeneric = isGenericPointerNode(gen, node->children[0]);
   int rightIsGeneric = isGenericPointerNode(gen, node->children[1]);
 
-  fprintf(stderr, "[IS DEBUG] leftIsGeneric=%d, rightIsGeneric=%d\n", leftIsGeneric, rightIsGeneric);
+  TRACE(TRACE_VALUES, "is (compile): leftIsGeneric=%d, rightIsGeneric=%d", leftIsGeneric, rightIsGeneric);
 
   if (leftIsGeneric || rightIsGeneric) {
-    fprintf(stderr, "[IS DEBUG] Taking Generic* comparison path\n");
+    TRACE(TRACE_VALUES, "is (compile): Taking Generic* comparison path");
 
     LLVMTypeRef genericPtrType = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
 
@@ -186,24 +187,24 @@ static LLVMValueRef LLVMCodeGen_buildIsStandardComparison(LLVMCodeGen *gen,
         leftPtr = leftParamBoxed;
       } else if (leftIsGeneric) {
         if (leftType == gen->intType) {
-          fprintf(stderr, "[IS DEBUG] Left tracked as Generic*, converting i64→ptr\n");
+          TRACE(TRACE_VALUES, "is (compile): Left tracked as Generic*, converting i64→ptr");
           leftPtr = LLVMBuildIntToPtr(gen->builder, left, genericPtrType, "left_tracked_generic_ptr");
         } else {
-          fprintf(stderr, "[IS DEBUG] Left already Generic* pointer\n");
+          TRACE(TRACE_VALUES, "is (compile): Left already Generic* pointer");
           leftPtr = left;
         }
       } else if (leftType == gen->intType) {
-        fprintf(stderr, "[IS DEBUG] Boxing left integer into Generic*\n");
+        TRACE(TRACE_VALUES, "is (compile): Boxing left integer into Generic*");
         LLVMValueRef args[] = { left };
         leftPtr = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
                                  boxIntFunc, args, 1, "left_boxed_int");
       } else if (leftType == gen->floatType) {
-        fprintf(stderr, "[IS DEBUG] Boxing left float into Generic*\n");
+        TRACE(TRACE_VALUES, "is (compile): Boxing left float into Generic*");
         LLVMValueRef args[] = { left };
         leftPtr = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxFloatFunc),
                                  boxFloatFunc, args, 1, "left_boxed_float");
       } else if (leftType == gen->stringType) {
-        fprintf(stderr, "[IS DEBUG] Boxing left raw string into Generic*\n");
+        TRACE(TRACE_VALUES, "is (compile): Boxing left raw string into Generic*");
         LLVMValueRef args[] = { left };
         leftPtr = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
                                  boxStringFunc, args, 1, "left_boxed");
@@ -213,24 +214,24 @@ static LLVMValueRef LLVMCodeGen_buildIsStandardComparison(LLVMCodeGen *gen,
         rightPtr = rightParamBoxed;
       } else if (rightIsGeneric) {
         if (rightType == gen->intType) {
-          fprintf(stderr, "[IS DEBUG] Right tracked as Generic*, converting i64→ptr\n");
+          TRACE(TRACE_VALUES, "is (compile): Right tracked as Generic*, converting i64→ptr");
           rightPtr = LLVMBuildIntToPtr(gen->builder, right, genericPtrType, "right_tracked_generic_ptr");
         } else {
-          fprintf(stderr, "[IS DEBUG] Right is already Generic* pointer\n");
+          TRACE(TRACE_VALUES, "is (compile): Right is already Generic* pointer");
           rightPtr = right;
         }
       } else if (rightType == gen->intType) {
-        fprintf(stderr, "[IS DEBUG] Boxing right integer into Generic*\n");
+        TRACE(TRACE_VALUES, "is (compile): Boxing right integer into Generic*");
         LLVMValueRef args[] = { right };
         rightPtr = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
                                   boxIntFunc, args, 1, "right_boxed_int");
       } else if (rightType == gen->floatType) {
-        fprintf(stderr, "[IS DEBUG] Boxing right float into Generic*\n");
+        TRACE(TRACE_VALUES, "is (compile): Boxing right float into Generic*");
         LLVMValueRef args[] = { right };
         rightPtr = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxFloatFunc),
                                   boxFloatFunc, args, 1, "right_boxed_float");
       } else if (rightType == gen->stringType) {
-        fprintf(stderr, "[IS DEBUG] Boxing right raw string into Generic*\n");
+        TRACE(TRACE_VALUES, "is (compile): Boxing right raw string into Generic*");
         LLVMValueRef args[] = { right };
         rightPtr = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
                                   boxStringFunc, args, 1, "right_boxed");
@@ -243,7 +244,7 @@ static LLVMValueRef LLVMCodeGen_buildIsStandardComparison(LLVMCodeGen *gen,
         franzIsFunc = LLVMAddFunction(gen->module, "franz_generic_is", funcType);
       }
 
-      fprintf(stderr, "[IS DEBUG] Calling franz_generic_is\n");
+      TRACE(TRACE_VALUES, "is (compile): Calling franz_generic_is");
       LLVMValueRef args[] = { leftPtr, rightPtr };
       return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(franzIsFunc),
                             franzIsFunc, args, 2, "generic_is_result");
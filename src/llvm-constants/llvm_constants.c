@@ -0,0 +1,229 @@
+#include "llvm_constants.h"
+#include "../string.h"  // For parseString() - escape sequence processing
+#include "../number-formats/number_parse.h"
+#include "../list.h"
+#include "../string-object/string_object.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+// { i32 type, i64 payload, i32 refCount, i8 isMutable, i8 isInterned }, the layout of Generic
+static LLVMTypeRef LLVMConstants_genericType(LLVMCodeGen *gen) {
+  LLVMTypeRef i32 = LLVMInt32TypeInContext(gen->context);
+  LLVMTypeRef i8 = LLVMInt8TypeInContext(gen->context);
+  LLVMTypeRef fields[] = { i32, gen->intType, i32, i8, i8 };
+  return LLVMStructTypeInContext(gen->context, fields, 5, 0);
+}
+
+// Emit a private immortal Generic global and return it as i8*
+static LLVMValueRef LLVMConstants_emitGeneric(LLVMCodeGen *gen, const char *name,
+                                              enum Type type, LLVMValueRef payload) {
+  LLVMTypeRef i32 = LLVMInt32TypeInContext(gen->context);
+  LLVMTypeRef i8 = LLVMInt8TypeInContext(gen->context);
+  LLVMTypeRef genericType = LLVMConstants_genericType(gen);
+  LLVMValueRef fields[] = {
+    LLVMConstInt(i32, type, 0),
+    payload,
+    LLVMConstInt(i32, GENERIC_IMMORTAL, 0),
+    LLVMConstInt(i8, 0, 0),
+    LLVMConstInt(i8, 0, 0)
+  };
+
+  LLVMValueRef global = LLVMAddGlobal(gen->module, genericType, name);
+  LLVMSetInitializer(global, LLVMConstStructInContext(gen->context, fields, 5, 0));
+  LLVMSetLinkage(global, LLVMPrivateLinkage);
+  LLVMSetAlignment(global, 8);
+  return LLVMConstBitCast(global, gen->stringType);
+}
+
+// Look up a by-value global emitted earlier in this module
+static LLVMValueRef LLVMConstants_existing(LLVMCodeGen *gen, const char *name) {
+  LLVMValueRef global = LLVMGetNamedGlobal(gen->module, name);
+  return global ? LLVMConstBitCast(global, gen->stringType) : NULL;
+}
+
+static LLVMValueRef LLVMConstants_int(LLVMCodeGen *gen, int64_t value) {
+  char name[48];
+  snprintf(name, sizeof(name), "franz.int.%" PRId64, value);
+  LLVMValueRef existing = LLVMConstants_existing(gen, name);
+  if (existing) return existing;
+
+  return LLVMConstants_emitGeneric(gen, name, TYPE_INT, LLVMConstInt(gen->intType, (uint64_t) value, 1));
+}
+
+static LLVMValueRef LLVMConstants_float(LLVMCodeGen *gen, double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  char name[48];
+  snprintf(name, sizeof(name), "franz.float.%016" PRIx64, bits);
+  LLVMValueRef existing = LLVMConstants_existing(gen, name);
+  if (existing) return existing;
+
+  return LLVMConstants_emitGeneric(gen, name, TYPE_FLOAT, LLVMConstInt(gen->intType, bits, 0));
+}
+
+static LLVMValueRef LLVMConstants_string(LLVMCodeGen *gen, const char *raw) {
+  // Process escape sequences (\n, \t, \xHH, etc.) like LLVMCodeGen_compileString
+  char *value = parseString((char *) raw);
+  unsigned length = (unsigned) strlen(value);
+
+  // An immortal String { i32 refCount, i32 length, i32 capacity, i32 hash, [length + 1 x i8] text }
+  // with its hash computed now, so the runtime never has to write to it
+  LLVMTypeRef i32 = LLVMInt32TypeInContext(gen->context);
+  LLVMValueRef text = LLVMConstStringInContext(gen->context, value, length, 0);
+  LLVMValueRef header[] = {
+    LLVMConstInt(i32, STRING_IMMORTAL, 0),
+    LLVMConstInt(i32, length, 0),
+    LLVMConstInt(i32, length, 0),
+    LLVMConstInt(i32, String_hashBytes(value, (int) length), 0),
+    text
+  };
+  LLVMValueRef string = LLVMConstStructInContext(gen->context, header, 5, 0);
+  LLVMValueRef stringGlobal = LLVMAddGlobal(gen->module, LLVMTypeOf(string), "franz.string");
+  LLVMSetInitializer(stringGlobal, string);
+  LLVMSetGlobalConstant(stringGlobal, 1);
+  LLVMSetLinkage(stringGlobal, LLVMPrivateLinkage);
+  LLVMSetAlignment(stringGlobal, 8);
+  free(value);
+
+  // strVal points at the text inside the String, as it does for runtime strings
+  LLVMValueRef indices[] = { LLVMConstInt(i32, 0, 0), LLVMConstInt(i32, 4, 0), LLVMConstInt(i32, 0, 0) };
+  LLVMValueRef textPtr = LLVMConstInBoundsGEP2(LLVMTypeOf(string), stringGlobal, indices, 3);
+  LLVMValueRef payload = LLVMConstPtrToInt(textPtr, gen->intType);
+  return LLVMConstants_emitGeneric(gen, "franz.str", TYPE_STRING, payload);
+}
+
+// Emit an immortal ListNode { i32 refCount, [LIST_WIDTH x i8*] slots } and return it as i8*
+static LLVMValueRef LLVMConstants_emitNode(LLVMCodeGen *gen, LLVMValueRef *slots, int count) {
+  LLVMTypeRef i32 = LLVMInt32TypeInContext(gen->context);
+  LLVMTypeRef slotsType = LLVMArrayType(gen->stringType, LIST_WIDTH);
+  LLVMTypeRef fields[] = { i32, slotsType };
+  LLVMTypeRef nodeType = LLVMStructTypeInContext(gen->context, fields, 2, 0);
+
+  LLVMValueRef padded[LIST_WIDTH];
+  for (int i = 0; i < LIST_WIDTH; i++) {
+    padded[i] = i < count ? slots[i] : LLVMConstPointerNull(gen->stringType);
+  }
+
+  LLVMValueRef values[] = {
+    LLVMConstInt(i32, GENERIC_IMMORTAL, 0),
+    LLVMConstArray(gen->stringType, padded, LIST_WIDTH)
+  };
+  LLVMValueRef node = LLVMAddGlobal(gen->module, nodeType, "franz.list.node");
+  LLVMSetInitializer(node, LLVMConstStructInContext(gen->context, values, 2, 0));
+  LLVMSetLinkage(node, LLVMPrivateLinkage);
+  LLVMSetAlignment(node, 8);
+  return LLVMConstBitCast(node, gen->stringType);
+}
+
+static LLVMValueRef LLVMConstants_list(LLVMCodeGen *gen, AstNode *node) {
+  int count = node->childCount;
+  LLVMValueRef *level = malloc(sizeof(LLVMValueRef) * (count > 0 ? count : 1));
+
+  for (int i = 0; i < count; i++) {
+    level[i] = LLVMConstants_literal(gen, node->children[i]);
+    if (!level[i]) {
+      free(level);
+      return NULL;
+    }
+  }
+
+  // Build the trie bottom up: leaves of LIST_WIDTH items, then branches, until one root.
+  // The nodes are immortal like the items, so the runtime copies a node before changing it
+  LLVMValueRef root = LLVMConstPointerNull(gen->stringType);
+  int shift = 0;
+  int width = count;
+  if (count > 0) {
+    while (1) {
+      int nodes = (width + LIST_WIDTH - 1) / LIST_WIDTH;
+      for (int n = 0; n < nodes; n++) {
+        int slots = width - n * LIST_WIDTH < LIST_WIDTH ? width - n * LIST_WIDTH : LIST_WIDTH;
+        level[n] = LLVMConstants_emitNode(gen, level + n * LIST_WIDTH, slots);
+      }
+      width = nodes;
+      if (width == 1) break;
+      shift += LIST_BITS;
+    }
+    root = level[0];
+  }
+  free(level);
+
+  // List { int len; int offset; int shift; ListNode *root; }
+  LLVMTypeRef i32 = LLVMInt32TypeInContext(gen->context);
+  LLVMTypeRef listFields[] = { i32, i32, i32, gen->stringType };
+  LLVMTypeRef listType = LLVMStructTypeInContext(gen->context, listFields, 4, 0);
+  LLVMValueRef listValues[] = {
+    LLVMConstInt(i32, count, 0),
+    LLVMConstInt(i32, 0, 0),
+    LLVMConstInt(i32, shift, 0),
+    root
+  };
+  LLVMValueRef list = LLVMAddGlobal(gen->module, listType, "franz.list");
+  LLVMSetInitializer(list, LLVMConstStructInContext(gen->context, listValues, 4, 0));
+  LLVMSetLinkage(list, LLVMPrivateLinkage);
+
+  LLVMValueRef payload = LLVMConstPtrToInt(list, gen->intType);
+  return LLVMConstants_emitGeneric(gen, "franz.list.generic", TYPE_LIST, payload);
+}
+
+LLVMValueRef LLVMConstants_literal(LLVMCodeGen *gen, AstNode *node) {
+  if (!gen || !node) return NULL;
+
+  switch (node->opcode) {
+    case OP_INT:
+      return node->val ? LLVMConstants_int(gen, parseInteger(node->val)) : NULL;
+    case OP_FLOAT:
+      return node->val ? LLVMConstants_float(gen, parseFloat(node->val)) : NULL;
+    case OP_STRING:
+      return node->val ? LLVMConstants_string(gen, node->val) : NULL;
+    case OP_LIST:
+      return LLVMConstants_list(gen, node);
+    default:
+      return NULL;
+  }
+}
+
+LLVMValueRef LLVMConstants_internedString(LLVMCodeGen *gen, const char *raw) {
+  if (!gen || !raw) return NULL;
+
+  LLVMTypeRef ptrType = gen->stringType;
+
+  // franz_intern(Generic*) -> Generic*
+  LLVMValueRef internFunc = LLVMGetNamedFunction(gen->module, "franz_intern");
+  if (!internFunc) {
+    LLVMTypeRef params[] = { ptrType };
+    internFunc = LLVMAddFunction(gen->module, "franz_intern", LLVMFunctionType(ptrType, params, 1, 0));
+  }
+
+  // Slot caching the interned Generic for this site, NULL until the first evaluation
+  LLVMValueRef slot = LLVMAddGlobal(gen->module, ptrType, "franz.intern.slot");
+  LLVMSetInitializer(slot, LLVMConstPointerNull(ptrType));
+  LLVMSetLinkage(slot, LLVMPrivateLinkage);
+
+  LLVMValueRef cached = LLVMBuildLoad2(gen->builder, ptrType, slot, "interned_cached");
+  LLVMValueRef isEmpty = LLVMBuildICmp(gen->builder, LLVMIntEQ, cached,
+                                       LLVMConstPointerNull(ptrType), "intern_slot_empty");
+
+  LLVMBasicBlockRef loadBlock = LLVMGetInsertBlock(gen->builder);
+  LLVMValueRef func = LLVMGetBasicBlockParent(loadBlock);
+  LLVMBasicBlockRef internBlock = LLVMAppendBasicBlockInContext(gen->context, func, "intern_literal");
+  LLVMBasicBlockRef doneBlock = LLVMAppendBasicBlockInContext(gen->context, func, "intern_done");
+  LLVMBuildCondBr(gen->builder, isEmpty, internBlock, doneBlock);
+
+  // First evaluation: intern the static literal and remember the result
+  LLVMPositionBuilderAtEnd(gen->builder, internBlock);
+  LLVMValueRef literal = LLVMConstants_string(gen, raw);
+  LLVMValueRef interned = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(internFunc),
+                                         internFunc, &literal, 1, "interned");
+  LLVMBuildStore(gen->builder, interned, slot);
+  LLVMBuildBr(gen->builder, doneBlock);
+
+  LLVMPositionBuilderAtEnd(gen->builder, doneBlock);
+  LLVMValueRef result = LLVMBuildPhi(gen->builder, ptrType, "interned_string");
+  LLVMValueRef incoming[] = { cached, interned };
+  LLVMBasicBlockRef incomingBlocks[] = { loadBlock, internBlock };
+  LLVMAddIncoming(result, incoming, incomingBlocks, 2);
+  return result;
+}
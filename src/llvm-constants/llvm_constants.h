@@ -0,0 +1,57 @@
+#ifndef LLVM_CONSTANTS_H
+#define LLVM_CONSTANTS_H
+
+#include <llvm-c/Core.h>
+#include "../ast.h"
+#include "../llvm-codegen/llvm_codegen.h"
+
+/**
+ *  LLVM Static Literal Generics
+ *
+ * A literal that has to be passed around as a Generic* (a list element, a dict
+ * key or value) used to be boxed with franz_box_int/float/string every time
+ * the code ran, and list literals were rebuilt with franz_list_new. Literals
+ * never change, so they are emitted once as module globals laid out exactly
+ * like a Generic:
+ *
+ *   { i32 type, i64 payload, i32 refCount = GENERIC_IMMORTAL,
+ *     i8 isMutable = 0, i8 isInterned = 0 }
+ *
+ * A string literal's payload points into an immortal String global (see
+ * src/string-object), emitted with its length and hash.
+ *
+ * The refCount marks them immortal (see generic.h), so the runtime shares them
+ * instead of copying and never frees them. A list literal whose elements are
+ * all literals becomes a static trie (immortal ListNodes, see list.h), a
+ * static List and a static list Generic. Evaluating such a literal is a
+ * constant pointer: no call, no allocation.
+ *
+ * Globals are writable (the runtime may still bump the refCount) and private
+ * to the module. Int and float globals are shared by value within a module.
+ */
+
+/**
+ * Static immortal Generic for a literal node
+ *
+ * @param gen LLVM code generator context
+ * @param node OP_INT, OP_FLOAT, OP_STRING, or OP_LIST whose elements are all literals
+ * @return Constant i8* pointing at the Generic, or NULL if node is not a literal
+ */
+LLVMValueRef LLVMConstants_literal(LLVMCodeGen *gen, AstNode *node);
+
+/**
+ * Interned Generic for a string literal (see src/intern)
+ *
+ * Static literals are private to their module, so they cannot be the one
+ * interned copy of their text. Instead each site gets a slot global: the first
+ * evaluation passes the static literal to franz_intern and stores the result,
+ * later ones only load the slot. Dict keys, variant tags and match patterns
+ * use this, so their hash is never recomputed and equal ones share a pointer.
+ *
+ * @param gen LLVM code generator context, positioned inside a function
+ * @param raw The literal's source text (escapes are processed)
+ * @return i8* to the interned Generic (the builder ends in a new block)
+ */
+LLVMValueRef LLVMConstants_internedString(LLVMCodeGen *gen, const char *raw);
+
+#endif
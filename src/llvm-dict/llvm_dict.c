@@ -1,5 +1,7 @@
 #include "llvm_dict.h"
 #include "../llvm-codegen/llvm_codegen.h"
+#include "../llvm-constants/llvm_constants.h"  //  Static immortal literals
+#include "../trace/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -8,7 +10,7 @@
 // ============================================================================
 
 static void declareRuntimeDictFunctions(LLVMCodeGen *gen) {
-  // franz_dict_new(capacity: i32) -> ptr
+  // franz_dict_new(expected_size: i32) -> ptr
   if (!LLVMGetNamedFunction(gen->module, "franz_dict_new")) {
     LLVMTypeRef dictNewParams[] = {LLVMInt32TypeInContext(gen->context)};
     LLVMTypeRef dictNewType = LLVMFunctionType(
@@ -166,8 +168,8 @@ static void declareRuntimeDictFunctions(LLVMCodeGen *gen) {
 LLVMValueRef LLVMDict_compileDict(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
 
-  fprintf(stderr, "[DICT DEBUG] Compiling dict creation at line %d\n", lineNumber);
-  fprintf(stderr, "[DICT DEBUG] Number of arguments: %d\n", node->childCount - 1);
+  TRACE(TRACE_DICTS, "Compiling dict creation at line %d", lineNumber);
+  TRACE(TRACE_DICTS, "Number of arguments: %d", node->childCount - 1);
 
   // Validate even number of arguments (key-value pairs)
   int argCount = node->childCount - 1;  // Exclude function name
@@ -177,18 +179,11 @@ LLVMValueRef LLVMDict_compileDict(LLVMCodeGen *gen, AstNode *node, int lineNumbe
   }
 
   int pairCount = argCount / 2;
-  fprintf(stderr, "[DICT DEBUG] Creating dict with %d key-value pairs\n", pairCount);
+  TRACE(TRACE_DICTS, "Creating dict with %d key-value pairs", pairCount);
 
-  // Calculate initial capacity (next power of 2 >= pairCount * 2)
-  int capacity = 16;
-  while (capacity < pairCount * 2) {
-    capacity *= 2;
-  }
-  fprintf(stderr, "[DICT DEBUG] Dict capacity: %d\n", capacity);
-
-  // Create new dict
+  // Create new dict, pre-sized for all pairs so it never grows while being built
   LLVMValueRef dictNewFunc = LLVMGetNamedFunction(gen->module, "franz_dict_new");
-  LLVMValueRef capacityVal = LLVMConstInt(LLVMInt32TypeInContext(gen->context), capacity, 0);
+  LLVMValueRef capacityVal = LLVMConstInt(LLVMInt32TypeInContext(gen->context), pairCount, 0);
   LLVMValueRef dictPtr = LLVMBuildCall2(
     gen->builder,
     LLVMGlobalGetValueType(dictNewFunc),
@@ -198,70 +193,66 @@ LLVMValueRef LLVMDict_compileDict(LLVMCodeGen *gen, AstNode *node, int lineNumbe
     "dict_ptr"
   );
 
-  fprintf(stderr, "[DICT DEBUG] Dict created, adding %d pairs\n", pairCount);
+  TRACE(TRACE_DICTS, "Dict created, adding %d pairs", pairCount);
 
   // Add each key-value pair
   LLVMValueRef setInplaceFunc = LLVMGetNamedFunction(gen->module, "franz_dict_set_inplace");
 
-  // Get boxing functions
-  LLVMValueRef boxIntFunc = LLVMGetNamedFunction(gen->module, "franz_box_int");
-  LLVMValueRef boxStringFunc = LLVMGetNamedFunction(gen->module, "franz_box_string");
   LLVMTypeRef genericPtrType = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
 
   for (int i = 0; i < pairCount; i++) {
-    fprintf(stderr, "[DICT DEBUG] Processing pair %d/%d\n", i + 1, pairCount);
+    TRACE(TRACE_DICTS, "Processing pair %d/%d", i + 1, pairCount);
 
     // Compile key (at index i*2 + 1)
     AstNode *keyNode = node->children[i * 2 + 1];
-    LLVMValueRef keyValue = LLVMCodeGen_compileNode(gen, keyNode);
 
-    if (!keyValue) {
-      fprintf(stderr, "ERROR: Failed to compile dict key at index %d, line %d\n", i, lineNumber);
-      return NULL;
-    }
-
-    // Box key into Generic* based on type
+    // String literal keys are interned (hash computed once), integer literal keys
+    // are static immortal Generics, no boxing
     LLVMValueRef keyGeneric;
-    if (keyNode->opcode == OP_STRING) {
-      // String literal: keyValue is ptr (char*), box it
-      fprintf(stderr, "[DICT DEBUG] Boxing string key\n");
-      keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
-                                  boxStringFunc, &keyValue, 1, "key_boxed");
+    if (keyNode->opcode == OP_STRING && keyNode->val) {
+      TRACE(TRACE_DICTS, "Interned literal key");
+      keyGeneric = LLVMConstants_internedString(gen, keyNode->val);
     } else if (keyNode->opcode == OP_INT) {
-      // Integer literal: keyValue is i64, box it
-      fprintf(stderr, "[DICT DEBUG] Boxing integer key\n");
-      keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
-                                  boxIntFunc, &keyValue, 1, "key_boxed");
+      TRACE(TRACE_DICTS, "Static literal key");
+      keyGeneric = LLVMConstants_literal(gen, keyNode);
     } else {
-      // Variable or other: keyValue is already Generic* as i64, convert to ptr
-      fprintf(stderr, "[DICT DEBUG] Key is already boxed (i64 Generic*)\n");
-      keyGeneric = LLVMBuildIntToPtr(gen->builder, keyValue, genericPtrType, "key_ptr");
+      LLVMValueRef keyValue = LLVMCodeGen_compileNode(gen, keyNode);
+
+      if (!keyValue) {
+        fprintf(stderr, "ERROR: Failed to compile dict key at index %d, line %d\n", i, lineNumber);
+        return NULL;
+      }
+
+      if (LLVMGetTypeKind(LLVMTypeOf(keyValue)) == LLVMPointerTypeKind) {
+        // Runtime string (char*): box it; the text of an interned string boxes back to it
+        LLVMValueRef boxStringFunc = LLVMGetNamedFunction(gen->module, "franz_box_string");
+        keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
+                                    boxStringFunc, &keyValue, 1, "key_boxed");
+      } else {
+        // Variable or other: keyValue is already Generic* as i64, convert to ptr
+        TRACE(TRACE_DICTS, "Key is already boxed (i64 Generic*)");
+        keyGeneric = LLVMBuildIntToPtr(gen->builder, keyValue, genericPtrType, "key_ptr");
+      }
     }
 
     // Compile value (at index i*2 + 2)
     AstNode *valueNode = node->children[i * 2 + 2];
-    LLVMValueRef valueValue = LLVMCodeGen_compileNode(gen, valueNode);
-
-    if (!valueValue) {
-      fprintf(stderr, "ERROR: Failed to compile dict value at index %d, line %d\n", i, lineNumber);
-      return NULL;
-    }
 
-    // Box value into Generic* based on type
+    // String and integer literal values are static immortal Generics, no boxing
     LLVMValueRef valueGeneric;
-    if (valueNode->opcode == OP_STRING) {
-      // String literal: valueValue is ptr (char*), box it
-      fprintf(stderr, "[DICT DEBUG] Boxing string value\n");
-      valueGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
-                                    boxStringFunc, &valueValue, 1, "value_boxed");
-    } else if (valueNode->opcode == OP_INT) {
-      // Integer literal: valueValue is i64, box it
-      fprintf(stderr, "[DICT DEBUG] Boxing integer value\n");
-      valueGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
-                                    boxIntFunc, &valueValue, 1, "value_boxed");
+    if (valueNode->opcode == OP_STRING || valueNode->opcode == OP_INT) {
+      TRACE(TRACE_DICTS, "Static literal value");
+      valueGeneric = LLVMConstants_literal(gen, valueNode);
     } else {
+      LLVMValueRef valueValue = LLVMCodeGen_compileNode(gen, valueNode);
+
+      if (!valueValue) {
+        fprintf(stderr, "ERROR: Failed to compile dict value at index %d, line %d\n", i, lineNumber);
+        return NULL;
+      }
+
       // Variable or other: valueValue is already Generic* as i64, convert to ptr
-      fprintf(stderr, "[DICT DEBUG] Value is already boxed (i64 Generic*)\n");
+      TRACE(TRACE_DICTS, "Value is already boxed (i64 Generic*)");
       valueGeneric = LLVMBuildIntToPtr(gen->builder, valueValue, genericPtrType, "value_ptr");
     }
 
@@ -276,7 +267,7 @@ LLVMValueRef LLVMDict_compileDict(LLVMCodeGen *gen, AstNode *node, int lineNumbe
       ""
     );
 
-    fprintf(stderr, "[DICT DEBUG] Added pair %d: key and value set\n", i + 1);
+    TRACE(TRACE_DICTS, "Added pair %d: key and value set", i + 1);
   }
 
   // Box dict into Generic*
@@ -293,7 +284,7 @@ LLVMValueRef LLVMDict_compileDict(LLVMCodeGen *gen, AstNode *node, int lineNumbe
   // Convert Generic* to i64 for Universal Type System
   LLVMValueRef dictAsInt = LLVMBuildPtrToInt(gen->builder, dictGeneric, gen->intType, "dict_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] Dict creation complete, returning i64\n");
+  TRACE(TRACE_DICTS, "Dict creation complete, returning i64");
   return dictAsInt;
 }
 
@@ -304,7 +295,7 @@ LLVMValueRef LLVMDict_compileDict(LLVMCodeGen *gen, AstNode *node, int lineNumbe
 LLVMValueRef LLVMDict_compileDictGet(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
 
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_get at line %d\n", lineNumber);
+  TRACE(TRACE_DICTS, "Compiling dict_get at line %d", lineNumber);
 
   // Validate argument count
   if (node->childCount != 3) {  // func + dict + key
@@ -345,7 +336,7 @@ LLVMValueRef LLVMDict_compileDictGet(LLVMCodeGen *gen, AstNode *node, int lineNu
     return NULL;
   }
 
-  fprintf(stderr, "[DICT DEBUG] dict_get: key node opcode=%d\n", keyNode->opcode);
+  TRACE(TRACE_DICTS, "dict_get: key node opcode=%d", keyNode->opcode);
 
   // Get boxing functions
   LLVMValueRef boxIntFunc = LLVMGetNamedFunction(gen->module, "franz_box_int");
@@ -353,23 +344,31 @@ LLVMValueRef LLVMDict_compileDictGet(LLVMCodeGen *gen, AstNode *node, int lineNu
 
   // Box key into Generic* based on type (MUST match dict creation boxing)
   LLVMValueRef keyGeneric;
-  if (keyNode->opcode == OP_STRING) {
+  if (keyNode->opcode == OP_STRING && keyNode->val) {
+    // String literal: the interned Generic, same pointer as the literal keys of dict
+    TRACE(TRACE_DICTS, "dict_get: Interned string key");
+    keyGeneric = LLVMConstants_internedString(gen, keyNode->val);
+  } else if (keyNode->opcode == OP_STRING) {
     // String literal: keyValue is ptr (char*), box it
-    fprintf(stderr, "[DICT DEBUG] dict_get: Boxing string key\n");
+    TRACE(TRACE_DICTS, "dict_get: Boxing string key");
     keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
                                 boxStringFunc, &keyValue, 1, "key_boxed");
   } else if (keyNode->opcode == OP_INT) {
     // Integer literal: keyValue is i64, box it
-    fprintf(stderr, "[DICT DEBUG] dict_get: Boxing integer key\n");
+    TRACE(TRACE_DICTS, "dict_get: Boxing integer key");
     keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
                                 boxIntFunc, &keyValue, 1, "key_boxed");
+  } else if (LLVMGetTypeKind(LLVMTypeOf(keyValue)) == LLVMPointerTypeKind) {
+    // Runtime string (char*): box it; the text of an interned string boxes back to it
+    keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
+                                boxStringFunc, &keyValue, 1, "key_boxed");
   } else {
     // Variable or other: keyValue is already Generic* as i64, convert to ptr
-    fprintf(stderr, "[DICT DEBUG] dict_get: Key is already boxed (i64 Generic*)\n");
+    TRACE(TRACE_DICTS, "dict_get: Key is already boxed (i64 Generic*)");
     keyGeneric = LLVMBuildIntToPtr(gen->builder, keyValue, genericPtrType, "key_ptr");
   }
 
-  fprintf(stderr, "[DICT DEBUG] dict_get: Key boxed, calling franz_dict_get\n");
+  TRACE(TRACE_DICTS, "dict_get: Key boxed, calling franz_dict_get");
 
   // Call franz_dict_get(dict, key_generic) -> Generic*
   LLVMValueRef dictGetFunc = LLVMGetNamedFunction(gen->module, "franz_dict_get");
@@ -383,12 +382,12 @@ LLVMValueRef LLVMDict_compileDictGet(LLVMCodeGen *gen, AstNode *node, int lineNu
     "value_ptr"
   );
 
-  fprintf(stderr, "[DICT DEBUG] dict_get: franz_dict_get returned, converting to i64\n");
+  TRACE(TRACE_DICTS, "dict_get: franz_dict_get returned, converting to i64");
 
   // Convert Generic* to i64 for Universal Type System
   LLVMValueRef valueAsInt = LLVMBuildPtrToInt(gen->builder, valuePtr, gen->intType, "value_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_get complete\n");
+  TRACE(TRACE_DICTS, "dict_get complete");
   return valueAsInt;
 }
 
@@ -399,7 +398,7 @@ LLVMValueRef LLVMDict_compileDictGet(LLVMCodeGen *gen, AstNode *node, int lineNu
 LLVMValueRef LLVMDict_compileDictSet(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
 
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_set at line %d\n", lineNumber);
+  TRACE(TRACE_DICTS, "Compiling dict_set at line %d", lineNumber);
 
   // Validate argument count
   if (node->childCount != 4) {  // func + dict + key + value
@@ -439,18 +438,24 @@ LLVMValueRef LLVMDict_compileDictSet(LLVMCodeGen *gen, AstNode *node, int lineNu
     return NULL;
   }
 
-  fprintf(stderr, "[DICT DEBUG] dict_set: key node opcode=%d\n", keyNode->opcode);
+  TRACE(TRACE_DICTS, "dict_set: key node opcode=%d", keyNode->opcode);
   LLVMValueRef keyGeneric;
-  if (keyNode->opcode == OP_STRING) {
-    fprintf(stderr, "[DICT DEBUG] dict_set: Boxing string key\n");
+  if (keyNode->opcode == OP_STRING && keyNode->val) {
+    TRACE(TRACE_DICTS, "dict_set: Interned string key");
+    keyGeneric = LLVMConstants_internedString(gen, keyNode->val);
+  } else if (keyNode->opcode == OP_STRING) {
+    TRACE(TRACE_DICTS, "dict_set: Boxing string key");
     keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
                                 boxStringFunc, &keyValue, 1, "key_boxed");
   } else if (keyNode->opcode == OP_INT) {
-    fprintf(stderr, "[DICT DEBUG] dict_set: Boxing integer key\n");
+    TRACE(TRACE_DICTS, "dict_set: Boxing integer key");
     keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
                                 boxIntFunc, &keyValue, 1, "key_boxed");
+  } else if (LLVMGetTypeKind(LLVMTypeOf(keyValue)) == LLVMPointerTypeKind) {
+    keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
+                                boxStringFunc, &keyValue, 1, "key_boxed");
   } else {
-    fprintf(stderr, "[DICT DEBUG] dict_set: Key already boxed\n");
+    TRACE(TRACE_DICTS, "dict_set: Key already boxed");
     keyGeneric = LLVMBuildIntToPtr(gen->builder, keyValue, genericPtrType, "key_ptr");
   }
 
@@ -462,18 +467,18 @@ LLVMValueRef LLVMDict_compileDictSet(LLVMCodeGen *gen, AstNode *node, int lineNu
     return NULL;
   }
 
-  fprintf(stderr, "[DICT DEBUG] dict_set: value node opcode=%d\n", valueNode->opcode);
+  TRACE(TRACE_DICTS, "dict_set: value node opcode=%d", valueNode->opcode);
   LLVMValueRef valueGeneric;
   if (valueNode->opcode == OP_STRING) {
-    fprintf(stderr, "[DICT DEBUG] dict_set: Boxing string value\n");
+    TRACE(TRACE_DICTS, "dict_set: Boxing string value");
     valueGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
                                   boxStringFunc, &valueValue, 1, "value_boxed");
   } else if (valueNode->opcode == OP_INT) {
-    fprintf(stderr, "[DICT DEBUG] dict_set: Boxing integer value\n");
+    TRACE(TRACE_DICTS, "dict_set: Boxing integer value");
     valueGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
                                   boxIntFunc, &valueValue, 1, "value_boxed");
   } else {
-    fprintf(stderr, "[DICT DEBUG] dict_set: Value already boxed\n");
+    TRACE(TRACE_DICTS, "dict_set: Value already boxed");
     valueGeneric = LLVMBuildIntToPtr(gen->builder, valueValue, genericPtrType, "value_ptr");
   }
 
@@ -492,7 +497,7 @@ LLVMValueRef LLVMDict_compileDictSet(LLVMCodeGen *gen, AstNode *node, int lineNu
   // Convert Generic* to i64
   LLVMValueRef newDictAsInt = LLVMBuildPtrToInt(gen->builder, newDictPtr, gen->intType, "new_dict_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_set complete\n");
+  TRACE(TRACE_DICTS, "dict_set complete");
   return newDictAsInt;
 }
 
@@ -503,7 +508,7 @@ LLVMValueRef LLVMDict_compileDictSet(LLVMCodeGen *gen, AstNode *node, int lineNu
 LLVMValueRef LLVMDict_compileDictHas(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
 
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_has at line %d\n", lineNumber);
+  TRACE(TRACE_DICTS, "Compiling dict_has at line %d", lineNumber);
 
   if (node->childCount != 3) {
     fprintf(stderr, "ERROR: dict_has requires 2 arguments (dict, key) at line %d\n", lineNumber);
@@ -529,18 +534,24 @@ LLVMValueRef LLVMDict_compileDictHas(LLVMCodeGen *gen, AstNode *node, int lineNu
   LLVMValueRef keyValue = LLVMCodeGen_compileNode(gen, keyNode);
   if (!keyValue) return NULL;
 
-  fprintf(stderr, "[DICT DEBUG] dict_has: key node opcode=%d\n", keyNode->opcode);
+  TRACE(TRACE_DICTS, "dict_has: key node opcode=%d", keyNode->opcode);
   LLVMValueRef keyGeneric;
-  if (keyNode->opcode == OP_STRING) {
-    fprintf(stderr, "[DICT DEBUG] dict_has: Boxing string key\n");
+  if (keyNode->opcode == OP_STRING && keyNode->val) {
+    TRACE(TRACE_DICTS, "dict_has: Interned string key");
+    keyGeneric = LLVMConstants_internedString(gen, keyNode->val);
+  } else if (keyNode->opcode == OP_STRING) {
+    TRACE(TRACE_DICTS, "dict_has: Boxing string key");
     keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
                                 boxStringFunc, &keyValue, 1, "key_boxed");
   } else if (keyNode->opcode == OP_INT) {
-    fprintf(stderr, "[DICT DEBUG] dict_has: Boxing integer key\n");
+    TRACE(TRACE_DICTS, "dict_has: Boxing integer key");
     keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
                                 boxIntFunc, &keyValue, 1, "key_boxed");
+  } else if (LLVMGetTypeKind(LLVMTypeOf(keyValue)) == LLVMPointerTypeKind) {
+    keyGeneric = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
+                                boxStringFunc, &keyValue, 1, "key_boxed");
   } else {
-    fprintf(stderr, "[DICT DEBUG] dict_has: Key already boxed\n");
+    TRACE(TRACE_DICTS, "dict_has: Key already boxed");
     keyGeneric = LLVMBuildIntToPtr(gen->builder, keyValue, genericPtrType, "key_ptr");
   }
 
@@ -552,7 +563,7 @@ LLVMValueRef LLVMDict_compileDictHas(LLVMCodeGen *gen, AstNode *node, int lineNu
   // Extend i32 to i64
   LLVMValueRef hasResultI64 = LLVMBuildZExt(gen->builder, hasResult, gen->intType, "has_result_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_has complete\n");
+  TRACE(TRACE_DICTS, "dict_has complete");
   return hasResultI64;
 }
 
@@ -563,7 +574,7 @@ LLVMValueRef LLVMDict_compileDictHas(LLVMCodeGen *gen, AstNode *node, int lineNu
 LLVMValueRef LLVMDict_compileDictKeys(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
 
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_keys at line %d\n", lineNumber);
+  TRACE(TRACE_DICTS, "Compiling dict_keys at line %d", lineNumber);
 
   if (node->childCount != 2) {
     fprintf(stderr, "ERROR: dict_keys requires 1 argument (dict) at line %d\n", lineNumber);
@@ -600,14 +611,14 @@ LLVMValueRef LLVMDict_compileDictKeys(LLVMCodeGen *gen, AstNode *node, int lineN
   // Convert to i64
   LLVMValueRef listAsInt = LLVMBuildPtrToInt(gen->builder, listPtr, gen->intType, "list_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_keys complete\n");
+  TRACE(TRACE_DICTS, "dict_keys complete");
   return listAsInt;
 }
 
 LLVMValueRef LLVMDict_compileDictValues(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
 
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_values at line %d\n", lineNumber);
+  TRACE(TRACE_DICTS, "Compiling dict_values at line %d", lineNumber);
 
   if (node->childCount != 2) {
     fprintf(stderr, "ERROR: dict_values requires 1 argument (dict) at line %d\n", lineNumber);
@@ -644,7 +655,7 @@ LLVMValueRef LLVMDict_compileDictValues(LLVMCodeGen *gen, AstNode *node, int lin
   // Convert to i64
   LLVMValueRef listAsInt = LLVMBuildPtrToInt(gen->builder, listPtr, gen->intType, "list_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_values complete\n");
+  TRACE(TRACE_DICTS, "dict_values complete");
   return listAsInt;
 }
 
@@ -655,7 +666,7 @@ LLVMValueRef LLVMDict_compileDictValues(LLVMCodeGen *gen, AstNode *node, int lin
 LLVMValueRef LLVMDict_compileDictMerge(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
 
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_merge at line %d\n", lineNumber);
+  TRACE(TRACE_DICTS, "Compiling dict_merge at line %d", lineNumber);
 
   if (node->childCount != 3) {
     fprintf(stderr, "ERROR: dict_merge requires 2 arguments (dict1, dict2) at line %d\n", lineNumber);
@@ -687,7 +698,7 @@ LLVMValueRef LLVMDict_compileDictMerge(LLVMCodeGen *gen, AstNode *node, int line
   // Convert to i64
   LLVMValueRef mergedDictAsInt = LLVMBuildPtrToInt(gen->builder, mergedDictPtr, gen->intType, "merged_dict_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_merge complete\n");
+  TRACE(TRACE_DICTS, "dict_merge complete");
   return mergedDictAsInt;
 }
 
@@ -695,11 +706,11 @@ LLVMValueRef LLVMDict_compileDictMerge(LLVMCodeGen *gen, AstNode *node, int line
 // dict_map - Transform dictionary values
 // ============================================================================
 LLVMValueRef LLVMDict_compileDictMap(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_map at line %d\n", lineNumber);
-  fprintf(stderr, "[DICT DEBUG] Node childCount: %d\n", node->childCount);
+  TRACE(TRACE_DICTS, "Compiling dict_map at line %d", lineNumber);
+  TRACE(TRACE_DICTS, "Node childCount: %d", node->childCount);
 
   declareRuntimeDictFunctions(gen);
-  fprintf(stderr, "[DICT DEBUG] After declareRuntimeDictFunctions\n");
+  TRACE(TRACE_DICTS, "After declareRuntimeDictFunctions");
 
   // childCount should be 3: children[0]=function name, children[1]=dict, children[2]=closure
   if (node->childCount < 3) {
@@ -707,24 +718,24 @@ LLVMValueRef LLVMDict_compileDictMap(LLVMCodeGen *gen, AstNode *node, int lineNu
     return NULL;
   }
 
-  fprintf(stderr, "[DICT DEBUG] Creating genericPtrType\n");
+  TRACE(TRACE_DICTS, "Creating genericPtrType");
   LLVMTypeRef genericPtrType = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
 
-  fprintf(stderr, "[DICT DEBUG] Looking for franz_dict_map function\n");
+  TRACE(TRACE_DICTS, "Looking for franz_dict_map function");
   // Declare franz_dict_map(dict_generic, closure_generic, lineNumber) -> Generic*
   LLVMValueRef dictMapFunc = LLVMGetNamedFunction(gen->module, "franz_dict_map");
   if (!dictMapFunc) {
-    fprintf(stderr, "[DICT DEBUG] franz_dict_map not found, creating it\n");
+    TRACE(TRACE_DICTS, "franz_dict_map not found, creating it");
     LLVMTypeRef paramTypes[] = {genericPtrType, genericPtrType, gen->intType};
     LLVMTypeRef funcType = LLVMFunctionType(genericPtrType, paramTypes, 3, 0);
     dictMapFunc = LLVMAddFunction(gen->module, "franz_dict_map", funcType);
   }
-  fprintf(stderr, "[DICT DEBUG] franz_dict_map function ready\n");
+  TRACE(TRACE_DICTS, "franz_dict_map function ready");
 
   // Compile dict argument (returns i64)
   // NOTE: children[0] is the function name, actual args start at children[1]
   AstNode *dictNode = node->children[1];
-  fprintf(stderr, "[DICT DEBUG] Compiling dict argument (child 1: scores)\n");
+  TRACE(TRACE_DICTS, "Compiling dict argument (child 1: scores)");
 
   LLVMValueRef dictValue = LLVMCodeGen_compileNode(gen, dictNode);
   if (!dictValue) {
@@ -771,7 +782,7 @@ LLVMValueRef LLVMDict_compileDictMap(LLVMCodeGen *gen, AstNode *node, int lineNu
   // Convert result to i64
   LLVMValueRef newDictAsInt = LLVMBuildPtrToInt(gen->builder, newDictPtr, gen->intType, "new_dict_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_map complete\n");
+  TRACE(TRACE_DICTS, "dict_map complete");
   return newDictAsInt;
 }
 
@@ -780,7 +791,7 @@ LLVMValueRef LLVMDict_compileDictMap(LLVMCodeGen *gen, AstNode *node, int lineNu
 // ============================================================================
 LLVMValueRef LLVMDict_compileDictFilter(LLVMCodeGen *gen, AstNode *node, int lineNumber) {
   declareRuntimeDictFunctions(gen);
-  fprintf(stderr, "[DICT DEBUG] Compiling dict_filter at line %d\n", lineNumber);
+  TRACE(TRACE_DICTS, "Compiling dict_filter at line %d", lineNumber);
 
   // childCount should be 3: children[0]=function name, children[1]=dict, children[2]=closure
   if (node->childCount < 3) {
@@ -846,6 +857,6 @@ LLVMValueRef LLVMDict_compileDictFilter(LLVMCodeGen *gen, AstNode *node, int lin
   // Convert result to i64
   LLVMValueRef filteredDictAsInt = LLVMBuildPtrToInt(gen->builder, filteredDictPtr, gen->intType, "filtered_dict_as_i64");
 
-  fprintf(stderr, "[DICT DEBUG] dict_filter complete\n");
+  TRACE(TRACE_DICTS, "dict_filter complete");
   return filteredDictAsInt;
 }
@@ -1,5 +1,6 @@
 #include "llvm_filter.h"
 #include "../stdlib.h"
+#include "../llvm-callbacks/llvm_callbacks.h"
 #include <stdio.h>
 
 /**
@@ -18,6 +19,10 @@
  *
  * This matches the pattern used by map/reduce - runtime helper handles
  * the iteration and closure calling, LLVM just compiles the call.
+ *
+ * A predicate that is a top-level function literal or top-level function with
+ * int/float parameters and an int result (see llvm-callbacks) is called directly
+ * from a loop emitted in IR instead.
  */
 
 // Declare runtime filter helper function
@@ -49,6 +54,45 @@ static void ensureClosureBoxFunction(LLVMCodeGen *gen) {
   }
 }
 
+// Keep list[i] where predicate(list[i], i) is non-zero, for a predicate called directly
+static LLVMValueRef compileDirectFilter(LLVMCodeGen *gen, LLVMValueRef listValue,
+                                        LLVMCallback *predicate, int lineNumber) {
+  LLVMValueRef length = LLVMCallbacks_listLength(gen, listValue, "filter", lineNumber);
+  LLVMValueRef items = LLVMCallbacks_newItems(gen, length);
+  LLVMValueRef keptPtr = LLVMCallbacks_alloca(gen, gen->intType, "filter_kept");
+  LLVMBuildStore(gen->builder, LLVMConstInt(gen->intType, 0, 0), keptPtr);
+
+  LLVMCallbackLoop loop;
+  LLVMCallbacks_beginLoop(gen, length, &loop);
+
+  LLVMValueRef element = LLVMCallbacks_element(gen, listValue, loop.index);
+  LLVMValueRef args[] = { element, loop.index };
+  LLVMValueRef result = LLVMCallbacks_call(gen, predicate, args);
+  LLVMValueRef truthy = LLVMBuildICmp(gen->builder, LLVMIntNE, result,
+                                      LLVMConstInt(gen->intType, 0, 0), "filter_truthy");
+
+  LLVMBasicBlockRef keepBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction,
+                                                              "filter_keep");
+  LLVMBasicBlockRef nextBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction,
+                                                              "filter_next");
+  LLVMBuildCondBr(gen->builder, truthy, keepBlock, nextBlock);
+
+  // The element itself goes in the result (the new list takes its own reference)
+  LLVMPositionBuilderAtEnd(gen->builder, keepBlock);
+  LLVMValueRef kept = LLVMBuildLoad2(gen->builder, gen->intType, keptPtr, "kept");
+  LLVMValueRef slot = LLVMBuildGEP2(gen->builder, gen->genericType, items, &kept, 1, "filter_slot");
+  LLVMBuildStore(gen->builder, element, slot);
+  LLVMBuildStore(gen->builder, LLVMBuildAdd(gen->builder, kept, LLVMConstInt(gen->intType, 1, 0),
+                                            "kept_next"), keptPtr);
+  LLVMBuildBr(gen->builder, nextBlock);
+
+  LLVMPositionBuilderAtEnd(gen->builder, nextBlock);
+  LLVMCallbacks_endLoop(gen, &loop);
+
+  LLVMValueRef count = LLVMBuildLoad2(gen->builder, gen->intType, keptPtr, "filter_count");
+  return LLVMCallbacks_finishItems(gen, items, count);
+}
+
 LLVMValueRef LLVMFilter_compileFilter(LLVMCodeGen *gen, AstNode *node) {
   ensureRuntimeFilterFunction(gen);
   ensureClosureBoxFunction(gen);
@@ -68,14 +112,20 @@ LLVMValueRef LLVMFilter_compileFilter(LLVMCodeGen *gen, AstNode *node) {
     return NULL;
   }
 
-  // Compile predicate argument
-  LLVMValueRef predicateValue = LLVMCodeGen_compileNode(gen, node->children[1]);
+  // Compile predicate argument: (element) or (element, index)
+  LLVMCallback direct;
+  LLVMValueRef predicateValue = LLVMCallbacks_compile(gen, node->children[1], 1, 2, 1, &direct);
   if (!predicateValue) {
     fprintf(stderr, "ERROR: Failed to compile predicate argument for filter at line %d\n",
             node->lineNumber);
     return NULL;
   }
 
+  // Only an int result has a plain truthiness test (any boxed non-int counts as true at runtime)
+  if (direct.function && LLVMGetReturnType(direct.type) == gen->intType) {
+    return compileDirectFilter(gen, listValue, &direct, node->lineNumber);
+  }
+
   // Convert predicate i64 to Generic* using franz_box_closure
   // Industry-standard approach: ~30ns overhead, optimal for runtime boundary crossing
   LLVMTypeRef predicateType = LLVMTypeOf(predicateValue);
@@ -0,0 +1,129 @@
+#include "llvm_jit.h"
+#include <llvm-c/Error.h>
+#include <llvm-c/LLJIT.h>
+#include <llvm-c/Orc.h>
+#include <llvm-c/Target.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../time-report/time_report.h"
+
+/**
+ * LLVM In-Process JIT Execution
+ *
+ * ORC LLJIT is used through its C API (llvm-c/LLJIT.h, LLVM 12+). Unlike
+ * MCJIT it accepts prebuilt object files, and an unresolved runtime symbol
+ * comes back as an error instead of aborting the whole process.
+ */
+
+// Native target setup only needs to happen once per process
+static int jitInitialized = 0;
+
+static int LLVMJit_init(void) {
+  if (jitInitialized) return 0;
+
+  if (LLVMInitializeNativeTarget() != 0) {
+    fprintf(stderr, "ERROR: Failed to initialize native target for JIT\n");
+    return -1;
+  }
+  if (LLVMInitializeNativeAsmPrinter() != 0) {
+    fprintf(stderr, "ERROR: Failed to initialize native asm printer for JIT\n");
+    return -1;
+  }
+
+  jitInitialized = 1;
+  return 0;
+}
+
+// Print and consume an ORC error
+static void LLVMJit_reportError(const char *what, LLVMErrorRef error) {
+  char *message = LLVMGetErrorMessage(error);
+  fprintf(stderr, "ERROR: %s: %s\n", what, message);
+  LLVMDisposeErrorMessage(message);
+}
+
+LLVMMemoryBufferRef LLVMJit_emitObject(LLVMModuleRef module, LLVMTargetMachineRef tm) {
+  if (!module || !tm) return NULL;
+
+  char *error = NULL;
+  LLVMMemoryBufferRef object = NULL;
+  if (LLVMTargetMachineEmitToMemoryBuffer(tm, module, LLVMObjectFile, &error, &object)) {
+    fprintf(stderr, "ERROR: Failed to generate machine code: %s\n", error ? error : "unknown error");
+    if (error) LLVMDisposeMessage(error);
+    return NULL;
+  }
+  return object;
+}
+
+int LLVMJit_runObject(LLVMMemoryBufferRef object, int debug) {
+  if (!object) return 1;
+  if (LLVMJit_init() != 0) {
+    LLVMDisposeMemoryBuffer(object);
+    return 1;
+  }
+
+  LLVMOrcLLJITRef jit = NULL;
+  LLVMErrorRef error = LLVMOrcCreateLLJIT(&jit, LLVMOrcCreateLLJITBuilder());
+  if (error) {
+    LLVMJit_reportError("Failed to create JIT", error);
+    LLVMDisposeMemoryBuffer(object);
+    return 1;
+  }
+
+  // Resolve runtime calls against the symbols of the franz executable itself
+  LLVMOrcJITDylibRef mainDylib = LLVMOrcLLJITGetMainJITDylib(jit);
+  LLVMOrcDefinitionGeneratorRef processSymbols = NULL;
+  error = LLVMOrcCreateDynamicLibrarySearchGeneratorForProcess(
+      &processSymbols, LLVMOrcLLJITGetGlobalPrefix(jit), NULL, NULL);
+  if (error) {
+    LLVMJit_reportError("Failed to expose runtime symbols to JIT", error);
+    LLVMDisposeMemoryBuffer(object);
+    LLVMOrcDisposeLLJIT(jit);
+    return 1;
+  }
+  LLVMOrcJITDylibAddGenerator(mainDylib, processSymbols);
+
+  // The JIT takes ownership of the object buffer
+  TimeReport_begin("jit link");
+  error = LLVMOrcLLJITAddObjectFile(jit, mainDylib, object);
+  if (error) {
+    TimeReport_end("jit link");
+    LLVMJit_reportError("Failed to load compiled object into JIT", error);
+    LLVMOrcDisposeLLJIT(jit);
+    return 1;
+  }
+
+  // Looking up main() links the object; missing runtime symbols fail here
+  LLVMOrcExecutorAddress mainAddr = 0;
+  error = LLVMOrcLLJITLookup(jit, &mainAddr, "main");
+  TimeReport_end("jit link");
+  if (error) {
+    LLVMJit_reportError("JIT could not link main()", error);
+    fprintf(stderr, "Hint: rebuild franz with -rdynamic, or use --aot\n");
+    LLVMOrcDisposeLLJIT(jit);
+    return 1;
+  }
+
+  if (debug) {
+    printf("[DEBUG] JIT: calling main() at %p\n", (void *)(uintptr_t)mainAddr);
+  }
+
+  // Program output shares our stdio buffers, so flush compiler output first
+  fflush(stdout);
+
+  int (*mainFunc)(void) = (int (*)(void))(uintptr_t)mainAddr;
+  TimeReport_begin("run");
+  int exitCode = mainFunc();
+  TimeReport_end("run");
+
+  fflush(stdout);
+  fflush(stderr);
+
+  error = LLVMOrcDisposeLLJIT(jit);
+  if (error) {
+    LLVMJit_reportError("Failed to tear down JIT", error);
+  }
+
+  // Match the 8-bit exit status a native child process would report
+  return exitCode & 0xff;
+}
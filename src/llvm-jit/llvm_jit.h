@@ -0,0 +1,45 @@
+#ifndef LLVM_JIT_H
+#define LLVM_JIT_H
+
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+
+/**
+ * LLVM In-Process JIT Execution
+ *
+ * Runs the compiled Franz module inside the franz process instead of
+ * writing it to disk and going through llc + clang + system().
+ *
+ * The module is compiled to a relocatable object in memory with the same
+ * target machine the optimizer used (so -O/--cpu apply), and that object is
+ * linked into the process by ORC LLJIT. Working from an object rather than
+ * IR is what lets the build cache (src/build-cache) store the result and
+ * skip compilation entirely on the next run of an unchanged script.
+ *
+ * The generated code calls into the runtime (franz_* in stdlib.c, Dict_*,
+ * terminal/number helpers). Those are already linked into the franz binary,
+ * so the JIT resolves them against the running process (the executable is
+ * linked with -rdynamic so its symbols are visible to dlsym).
+ *
+ * Pattern: Similar to `lli`, Julia and LuaJIT - compile and call main()
+ */
+
+/**
+ * Compile an optimized module to a native object file in memory
+ *
+ * @param module Module with main(), triple/data layout set by LLVMOpt_optimizeModule
+ * @param tm Target machine the module was optimized for
+ * @return Object file buffer (caller owns it), or NULL on failure
+ */
+LLVMMemoryBufferRef LLVMJit_emitObject(LLVMModuleRef module, LLVMTargetMachineRef tm);
+
+/**
+ * Link an object file into the process and call its main() function
+ *
+ * @param object Object file from LLVMJit_emitObject() or the build cache (ownership is taken)
+ * @param debug Print JIT diagnostics
+ * @return Exit code returned by main(), or 1 if the object could not be linked
+ */
+int LLVMJit_runObject(LLVMMemoryBufferRef object, int debug);
+
+#endif // LLVM_JIT_H
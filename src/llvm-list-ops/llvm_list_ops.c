@@ -1,5 +1,6 @@
 #include "llvm_list_ops.h"
 #include "../stdlib.h"
+#include "../trace/trace.h"
 #include <stdio.h>
 
 /**
@@ -61,6 +62,20 @@ static void ensureRuntimeFunctions(LLVMCodeGen *gen) {
     LLVMTypeRef funcType = LLVMFunctionType(gen->intType, params, 1, 0);
     LLVMAddFunction(gen->module, "franz_is_list", funcType);
   }
+
+  // franz_list_range(i64 count, i64 lineNumber) -> Generic*
+  if (!LLVMGetNamedFunction(gen->module, "franz_list_range")) {
+    LLVMTypeRef params[] = { gen->intType, gen->intType };
+    LLVMTypeRef funcType = LLVMFunctionType(genericPtrType, params, 2, 0);
+    LLVMAddFunction(gen->module, "franz_list_range", funcType);
+  }
+
+  // franz_unbox_int(Generic*) -> i64
+  if (!LLVMGetNamedFunction(gen->module, "franz_unbox_int")) {
+    LLVMTypeRef params[] = { genericPtrType };
+    LLVMTypeRef funcType = LLVMFunctionType(gen->intType, params, 1, 0);
+    LLVMAddFunction(gen->module, "franz_unbox_int", funcType);
+  }
 }
 
 LLVMValueRef LLVMListOps_compileHead(LLVMCodeGen *gen, AstNode *node) {
@@ -113,6 +128,19 @@ LLVMValueRef LLVMListOps_compileTail(LLVMCodeGen *gen, AstNode *node) {
                         tailFunc, args, 1, "tail");
 }
 
+// Get or declare a franz_box_* function: list literals may compile to constants,
+// so nothing guarantees the boxing helpers were declared before cons needs them
+static LLVMValueRef getBoxFunction(LLVMCodeGen *gen, const char *name, LLVMTypeRef paramType) {
+  LLVMValueRef func = LLVMGetNamedFunction(gen->module, name);
+  if (!func) {
+    LLVMTypeRef genericPtrType = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
+    LLVMTypeRef params[] = { paramType };
+    LLVMTypeRef funcType = LLVMFunctionType(genericPtrType, params, 1, 0);
+    func = LLVMAddFunction(gen->module, name, funcType);
+  }
+  return func;
+}
+
 LLVMValueRef LLVMListOps_compileCons(LLVMCodeGen *gen, AstNode *node) {
   ensureRuntimeFunctions(gen);
 
@@ -140,13 +168,13 @@ LLVMValueRef LLVMListOps_compileCons(LLVMCodeGen *gen, AstNode *node) {
 
   if (typeKind == LLVMIntegerTypeKind) {
     // Integer: box with franz_box_int
-    LLVMValueRef boxIntFunc = LLVMGetNamedFunction(gen->module, "franz_box_int");
+    LLVMValueRef boxIntFunc = getBoxFunction(gen, "franz_box_int", gen->intType);
     LLVMValueRef boxArgs[] = { elemValue };
     boxedElem = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
                                 boxIntFunc, boxArgs, 1, "boxed_int");
   } else if (typeKind == LLVMDoubleTypeKind) {
     // Float: box with franz_box_float
-    LLVMValueRef boxFloatFunc = LLVMGetNamedFunction(gen->module, "franz_box_float");
+    LLVMValueRef boxFloatFunc = getBoxFunction(gen, "franz_box_float", gen->floatType);
     LLVMValueRef boxArgs[] = { elemValue };
     boxedElem = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxFloatFunc),
                                 boxFloatFunc, boxArgs, 1, "boxed_float");
@@ -154,7 +182,7 @@ LLVMValueRef LLVMListOps_compileCons(LLVMCodeGen *gen, AstNode *node) {
     // Check if it's a string literal (not already Generic*)
     AstNode *elemNode = node->children[0];
     if (elemNode->opcode == OP_STRING) {
-      LLVMValueRef boxStringFunc = LLVMGetNamedFunction(gen->module, "franz_box_string");
+      LLVMValueRef boxStringFunc = getBoxFunction(gen, "franz_box_string", gen->stringType);
       LLVMValueRef boxArgs[] = { elemValue };
       boxedElem = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
                                   boxStringFunc, boxArgs, 1, "boxed_string");
@@ -216,11 +244,11 @@ LLVMValueRef LLVMListOps_compileLength(LLVMCodeGen *gen, AstNode *node) {
   LLVMTypeRef listType = LLVMTypeOf(listValue);
   LLVMTypeKind listTypeKind = LLVMGetTypeKind(listType);
 
-  fprintf(stderr, "[LENGTH DEBUG] listValue type kind: %d (8=IntegerTypeKind, 10=PointerTypeKind)\n", listTypeKind);
+  TRACE(TRACE_LISTS, "length (compile): listValue type kind: %d (8=IntegerTypeKind, 10=PointerTypeKind)", listTypeKind);
 
   // If it's i64 (from dict_keys or other operations), convert to ptr
   if (listTypeKind == LLVMIntegerTypeKind) {
-    fprintf(stderr, "[LENGTH DEBUG] Converting i64 to ptr for franz_list_length\n");
+    TRACE(TRACE_LISTS, "length (compile): Converting i64 to ptr for franz_list_length");
     LLVMTypeRef genericPtrType = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
     listValue = LLVMBuildIntToPtr(gen->builder, listValue, genericPtrType, "list_ptr");
   }
@@ -258,3 +286,38 @@ LLVMValueRef LLVMListOps_compileNth(LLVMCodeGen *gen, AstNode *node) {
   return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(nthFunc),
                         nthFunc, args, 2, "nth");
 }
+
+LLVMValueRef LLVMListOps_compileRange(LLVMCodeGen *gen, AstNode *node) {
+  ensureRuntimeFunctions(gen);
+
+  // Expect 1 argument: (range n)
+  if (node->childCount != 1) {
+    fprintf(stderr, "ERROR: range expects 1 argument, got %d at line %d\n",
+            node->childCount, node->lineNumber);
+    return NULL;
+  }
+
+  LLVMValueRef countValue = LLVMCodeGen_compileNode(gen, node->children[0]);
+  if (!countValue) {
+    fprintf(stderr, "ERROR: Failed to compile range argument at line %d\n",
+            node->lineNumber);
+    return NULL;
+  }
+
+  // A boxed count (e.g. an element of a list) is unboxed first
+  if (LLVMGetTypeKind(LLVMTypeOf(countValue)) == LLVMPointerTypeKind) {
+    LLVMValueRef unboxFunc = LLVMGetNamedFunction(gen->module, "franz_unbox_int");
+    LLVMValueRef unboxArgs[] = { countValue };
+    countValue = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(unboxFunc),
+                                unboxFunc, unboxArgs, 1, "range_count");
+  } else if (LLVMTypeOf(countValue) != gen->intType) {
+    fprintf(stderr, "ERROR: range requires an integer count at line %d\n", node->lineNumber);
+    return NULL;
+  }
+
+  // Call franz_list_range(countValue, lineNumber)
+  LLVMValueRef rangeFunc = LLVMGetNamedFunction(gen->module, "franz_list_range");
+  LLVMValueRef args[] = { countValue, LLVMConstInt(gen->intType, node->lineNumber, 0) };
+  return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(rangeFunc),
+                        rangeFunc, args, 2, "range");
+}
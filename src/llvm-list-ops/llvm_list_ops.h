@@ -15,6 +15,7 @@
  * - empty?: Check if list is empty
  * - length: Get list length
  * - nth: Get element at index
+ * - range: List of 0 .. n - 1
  *
  * All operations work with heterogeneous lists (like Rust's Vec<Box<dyn Any>>)
  */
@@ -67,4 +68,12 @@ LLVMValueRef LLVMListOps_compileLength(LLVMCodeGen *gen, AstNode *node);
  */
 LLVMValueRef LLVMListOps_compileNth(LLVMCodeGen *gen, AstNode *node);
 
+/**
+ * Compile (range n) - list of 0 .. n - 1
+ * @param gen LLVM code generator context
+ * @param node AST node with function application
+ * @return LLVM value (Generic*)
+ */
+LLVMValueRef LLVMListOps_compileRange(LLVMCodeGen *gen, AstNode *node);
+
 #endif
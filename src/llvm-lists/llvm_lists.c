@@ -1,4 +1,5 @@
 #include "llvm_lists.h"
+#include "../llvm-constants/llvm_constants.h"  //  Static immortal literals
 #include "../stdlib.h"
 #include <stdio.h>
 
@@ -11,6 +12,9 @@
  * 3. Store Generic* pointers in an array (alloca)
  * 4. Call franz_list_new(Generic**, int) runtime function
  * 5. Return opaque pointer (i8*) to list Generic*
+ *
+ * A list made only of literals is emitted as static data instead (no calls),
+ * and literal elements of other lists use static Generics instead of boxing.
  */
 LLVMValueRef LLVMLists_compileList(LLVMCodeGen *gen, AstNode *node) {
   // Static counter for generating unique list variable names
@@ -22,6 +26,12 @@ LLVMValueRef LLVMLists_compileList(LLVMCodeGen *gen, AstNode *node) {
     return NULL;
   }
 
+  // All-literal list: a static immortal Generic, see llvm-constants
+  LLVMValueRef constantList = LLVMConstants_literal(gen, node);
+  if (constantList) {
+    return constantList;
+  }
+
   int elementCount = node->childCount;
 
   // Declare runtime boxing functions if not already declared
@@ -68,29 +78,23 @@ LLVMValueRef LLVMLists_compileList(LLVMCodeGen *gen, AstNode *node) {
     listNewFunc = LLVMAddFunction(gen->module, "franz_list_new", listNewType);
   }
 
-  // Empty list: []
-  if (elementCount == 0) {
-    // Call franz_list_new(NULL, 0)
-    LLVMTypeRef genericPtrPtrType = LLVMPointerType(genericPtrType, 0);
-    LLVMValueRef nullPtr = LLVMConstPointerNull(genericPtrPtrType);
-    LLVMValueRef zero = LLVMConstInt(gen->intType, 0, 0);
-    LLVMValueRef args[] = { nullPtr, zero };
-
-    // Generate unique name to avoid PHI node conflicts
-    char listName[32];
-    snprintf(listName, sizeof(listName), "list_%d", listCounter++);
-
-    return LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(listNewFunc),
-                          listNewFunc, args, 2, listName);
-  }
-
-  // Non-empty list: [elem1, elem2, ...]
+  // Non-empty list with at least one computed element (the empty list is a literal)
   // Allocate array for Generic* pointers
   LLVMValueRef arraySize = LLVMConstInt(gen->intType, elementCount, 0);
   LLVMValueRef array = LLVMBuildArrayAlloca(gen->builder, genericPtrType, arraySize, "list_array");
 
   // Compile and box each element
   for (int i = 0; i < elementCount; i++) {
+    // Literal element: store the static Generic, nothing to compile or box
+    LLVMValueRef constantElem = LLVMConstants_literal(gen, node->children[i]);
+    if (constantElem) {
+      LLVMValueRef indices[] = { LLVMConstInt(gen->intType, i, 0) };
+      LLVMValueRef elemPtr = LLVMBuildGEP2(gen->builder, genericPtrType, array,
+                                            indices, 1, "elem_ptr");
+      LLVMBuildStore(gen->builder, constantElem, elemPtr);
+      continue;
+    }
+
     // Compile child element
     LLVMValueRef elemValue = LLVMCodeGen_compileNode(gen, node->children[i]);
     if (!elemValue) {
@@ -0,0 +1,313 @@
+#include "llvm_lto.h"
+#include "../llvm-aot/llvm_aot.h"
+#include "../time-report/time_report.h"
+#include <llvm-c/BitReader.h>
+#include <llvm-c/Comdat.h>
+#include <llvm-c/Error.h>
+#include <llvm-c/Linker.h>
+#include <llvm-c/Transforms/PassBuilder.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * Cross-Module Inlining of the Franz Runtime (LTO)
+ *
+ * The runtime module is pruned before it is linked, so the optimizer only
+ * ever sees the handful of helpers the program can actually inline:
+ *
+ * 1. Pick candidates: runtime functions the program calls (and what those
+ *    call in turn), no larger than LLVM_LTO_MAX_INSTRUCTIONS, that reach no
+ *    mutable static variable (directly or through static helper functions)
+ * 2. Replace every other runtime function and global with a declaration
+ * 3. globaldce drops the static helpers nothing references any more
+ * 4. Candidates become available_externally, then LLVMLinkModules2
+ */
+
+// Small set of values, for the reachability walk
+typedef struct LLVMLtoValueSet {
+  LLVMValueRef *items;
+  int count;
+  int capacity;
+} LLVMLtoValueSet;
+
+// Add a value; returns 0 if it was already present
+static int LLVMLto_insert(LLVMLtoValueSet *set, LLVMValueRef value) {
+  for (int i = 0; i < set->count; i++) {
+    if (set->items[i] == value) return 0;
+  }
+  if (set->count == set->capacity) {
+    set->capacity = set->capacity ? set->capacity * 2 : 32;
+    set->items = realloc(set->items, sizeof(LLVMValueRef) * set->capacity);
+  }
+  set->items[set->count++] = value;
+  return 1;
+}
+
+static int LLVMLto_isLocal(LLVMValueRef global) {
+  LLVMLinkage linkage = LLVMGetLinkage(global);
+  return linkage == LLVMInternalLinkage || linkage == LLVMPrivateLinkage;
+}
+
+static int LLVMLto_bodyTouchesPrivateState(LLVMValueRef fn, LLVMLtoValueSet *visited);
+
+// 1 if a constant reaches a mutable static variable of the runtime.
+// Such code must keep running inside the runtime: an inlined copy would
+// get its own copy of the variable.
+static int LLVMLto_constantTouchesPrivateState(LLVMValueRef value, LLVMLtoValueSet *visited) {
+  if (LLVMIsAGlobalVariable(value)) {
+    if (!LLVMLto_isLocal(value)) return 0;   // Becomes a declaration: shared with the runtime
+    if (!LLVMIsGlobalConstant(value)) return 1;
+    if (!LLVMLto_insert(visited, value)) return 0;
+    LLVMValueRef init = LLVMGetInitializer(value);
+    return init ? LLVMLto_constantTouchesPrivateState(init, visited) : 0;
+  }
+  if (LLVMIsAFunction(value)) {
+    if (!LLVMLto_isLocal(value)) return 0;   // Called through the runtime's symbol
+    if (!LLVMLto_insert(visited, value)) return 0;
+    return LLVMLto_bodyTouchesPrivateState(value, visited);
+  }
+  if (LLVMIsAGlobalAlias(value)) return 1;   // Not worth following
+
+  int operandCount = LLVMGetNumOperands(value);
+  for (int i = 0; i < operandCount; i++) {
+    LLVMValueRef operand = LLVMGetOperand(value, i);
+    if (operand && LLVMIsAConstant(operand) && LLVMLto_constantTouchesPrivateState(operand, visited)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int LLVMLto_bodyTouchesPrivateState(LLVMValueRef fn, LLVMLtoValueSet *visited) {
+  for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block; block = LLVMGetNextBasicBlock(block)) {
+    for (LLVMValueRef inst = LLVMGetFirstInstruction(block); inst; inst = LLVMGetNextInstruction(inst)) {
+      int operandCount = LLVMGetNumOperands(inst);
+      for (int i = 0; i < operandCount; i++) {
+        LLVMValueRef operand = LLVMGetOperand(inst, i);
+        if (operand && LLVMIsAConstant(operand) && LLVMLto_constantTouchesPrivateState(operand, visited)) {
+          return 1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+static int LLVMLto_instructionCount(LLVMValueRef fn) {
+  int count = 0;
+  for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block; block = LLVMGetNextBasicBlock(block)) {
+    for (LLVMValueRef inst = LLVMGetFirstInstruction(block); inst; inst = LLVMGetNextInstruction(inst)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Should this runtime function be offered to the inliner?
+static int LLVMLto_isCandidate(LLVMModuleRef program, LLVMValueRef fn) {
+  if (LLVMIsDeclaration(fn) || LLVMLto_isLocal(fn)) return 0;
+
+  // The program's own definition wins
+  size_t nameLength = 0;
+  const char *name = LLVMGetValueName2(fn, &nameLength);
+  LLVMValueRef existing = LLVMGetNamedFunction(program, name);
+  if (existing && !LLVMIsDeclaration(existing)) return 0;
+
+  if (LLVMLto_instructionCount(fn) > LLVM_LTO_MAX_INSTRUCTIONS) return 0;
+
+  LLVMLtoValueSet visited = {0};
+  LLVMLto_insert(&visited, fn);
+  int touches = LLVMLto_bodyTouchesPrivateState(fn, &visited);
+  free(visited.items);
+  return !touches;
+}
+
+// Swap a runtime function or global for a fresh declaration of the same name.
+// A new value rather than an edited one: it carries none of the definition's
+// flags (dso_local, comdat, section), so references go through the symbol.
+static void LLVMLto_replaceWithDeclaration(LLVMModuleRef runtime, LLVMValueRef global) {
+  size_t nameLength = 0;
+  char *name = strdup(LLVMGetValueName2(global, &nameLength));
+  LLVMTypeRef type = LLVMGlobalGetValueType(global);
+
+  LLVMValueRef declaration;
+  if (LLVMIsAFunction(global)) {
+    declaration = LLVMAddFunction(runtime, "", type);
+  } else {
+    declaration = LLVMAddGlobal(runtime, type, "");
+    LLVMSetThreadLocal(declaration, LLVMIsThreadLocal(global));
+  }
+
+  LLVMReplaceAllUsesWith(global, declaration);
+  if (LLVMIsAFunction(global)) {
+    LLVMDeleteFunction(global);
+  } else {
+    LLVMDeleteGlobal(global);
+  }
+  LLVMSetValueName2(declaration, name, nameLength);
+  free(name);
+}
+
+// Reduce the runtime module to the inlining candidates
+static int LLVMLto_pruneRuntime(LLVMModuleRef program, LLVMModuleRef runtime, int debug) {
+  // Collect first: replacing values while walking the module list is unsafe
+  int capacity = 0;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(runtime); fn; fn = LLVMGetNextFunction(fn)) capacity++;
+  for (LLVMValueRef g = LLVMGetFirstGlobal(runtime); g; g = LLVMGetNextGlobal(g)) capacity++;
+
+  LLVMValueRef *keep = malloc(sizeof(LLVMValueRef) * (capacity + 1));
+  LLVMValueRef *drop = malloc(sizeof(LLVMValueRef) * (capacity + 1));
+  int keepCount = 0;
+  int dropCount = 0;
+
+  // Seed with the runtime functions the program calls, then follow calls
+  // from accepted candidates (franz_box_int -> Generic_new -> ...)
+  LLVMLtoValueSet considered = {0};
+  for (LLVMValueRef fn = LLVMGetFirstFunction(program); fn; fn = LLVMGetNextFunction(fn)) {
+    if (!LLVMIsDeclaration(fn)) continue;
+    size_t nameLength = 0;
+    LLVMValueRef definition = LLVMGetNamedFunction(runtime, LLVMGetValueName2(fn, &nameLength));
+    if (definition) LLVMLto_insert(&considered, definition);
+  }
+
+  for (int next = 0; next < considered.count; next++) {
+    LLVMValueRef fn = considered.items[next];
+    if (!LLVMLto_isCandidate(program, fn)) continue;
+    keep[keepCount++] = fn;
+
+    for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block; block = LLVMGetNextBasicBlock(block)) {
+      for (LLVMValueRef inst = LLVMGetFirstInstruction(block); inst; inst = LLVMGetNextInstruction(inst)) {
+        if (!LLVMIsACallInst(inst)) continue;
+        LLVMValueRef callee = LLVMGetCalledValue(inst);
+        if (LLVMIsAFunction(callee) && !LLVMIsDeclaration(callee) && !LLVMLto_isLocal(callee)) {
+          LLVMLto_insert(&considered, callee);
+        }
+      }
+    }
+  }
+
+  // Every other runtime definition becomes a declaration
+  for (LLVMValueRef fn = LLVMGetFirstFunction(runtime); fn; fn = LLVMGetNextFunction(fn)) {
+    if (LLVMIsDeclaration(fn) || LLVMLto_isLocal(fn)) continue;
+    int kept = 0;
+    for (int i = 0; i < keepCount && !kept; i++) kept = keep[i] == fn;
+    if (!kept) drop[dropCount++] = fn;
+  }
+  free(considered.items);
+
+  // Runtime variables live in the runtime only; the program refers to them by name
+  for (LLVMValueRef g = LLVMGetFirstGlobal(runtime); g; g = LLVMGetNextGlobal(g)) {
+    if (LLVMIsDeclaration(g) || LLVMLto_isLocal(g)) continue;
+    drop[dropCount++] = g;
+  }
+
+  for (int i = 0; i < dropCount; i++) {
+    size_t nameLength = 0;
+    const char *name = LLVMGetValueName2(drop[i], &nameLength);
+    if (strncmp(name, "llvm.", 5) == 0) {
+      // llvm.used / llvm.global_ctors: the runtime already ran its own constructors
+      LLVMDeleteGlobal(drop[i]);
+    } else {
+      LLVMLto_replaceWithDeclaration(runtime, drop[i]);
+    }
+  }
+  free(drop);
+
+  // Static helpers only the dropped definitions used go away here
+  LLVMPassBuilderOptionsRef options = LLVMCreatePassBuilderOptions();
+  LLVMErrorRef error = LLVMRunPasses(runtime, "globaldce", NULL, options);
+  LLVMDisposePassBuilderOptions(options);
+  if (error) {
+    char *message = LLVMGetErrorMessage(error);
+    fprintf(stderr, "ERROR: Failed to prune runtime bitcode: %s\n", message);
+    LLVMDisposeErrorMessage(message);
+    free(keep);
+    return -1;
+  }
+
+  // Inlinable, but never emitted: the runtime keeps the one real definition
+  for (int i = 0; i < keepCount; i++) {
+    LLVMSetLinkage(keep[i], LLVMAvailableExternallyLinkage);
+    LLVMSetComdat(keep[i], NULL);
+    if (debug) {
+      size_t nameLength = 0;
+      printf("[DEBUG] LTO: importing %s\n", LLVMGetValueName2(keep[i], &nameLength));
+    }
+  }
+  free(keep);
+
+  // The program module is retargeted by LLVMOpt_optimizeModule right after linking
+  LLVMSetTarget(runtime, "");
+  LLVMSetDataLayout(runtime, "");
+
+  return keepCount;
+}
+
+int LLVMLto_findRuntimeBitcode(char *path, size_t size) {
+  const char *override = getenv("FRANZ_RUNTIME_BC");
+  if (override && override[0] != '\0') {
+    snprintf(path, size, "%s", override);
+    return access(path, R_OK) == 0 ? 0 : -1;
+  }
+
+  char exePath[PATH_MAX];
+  if (LLVMAot_executablePath(exePath, sizeof(exePath)) != 0) return -1;
+
+  char *slash = strrchr(exePath, '/');
+  if (slash) *slash = '\0';
+
+  snprintf(path, size, "%s/%s", exePath, FRANZ_RUNTIME_BC_NAME);
+  return access(path, R_OK) == 0 ? 0 : -1;
+}
+
+int LLVMLto_linkRuntime(LLVMModuleRef module, int debug) {
+  char path[PATH_MAX];
+  if (LLVMLto_findRuntimeBitcode(path, sizeof(path)) != 0) {
+    if (debug) printf("[DEBUG] LTO: no %s, runtime calls stay opaque\n", FRANZ_RUNTIME_BC_NAME);
+    return 0;
+  }
+
+  TimeReport_begin("lto link");
+
+  LLVMMemoryBufferRef buffer = NULL;
+  char *message = NULL;
+  if (LLVMCreateMemoryBufferWithContentsOfFile(path, &buffer, &message)) {
+    fprintf(stderr, "ERROR: Failed to read %s: %s\n", path, message);
+    LLVMDisposeMessage(message);
+    TimeReport_end("lto link");
+    return -1;
+  }
+
+  LLVMModuleRef runtime = NULL;
+  int parseFailed = LLVMParseBitcodeInContext2(LLVMGetModuleContext(module), buffer, &runtime);
+  LLVMDisposeMemoryBuffer(buffer);
+  if (parseFailed) {
+    fprintf(stderr, "ERROR: %s is not valid bitcode for this LLVM version\n", path);
+    TimeReport_end("lto link");
+    return -1;
+  }
+
+  int imported = LLVMLto_pruneRuntime(module, runtime, debug);
+  if (imported <= 0) {
+    LLVMDisposeModule(runtime);
+    TimeReport_end("lto link");
+    return imported;
+  }
+
+  // Consumes the runtime module
+  if (LLVMLinkModules2(module, runtime)) {
+    fprintf(stderr, "ERROR: Failed to link runtime bitcode %s\n", path);
+    TimeReport_end("lto link");
+    return -1;
+  }
+
+  TimeReport_end("lto link");
+
+  if (debug) {
+    printf("[DEBUG] LTO: %d runtime functions available for inlining\n", imported);
+  }
+  return imported;
+}
@@ -0,0 +1,57 @@
+#ifndef LLVM_LTO_H
+#define LLVM_LTO_H
+
+#include <stddef.h>
+#include <llvm-c/Core.h>
+
+/**
+ * Cross-Module Inlining of the Franz Runtime (LTO)
+ *
+ * Generated code calls into the runtime for every box, unbox and type check
+ * (franz_box_int, franz_unbox_int, franz_generic_get_type, ...). Compiled
+ * separately, those calls are opaque to the optimizer. At -O1 and above the
+ * runtime's LLVM bitcode (libfranz_runtime.bc, built by `make` when clang is
+ * available) is linked into the program module before optimization:
+ *
+ * - Only runtime functions the program calls are imported, and only if they
+ *   are small and do not touch the runtime's private (static) state
+ * - Imported functions get available_externally linkage: the optimizer may
+ *   inline them, but no copy is emitted - calls that are not inlined still
+ *   go to the one runtime in the franz process (JIT) or libfranz_runtime.a
+ * - Runtime globals become declarations, so state is never duplicated
+ *
+ * Without the bitcode file this is a no-op and code generation is unchanged.
+ */
+
+// Runtime bitcode name, installed next to the franz executable
+#define FRANZ_RUNTIME_BC_NAME "libfranz_runtime.bc"
+
+// Larger runtime functions are left as calls (keeps -O2 compile time flat)
+#define LLVM_LTO_MAX_INSTRUCTIONS 200
+
+/**
+ * Locate the runtime bitcode
+ *
+ * Search order:
+ * 1. $FRANZ_RUNTIME_BC (explicit override)
+ * 2. libfranz_runtime.bc in the directory of the running franz executable
+ *
+ * @param path Output buffer for the bitcode path
+ * @param size Size of the output buffer
+ * @return 0 if found, -1 otherwise
+ */
+int LLVMLto_findRuntimeBitcode(char *path, size_t size);
+
+/**
+ * Link the runtime functions the module calls into it, for inlining
+ *
+ * Must run after LLVMCodeGen_compile and before LLVMOpt_optimizeModule.
+ *
+ * @param module Program module (same LLVM context is used for the runtime)
+ * @param debug Print what was imported
+ * @return Number of runtime functions imported, 0 if the bitcode is not
+ *         available, -1 if loading or linking it failed
+ */
+int LLVMLto_linkRuntime(LLVMModuleRef module, int debug);
+
+#endif // LLVM_LTO_H
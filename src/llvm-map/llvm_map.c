@@ -1,5 +1,6 @@
 #include "llvm_map.h"
 #include "../stdlib.h"
+#include "../llvm-callbacks/llvm_callbacks.h"
 #include <stdio.h>
 
 /**
@@ -18,6 +19,11 @@
  *
  * This matches the pattern used by filter - runtime helper handles
  * the iteration and closure calling, LLVM just compiles the call.
+ *
+ * When the callback is a top-level function literal or the name of a top-level
+ * function with int/float parameters (see llvm-callbacks), the loop is emitted
+ * in IR instead and calls the function directly, without boxing the closure or
+ * the index.
  */
 
 // Declare runtime map helper function
@@ -49,6 +55,25 @@ static void ensureClosureBoxFunction(LLVMCodeGen *gen) {
   }
 }
 
+// items[i] = box(callback(list[i], i)) for a callback called directly
+static LLVMValueRef compileDirectMap(LLVMCodeGen *gen, LLVMValueRef listValue,
+                                     LLVMCallback *callback, int lineNumber) {
+  LLVMValueRef length = LLVMCallbacks_listLength(gen, listValue, "map", lineNumber);
+  LLVMValueRef items = LLVMCallbacks_newItems(gen, length);
+
+  LLVMCallbackLoop loop;
+  LLVMCallbacks_beginLoop(gen, length, &loop);
+
+  LLVMValueRef args[] = { LLVMCallbacks_element(gen, listValue, loop.index), loop.index };
+  LLVMValueRef result = LLVMCallbacks_call(gen, callback, args);
+
+  LLVMValueRef slot = LLVMBuildGEP2(gen->builder, gen->genericType, items, &loop.index, 1, "map_slot");
+  LLVMBuildStore(gen->builder, LLVMCallbacks_box(gen, result), slot);
+
+  LLVMCallbacks_endLoop(gen, &loop);
+  return LLVMCallbacks_finishItems(gen, items, length);
+}
+
 LLVMValueRef LLVMMap_compileMap(LLVMCodeGen *gen, AstNode *node) {
   ensureRuntimeMapFunction(gen);
   ensureClosureBoxFunction(gen);
@@ -70,14 +95,19 @@ LLVMValueRef LLVMMap_compileMap(LLVMCodeGen *gen, AstNode *node) {
 
   LLVMTypeRef genericPtrType = LLVMPointerType(LLVMInt8TypeInContext(gen->context), 0);
 
-  // Compile callback argument
-  LLVMValueRef callbackValue = LLVMCodeGen_compileNode(gen, node->children[1]);
+  // Compile callback argument: (element) or (element, index)
+  LLVMCallback direct;
+  LLVMValueRef callbackValue = LLVMCallbacks_compile(gen, node->children[1], 1, 2, 1, &direct);
   if (!callbackValue) {
     fprintf(stderr, "ERROR: Failed to compile callback argument for map at line %d\n",
             node->lineNumber);
     return NULL;
   }
 
+  if (direct.function) {
+    return compileDirectMap(gen, listValue, &direct, node->lineNumber);
+  }
+
   int callbackIsGeneric = isGenericPointerNode(gen, node->children[1]);
   LLVMTypeRef callbackType = LLVMTypeOf(callbackValue);
 
@@ -3,6 +3,10 @@
 #include <string.h>
 #include "llvm_modules.h"
 #include "../file.h"
+#include "../module_cache.h"
+#include "../build-cache/build_cache.h"
+#include "../time-report/time_report.h"
+#include "../trace/trace.h"
 #include "../lex.h"
 #include "../parse.h"
 #include "../llvm-codegen/llvm_codegen.h"
@@ -153,6 +157,13 @@ void LLVMModules_clearCache(void) {
 // Helper Functions
 // ============================================================================
 
+// Record a module read from disk so the build cache can validate it later
+static void LLVMModules_recordDependency(const char *modulePath, const char *code) {
+  char *normalizedPath = ModuleCache_normalizePath(modulePath);
+  BuildCache_recordDependency(normalizedPath, code);
+  free(normalizedPath);
+}
+
 // Check if a function is a stdlib function (should be available to modules)
 static int isStdlibFunction(const char *name) {
   // IO functions
@@ -229,9 +240,7 @@ int LLVMModules_use(LLVMCodeGen *gen, const char *modulePath, int lineNumber) {
 
   // Check cache first
   if (LLVMModules_isCached(modulePath)) {
-    if (gen->debugMode) {
-      fprintf(stderr, "[DEBUG] Module '%s' already compiled (cached)\n", modulePath);
-    }
+    TRACE(TRACE_MODULES, "Module '%s' already compiled (cached)", modulePath);
 
     // Restore symbols from cache
     LLVMVariableMap *cachedSymbols = LLVMModules_getCached(modulePath);
@@ -250,19 +259,22 @@ int LLVMModules_use(LLVMCodeGen *gen, const char *modulePath, int lineNumber) {
   }
 
   // Not cached - load and compile the module
-  if (gen->debugMode) {
-    fprintf(stderr, "[DEBUG] Loading module '%s' (not cached)\n", modulePath);
-  }
+  TRACE(TRACE_MODULES, "Loading module '%s' (not cached)", modulePath);
 
   // Read the module file
+  TimeReport_beginModule(modulePath);
   char *code = readFile(modulePath, 1); // 1 = true for isModule
   if (!code) {
     fprintf(stderr, "ERROR: Failed to read module file '%s' at line %d\n",
             modulePath, lineNumber);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
 
+  // The compiled program depends on this module's contents (build cache key)
+  LLVMModules_recordDependency(modulePath, code);
+
   // Get file length for lexer
   int fileLength = strlen(code);
 
@@ -272,6 +284,7 @@ int LLVMModules_use(LLVMCodeGen *gen, const char *modulePath, int lineNumber) {
     fprintf(stderr, "ERROR: Failed to tokenize module '%s' at line %d\n",
             modulePath, lineNumber);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -283,6 +296,7 @@ int LLVMModules_use(LLVMCodeGen *gen, const char *modulePath, int lineNumber) {
             modulePath, lineNumber);
     TokenArray_free(tokens);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -303,6 +317,7 @@ int LLVMModules_use(LLVMCodeGen *gen, const char *modulePath, int lineNumber) {
     AstNode_free(ast);
     TokenArray_free(tokens);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -326,11 +341,10 @@ int LLVMModules_use(LLVMCodeGen *gen, const char *modulePath, int lineNumber) {
   free(code);
 
   // Pop from import stack after successful load
+  TimeReport_endModule(modulePath);
   LLVMModules_popImport(modulePath);
 
-  if (gen->debugMode) {
-    fprintf(stderr, "[DEBUG] Module '%s' loaded successfully\n", modulePath);
-  }
+  TRACE(TRACE_MODULES, "Module '%s' loaded successfully", modulePath);
 
   return 0;
 }
@@ -367,10 +381,7 @@ int LLVMModules_useAs(LLVMCodeGen *gen, const char *modulePath, const char *name
   snprintf(cacheKey, sizeof(cacheKey), "%s@%s", modulePath, namespaceName);
 
   if (LLVMModules_isCached(cacheKey)) {
-    if (gen->debugMode) {
-      fprintf(stderr, "[DEBUG] Module '%s' with namespace '%s' already compiled (cached)\n",
-              modulePath, namespaceName);
-    }
+    TRACE(TRACE_MODULES, "Module '%s' with namespace '%s' already compiled (cached)", modulePath, namespaceName);
 
     // Restore symbols from cache
     LLVMVariableMap *cachedSymbols = LLVMModules_getCached(cacheKey);
@@ -388,20 +399,22 @@ int LLVMModules_useAs(LLVMCodeGen *gen, const char *modulePath, const char *name
   }
 
   // Not cached - load and compile the module
-  if (gen->debugMode) {
-    fprintf(stderr, "[DEBUG] Loading module '%s' into namespace '%s' (not cached)\n",
-            modulePath, namespaceName);
-  }
+  TRACE(TRACE_MODULES, "Loading module '%s' into namespace '%s' (not cached)", modulePath, namespaceName);
 
   // Read the module file
+  TimeReport_beginModule(modulePath);
   char *code = readFile(modulePath, 1);
   if (!code) {
     fprintf(stderr, "ERROR: Failed to read module file '%s' at line %d\n",
             modulePath, lineNumber);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
 
+  // The compiled program depends on this module's contents (build cache key)
+  LLVMModules_recordDependency(modulePath, code);
+
   // Get file length for lexer
   int fileLength = strlen(code);
 
@@ -411,6 +424,7 @@ int LLVMModules_useAs(LLVMCodeGen *gen, const char *modulePath, const char *name
     fprintf(stderr, "ERROR: Failed to tokenize module '%s' at line %d\n",
             modulePath, lineNumber);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -422,6 +436,7 @@ int LLVMModules_useAs(LLVMCodeGen *gen, const char *modulePath, const char *name
             modulePath, lineNumber);
     TokenArray_free(tokens);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -474,6 +489,7 @@ int LLVMModules_useAs(LLVMCodeGen *gen, const char *modulePath, const char *name
     AstNode_free(ast);
     TokenArray_free(tokens);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -547,12 +563,10 @@ int LLVMModules_useAs(LLVMCodeGen *gen, const char *modulePath, const char *name
   free(code);
 
   // Pop from import stack after successful load
+  TimeReport_endModule(modulePath);
   LLVMModules_popImport(modulePath);
 
-  if (gen->debugMode) {
-    fprintf(stderr, "[DEBUG] Module '%s' loaded into namespace '%s' successfully\n",
-            modulePath, namespaceName);
-  }
+  TRACE(TRACE_MODULES, "Module '%s' loaded into namespace '%s' successfully", modulePath, namespaceName);
 
   return 0;
 }
@@ -586,23 +600,25 @@ int LLVMModules_useWith(LLVMCodeGen *gen, const char **capabilities, int capabil
     return -1;
   }
 
-  if (gen->debugMode) {
-    fprintf(stderr, "[DEBUG] Loading module '%s' with %d capabilities\n",
-            modulePath, capabilityCount);
-    for (int i = 0; i < capabilityCount; i++) {
-      fprintf(stderr, "[DEBUG]   - %s\n", capabilities[i]);
-    }
+  TRACE(TRACE_MODULES, "Loading module '%s' with %d capabilities", modulePath, capabilityCount);
+  for (int i = 0; i < capabilityCount; i++) {
+    TRACE(TRACE_MODULES, "  - %s", capabilities[i]);
   }
 
   // Read the module file
+  TimeReport_beginModule(modulePath);
   char *code = readFile(modulePath, 1);
   if (!code) {
     fprintf(stderr, "ERROR: Failed to read module file '%s' at line %d\n",
             modulePath, lineNumber);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
 
+  // The compiled program depends on this module's contents (build cache key)
+  LLVMModules_recordDependency(modulePath, code);
+
   // Get file length for lexer
   int fileLength = strlen(code);
 
@@ -612,6 +628,7 @@ int LLVMModules_useWith(LLVMCodeGen *gen, const char **capabilities, int capabil
     fprintf(stderr, "ERROR: Failed to tokenize module '%s' at line %d\n",
             modulePath, lineNumber);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -623,6 +640,7 @@ int LLVMModules_useWith(LLVMCodeGen *gen, const char **capabilities, int capabil
             modulePath, lineNumber);
     TokenArray_free(tokens);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -807,6 +825,7 @@ int LLVMModules_useWith(LLVMCodeGen *gen, const char **capabilities, int capabil
     AstNode_free(ast);
     TokenArray_free(tokens);
     free(code);
+    TimeReport_endModule(modulePath);
     LLVMModules_popImport(modulePath);
     return -1;
   }
@@ -844,11 +863,10 @@ int LLVMModules_useWith(LLVMCodeGen *gen, const char **capabilities, int capabil
   free(code);
 
   // Pop from import stack after successful load
+  TimeReport_endModule(modulePath);
   LLVMModules_popImport(modulePath);
 
-  if (gen->debugMode) {
-    fprintf(stderr, "[DEBUG] Module '%s' loaded with restricted capabilities\n", modulePath);
-  }
+  TRACE(TRACE_MODULES, "Module '%s' loaded with restricted capabilities", modulePath);
 
   return 0;
 }
@@ -0,0 +1,304 @@
+#include "llvm_monomorphize.h"
+#include "../type-inference/type_infer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Monomorphization of Polymorphic Functions
+ *
+ * A clone is compiled from the function's AST node (gen->functionNodes) the way
+ * LLVMCodeGen_compileFunction_impl compiles the generic version, with the
+ * parameters bound to the argument types instead of i64. Its return type is the
+ * type the body actually returns. Clones are named <generic>.mono.<signature>,
+ * one letter per argument (i for i64, f for double), and looked up by that name,
+ * so a recursive call inside a clone reaches the clone itself.
+ */
+
+#define MONOMORPHIZE_DEFAULT_CLONES 8
+#define MONOMORPHIZE_MAX_PARAMS 16
+#define MONOMORPHIZE_MAX_DEPTH 8   // Calls followed looking for a polymorphic result
+
+// FRANZ_MONO_CLONES: clones per function (0 compiles every call as before, to compare)
+static int cloneLimit(void) {
+  static int limit = -1;
+  if (limit < 0) {
+    const char *env = getenv("FRANZ_MONO_CLONES");
+    limit = env ? atoi(env) : MONOMORPHIZE_DEFAULT_CLONES;
+    if (limit < 0) limit = 0;
+  }
+  return limit;
+}
+
+static int countParams(AstNode *node) {
+  int paramCount = 0;
+  while (paramCount < node->childCount && node->children[paramCount]->opcode == OP_IDENTIFIER) {
+    paramCount++;
+  }
+  return paramCount;
+}
+
+// The expression the function's last statement returns
+static AstNode *returnedExpression(AstNode *node) {
+  AstNode *body = node->children[node->childCount - 1];
+  if (body && body->opcode == OP_STATEMENT && body->childCount > 0) {
+    body = body->children[body->childCount - 1];
+  }
+  if (body && body->opcode == OP_RETURN && body->childCount > 0) {
+    body = body->children[0];
+  }
+  return body;
+}
+
+// Whether name is a parameter of the function or assigned in its body
+static int isLocal(AstNode *node, const char *name) {
+  int paramCount = countParams(node);
+  for (int i = 0; i < paramCount; i++) {
+    if (strcmp(node->children[i]->val, name) == 0) return 1;
+  }
+  AstNode *body = node->children[node->childCount - 1];
+  for (int i = 0; body && body->opcode == OP_STATEMENT && i < body->childCount; i++) {
+    AstNode *statement = body->children[i];
+    if (statement->opcode == OP_ASSIGNMENT && statement->childCount > 0 &&
+        statement->children[0]->val && strcmp(statement->children[0]->val, name) == 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// POLYMORPHIC_INFERRED: the generic version returns whatever its body does;
+// POLYMORPHIC_CALLS: it returns the type inference gave it, so even all-int
+// calls need a clone (spread = {x -> <- (subtract (clamp x 0.5 1.5) 1)})
+enum { POLYMORPHIC_NO, POLYMORPHIC_INFERRED, POLYMORPHIC_CALLS };
+
+static int isPolymorphic(LLVMCodeGen *gen, AstNode *node, int depth);
+
+// Whether expression calls a polymorphic user function other than self
+static int callsPolymorphic(LLVMCodeGen *gen, AstNode *expression, AstNode *self, int depth) {
+  if (!expression || expression->opcode == OP_FUNCTION) return 0;
+  if (expression->opcode == OP_APPLICATION && expression->childCount > 0 &&
+      expression->children[0]->opcode == OP_IDENTIFIER && expression->children[0]->val) {
+    AstNode *callee = (AstNode *) LLVMVariableMap_get(gen->functionNodes, expression->children[0]->val);
+    if (callee && callee != self && isPolymorphic(gen, callee, depth - 1)) return 1;
+  }
+  for (int i = 0; i < expression->childCount; i++) {
+    if (callsPolymorphic(gen, expression->children[i], self, depth)) return 1;
+  }
+  return 0;
+}
+
+static int isPolymorphic(LLVMCodeGen *gen, AstNode *node, int depth) {
+  AstNode *returned = returnedExpression(node);
+  if (!returned || returned->opcode == OP_FUNCTION) return POLYMORPHIC_NO;  // A closure factory
+
+  // The result of calling a local closure or a function parameter is a boxed
+  // Generic*, which the generic version hands back as it is
+  if (returned->opcode == OP_APPLICATION && returned->childCount > 0 &&
+      returned->children[0]->opcode == OP_IDENTIFIER && returned->children[0]->val &&
+      isLocal(node, returned->children[0]->val)) {
+    return POLYMORPHIC_NO;
+  }
+
+  InferredFunctionType *inferred = TypeInfer_inferFunction(node);
+  if (!inferred) return POLYMORPHIC_NO;
+  int polymorphic = inferred->returnType == INFER_TYPE_UNKNOWN;
+  TypeInfer_freeInferredType(inferred);
+  if (polymorphic) return POLYMORPHIC_INFERRED;
+
+  // Inference reads (max a b) as the builtin even where max is a user function
+  // (stdlib/math.franz): clamp = {value low high -> <- (max low (min high value))}
+  // is as polymorphic as the max it returns, and so is (add (clamp x 0 1) 1)
+  return depth > 0 && callsPolymorphic(gen, returned, node, depth) ? POLYMORPHIC_CALLS : POLYMORPHIC_NO;
+}
+
+// Give function a new return type, moving its body over (recursive calls included)
+static LLVMValueRef retype(LLVMCodeGen *gen, LLVMValueRef function, LLVMTypeRef returnType,
+                           LLVMTypeRef *paramTypes, int paramCount, const char *name) {
+  LLVMTypeRef type = LLVMFunctionType(returnType, paramTypes, paramCount, 0);
+  LLVMValueRef retyped = LLVMAddFunction(gen->module, "", type);
+  LLVMSetLinkage(retyped, LLVMGetLinkage(function));
+
+  unsigned attributeCount = LLVMGetAttributeCountAtIndex(function, LLVMAttributeFunctionIndex);
+  if (attributeCount > 0) {
+    LLVMAttributeRef *attributes = malloc(sizeof(LLVMAttributeRef) * attributeCount);
+    LLVMGetAttributesAtIndex(function, LLVMAttributeFunctionIndex, attributes);
+    for (unsigned i = 0; i < attributeCount; i++) {
+      LLVMAddAttributeAtIndex(retyped, LLVMAttributeFunctionIndex, attributes[i]);
+    }
+    free(attributes);
+  }
+
+  for (int i = 0; i < paramCount; i++) {
+    LLVMReplaceAllUsesWith(LLVMGetParam(function, i), LLVMGetParam(retyped, i));
+  }
+  LLVMReplaceAllUsesWith(function, LLVMConstBitCast(retyped, LLVMTypeOf(function)));
+
+  LLVMBasicBlockRef block;
+  while ((block = LLVMGetFirstBasicBlock(function)) != NULL) {
+    LLVMRemoveBasicBlockFromParent(block);
+    LLVMAppendExistingBasicBlock(retyped, block);
+  }
+
+  LLVMDeleteFunction(function);
+  LLVMSetValueName2(retyped, name, strlen(name));
+  return retyped;
+}
+
+// Compile node again with its parameters of paramTypes; NULL if the body doesn't compile
+static LLVMValueRef compileClone(LLVMCodeGen *gen, AstNode *node, const char *functionName,
+                                 const char *cloneName, LLVMTypeRef *paramTypes, int paramCount) {
+  // Start from the type an arithmetic body would return; the body decides below
+  LLVMTypeRef returnType = gen->intType;
+  for (int i = 0; i < paramCount; i++) {
+    if (paramTypes[i] == gen->floatType) returnType = gen->floatType;
+  }
+
+  LLVMValueRef function = LLVMAddFunction(gen->module, cloneName,
+                                          LLVMFunctionType(returnType, paramTypes, paramCount, 0));
+  LLVMSetLinkage(function, LLVMInternalLinkage);
+
+  LLVMBasicBlockRef prevBlock = LLVMGetInsertBlock(gen->builder);
+  LLVMValueRef prevFunction = gen->currentFunction;
+  LLVMVariableMap *prevVars = gen->variables;
+  LLVMVariableMap *prevParamTypeTags = gen->paramTypeTags;
+  const char *prevFunctionName = gen->currentFunctionName;
+  int prevIsPolymorphic = gen->isPolymorphicFunction;
+  int prevTailPosition = gen->inTailPosition;
+  int prevClosureTag = gen->currentClosureReturnTag;
+  LLVMBasicBlockRef prevLoopExit = gen->loopExitBlock;
+  LLVMBasicBlockRef prevLoopIncr = gen->loopIncrBlock;
+  LLVMValueRef prevLoopReturn = gen->loopReturnPtr;
+  LLVMTypeRef prevLoopReturnType = gen->loopReturnType;
+
+  LLVMPositionBuilderAtEnd(gen->builder, LLVMAppendBasicBlockInContext(gen->context, function, "entry"));
+  gen->currentFunction = function;
+  gen->variables = LLVMVariableMap_new();
+  gen->paramTypeTags = NULL;
+  gen->currentFunctionName = functionName;
+  gen->isPolymorphicFunction = 1;  // Return values keep their own type
+  gen->inTailPosition = 0;
+  gen->currentClosureReturnTag = -1;
+  gen->loopExitBlock = NULL;  // A call from inside a loop body: <- returns from the clone
+  gen->loopIncrBlock = NULL;
+  gen->loopReturnPtr = NULL;
+  gen->loopReturnType = NULL;
+
+  for (int i = 0; i < paramCount; i++) {
+    LLVMVariableMap_set(gen->variables, node->children[i]->val, LLVMGetParam(function, i));
+  }
+
+  LLVMValueRef bodyValue = NULL;
+  for (int i = paramCount; i < node->childCount; i++) {
+    bodyValue = LLVMCodeGen_compileNode(gen, node->children[i]);
+    if (!bodyValue) break;
+  }
+
+  if (bodyValue) {
+    LLVMValueRef terminator = LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(gen->builder));
+    LLVMTypeRef actualReturnType = NULL;
+    if (!terminator) {
+      actualReturnType = LLVMTypeOf(bodyValue);
+    } else if (LLVMIsAReturnInst(terminator) && LLVMGetNumOperands(terminator) > 0) {
+      actualReturnType = LLVMTypeOf(LLVMGetOperand(terminator, 0));
+    }
+
+    if (actualReturnType && actualReturnType != returnType) {
+      function = retype(gen, function, actualReturnType, paramTypes, paramCount, cloneName);
+    }
+    if (!terminator) {
+      LLVMBuildRet(gen->builder, bodyValue);
+    }
+  }
+
+  LLVMVariableMap_free(gen->variables);
+  gen->variables = prevVars;
+  gen->paramTypeTags = prevParamTypeTags;
+  gen->currentFunction = prevFunction;
+  gen->currentFunctionName = prevFunctionName;
+  gen->isPolymorphicFunction = prevIsPolymorphic;
+  gen->inTailPosition = prevTailPosition;
+  gen->currentClosureReturnTag = prevClosureTag;
+  gen->loopExitBlock = prevLoopExit;
+  gen->loopIncrBlock = prevLoopIncr;
+  gen->loopReturnPtr = prevLoopReturn;
+  gen->loopReturnType = prevLoopReturnType;
+  if (prevBlock) {
+    LLVMPositionBuilderAtEnd(gen->builder, prevBlock);
+  }
+
+  if (!bodyValue) {
+    LLVMDeleteFunction(function);
+    return NULL;
+  }
+  return function;
+}
+
+LLVMValueRef LLVMMonomorphize_function(LLVMCodeGen *gen, const char *name, LLVMValueRef *args,
+                                       int argCount) {
+  if (cloneLimit() == 0 || !name || argCount == 0 || argCount > MONOMORPHIZE_MAX_PARAMS) return NULL;
+
+  // A top-level function whose body has been compiled (not just forward-declared)
+  LLVMValueRef generic = LLVMVariableMap_get(gen->functions, name);
+  AstNode *node = (AstNode *) LLVMVariableMap_get(gen->functionNodes, name);
+  if (!generic || !node || !LLVMIsAFunction(generic) || LLVMCountBasicBlocks(generic) == 0) return NULL;
+
+  LLVMTypeRef genericType = LLVMGlobalGetValueType(generic);
+  int paramCount = countParams(node);
+  if (paramCount != argCount || (int) LLVMCountParamTypes(genericType) != argCount) return NULL;
+  int polymorphic = isPolymorphic(gen, node, MONOMORPHIZE_MAX_DEPTH);
+  if (polymorphic == POLYMORPHIC_NO) return NULL;
+
+  LLVMTypeRef genericParams[MONOMORPHIZE_MAX_PARAMS];
+  LLVMTypeRef paramTypes[MONOMORPHIZE_MAX_PARAMS];
+  char signature[MONOMORPHIZE_MAX_PARAMS + 1];
+  int matchesGeneric = 1;
+  int hasFloat = 0;
+  LLVMGetParamTypes(genericType, genericParams);
+  for (int i = 0; i < argCount; i++) {
+    paramTypes[i] = LLVMTypeOf(args[i]);
+    if (paramTypes[i] == gen->intType) {
+      signature[i] = 'i';
+    } else if (paramTypes[i] == gen->floatType) {
+      signature[i] = 'f';
+      hasFloat = 1;
+    } else {
+      return NULL;
+    }
+    if (paramTypes[i] != genericParams[i]) matchesGeneric = 0;
+  }
+  signature[argCount] = '\0';
+
+  if (matchesGeneric && polymorphic == POLYMORPHIC_INFERRED) return generic;
+
+  const char *genericName = LLVMGetValueName(generic);
+  char cloneName[256];
+  snprintf(cloneName, sizeof(cloneName), "%s.mono.%s", genericName, signature);
+  LLVMValueRef clone = LLVMGetNamedFunction(gen->module, cloneName);
+  if (clone) return clone;
+
+  int cloneCount = (int)(intptr_t) LLVMVariableMap_get(gen->specializations, genericName);
+  if (cloneCount >= cloneLimit()) {
+    // Past the limit the call widens to the all-float clone, its int arguments
+    // converted (an all-int call to the all-int clone). Both are outside the
+    // limit, so a function has at most limit + 2 clones and no call is
+    // truncated to the generic version's i64 parameters.
+    for (int i = 0; i < argCount; i++) {
+      if (hasFloat && paramTypes[i] == gen->intType) {
+        args[i] = LLVMBuildSIToFP(gen->builder, args[i], gen->floatType, "itof");
+        paramTypes[i] = gen->floatType;
+      }
+      signature[i] = hasFloat ? 'f' : 'i';
+    }
+    snprintf(cloneName, sizeof(cloneName), "%s.mono.%s", genericName, signature);
+    clone = LLVMGetNamedFunction(gen->module, cloneName);
+    if (clone) return clone;
+  } else {
+    LLVMVariableMap_set(gen->specializations, genericName, (LLVMValueRef)(intptr_t)(cloneCount + 1));
+  }
+
+  if (gen->debugMode) {
+    fprintf(stderr, "[MONOMORPHIZE] %s(%s) → %s\n", name, signature, cloneName);
+  }
+  return compileClone(gen, node, name, cloneName, paramTypes, paramCount);
+}
@@ -0,0 +1,51 @@
+#ifndef LLVM_MONOMORPHIZE_H
+#define LLVM_MONOMORPHIZE_H
+
+#include <llvm-c/Core.h>
+#include "../llvm-codegen/llvm_codegen.h"
+
+/**
+ * Monomorphization of Polymorphic Functions
+ *
+ * A top-level function whose return type inference leaves UNKNOWN is compiled
+ * once, with every parameter an i64:
+ *
+ *   max = {a b -> <- (if (greater_than a b) {<- a} {<- b})}
+ *
+ *   define i64 @_franz_lambda_0(i64, i64)
+ *
+ * so (max 2.5 1.5) truncated its arguments to 2 and 1, and in main the call
+ * went through max's closure. When such a function is called with ints or
+ * floats, it is now compiled again for those argument types and the call made
+ * directly to that clone:
+ *
+ *   (max 2.5 1.5)      → define internal double @_franz_lambda_0.mono.ff(double, double)
+ *   (clamp 0.5 0 1)    → @_franz_lambda_2.mono.fii, which calls max / min clones in turn
+ *
+ * A function returning a call to a polymorphic function (clamp, which inference
+ * types as returning an int) counts as polymorphic too. The generic version of
+ * one inference left UNKNOWN is already the all-int instance, so all-int calls
+ * to it use it without a clone. Each function gets at most FRANZ_MONO_CLONES
+ * clones (default 8) for the argument types of its calls; a later combination
+ * with a float argument calls the all-float clone, its int arguments converted,
+ * and an all-int one the all-int clone. FRANZ_MONO_CLONES=0 turns
+ * monomorphization off.
+ */
+
+/**
+ * Function to call for (name args...), specialized for the argument types
+ *
+ * @param gen LLVM code generator context
+ * @param name Franz name of the called function
+ * @param args Compiled arguments; int arguments are converted in place when the
+ *        call widens to the all-float clone
+ * @param argCount Number of arguments
+ * @return The generic function (when the arguments are already its parameter
+ *         types) or a clone whose parameter types are exactly those of args;
+ *         NULL if the call should be compiled as before (not a polymorphic
+ *         top-level function, or an argument that is not an int or a float)
+ */
+LLVMValueRef LLVMMonomorphize_function(LLVMCodeGen *gen, const char *name, LLVMValueRef *args,
+                                       int argCount);
+
+#endif // LLVM_MONOMORPHIZE_H
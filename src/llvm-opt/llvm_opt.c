@@ -0,0 +1,129 @@
+#include "llvm_opt.h"
+#include <llvm-c/Error.h>
+#include <llvm-c/Target.h>
+#include <llvm-c/Transforms/PassBuilder.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * LLVM Optimization Pipeline
+ *
+ * Uses the LLVM-C new pass manager entry point (LLVMRunPasses), available
+ * since LLVM 13, so the same code works on the LLVM 14-17 we build against.
+ */
+
+// Map -O level to the code generation level used by llc/JIT
+static LLVMCodeGenOptLevel LLVMOpt_codeGenLevel(int optLevel) {
+  switch (optLevel) {
+    case 0:  return LLVMCodeGenLevelNone;
+    case 1:  return LLVMCodeGenLevelLess;
+    case 2:  return LLVMCodeGenLevelDefault;
+    default: return LLVMCodeGenLevelAggressive;
+  }
+}
+
+LLVMTargetMachineRef LLVMOpt_createTargetMachine(const char *cpu, int optLevel) {
+  if (LLVMInitializeNativeTarget() != 0 || LLVMInitializeNativeAsmPrinter() != 0) {
+    fprintf(stderr, "ERROR: Failed to initialize native target\n");
+    return NULL;
+  }
+
+  char *triple = LLVMGetDefaultTargetTriple();
+  char *error = NULL;
+  LLVMTargetRef target = NULL;
+  if (LLVMGetTargetFromTriple(triple, &target, &error)) {
+    fprintf(stderr, "ERROR: No LLVM target for %s: %s\n", triple, error);
+    LLVMDisposeMessage(error);
+    LLVMDisposeMessage(triple);
+    return NULL;
+  }
+
+  // "host" (default): tune for and use every feature of the running CPU
+  char *cpuName = NULL;
+  char *features = NULL;
+  if (cpu == NULL || strcmp(cpu, "host") == 0) {
+    cpuName = LLVMGetHostCPUName();
+    features = LLVMGetHostCPUFeatures();
+  }
+
+  LLVMTargetMachineRef tm = LLVMCreateTargetMachine(
+      target, triple,
+      cpuName ? cpuName : cpu,
+      features ? features : "",
+      LLVMOpt_codeGenLevel(optLevel),
+      LLVMRelocPIC,
+      LLVMCodeModelDefault);
+
+  if (cpuName) LLVMDisposeMessage(cpuName);
+  if (features) LLVMDisposeMessage(features);
+  LLVMDisposeMessage(triple);
+
+  if (!tm) {
+    fprintf(stderr, "ERROR: Failed to create target machine for CPU '%s'\n", cpu ? cpu : "host");
+  }
+  return tm;
+}
+
+// Tag defined functions with the CPU the module was optimized for, so code
+// generation (JIT or llc) does not silently fall back to a generic CPU
+static void LLVMOpt_setFunctionTarget(LLVMModuleRef module, LLVMTargetMachineRef tm) {
+  LLVMContextRef context = LLVMGetModuleContext(module);
+  char *cpu = LLVMGetTargetMachineCPU(tm);
+  char *features = LLVMGetTargetMachineFeatureString(tm);
+
+  LLVMAttributeRef cpuAttr = LLVMCreateStringAttribute(
+      context, "target-cpu", 10, cpu, (unsigned)strlen(cpu));
+  LLVMAttributeRef featuresAttr = LLVMCreateStringAttribute(
+      context, "target-features", 15, features, (unsigned)strlen(features));
+
+  for (LLVMValueRef fn = LLVMGetFirstFunction(module); fn; fn = LLVMGetNextFunction(fn)) {
+    if (LLVMIsDeclaration(fn)) continue;
+    LLVMAddAttributeAtIndex(fn, LLVMAttributeFunctionIndex, cpuAttr);
+    if (features[0] != '\0') {
+      LLVMAddAttributeAtIndex(fn, LLVMAttributeFunctionIndex, featuresAttr);
+    }
+  }
+
+  LLVMDisposeMessage(cpu);
+  LLVMDisposeMessage(features);
+}
+
+int LLVMOpt_optimizeModule(LLVMModuleRef module, LLVMTargetMachineRef tm, int optLevel) {
+  if (!module || !tm) return -1;
+
+  // Triple + data layout first: the optimizer's cost models depend on them
+  char *triple = LLVMGetTargetMachineTriple(tm);
+  LLVMSetTarget(module, triple);
+  LLVMDisposeMessage(triple);
+
+  LLVMTargetDataRef dataLayout = LLVMCreateTargetDataLayout(tm);
+  char *layout = LLVMCopyStringRepOfTargetData(dataLayout);
+  LLVMSetDataLayout(module, layout);
+  LLVMDisposeMessage(layout);
+  LLVMDisposeTargetData(dataLayout);
+
+  LLVMOpt_setFunctionTarget(module, tm);
+
+  if (optLevel <= 0) return 0;
+  if (optLevel > LLVM_OPT_MAX_LEVEL) optLevel = LLVM_OPT_MAX_LEVEL;
+
+  char pipeline[32];
+  snprintf(pipeline, sizeof(pipeline), "default<O%d>", optLevel);
+
+  LLVMPassBuilderOptionsRef options = LLVMCreatePassBuilderOptions();
+  LLVMPassBuilderOptionsSetLoopVectorization(options, optLevel >= 2);
+  LLVMPassBuilderOptionsSetSLPVectorization(options, optLevel >= 2);
+  LLVMPassBuilderOptionsSetLoopUnrolling(options, 1);
+
+  LLVMErrorRef error = LLVMRunPasses(module, pipeline, tm, options);
+  LLVMDisposePassBuilderOptions(options);
+
+  if (error) {
+    char *message = LLVMGetErrorMessage(error);
+    fprintf(stderr, "ERROR: Optimization pipeline %s failed: %s\n", pipeline, message);
+    LLVMDisposeErrorMessage(message);
+    return -1;
+  }
+
+  return 0;
+}
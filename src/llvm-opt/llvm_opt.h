@@ -0,0 +1,47 @@
+#ifndef LLVM_OPT_H
+#define LLVM_OPT_H
+
+#include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
+
+/**
+ * LLVM Optimization Pipeline
+ *
+ * Runs the new pass manager (`default<O1>`, `default<O2>`, ...) over the
+ * module produced by LLVMCodeGen_compile before it is JIT-compiled or
+ * written out for llc. This is what turns the per-variable allocas into
+ * SSA values, folds franz_box_int/franz_unbox_int round trips through
+ * constants, and lets loops from LLVMCodeGen_compileLoop vectorize.
+ *
+ * Pattern: Same as `clang -O2` / `rustc -C opt-level=2`
+ */
+
+// Highest supported -O level
+#define LLVM_OPT_MAX_LEVEL 3
+
+/**
+ * Create a target machine for the host triple
+ *
+ * @param cpu "host" (default when NULL) for the running CPU and its features,
+ *            "generic" for a portable baseline, or an explicit LLVM CPU name
+ * @param optLevel 0-3, used as the code generation level
+ * @return Target machine (dispose with LLVMDisposeTargetMachine), NULL on error
+ */
+LLVMTargetMachineRef LLVMOpt_createTargetMachine(const char *cpu, int optLevel);
+
+/**
+ * Prepare a module for the target and run the optimization pipeline
+ *
+ * Sets the module triple and data layout from the target machine and tags
+ * every defined function with its target-cpu/target-features, so the JIT
+ * and llc generate code for the same CPU the optimizer assumed. At -O0 no
+ * passes run.
+ *
+ * @param module Verified module to optimize in place
+ * @param tm Target machine from LLVMOpt_createTargetMachine
+ * @param optLevel 0-3
+ * @return 0 on success, -1 if the pass pipeline failed
+ */
+int LLVMOpt_optimizeModule(LLVMModuleRef module, LLVMTargetMachineRef tm, int optLevel);
+
+#endif // LLVM_OPT_H
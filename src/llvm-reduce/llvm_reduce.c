@@ -1,5 +1,6 @@
 #include "llvm_reduce.h"
 #include "../stdlib.h"
+#include "../llvm-callbacks/llvm_callbacks.h"
 #include <stdio.h>
 
 /**
@@ -20,6 +21,11 @@
  *
  * This matches the pattern used by map/filter - runtime helper handles
  * the iteration and closure calling, LLVM just compiles the call.
+ *
+ * When the callback is a top-level function literal or top-level function with
+ * int/float parameters (see llvm-callbacks) and the initial value is an int or
+ * float, the loop is emitted in IR instead: the accumulator stays unboxed in a
+ * local and is boxed once, after the last element.
  */
 
 // Declare runtime reduce helper function
@@ -64,6 +70,28 @@ static void ensureBoxIntFunction(LLVMCodeGen *gen) {
   }
 }
 
+// acc = callback(acc, list[i], i) with an unboxed accumulator, for a callback called directly
+static LLVMValueRef compileDirectReduce(LLVMCodeGen *gen, LLVMValueRef listValue,
+                                        LLVMCallback *callback, LLVMValueRef initialValue,
+                                        int lineNumber) {
+  LLVMTypeRef accType = LLVMCallbacks_paramType(callback, 0);
+  LLVMValueRef length = LLVMCallbacks_listLength(gen, listValue, "reduce", lineNumber);
+  LLVMValueRef accPtr = LLVMCallbacks_alloca(gen, accType, "reduce_acc");
+  LLVMBuildStore(gen->builder, LLVMCallbacks_convert(gen, initialValue, accType), accPtr);
+
+  LLVMCallbackLoop loop;
+  LLVMCallbacks_beginLoop(gen, length, &loop);
+
+  LLVMValueRef acc = LLVMBuildLoad2(gen->builder, accType, accPtr, "acc");
+  LLVMValueRef args[] = { acc, LLVMCallbacks_element(gen, listValue, loop.index), loop.index };
+  LLVMBuildStore(gen->builder, LLVMCallbacks_call(gen, callback, args), accPtr);
+
+  LLVMCallbacks_endLoop(gen, &loop);
+
+  LLVMValueRef result = LLVMBuildLoad2(gen->builder, accType, accPtr, "reduce_value");
+  return LLVMCallbacks_box(gen, result);
+}
+
 LLVMValueRef LLVMReduce_compileReduce(LLVMCodeGen *gen, AstNode *node) {
   ensureRuntimeReduceFunction(gen);
   ensureClosureBoxFunction(gen);
@@ -84,14 +112,33 @@ LLVMValueRef LLVMReduce_compileReduce(LLVMCodeGen *gen, AstNode *node) {
     return NULL;
   }
 
-  // Compile callback argument
-  LLVMValueRef callbackValue = LLVMCodeGen_compileNode(gen, node->children[1]);
+  // Compile callback argument: (acc, element) or (acc, element, index)
+  LLVMCallback direct;
+  LLVMValueRef callbackValue = LLVMCallbacks_compile(gen, node->children[1], 2, 3, 2, &direct);
   if (!callbackValue) {
     fprintf(stderr, "ERROR: Failed to compile callback argument for reduce at line %d\n",
             node->lineNumber);
     return NULL;
   }
 
+  // Compile optional initial accumulator argument
+  LLVMValueRef initialValue = NULL;
+  if (node->childCount == 3) {
+    initialValue = LLVMCodeGen_compileNode(gen, node->children[2]);
+    if (!initialValue) {
+      fprintf(stderr, "ERROR: Failed to compile initial argument for reduce at line %d\n",
+              node->lineNumber);
+      return NULL;
+    }
+  }
+
+  // Direct call: the accumulator starts from a number of the callback's type and keeps it
+  if (direct.function && initialValue &&
+      LLVMTypeOf(initialValue) == LLVMCallbacks_paramType(&direct, 0) &&
+      LLVMGetReturnType(direct.type) == LLVMCallbacks_paramType(&direct, 0)) {
+    return compileDirectReduce(gen, listValue, &direct, initialValue, node->lineNumber);
+  }
+
   // Convert callback i64 to Generic* using franz_box_closure
   LLVMTypeRef callbackType = LLVMTypeOf(callbackValue);
   if (LLVMGetTypeKind(callbackType) == LLVMIntegerTypeKind) {
@@ -107,23 +154,11 @@ LLVMValueRef LLVMReduce_compileReduce(LLVMCodeGen *gen, AstNode *node) {
                                     boxFunc, boxArgs, 1, "callback_boxed");
   }
 
-  // Compile optional initial accumulator argument
-  LLVMValueRef initialValue;
-  if (node->childCount == 3) {
-    initialValue = LLVMCodeGen_compileNode(gen, node->children[2]);
-    if (!initialValue) {
-      fprintf(stderr, "ERROR: Failed to compile initial argument for reduce at line %d\n",
-              node->lineNumber);
-      return NULL;
-    }
-
-    // Box the initial value if it's an integer
+  if (initialValue) {
+    // Box the initial value if it's an integer or a float
     LLVMTypeRef initialType = LLVMTypeOf(initialValue);
-    if (LLVMGetTypeKind(initialType) == LLVMIntegerTypeKind) {
-      LLVMValueRef boxIntFunc = LLVMGetNamedFunction(gen->module, "franz_box_int");
-      LLVMValueRef boxArgs[] = { initialValue };
-      initialValue = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxIntFunc),
-                                     boxIntFunc, boxArgs, 1, "initial_boxed");
+    if (initialType == gen->intType || initialType == gen->floatType) {
+      initialValue = LLVMCallbacks_box(gen, initialValue);
     }
   } else {
     // No initial value provided - pass NULL (runtime will use void)
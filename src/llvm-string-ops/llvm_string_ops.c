@@ -13,14 +13,15 @@
  * Strategy:
  * 1. Unbox Generic* to check runtime type (TYPE_STRING or TYPE_LIST)
  * 2. Branch based on type:
- *    - TYPE_STRING: LLVM-native substring extraction (pure LLVM IR)
- *    - TYPE_LIST: Call franz_list_nth for element access
- * 3. Return result (char* for strings, Generic* for lists)
+ *    - TYPE_STRING: Call franz_string_slice (a single char is the slice [i, i+1))
+ *    - TYPE_LIST: Call franz_list_nth for element access, franz_list_slice for a range
+ * 3. Return the result as a Generic*
  *
  * Performance Characteristics:
- * - String single char: ~15 LLVM instructions (malloc, GEP, load, store)
- * - String substring: ~25 LLVM instructions + loop (still C-level speed)
+ * - String literal: LLVM-native extraction from the constant (pure LLVM IR)
+ * - String value: one bounds-checked memcpy into a new String (franz_string_slice)
  * - List element: Direct memory access via franz_list_nth
+ * - List slice: O(1) view sharing the list's trie (franz_list_slice), no copy
  */
 LLVMValueRef LLVMStringOps_compileGet(LLVMCodeGen *gen, AstNode *node) {
   if (node->childCount < 2 || node->childCount > 3) {
@@ -143,7 +144,7 @@ LLVMValueRef LLVMStringOps_compileGet(LLVMCodeGen *gen, AstNode *node) {
     collection = LLVMBuildIntToPtr(gen->builder, collection, genericPtrType, "collection_ptr");
   }
 
-  // Use runtime functions to get type and p_val from Generic*
+  // Use the runtime to get the type of the Generic*
   // franz_generic_get_type(Generic*) -> i32
   LLVMValueRef getTypeFunc = LLVMGetNamedFunction(gen->module, "franz_generic_get_type");
   if (!getTypeFunc) {
@@ -152,12 +153,14 @@ LLVMValueRef LLVMStringOps_compileGet(LLVMCodeGen *gen, AstNode *node) {
     getTypeFunc = LLVMAddFunction(gen->module, "franz_generic_get_type", getTypeType);
   }
 
-  // franz_generic_get_pval(Generic*) -> void*
-  LLVMValueRef getPvalFunc = LLVMGetNamedFunction(gen->module, "franz_generic_get_pval");
-  if (!getPvalFunc) {
-    LLVMTypeRef getPvalParams[] = {genericPtrType};
-    LLVMTypeRef getPvalType = LLVMFunctionType(genericPtrType, getPvalParams, 1, 0);
-    getPvalFunc = LLVMAddFunction(gen->module, "franz_generic_get_pval", getPvalType);
+  // End index, compiled once here so both the string and the list branch can use it
+  LLVMValueRef end = NULL;
+  if (node->childCount == 3) {
+    end = LLVMCodeGen_compileNode(gen, node->children[2]);
+    if (!end) {
+      fprintf(stderr, "ERROR: Failed to compile get end argument at line %d\n", node->lineNumber);
+      return NULL;
+    }
   }
 
   // Call runtime functions
@@ -165,10 +168,6 @@ LLVMValueRef LLVMStringOps_compileGet(LLVMCodeGen *gen, AstNode *node) {
   LLVMValueRef typeValue = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(getTypeFunc),
                                          getTypeFunc, typeArgs, 1, "type_value");
 
-  LLVMValueRef pvalArgs[] = {collection};
-  LLVMValueRef pValPtr = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(getPvalFunc),
-                                       getPvalFunc, pvalArgs, 1, "p_val_ptr");
-
   // Create basic blocks for type branching
   LLVMBasicBlockRef stringBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction, "get_string");
   LLVMBasicBlockRef listBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction, "get_list");
@@ -190,135 +189,58 @@ LLVMValueRef LLVMStringOps_compileGet(LLVMCodeGen *gen, AstNode *node) {
                                      "is_list");
   LLVMBuildCondBr(gen->builder, isList, listBlock, errorBlock);
 
-  // ========== STRING BLOCK: LLVM-Native Substring Extraction ==========
+  // ========== STRING BLOCK: Call franz_string_slice ==========
   LLVMPositionBuilderAtEnd(gen->builder, stringBlock);
 
-  // pValPtr points to char** (double pointer for strings)
-  // Dereference to get char*
-  LLVMValueRef stringPtrPtr = LLVMBuildBitCast(gen->builder, pValPtr,
-                                               LLVMPointerType(gen->stringType, 0),
-                                               "string_ptr_ptr");
-  LLVMValueRef stringPtr = LLVMBuildLoad2(gen->builder, gen->stringType,
-                                         stringPtrPtr, "string_ptr");
-
-  LLVMValueRef stringResult;
-  if (node->childCount == 2) {
-    // Single character: (get "hello" 0) → "h"
-    LLVMValueRef two = LLVMConstInt(gen->intType, 2, 0);
-    LLVMValueRef mallocArgs[] = {two};
-    LLVMValueRef buffer = LLVMBuildCall2(gen->builder, gen->mallocType, gen->mallocFunc,
-                                        mallocArgs, 1, "char_buffer");
-
-    // Load character at index
-    LLVMValueRef charPtr = LLVMBuildGEP2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                        stringPtr, &start, 1, "char_ptr");
-    LLVMValueRef charValue = LLVMBuildLoad2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                           charPtr, "char_value");
-
-    // Store character in buffer[0]
-    LLVMValueRef zero = LLVMConstInt(gen->intType, 0, 0);
-    LLVMValueRef bufferCharPtr = LLVMBuildGEP2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                               buffer, &zero, 1, "buffer_char_ptr");
-    LLVMBuildStore(gen->builder, charValue, bufferCharPtr);
-
-    // Store null terminator in buffer[1]
-    LLVMValueRef one = LLVMConstInt(gen->intType, 1, 0);
-    LLVMValueRef nullPtr = LLVMBuildGEP2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                        buffer, &one, 1, "null_ptr");
-    LLVMValueRef nullChar = LLVMConstInt(LLVMInt8TypeInContext(gen->context), 0, 0);
-    LLVMBuildStore(gen->builder, nullChar, nullPtr);
-
-    stringResult = buffer;
-  } else {
-    // Substring: (get "hello" 0 3) → "hel"
-    LLVMValueRef end = LLVMCodeGen_compileNode(gen, node->children[2]);
-    if (!end) {
-      fprintf(stderr, "ERROR: Failed to compile get end argument at line %d\n", node->lineNumber);
-      return NULL;
-    }
-
-    // Calculate substring length: end - start
-    LLVMValueRef length = LLVMBuildSub(gen->builder, end, start, "sub_length");
-
-    // Allocate buffer: length + 1 (for null terminator)
-    LLVMValueRef bufferSize = LLVMBuildAdd(gen->builder, length,
-                                          LLVMConstInt(gen->intType, 1, 0), "buffer_size");
-    LLVMValueRef mallocArgs[] = {bufferSize};
-    LLVMValueRef buffer = LLVMBuildCall2(gen->builder, gen->mallocType, gen->mallocFunc,
-                                        mallocArgs, 1, "substring_buffer");
-
-    // Copy characters using loop
-    LLVMBasicBlockRef loopBlock = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction, "substr_loop");
-    LLVMBasicBlockRef loopBody = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction, "substr_body");
-    LLVMBasicBlockRef loopEnd = LLVMAppendBasicBlockInContext(gen->context, gen->currentFunction, "substr_end");
-
-    // Loop counter
-    LLVMValueRef counter = LLVMBuildAlloca(gen->builder, gen->intType, "loop_counter");
-    LLVMValueRef zero = LLVMConstInt(gen->intType, 0, 0);
-    LLVMBuildStore(gen->builder, zero, counter);
-    LLVMBuildBr(gen->builder, loopBlock);
-
-    // Loop condition
-    LLVMPositionBuilderAtEnd(gen->builder, loopBlock);
-    LLVMValueRef i = LLVMBuildLoad2(gen->builder, gen->intType, counter, "i");
-    LLVMValueRef cond = LLVMBuildICmp(gen->builder, LLVMIntSLT, i, length, "loop_cond");
-    LLVMBuildCondBr(gen->builder, cond, loopBody, loopEnd);
-
-    // Loop body: copy character
-    LLVMPositionBuilderAtEnd(gen->builder, loopBody);
-    LLVMValueRef srcIndex = LLVMBuildAdd(gen->builder, start, i, "src_index");
-    LLVMValueRef srcCharPtr = LLVMBuildGEP2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                           stringPtr, &srcIndex, 1, "src_char_ptr");
-    LLVMValueRef charValue = LLVMBuildLoad2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                           srcCharPtr, "char_value");
-
-    LLVMValueRef dstCharPtr = LLVMBuildGEP2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                           buffer, &i, 1, "dst_char_ptr");
-    LLVMBuildStore(gen->builder, charValue, dstCharPtr);
-
-    // Increment counter
-    LLVMValueRef next = LLVMBuildAdd(gen->builder, i, LLVMConstInt(gen->intType, 1, 0), "next");
-    LLVMBuildStore(gen->builder, next, counter);
-    LLVMBuildBr(gen->builder, loopBlock);
-
-    // Loop end: add null terminator
-    LLVMPositionBuilderAtEnd(gen->builder, loopEnd);
-    LLVMValueRef nullPtr = LLVMBuildGEP2(gen->builder, LLVMInt8TypeInContext(gen->context),
-                                        buffer, &length, 1, "null_ptr");
-    LLVMValueRef nullChar = LLVMConstInt(LLVMInt8TypeInContext(gen->context), 0, 0);
-    LLVMBuildStore(gen->builder, nullChar, nullPtr);
-
-    stringResult = buffer;
+  // The Generic holds a String with its length in the header, so the runtime
+  // checks the bounds and copies the bytes once into the result String
+  LLVMValueRef stringSliceFunc = LLVMGetNamedFunction(gen->module, "franz_string_slice");
+  if (!stringSliceFunc) {
+    LLVMTypeRef stringSliceParams[] = {genericPtrType, gen->intType, gen->intType};
+    LLVMTypeRef stringSliceType = LLVMFunctionType(genericPtrType, stringSliceParams, 3, 0);
+    stringSliceFunc = LLVMAddFunction(gen->module, "franz_string_slice", stringSliceType);
   }
 
-  // Box the string result into Generic* using franz_box_string
-  LLVMValueRef boxStringFunc = LLVMGetNamedFunction(gen->module, "franz_box_string");
-  if (!boxStringFunc) {
-    LLVMTypeRef boxStringParams[] = {gen->stringType};
-    LLVMTypeRef boxStringType = LLVMFunctionType(genericPtrType, boxStringParams, 1, 0);
-    boxStringFunc = LLVMAddFunction(gen->module, "franz_box_string", boxStringType);
-  }
+  // Single character: (get s 0) is the slice [0, 1)
+  LLVMValueRef stringEnd = node->childCount == 2
+    ? LLVMBuildAdd(gen->builder, start, LLVMConstInt(gen->intType, 1, 0), "char_end")
+    : end;
 
-  LLVMValueRef boxArgs[] = {stringResult};
-  LLVMValueRef stringResultBoxed = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(boxStringFunc),
-                                                   boxStringFunc, boxArgs, 1, "string_result_boxed");
+  LLVMValueRef sliceArgs[] = {collection, start, stringEnd};
+  LLVMValueRef stringResultBoxed = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(stringSliceFunc),
+                                                   stringSliceFunc, sliceArgs, 3, "string_result_boxed");
   LLVMBuildBr(gen->builder, mergeBlock);
   LLVMBasicBlockRef stringExitBlock = LLVMGetInsertBlock(gen->builder);
 
-  // ========== LIST BLOCK: Call franz_list_nth ==========
+  // ========== LIST BLOCK: Call franz_list_nth / franz_list_slice ==========
   LLVMPositionBuilderAtEnd(gen->builder, listBlock);
 
-  // Call franz_list_nth(Generic* list, i64 index)
-  LLVMValueRef listNthFunc = LLVMGetNamedFunction(gen->module, "franz_list_nth");
-  if (!listNthFunc) {
-    LLVMTypeRef listNthParams[] = {genericPtrType, gen->intType};
-    LLVMTypeRef listNthType = LLVMFunctionType(genericPtrType, listNthParams, 2, 0);
-    listNthFunc = LLVMAddFunction(gen->module, "franz_list_nth", listNthType);
-  }
+  LLVMValueRef listResult;
+  if (node->childCount == 2) {
+    // Call franz_list_nth(Generic* list, i64 index)
+    LLVMValueRef listNthFunc = LLVMGetNamedFunction(gen->module, "franz_list_nth");
+    if (!listNthFunc) {
+      LLVMTypeRef listNthParams[] = {genericPtrType, gen->intType};
+      LLVMTypeRef listNthType = LLVMFunctionType(genericPtrType, listNthParams, 2, 0);
+      listNthFunc = LLVMAddFunction(gen->module, "franz_list_nth", listNthType);
+    }
 
-  LLVMValueRef listArgs[] = {collection, start};
-  LLVMValueRef listResult = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(listNthFunc),
-                                          listNthFunc, listArgs, 2, "list_nth_result");
+    LLVMValueRef listArgs[] = {collection, start};
+    listResult = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(listNthFunc),
+                                listNthFunc, listArgs, 2, "list_nth_result");
+  } else {
+    // Call franz_list_slice(Generic* list, i64 start, i64 end): a view, no copy
+    LLVMValueRef listSliceFunc = LLVMGetNamedFunction(gen->module, "franz_list_slice");
+    if (!listSliceFunc) {
+      LLVMTypeRef listSliceParams[] = {genericPtrType, gen->intType, gen->intType};
+      LLVMTypeRef listSliceType = LLVMFunctionType(genericPtrType, listSliceParams, 3, 0);
+      listSliceFunc = LLVMAddFunction(gen->module, "franz_list_slice", listSliceType);
+    }
+
+    LLVMValueRef listArgs[] = {collection, start, end};
+    listResult = LLVMBuildCall2(gen->builder, LLVMGlobalGetValueType(listSliceFunc),
+                                listSliceFunc, listArgs, 3, "list_slice_result");
+  }
   LLVMBuildBr(gen->builder, mergeBlock);
   LLVMBasicBlockRef listExitBlock = LLVMGetInsertBlock(gen->builder);
 
@@ -14,11 +14,13 @@
  *
  * LLVM-Native Implementation:
  * - Unboxes Generic* to check runtime type
- * - For strings: Pure LLVM IR substring extraction (C-level speed)
+ * - For string literals: Pure LLVM IR substring extraction (C-level speed)
+ * - For string values: franz_string_slice, one memcpy into a new String
  * - For lists: Direct element access via franz_list_nth
  *
  * Performance:
- * - String operations: 100% LLVM-native, no runtime overhead
+ * - String literals: 100% LLVM-native, no runtime overhead
+ * - String values: one runtime call, the length comes from the String header
  * - List operations: Minimal overhead (just Generic* unboxing)
  * - Type checking: Runtime branch (unavoidable with Generic*)
  *
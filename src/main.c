@@ -16,10 +16,50 @@
 #include "module_cache.h"
 #include "circular-deps/circular_deps.h"
 #include "error-handling/error_handler.h"
+#include "time-report/time_report.h"
+#include "trace/trace.h"
+#include "source-buffer/source_buffer.h"
 // Type checking (optional pre-run assertions)
 #include "assert_types.h"
 
-#define FRANZ_VERSION ("v0.0.4")
+// --time-report: printed at exit so scripts that call exit() still get one
+static const char *time_report_path = NULL;
+
+static void printTimeReport(void) {
+  FILE *out = time_report_path ? fopen(time_report_path, "w") : stderr;
+  if (!out) {
+    fprintf(stderr, "Error: Could not write time report to %s.\n", time_report_path);
+    return;
+  }
+  TimeReport_print(out);
+  if (out != stderr) fclose(out);
+}
+
+// franz build without -o: script name minus .franz, plus the --emit extension
+static void defaultBuildOutput(const char *script, BuildEmit emit, char *path, size_t size) {
+  const char *name = strrchr(script, '/');
+  name = name ? name + 1 : script;
+
+  size_t length = strlen(name);
+  bool stripped = length > 6 && strcmp(name + length - 6, ".franz") == 0;
+  if (stripped) length -= 6;
+
+  const char *extension = "";
+  switch (emit) {
+    case BUILD_EMIT_EXE: extension = ""; break;
+    case BUILD_EMIT_OBJ: extension = ".o"; break;
+    case BUILD_EMIT_ASM: extension = ".s"; break;
+    case BUILD_EMIT_LL:  extension = ".ll"; break;
+    case BUILD_EMIT_BC:  extension = ".bc"; break;
+  }
+
+  // Never write over the script itself (a script without the .franz extension)
+  if (!stripped && extension[0] == '\0') {
+    snprintf(path, size, "%s.out", name);
+  } else {
+    snprintf(path, size, "%.*s%s", (int)length, name, extension);
+  }
+}
 
 int main(int argc, char *argv[]) {
   // Initialize error handling system
@@ -41,13 +81,24 @@ int main(int argc, char *argv[]) {
     }
   }
 
-  // parse flags: -v, -d, --assert-types, --scoping, --no-tco
+  // parse flags: -v, -d, --assert-types, --scoping, --no-tco, --jit, --aot, -O<n>, --cpu=, --dump-ir, --no-cache, --time-report[=json], --time-report-file=, --no-lto, --alloc-stats, --trace[=categories]
+  // franz build SCRIPT [-o PATH] [--emit=exe|obj|asm|ll|bc] [flags]: write the program instead of running it
   bool debug = false;
   bool assert_types = false;
   bool enable_tco = true;  // TCO: Enabled by default (functional language standard), use --no-tco to disable
-  int first_arg_index = 1;
-
-  for (int i = 1; i < argc; i++) {
+  RunMode run_mode = RUN_MODE_JIT;  // JIT in-process by default, use --aot for a linked native executable
+  int opt_level = 0;                // -O0 (default) .. -O3
+  const char *target_cpu = "host";  // Optimize for the running CPU unless --cpu= says otherwise
+  const char *dump_ir_prefix = NULL;
+  bool use_cache = true;            // Build cache: reuse compiled output of unchanged scripts
+  bool lto = true;                  // Inline runtime helpers at -O1+ when libfranz_runtime.bc exists
+  bool building = argc > 1 && strcmp(argv[1], "build") == 0;
+  const char *build_script = NULL;
+  const char *output_path = NULL;
+  BuildEmit build_emit = BUILD_EMIT_EXE;
+  int first_arg_index = building ? 2 : 1;
+
+  for (int i = first_arg_index; i < argc; i++) {
     if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--version") == 0) {
       printf("%s\n", FRANZ_VERSION);
       return 0;
@@ -61,6 +112,94 @@ int main(int argc, char *argv[]) {
       // TCO: Disable tail call optimization (for debugging stack traces)
       enable_tco = false;
       first_arg_index++;
+    } else if (strcmp(argv[i], "--jit") == 0) {
+      run_mode = RUN_MODE_JIT;
+      first_arg_index++;
+    } else if (strcmp(argv[i], "--aot") == 0) {
+      // Ahead-of-time: build a native executable in a private temp dir and run it as a separate process
+      run_mode = RUN_MODE_AOT;
+      first_arg_index++;
+    } else if (strncmp(argv[i], "-O", 2) == 0) {
+      // -O0 / -O1 / -O2 / -O3 (bare -O means -O2, like clang)
+      const char *level = argv[i] + 2;
+      if (level[0] == '\0') {
+        opt_level = 2;
+      } else if (level[0] >= '0' && level[0] <= '3' && level[1] == '\0') {
+        opt_level = level[0] - '0';
+      } else {
+        fprintf(stderr, "Error: Invalid optimization level '%s'. Use -O0, -O1, -O2 or -O3.\n", argv[i]);
+        return 1;
+      }
+      first_arg_index++;
+    } else if (strncmp(argv[i], "--cpu=", 6) == 0) {
+      //  --cpu=host (default), --cpu=generic for portable code, or an LLVM CPU name
+      target_cpu = argv[i] + 6;
+      first_arg_index++;
+    } else if (strcmp(argv[i], "--dump-ir") == 0) {
+      dump_ir_prefix = "franz";
+      first_arg_index++;
+    } else if (strncmp(argv[i], "--dump-ir=", 10) == 0) {
+      //  Write PREFIX.pre-opt.ll and PREFIX.post-opt.ll
+      dump_ir_prefix = argv[i] + 10;
+      first_arg_index++;
+    } else if (strcmp(argv[i], "--no-cache") == 0) {
+      //  Always recompile, and do not store the result in the build cache
+      use_cache = false;
+      first_arg_index++;
+    } else if (building && strcmp(argv[i], "-o") == 0) {
+      //  franz build: output path
+      if (i + 1 >= argc) {
+        fprintf(stderr, "Error: -o needs an output path.\n");
+        return 1;
+      }
+      output_path = argv[++i];
+    } else if (building && strncmp(argv[i], "--emit=", 7) == 0) {
+      //  franz build: exe (default), obj, asm, ll or bc
+      const char *kind = argv[i] + 7;
+      if (strcmp(kind, "exe") == 0) {
+        build_emit = BUILD_EMIT_EXE;
+      } else if (strcmp(kind, "obj") == 0) {
+        build_emit = BUILD_EMIT_OBJ;
+      } else if (strcmp(kind, "asm") == 0) {
+        build_emit = BUILD_EMIT_ASM;
+      } else if (strcmp(kind, "ll") == 0) {
+        build_emit = BUILD_EMIT_LL;
+      } else if (strcmp(kind, "bc") == 0) {
+        build_emit = BUILD_EMIT_BC;
+      } else {
+        fprintf(stderr, "Error: Invalid --emit kind '%s'. Use exe, obj, asm, ll or bc.\n", kind);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--no-lto") == 0) {
+      //  Keep runtime calls opaque (do not link libfranz_runtime.bc before optimizing)
+      lto = false;
+      first_arg_index++;
+    } else if (strcmp(argv[i], "--time-report") == 0 || strcmp(argv[i], "--time-report=text") == 0) {
+      //  Print wall/CPU time and peak RSS of each compilation stage to stderr
+      TimeReport_enable(TIME_REPORT_TEXT);
+      first_arg_index++;
+    } else if (strcmp(argv[i], "--time-report=json") == 0) {
+      //  Same report as one JSON object, for tracking compile times in CI
+      TimeReport_enable(TIME_REPORT_JSON);
+      first_arg_index++;
+    } else if (strncmp(argv[i], "--time-report-file=", 19) == 0) {
+      //  Write the report to a file instead of stderr
+      time_report_path = argv[i] + 19;
+      first_arg_index++;
+    } else if (strcmp(argv[i], "--alloc-stats") == 0) {
+      //  Print live runtime objects per kind at exit (read by the slab allocator,
+      //  and inherited by --aot executables)
+      setenv("FRANZ_ALLOC_STATS", "1", 1);
+      first_arg_index++;
+    } else if (strcmp(argv[i], "--trace") == 0 || strncmp(argv[i], "--trace=", 8) == 0) {
+      //  Record runtime trace points (closures, lists, dicts, refs, modules, values or all),
+      //  written to stderr at exit or on a crash; inherited by --aot executables
+      const char *spec = argv[i][7] == '=' ? argv[i] + 8 : "all";
+      int categories = Trace_parse(spec);
+      if (categories < 0) return 1;
+      setenv("FRANZ_TRACE", spec, 1);
+      Trace_enable((unsigned int)categories);
+      first_arg_index++;
     } else if (strncmp(argv[i], "--scoping=", 10) == 0) {
       //  Parse --scoping=lexical or --scoping=dynamic
       const char* mode = argv[i] + 10;
@@ -76,6 +215,13 @@ int main(int argc, char *argv[]) {
     } else if (argv[i][0] == '-') {
       // unknown flag - ignore for now, keep compatibility
       first_arg_index++;
+    } else if (building) {
+      // franz build: the script takes no arguments, so flags may also follow it
+      if (build_script) {
+        fprintf(stderr, "Error: franz build takes one script, got '%s' and '%s'.\n", build_script, argv[i]);
+        return 1;
+      }
+      build_script = argv[i];
     } else {
       // first non-flag argument is the file path
       break;
@@ -87,10 +233,17 @@ int main(int argc, char *argv[]) {
     printf("Scoping mode: %s\n", ScopingMode_name(g_scoping_mode));
   }
 
+  // Enabled before reading the script so the report covers the whole pipeline
+  if (time_report_path && !TimeReport_isEnabled()) {
+    TimeReport_enable(TIME_REPORT_JSON);
+  }
+  if (TimeReport_isEnabled()) {
+    atexit(printTimeReport);
+  }
+
   /* read file */
   if (debug) printf("\nCODE\n");
-  char *code = NULL;
-  long fileLength = 0;
+  SourceBuffer source = {0};
   bool pipedInput = false;
 
   // Check if stdin is empty.
@@ -99,61 +252,47 @@ int main(int argc, char *argv[]) {
   rewind(stdin);
 
 
-  if (argc > first_arg_index) {
+  if (building && !build_script) {
+    fprintf(stderr, "Usage: franz build SCRIPT [-o PATH] [--emit=exe|obj|asm|ll|bc]\n");
+    return 1;
+  }
+
+  char build_output[1024];
+  if (building && !output_path) {
+    defaultBuildOutput(build_script, build_emit, build_output, sizeof(build_output));
+    output_path = build_output;
+  }
+
+  TimeReport_begin("read");
+  if (building || argc > first_arg_index) {
 
     // if a path was supplied
-    char *codePath = argv[first_arg_index];
+    const char *codePath = building ? build_script : argv[first_arg_index];
 
-    // if code is passed through an file argument
-    FILE *p_file = fopen(codePath, "r");
-    if (p_file == NULL) {
+    // map the file instead of copying it; tokens point straight into the mapping
+    if (SourceBuffer_mapFile(codePath, &source) != 0) {
       printf("Error: Could not read file %s.\n", codePath);
       return 0;
     }
 
-    // go to end, and record position (this will be the length of the file)
-    fseek(p_file, 0, SEEK_END);
-    fileLength = ftell(p_file);
-
-    // rewind to start
-    rewind(p_file);
-
-    // allocate memory (+1 for 0 terminated string)
-    code = malloc(fileLength + 1);
-
-    // read file and close
-    fread(code, fileLength, 1, p_file); 
-    fclose(p_file);
-
-    // set terminator to 0
-    code[fileLength] = '\0';
-
   } else if (!stdinEmpty) {
-    
-    // if stdin is empty, read it (code was passed in as a pipe)
-    code = malloc(0);
-
-    // finalIndex tracks the last index populated with a non '\0' char
-    int finalIndex = 0;
-    char c = EOF;
-
-    // loop through stdin.
-    for (finalIndex = 0; (c = getchar()) != EOF; finalIndex += 1) {
-      code = realloc(code, finalIndex + 1);
-      code[finalIndex] = c;
-    }
 
-    // create space for null terminator
-    code = realloc(code, finalIndex + 2);
-    fileLength = finalIndex + 1;
-    code[fileLength] = '\0';
+    // code was passed in as a pipe, read it in large chunks
+    if (SourceBuffer_readStream(stdin, &source) != 0) {
+      printf("Error: Could not read program from stdin.\n");
+      return 1;
+    }
 
     pipedInput = true;
   } else {
     printf("Error: Program not supplied through pipe or argument.\n");
     return 0;
   }
+  TimeReport_end("read");
   
+  char *code = source.code;
+  long fileLength = source.length;
+
   if (debug) {
     printf("%s\n", code);
   }
@@ -162,19 +301,33 @@ int main(int argc, char *argv[]) {
   if (assert_types) {
     if (debug) printf("Running type assertions (franz-check inline)\n");
 
+    TimeReport_begin("type check");
     int ok = franz_assert_types(code, fileLength, debug ? 1 : 0);
+    TimeReport_end("type check");
     if (!ok) {
-      free(code);
+      SourceBuffer_release(&source);
       return 1;
     }
   }
 
   // Calculate the number of arguments to skip (ie. name of executable, file passed, and flags).
-  int argsToSkip = first_arg_index + (pipedInput ? 0 : 1);
-  int exitCode = run(code, fileLength, argc - argsToSkip, &argv[argsToSkip], debug, enable_tco);
-
-  // free code
-  free(code);
+  int argsToSkip = building ? argc : first_arg_index + (pipedInput ? 0 : 1);
+  RunOptions options = {
+    .debug = debug,
+    .enableTCO = enable_tco,
+    .mode = building ? RUN_MODE_BUILD : run_mode,
+    .optLevel = opt_level,
+    .targetCpu = target_cpu,
+    .dumpIRPrefix = dump_ir_prefix,
+    .useCache = use_cache,
+    .lto = lto,
+    .outputPath = output_path,
+    .emit = build_emit
+  };
+  int exitCode = run(code, fileLength, argc - argsToSkip, &argv[argsToSkip], &options);
+
+  // unmap / free code
+  SourceBuffer_release(&source);
   code = NULL;
   if (debug) printf("Code Freed\n");
 
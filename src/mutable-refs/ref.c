@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include "ref.h"
 #include "../generic.h"
+#include "../trace/trace.h"
 
 // Create a new mutable reference
 Ref *Ref_new(Generic *initial_value) {
@@ -14,9 +15,7 @@ Ref *Ref_new(Generic *initial_value) {
   ref->value = initial_value;
   ref->refCount = 1;
 
-  #ifdef DEBUG_REF
-  fprintf(stderr, "[DEBUG] Ref_new: Created ref with refCount=%d\n", ref->refCount);
-  #endif
+  TRACE(TRACE_REFS, "Ref_new %p: Created ref with refCount=%d", (void *) ref, ref->refCount);
 
   return ref;
 }
@@ -25,9 +24,7 @@ Ref *Ref_new(Generic *initial_value) {
 void Ref_free(Ref *ref) {
   if (ref == NULL) return;
 
-  #ifdef DEBUG_REF
-  fprintf(stderr, "[DEBUG] Ref_free: Freeing ref (refCount was %d)\n", ref->refCount);
-  #endif
+  TRACE(TRACE_REFS, "Ref_free %p: Freeing ref (refCount was %d)", (void *) ref, ref->refCount);
 
   // Free the contained value
   if (ref->value != NULL) {
@@ -57,9 +54,7 @@ void Ref_set(Ref *ref, Generic *new_value) {
     exit(1);
   }
 
-  #ifdef DEBUG_REF
-  fprintf(stderr, "[DEBUG] Ref_set: Updating ref value\n");
-  #endif
+  TRACE(TRACE_REFS, "Ref_set %p: Updating ref value", (void *) ref);
 
   // Release old value
   if (ref->value != NULL) {
@@ -81,9 +76,7 @@ Ref *Ref_copy(Ref *ref) {
   // Increment refCount of existing ref
   ref->refCount++;
 
-  #ifdef DEBUG_REF
-  fprintf(stderr, "[DEBUG] Ref_copy: Copied ref, refCount now %d\n", ref->refCount);
-  #endif
+  TRACE(TRACE_REFS, "Ref_copy %p: Copied ref, refCount now %d", (void *) ref, ref->refCount);
 
   return ref;
 }
@@ -93,9 +86,7 @@ void Ref_retain(Ref *ref) {
   if (ref == NULL) return;
   ref->refCount++;
 
-  #ifdef DEBUG_REF
-  fprintf(stderr, "[DEBUG] Ref_retain: refCount now %d\n", ref->refCount);
-  #endif
+  TRACE(TRACE_REFS, "Ref_retain %p: refCount now %d", (void *) ref, ref->refCount);
 }
 
 // Release reference (decrement refCount, free if 0)
@@ -104,9 +95,7 @@ void Ref_release(Ref *ref) {
 
   ref->refCount--;
 
-  #ifdef DEBUG_REF
-  fprintf(stderr, "[DEBUG] Ref_release: refCount now %d\n", ref->refCount);
-  #endif
+  TRACE(TRACE_REFS, "Ref_release %p: refCount now %d", (void *) ref, ref->refCount);
 
   if (ref->refCount <= 0) {
     Ref_free(ref);
@@ -170,13 +170,13 @@ AstNode *parseValue(TokenArray *arr, int start, int length) {
   if (length == 1) {
     // Single token: int, float, string, or identifier
     if (head->type == TOK_STRING) {
-      return AstNode_new(head->val, OP_STRING, head->lineNumber);
+      return AstNode_newSpan(head->start, head->length, OP_STRING, head->lineNumber);
     } else if (head->type == TOK_FLOAT) {
-      return AstNode_new(head->val, OP_FLOAT, head->lineNumber);
+      return AstNode_newSpan(head->start, head->length, OP_FLOAT, head->lineNumber);
     } else if (head->type == TOK_INT) {
-      return AstNode_new(head->val, OP_INT, head->lineNumber);
+      return AstNode_newSpan(head->start, head->length, OP_INT, head->lineNumber);
     } else if (head->type == TOK_IDENTIFIER) {
-      return AstNode_new(head->val, OP_IDENTIFIER, head->lineNumber);
+      return AstNode_newSpan(head->start, head->length, OP_IDENTIFIER, head->lineNumber);
     } else {
       printf(
         "Syntax Error @ Line %i: Unexpected %s token.\n",
@@ -190,14 +190,18 @@ AstNode *parseValue(TokenArray *arr, int start, int length) {
              arr->tokens[start + 1].type == TOK_DOT &&
              arr->tokens[start + 2].type == TOK_IDENTIFIER) {
     // Qualified name: ns.identifier
-    int namespace_len = strlen(head->val);
-    int member_len = strlen(arr->tokens[start + 2].val);
+    Token *member = &arr->tokens[start + 2];
+    int namespace_len = head->length;
+    int member_len = member->length;
     char *qualified_name = malloc(namespace_len + 1 + member_len + 1);
-    strcpy(qualified_name, head->val);
+    memcpy(qualified_name, head->start, namespace_len);
     qualified_name[namespace_len] = '.';
-    strcpy(qualified_name + namespace_len + 1, arr->tokens[start + 2].val);
+    memcpy(qualified_name + namespace_len + 1, member->start, member_len);
+    qualified_name[namespace_len + 1 + member_len] = '\0';
 
-    return AstNode_new(qualified_name, OP_QUALIFIED, head->lineNumber);
+    AstNode *qualified = AstNode_new(qualified_name, OP_QUALIFIED, head->lineNumber);
+    free(qualified_name);
+    return qualified;
 
   } else if (length > 1) {
     // Application, function, or list literal
@@ -272,7 +276,7 @@ AstNode *parseAssignment(TokenArray *arr, int start, int length) {
   // Create assignment node
   AstNode *res = AstNode_new(NULL, OP_ASSIGNMENT, head->lineNumber);
   res->isMutable = isMutable;  // Mark if declared with mut
-  AstNode_addChild(res, AstNode_new(head->val, OP_IDENTIFIER, head->lineNumber));
+  AstNode_addChild(res, AstNode_newSpan(head->start, head->length, OP_IDENTIFIER, head->lineNumber));
   AstNode_addChild(res, parseValue(arr, start + offset + 2, length - offset - 2));
 
   return res;
@@ -402,7 +406,7 @@ AstNode *parseFunction(TokenArray *arr, int start, int length) {
     while (i < arrowIndex) {
       Token *curr = &arr->tokens[i];
       if (curr->type == TOK_IDENTIFIER) {
-        AstNode_appendChild(res, &p_lastChild, AstNode_new(curr->val, OP_IDENTIFIER, curr->lineNumber));
+        AstNode_appendChild(res, &p_lastChild, AstNode_newSpan(curr->start, curr->length, OP_IDENTIFIER, curr->lineNumber));
       }
       i++;
     }
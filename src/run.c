@@ -1,12 +1,14 @@
 #include "run.h"
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/wait.h>
-#include <unistd.h>  //  For access() function
+#include <sys/stat.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm-c/BitWriter.h>
 
 #include "tokens.h"
 #include "lex.h"
@@ -17,20 +19,180 @@
 #include "file.h"
 #include "scope.h"
 
-//  LLVM native compilation (default and only mode)
+//  LLVM native compilation (in-process JIT by default, AOT executable with --aot)
 #include "llvm-codegen/llvm_codegen.h"
+#include "llvm-jit/llvm_jit.h"
+#include "llvm-opt/llvm_opt.h"
+#include "llvm-aot/llvm_aot.h"
+#include "llvm-lto/llvm_lto.h"
+#include "build-cache/build_cache.h"
+#include "time-report/time_report.h"
 
 void exitHandler() {
   exit(0);
 }
 
-int run(char *code, long length, int argc, char *argv[], bool debug, bool enable_tco) {
+// --dump-ir: write the module as PREFIX.<stage>.ll for before/after comparison
+static void dumpIR(LLVMModuleRef module, const char *prefix, const char *stage) {
+  char path[1024];
+  snprintf(path, sizeof(path), "%s.%s.ll", prefix, stage);
+
+  char *error = NULL;
+  if (LLVMPrintModuleToFile(module, path, &error)) {
+    fprintf(stderr, "ERROR: Failed to write %s: %s\n", path, error);
+    LLVMDisposeMessage(error);
+    return;
+  }
+  fprintf(stderr, "[IR] Wrote %s\n", path);
+}
+
+// "mtime:size" of a file, so rebuilding franz or its runtime invalidates cached builds
+static void fileIdentity(const char *path, char *identity, size_t size) {
+  struct stat info;
+  if (path && stat(path, &info) == 0) {
+    snprintf(identity, size, "%lld:%lld", (long long)info.st_mtime, (long long)info.st_size);
+  } else {
+    snprintf(identity, size, "unknown");
+  }
+}
+
+// Everything besides the source text that changes the compiled output
+static void describeBuild(const RunOptions *options, LLVMTargetMachineRef tm, char *config, size_t size) {
+  char path[PATH_MAX];
+  char compiler[64];
+  char runtime[64];
+  char runtimeBitcode[64];
+  fileIdentity(LLVMAot_executablePath(path, sizeof(path)) == 0 ? path : NULL, compiler, sizeof(compiler));
+  if (options->mode == RUN_MODE_AOT) {
+    fileIdentity(LLVMAot_findRuntimeLibrary(path, sizeof(path)) == 0 ? path : NULL, runtime, sizeof(runtime));
+  } else {
+    snprintf(runtime, sizeof(runtime), "in-process");
+  }
+  if (options->lto && options->optLevel > 0) {
+    fileIdentity(LLVMLto_findRuntimeBitcode(path, sizeof(path)) == 0 ? path : NULL, runtimeBitcode, sizeof(runtimeBitcode));
+  } else {
+    snprintf(runtimeBitcode, sizeof(runtimeBitcode), "off");
+  }
+
+  char *triple = LLVMGetTargetMachineTriple(tm);
+  char *cpu = LLVMGetTargetMachineCPU(tm);
+  char *features = LLVMGetTargetMachineFeatureString(tm);
+
+  snprintf(config, size,
+           "franz=%s llvm=%s compiler=%s runtime=%s lto=%s mode=%s opt=%d target=%s cpu=%s features=%s tco=%d scoping=%s",
+           FRANZ_VERSION, LLVM_VERSION_STRING, compiler, runtime, runtimeBitcode,
+           options->mode == RUN_MODE_AOT ? "aot" : "jit", options->optLevel,
+           triple, cpu, features, options->enableTCO ? 1 : 0, ScopingMode_name(g_scoping_mode));
+
+  LLVMDisposeMessage(triple);
+  LLVMDisposeMessage(cpu);
+  LLVMDisposeMessage(features);
+}
+
+// franz build: write the optimized module in the requested form instead of running it
+static int writeBuildOutput(LLVMModuleRef module, LLVMTargetMachineRef tm, const RunOptions *options) {
+  const char *path = options->outputPath;
+  char *error = NULL;
+
+  switch (options->emit) {
+    case BUILD_EMIT_LL:
+      if (LLVMPrintModuleToFile(module, path, &error)) {
+        fprintf(stderr, "ERROR: Failed to write %s: %s\n", path, error);
+        LLVMDisposeMessage(error);
+        return 1;
+      }
+      break;
+    case BUILD_EMIT_BC:
+      if (LLVMWriteBitcodeToFile(module, path) != 0) {
+        fprintf(stderr, "ERROR: Failed to write %s\n", path);
+        return 1;
+      }
+      break;
+    case BUILD_EMIT_OBJ:
+      if (LLVMAot_emitFile(module, tm, LLVMObjectFile, path) != 0) return 1;
+      break;
+    case BUILD_EMIT_ASM:
+      if (LLVMAot_emitFile(module, tm, LLVMAssemblyFile, path) != 0) return 1;
+      break;
+    case BUILD_EMIT_EXE:
+      if (LLVMAot_writeExecutable(module, tm, path, options->debug) != 0) return 1;
+      break;
+  }
+
+  fflush(stdout);
+  fprintf(stderr, "Wrote %s\n", path);
+  return 0;
+}
+
+// Run a build cache hit: an executable (--aot) or an object file for the JIT
+static int runCached(const RunOptions *options, const char *path) {
+  if (options->debug) {
+    printf("[DEBUG] Build cache hit: %s\n", path);
+    fflush(stdout);
+  }
+
+  if (options->mode == RUN_MODE_AOT) {
+    return LLVMAot_runExecutable(path, options->debug);
+  }
+
+  LLVMMemoryBufferRef object = NULL;
+  char *error = NULL;
+  if (LLVMCreateMemoryBufferWithContentsOfFile(path, &object, &error)) {
+    fprintf(stderr, "ERROR: Failed to read cached build %s: %s\n", path, error);
+    LLVMDisposeMessage(error);
+    return 1;
+  }
+  return LLVMJit_runObject(object, options->debug);
+}
+
+int run(char *code, long length, int argc, char *argv[], const RunOptions *options) {
+  bool debug = options->debug;
+  bool enable_tco = options->enableTCO;
+
+  initEvents();
+
+  // cleanly handle exit events
+  signal(SIGTERM, exitHandler);
+  signal(SIGINT, exitHandler);
+
+  // Target machine first: the CPU it resolves to is part of the build cache key
+  LLVMTargetMachineRef targetMachine = LLVMOpt_createTargetMachine(options->targetCpu, options->optLevel);
+  if (!targetMachine) {
+    return 1;
+  }
+
+  // Build cache: an unchanged script (and unchanged used modules) skips compilation.
+  // Not used with -d or --dump-ir, which exist to look at the compilation itself, or franz build.
+  const char *artifactKind = options->mode == RUN_MODE_AOT ? "exe" : "o";
+  bool useCache = options->useCache && !debug && !options->dumpIRPrefix && options->mode != RUN_MODE_BUILD;
+  if (useCache) {
+    TimeReport_begin("cache lookup");
+    char config[2048];
+    describeBuild(options, targetMachine, config, sizeof(config));
+    useCache = BuildCache_begin(code, length, config) == 0;
+
+    char cachedPath[PATH_MAX];
+    bool hit = useCache && BuildCache_lookup(artifactKind, cachedPath, sizeof(cachedPath)) == 0;
+    TimeReport_end("cache lookup");
+
+    if (hit) {
+      LLVMDisposeTargetMachine(targetMachine);
+      BuildCache_end();
+      return runCached(options, cachedPath);
+    }
+
+    // Miss: record compiler diagnostics so a later hit can show them too
+    if (useCache) BuildCache_captureDiagnostics();
+  }
+
   if (debug) {
     printf("\nTOKENS\n");
   }
 
   /*  Lex with array-based tokens */
+  TimeReport_begin("lex");
   TokenArray *tokens = lex(code, length);
+  TimeReport_end("lex");
 
   if (debug) {
     // print tokens
@@ -40,7 +202,9 @@ int run(char *code, long length, int argc, char *argv[], bool debug, bool enable
   }
 
   /*  Parse with array-based tokens */
+  TimeReport_begin("parse");
   AstNode *p_headAstNode = parseProgram(tokens);
+  TimeReport_end("parse");
 
   if (debug) {
     // print AST
@@ -49,11 +213,6 @@ int run(char *code, long length, int argc, char *argv[], bool debug, bool enable
   }
 
   /*  LLVM native compilation (Rust-level performance) */
-  initEvents();
-
-  // cleanly handle exit events
-  signal(SIGTERM, exitHandler);
-  signal(SIGINT, exitHandler);
 
   // Create global scope with stdlib
   Scope *p_global = newGlobal(argc, argv);
@@ -62,6 +221,8 @@ int run(char *code, long length, int argc, char *argv[], bool debug, bool enable
   LLVMCodeGen *codegen = LLVMCodeGen_new("franz_module");
   if (!codegen) {
     fprintf(stderr, "ERROR: Failed to initialize LLVM code generator\n");
+    LLVMDisposeTargetMachine(targetMachine);
+    BuildCache_end();
     AstNode_free(p_headAstNode);
     TokenArray_free(tokens);
     Scope_free(p_global);
@@ -82,10 +243,14 @@ int run(char *code, long length, int argc, char *argv[], bool debug, bool enable
   }
 
   // Compile AST to LLVM IR ( stub prints status)
+  TimeReport_begin("codegen");
   int compileResult = LLVMCodeGen_compile(codegen, p_headAstNode, p_global);
+  TimeReport_end("codegen");
 
   if (compileResult != 0) {
     fprintf(stderr, "ERROR: LLVM compilation failed\n");
+    LLVMDisposeTargetMachine(targetMachine);
+    BuildCache_end();
     LLVMCodeGen_free(codegen);
     AstNode_free(p_headAstNode);
     TokenArray_free(tokens);
@@ -99,41 +264,28 @@ int run(char *code, long length, int argc, char *argv[], bool debug, bool enable
     fflush(stdout);
   }
 
-  //  Write LLVM IR to file and compile to native executable
-  const char *llFilename = "/tmp/franz_output.ll";
-  const char *objFilename = "/tmp/franz_output.o";
-  const char *exeFilename = "/tmp/franz_output";
-
-  if (debug) {
-    printf("[DEBUG] Writing LLVM IR to %s\n", llFilename);
-    fflush(stdout);
+  // Optimize for the target CPU at the requested -O level
+  if (options->dumpIRPrefix) {
+    dumpIR(codegen->module, options->dumpIRPrefix, "pre-opt");
   }
 
-  // Write LLVM IR to .ll file
-  char *error = NULL;
-  if (LLVMPrintModuleToFile(codegen->module, llFilename, &error)) {
-    fprintf(stderr, "ERROR: Failed to write LLVM IR to file: %s\n", error);
-    LLVMDisposeMessage(error);
-    LLVMCodeGen_free(codegen);
-    AstNode_free(p_headAstNode);
-    TokenArray_free(tokens);
-    Scope_free(p_global);
-    return 1;
+  // Pull small runtime helpers into the module so the optimizer can inline them
+  if (options->lto && options->optLevel > 0) {
+    LLVMLto_linkRuntime(codegen->module, debug);
   }
 
   if (debug) {
-    printf("[DEBUG] Compiling LLVM IR to object file...\n");
+    printf("[DEBUG] Running LLVM optimization pipeline at -O%d\n", options->optLevel);
     fflush(stdout);
   }
 
-  // Compile LLVM IR to object file using llc
-  char llcCmd[512];
-  snprintf(llcCmd, sizeof(llcCmd), "/opt/homebrew/opt/llvm@17/bin/llc -filetype=obj %s -o %s",
-           llFilename, objFilename);
-  int llcResult = system(llcCmd);
+  TimeReport_begin("optimize");
+  int optResult = LLVMOpt_optimizeModule(codegen->module, targetMachine, options->optLevel);
+  TimeReport_end("optimize");
 
-  if (llcResult != 0) {
-    fprintf(stderr, "ERROR: Failed to compile LLVM IR to object file\n");
+  if (optResult != 0) {
+    LLVMDisposeTargetMachine(targetMachine);
+    BuildCache_end();
     LLVMCodeGen_free(codegen);
     AstNode_free(p_headAstNode);
     TokenArray_free(tokens);
@@ -141,134 +293,48 @@ int run(char *code, long length, int argc, char *argv[], bool debug, bool enable
     return 1;
   }
 
-  if (debug) {
-    printf("[DEBUG] Linking object file to executable...\n");
-    fflush(stdout);
-  }
-
-  //  Compile runtime dependencies for runtime linking
-  const char *numberParseC = "src/number-formats/number_parse.c";
-  const char *numberParseObj = "/tmp/number_parse.o";
-
-  char compileNumberCmd[512];
-  snprintf(compileNumberCmd, sizeof(compileNumberCmd),
-           "gcc -c %s -o %s 2>/dev/null", numberParseC, numberParseObj);
-  system(compileNumberCmd);  // Compile number_parse.c to object file
-
-  //  Compile terminal_runtime.c for runtime linking
-  const char *terminalRuntimeC = "src/llvm-terminal/terminal_runtime.c";
-  const char *terminalRuntimeObj = "/tmp/terminal_runtime.o";
-
-  char compileTerminalCmd[512];
-  snprintf(compileTerminalCmd, sizeof(compileTerminalCmd),
-           "gcc -c %s -o %s 2>/dev/null", terminalRuntimeC, terminalRuntimeObj);
-  system(compileTerminalCmd);  // Compile terminal_runtime.c to object file
-
-  //  Compile llvm_repeat.c for runtime linking
-  const char *repeatC = "src/llvm-terminal/llvm_repeat.c";
-  const char *repeatObj = "/tmp/llvm_repeat.o";
-
-  char compileRepeatCmd[512];
-  snprintf(compileRepeatCmd, sizeof(compileRepeatCmd),
-           "gcc -c %s -o %s 2>/dev/null", repeatC, repeatObj);
-  system(compileRepeatCmd);  // Compile llvm_repeat.c to object file
-
-  //  Compile dict.c for runtime linking (dictionary/hash map support)
-  const char *dictC = "src/dict.c";
-  const char *dictObj = "/tmp/dict.o";
-
-  if (debug) {
-    printf("[DEBUG] Compiling dict.c...\n");
-    fflush(stdout);
-  }
-
-  char compileDictCmd[512];
-  snprintf(compileDictCmd, sizeof(compileDictCmd),
-           "gcc -c %s -o %s", dictC, dictObj);
-
-  if (debug) {
-    printf("[DEBUG] Dict compile command: %s\n", compileDictCmd);
-    fflush(stdout);
+  if (options->dumpIRPrefix) {
+    dumpIR(codegen->module, options->dumpIRPrefix, "post-opt");
   }
 
-  int dictCompileResult = system(compileDictCmd);
-
-  if (dictCompileResult != 0) {
-    fprintf(stderr, "[ERROR] Failed to compile dict.c (exit code: %d)\n", dictCompileResult);
-  } else if (debug) {
-    printf("[DEBUG] Successfully compiled dict.c to %s\n", dictObj);
-    // Verify symbols in dict.o
-    system("nm /tmp/dict.o | grep -c Dict 2>/dev/null | xargs -I{} printf '[DEBUG] dict.o contains {} Dict symbols\\n'");
-    fflush(stdout);
-  }
-
-  //  Compile stdlib.c for runtime linking (dict wrapper functions)
-  const char *stdlibC = "src/stdlib.c";
-  const char *stdlibObj = "/tmp/stdlib.o";
-
-  if (debug) {
-    printf("[DEBUG] Compiling stdlib.c...\n");
-    fflush(stdout);
-  }
-
-  char compileStdlibCmd[512];
-  snprintf(compileStdlibCmd, sizeof(compileStdlibCmd),
-           "gcc -c %s -o %s", stdlibC, stdlibObj);
-
-  if (debug) {
-    printf("[DEBUG] Stdlib compile command: %s\n", compileStdlibCmd);
-    fflush(stdout);
-  }
-
-  int stdlibCompileResult = system(compileStdlibCmd);
-
-  if (stdlibCompileResult != 0) {
-    fprintf(stderr, "[ERROR] Failed to compile stdlib.c (exit code: %d)\n", stdlibCompileResult);
-  } else if (debug) {
-    printf("[DEBUG] Successfully compiled stdlib.c to %s\n", stdlibObj);
-    // Verify franz_dict_* symbols in stdlib.o
-    system("nm /tmp/stdlib.o | grep -c franz_dict 2>/dev/null | xargs -I{} printf '[DEBUG] stdlib.o contains {} franz_dict symbols\\n'");
-    fflush(stdout);
-  }
-
-  //  Build runtime library if not exists (industry-standard static library)
-  const char *runtimeLib = "/tmp/libfranz_runtime.a";
-  if (access(runtimeLib, F_OK) != 0) {
-    // Runtime library doesn't exist - build it
-    system("make -f Makefile.runtime 2>/dev/null");
-  }
-
-  // Link object file + runtime library to executable using clang
-  //  Include dict.o and stdlib.o for dict runtime support
-  char clangCmd[1024];
-  snprintf(clangCmd, sizeof(clangCmd), "clang %s %s %s %s %s %s %s -lm -o %s",
-           objFilename, numberParseObj, terminalRuntimeObj, repeatObj,
-           dictObj, stdlibObj, runtimeLib, exeFilename);
-
-  if (debug) {
-    printf("[DEBUG] Linking command: %s\n", clangCmd);
-    fflush(stdout);
-  }
-
-  int clangResult = system(clangCmd);
-
-  if (clangResult != 0) {
-    fprintf(stderr, "ERROR: Failed to link executable\n");
-    LLVMCodeGen_free(codegen);
-    AstNode_free(p_headAstNode);
-    TokenArray_free(tokens);
-    Scope_free(p_global);
-    return 1;
-  }
-
-  if (debug) {
-    printf("[DEBUG] Executing native binary: %s\n", exeFilename);
-    fflush(stdout);
+  // Build the artifact, store it in the build cache, then run it
+  int exitCode = 1;
+  if (options->mode == RUN_MODE_BUILD) {
+    exitCode = writeBuildOutput(codegen->module, targetMachine, options);
+    LLVMDisposeTargetMachine(targetMachine);
+  } else if (options->mode == RUN_MODE_AOT) {
+    const char *executable = LLVMAot_buildExecutable(codegen->module, targetMachine, debug);
+    LLVMDisposeTargetMachine(targetMachine);
+    BuildCache_releaseDiagnostics();
+    if (executable) {
+      if (useCache) {
+        TimeReport_begin("cache store");
+        BuildCache_storeFile(artifactKind, executable);
+        TimeReport_end("cache store");
+      }
+      exitCode = LLVMAot_runExecutable(executable, debug);
+    }
+    LLVMAot_removeWorkDir();
+  } else {
+    if (debug) {
+      printf("[DEBUG] Running module in-process via JIT\n");
+      fflush(stdout);
+    }
+    TimeReport_begin("emit");
+    LLVMMemoryBufferRef object = LLVMJit_emitObject(codegen->module, targetMachine);
+    TimeReport_end("emit");
+    LLVMDisposeTargetMachine(targetMachine);
+    BuildCache_releaseDiagnostics();
+    if (object) {
+      if (useCache) {
+        TimeReport_begin("cache store");
+        BuildCache_storeBuffer(artifactKind, LLVMGetBufferStart(object), LLVMGetBufferSize(object));
+        TimeReport_end("cache store");
+      }
+      exitCode = LLVMJit_runObject(object, debug);
+    }
   }
-
-  // Execute the native binary
-  int execResult = system(exeFilename);
-  int exitCode = WEXITSTATUS(execResult);
+  BuildCache_end();
 
   /* free */
   if (debug) {
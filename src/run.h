@@ -2,8 +2,39 @@
 #define RUN_H
 #include <stdbool.h>
 
-//  Run function now uses bytecode VM by default
+#define FRANZ_VERSION ("v0.0.4")
+
+// How the compiled module is executed
+typedef enum {
+  RUN_MODE_JIT,   // JIT-compile in-process and call main() directly (default)
+  RUN_MODE_AOT,   // Emit .o in-process, link in a private temp dir, then run it (--aot)
+  RUN_MODE_BUILD  // Write the compiled program to a file and stop (franz build)
+} RunMode;
+
+// What `franz build` writes (--emit=)
+typedef enum {
+  BUILD_EMIT_EXE,   // Standalone native executable (default)
+  BUILD_EMIT_OBJ,   // --emit=obj: object file
+  BUILD_EMIT_ASM,   // --emit=asm: assembly listing
+  BUILD_EMIT_LL,    // --emit=ll: textual LLVM IR
+  BUILD_EMIT_BC     // --emit=bc: LLVM bitcode
+} BuildEmit;
+
+// Options collected from command line flags in main.c
+typedef struct RunOptions {
+  bool debug;       // -d: print tokens, AST and IR
+  bool enableTCO;   // Tail call optimization (disabled with --no-tco)
+  RunMode mode;     // --jit (default) / --aot
+  int optLevel;     // -O0 .. -O3: LLVM pass pipeline and codegen level
+  const char *targetCpu;      // --cpu=: "host" (default), "generic" or an LLVM CPU name
+  const char *dumpIRPrefix;   // --dump-ir[=PREFIX]: write PREFIX.pre-opt.ll / PREFIX.post-opt.ll (NULL = off)
+  bool useCache;    // Reuse compiled output of unchanged scripts (disabled with --no-cache)
+  bool lto;         // Inline runtime helpers from libfranz_runtime.bc at -O1+ (disabled with --no-lto)
+  const char *outputPath;   // franz build -o PATH
+  BuildEmit emit;           // franz build --emit=
+} RunOptions;
+
 // prototypes
-int run(char *code, long length, int argc, char *argv[], bool debug, bool enable_tco);
+int run(char *code, long length, int argc, char *argv[], const RunOptions *options);
 
 #endif
@@ -232,7 +232,7 @@ int Security_seedCapabilities(Scope *p_scope, Generic *capabilities, int lineNum
   List *capList = (List *) capabilities->p_val;
 
   for (int i = 0; i < capList->len; i++) {
-    Generic *capGen = capList->vals[i];
+    Generic *capGen = List_at(capList, i);
 
     // Validate each capability is a string
     if (capGen->type != TYPE_STRING) {
@@ -243,12 +243,12 @@ int Security_seedCapabilities(Scope *p_scope, Generic *capabilities, int lineNum
       return -1;
     }
 
-    char *cap = *((char **) capGen->p_val);
+    char *cap = capGen->strVal;
     Security_grantCapability(p_scope, cap, lineNumber);
   }
 
   // Always grant void (no security risk)
-  Scope_set(p_scope, "void", Generic_new(TYPE_VOID, NULL, 0), -1);
+  Scope_set(p_scope, "void", Generic_void(), -1);
 
   return 0;
 }
@@ -0,0 +1,148 @@
+#include "slab.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+/**
+ * Slab Allocator for Franz Runtime Objects
+ *
+ * Size classes are multiples of 16 so every block keeps malloc's alignment.
+ * A thread refills a class by taking a fresh chunk and bumping through it;
+ * freed blocks are pushed on the class free list and reused first. Chunks
+ * are linked on a global lock-free stack so the exit handler can free them
+ * whichever thread allocated them.
+ */
+
+#define SLAB_CHUNK_SIZE (64 * 1024)
+#define SLAB_MAX_SIZE 272
+#define SLAB_CLASS_COUNT 8
+
+static const size_t slabClassSizes[SLAB_CLASS_COUNT] = {16, 32, 48, 64, 96, 128, 192, 272};
+
+// Size class for (size + 15) / 16, i.e. per 16-byte step up to SLAB_MAX_SIZE
+static const unsigned char slabClassForStep[SLAB_MAX_SIZE / 16 + 1] = {
+  0,                 // 0 bytes
+  0, 1, 2, 3,        // 16, 32, 48, 64
+  4, 4, 5, 5,        // 80-96, 112-128
+  6, 6, 6, 6,        // 144-192
+  7, 7, 7, 7, 7      // 208-272 (272: a ListNode)
+};
+
+static const char *slabKindNames[SLAB_KIND_COUNT] = {
+  "Generic", "List", "List node", "Dict", "Dict node", "String"
+};
+
+typedef struct SlabBlock {
+  struct SlabBlock *next;
+} SlabBlock;
+
+// Header at the start of every chunk; 16 bytes so blocks stay aligned
+typedef struct SlabChunk {
+  struct SlabChunk *next;
+  size_t padding;
+} SlabChunk;
+
+typedef struct SlabCache {
+  SlabBlock *freeList[SLAB_CLASS_COUNT];
+  char *bump[SLAB_CLASS_COUNT];
+  char *bumpEnd[SLAB_CLASS_COUNT];
+  long allocated[SLAB_KIND_COUNT];  // Always counted: a thread-local increment is free
+  long freed[SLAB_KIND_COUNT];
+} SlabCache;
+
+static _Thread_local SlabCache slabCache;
+static _Atomic(SlabChunk *) slabChunks = NULL;
+static atomic_flag slabExitRegistered = ATOMIC_FLAG_INIT;
+static atomic_int slabReleased = 0;  // Set by the exit handler
+
+// Print the stats if asked for, then hand every chunk back to malloc
+static void Slab_releaseAll(void) {
+  const char *stats = getenv("FRANZ_ALLOC_STATS");
+  if (stats && *stats && strcmp(stats, "0") != 0) Slab_printStats(stderr);
+
+  atomic_store(&slabReleased, 1);
+  SlabChunk *chunk = atomic_exchange(&slabChunks, NULL);
+  while (chunk) {
+    SlabChunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  // Nothing may be served from the released chunks any more; later
+  // allocations (from other exit handlers) fall back to malloc and leak
+  for (int i = 0; i < SLAB_CLASS_COUNT; i++) {
+    slabCache.freeList[i] = NULL;
+    slabCache.bump[i] = NULL;
+    slabCache.bumpEnd[i] = NULL;
+  }
+}
+
+// Give this thread a fresh chunk for one size class
+static int Slab_refill(int sizeClass) {
+  SlabChunk *chunk = malloc(SLAB_CHUNK_SIZE);
+  if (!chunk) return 0;
+
+  if (!atomic_flag_test_and_set(&slabExitRegistered)) atexit(Slab_releaseAll);
+
+  chunk->next = atomic_load(&slabChunks);
+  while (!atomic_compare_exchange_weak(&slabChunks, &chunk->next, chunk)) {
+  }
+
+  slabCache.bump[sizeClass] = (char *) chunk + sizeof(SlabChunk);
+  slabCache.bumpEnd[sizeClass] = (char *) chunk + SLAB_CHUNK_SIZE;
+  return 1;
+}
+
+void *Slab_alloc(size_t size, SlabKind kind) {
+  slabCache.allocated[kind]++;
+  if (size > SLAB_MAX_SIZE || atomic_load_explicit(&slabReleased, memory_order_relaxed)) {
+    return malloc(size);
+  }
+
+  int sizeClass = slabClassForStep[(size + 15) / 16];
+  SlabBlock *block = slabCache.freeList[sizeClass];
+  if (block) {
+    slabCache.freeList[sizeClass] = block->next;
+    return block;
+  }
+
+  size_t blockSize = slabClassSizes[sizeClass];
+  if ((size_t) (slabCache.bumpEnd[sizeClass] - slabCache.bump[sizeClass]) < blockSize
+      && !Slab_refill(sizeClass)) {
+    return NULL;
+  }
+
+  void *res = slabCache.bump[sizeClass];
+  slabCache.bump[sizeClass] += blockSize;
+  return res;
+}
+
+size_t Slab_blockSize(size_t size) {
+  if (size > SLAB_MAX_SIZE) return size;
+  return slabClassSizes[slabClassForStep[(size + 15) / 16]];
+}
+
+void Slab_free(void *ptr, size_t size, SlabKind kind) {
+  if (!ptr) return;
+  slabCache.freed[kind]++;
+  if (size > SLAB_MAX_SIZE) {
+    free(ptr);
+    return;
+  }
+  if (atomic_load_explicit(&slabReleased, memory_order_relaxed)) return;
+
+  int sizeClass = slabClassForStep[(size + 15) / 16];
+  SlabBlock *block = (SlabBlock *) ptr;
+  block->next = slabCache.freeList[sizeClass];
+  slabCache.freeList[sizeClass] = block;
+}
+
+void Slab_printStats(FILE *out) {
+  fprintf(out, "\n=== Franz allocations ===\n");
+  fprintf(out, "  %-12s %12s %12s %12s\n", "kind", "allocated", "freed", "live");
+  for (int i = 0; i < SLAB_KIND_COUNT; i++) {
+    long allocated = slabCache.allocated[i];
+    long freed = slabCache.freed[i];
+    fprintf(out, "  %-12s %12ld %12ld %12ld\n", slabKindNames[i], allocated, freed, allocated - freed);
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * Slab Allocator for Franz Runtime Objects
+ *
+ * Generic, List and Dict headers, their trie nodes and short strings are
+ * small and allocated and freed constantly. Slab_alloc() serves them from size
+ * classes of 16..272 bytes carved out of 64 KB chunks. Each thread keeps its
+ * own free lists and bump pointers, so the fast path is a pointer pop with no
+ * locking. Freed blocks go back to the free list of the calling thread.
+ *
+ * Chunks are never returned to malloc while the program runs; they are all
+ * released in one go when the process exits. Requests above 272 bytes fall
+ * through to malloc/free.
+ *
+ * The caller passes the size to Slab_free() (every caller knows it: it is the
+ * struct size, or a String's capacity plus its header), so blocks need no header.
+ *
+ * Allocations and frees are counted per kind in the same thread-local cache.
+ * With FRANZ_ALLOC_STATS set (franz --alloc-stats) the exiting thread prints
+ * them, with the objects still live, on stderr. Franz programs run on one
+ * thread, so that is the whole program.
+ */
+
+typedef enum SlabKind {
+  SLAB_GENERIC,     // Generic
+  SLAB_LIST,        // List header
+  SLAB_LIST_NODE,   // ListNode of a List trie
+  SLAB_DICT,        // Dict header
+  SLAB_DICT_NODE,   // DictNode of a Dict trie
+  SLAB_STRING,      // String (header and text) of up to 272 bytes
+  SLAB_KIND_COUNT
+} SlabKind;
+
+/**
+ * Allocate a block of at least size bytes
+ *
+ * @param size Bytes needed (0 is allowed and returns a valid block)
+ * @param kind What the block holds, for --alloc-stats
+ * @return The block, or NULL if out of memory
+ */
+void *Slab_alloc(size_t size, SlabKind kind);
+
+/**
+ * Usable size of the block Slab_alloc(size, ...) returns
+ *
+ * @param size Bytes requested
+ * @return The size class for size, or size itself above 272 bytes
+ */
+size_t Slab_blockSize(size_t size);
+
+/**
+ * Return a block obtained from Slab_alloc()
+ *
+ * @param ptr Block to free (NULL is ignored)
+ * @param size The size passed to Slab_alloc()
+ * @param kind The kind passed to Slab_alloc()
+ */
+void Slab_free(void *ptr, size_t size, SlabKind kind);
+
+/**
+ * Print allocated / freed / live counts per kind for the calling thread
+ *
+ * @param out Stream to print to
+ */
+void Slab_printStats(FILE *out);
+
+#endif // SLAB_H
@@ -0,0 +1,96 @@
+#include "source_buffer.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Source Loading for Franz
+ *
+ * A file of N bytes is mapped into a zero-filled anonymous reservation of
+ * at least N + 1 bytes. The file replaces the start of the reservation, so
+ * the byte after the text is always mapped and zero, even when N is a
+ * multiple of the page size.
+ */
+
+int SourceBuffer_mapFile(const char *path, SourceBuffer *buffer) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return -1;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    close(fd);
+    return -1;
+  }
+
+  size_t length = (size_t)info.st_size;
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  size_t mapSize = (length / pageSize + 1) * pageSize;
+
+  char *base = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    close(fd);
+    return -1;
+  }
+
+  if (length > 0 &&
+      mmap(base, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    munmap(base, mapSize);
+    close(fd);
+    return -1;
+  }
+  close(fd);
+
+  // The lexer walks the text once from start to end
+  madvise(base, mapSize, MADV_SEQUENTIAL);
+
+  buffer->code = base;
+  buffer->length = (long)length;
+  buffer->mapSize = mapSize;
+  return 0;
+}
+
+int SourceBuffer_readStream(FILE *stream, SourceBuffer *buffer) {
+  size_t capacity = SOURCE_BUFFER_STDIN_CHUNK;
+  size_t length = 0;
+  char *code = malloc(capacity);
+  if (!code) return -1;
+
+  for (;;) {
+    // Keep room for the terminator
+    if (capacity - length < 2) {
+      char *grown = realloc(code, capacity * 2);
+      if (!grown) {
+        free(code);
+        return -1;
+      }
+      code = grown;
+      capacity *= 2;
+    }
+
+    size_t read = fread(code + length, 1, capacity - length - 1, stream);
+    if (read == 0) break;
+    length += read;
+  }
+  code[length] = '\0';
+
+  buffer->code = code;
+  buffer->length = (long)length;
+  buffer->mapSize = 0;
+  return 0;
+}
+
+void SourceBuffer_release(SourceBuffer *buffer) {
+  if (!buffer->code) return;
+
+  if (buffer->mapSize > 0) {
+    munmap(buffer->code, buffer->mapSize);
+  } else {
+    free(buffer->code);
+  }
+  buffer->code = NULL;
+  buffer->length = 0;
+  buffer->mapSize = 0;
+}
@@ -0,0 +1,52 @@
+#ifndef SOURCE_BUFFER_H
+#define SOURCE_BUFFER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * Source Loading for Franz
+ *
+ * Script files are mapped with mmap() instead of being copied into a heap
+ * buffer, and piped programs are read from stdin in large chunks. Either
+ * way the text is followed by at least one '\0', which the lexer relies on
+ * when it looks one character ahead.
+ *
+ * Tokens point into this buffer (see tokens.h), so it must stay alive until
+ * the program has been parsed.
+ */
+
+// Initial buffer size for piped programs; doubled as needed
+#define SOURCE_BUFFER_STDIN_CHUNK (64 * 1024)
+
+typedef struct SourceBuffer {
+  char *code;       // Source text, '\0'-terminated
+  long length;      // Number of source bytes (excluding the terminator)
+  size_t mapSize;   // Size of the mapping, 0 for heap buffers
+} SourceBuffer;
+
+/**
+ * Map a script file into memory
+ * The mapping is private: writes to the buffer never reach the file.
+ *
+ * @param path Script path
+ * @param buffer Filled in on success
+ * @return 0 on success, -1 if the file could not be opened or mapped
+ */
+int SourceBuffer_mapFile(const char *path, SourceBuffer *buffer);
+
+/**
+ * Read a whole stream (piped stdin) into a heap buffer
+ *
+ * @param stream Stream to read until EOF
+ * @param buffer Filled in on success
+ * @return 0 on success, -1 if out of memory
+ */
+int SourceBuffer_readStream(FILE *stream, SourceBuffer *buffer);
+
+/**
+ * Unmap or free the buffer
+ */
+void SourceBuffer_release(SourceBuffer *buffer);
+
+#endif // SOURCE_BUFFER_H
@@ -29,6 +29,9 @@
 #include "error-handling/error_handler.h"
 #include "mutable-refs/ref.h"  //  Mutable reference support
 #include "number-formats/number_parse.h"  // Multi-base & formatting
+#include "intern/intern.h"  //  Interned strings
+#include "string-object/string_object.h"  //  Length-prefixed strings
+#include "trace/trace.h"  //  --trace= / FRANZ_TRACE records
 
 /* tools, used later in stdlib */
 // validate number of arguments
@@ -90,22 +93,22 @@ void validateType(enum Type allowedTypes[], int typeCount, enum Type type, int a
 }
 
 // validate that argument is binary
-void validateBinary(int *p_val, int argNum, int lineNumber, char* funcName) {
-  if (*(p_val) != 0 && *(p_val) != 1) {
+void validateBinary(int64_t val, int argNum, int lineNumber, char* funcName) {
+  if (val != 0 && val != 1) {
     printf(
-      "Runtime Error @ Line %i: %s function expected 0 or 1 for argument #%i, %i supplied instead.\n", 
-      lineNumber, funcName, argNum, *p_val
+      "Runtime Error @ Line %i: %s function expected 0 or 1 for argument #%i, %lld supplied instead.\n", 
+      lineNumber, funcName, argNum, (long long) val
     );
     exit(0);
   }
 }
 
 // validate that argument is within a range
-void validateRange(int *p_val, int min, int max, int argNum, int lineNumber, char* funcName) {
-  if (*p_val > max || *p_val < min) {
+void validateRange(int64_t val, int min, int max, int argNum, int lineNumber, char* funcName) {
+  if (val > max || val < min) {
     printf(
-      "Runtime Error @ Line %i: %s function expected a value in the range [%i, %i] for argument #%i, %i supplied instead.\n", 
-      lineNumber, funcName, min, max, argNum, *p_val
+      "Runtime Error @ Line %i: %s function expected a value in the range [%i, %i] for argument #%i, %lld supplied instead.\n", 
+      lineNumber, funcName, min, max, argNum, (long long) val
     );
 
     exit(0);
@@ -113,11 +116,11 @@ void validateRange(int *p_val, int min, int max, int argNum, int lineNumber, cha
 }
 
 // validate that value is at least a minimum
-void validateMin(int *p_val, int min, int argNum, int lineNumber, char* funcName) {
-  if (*p_val < min) {
+void validateMin(int64_t val, int min, int argNum, int lineNumber, char* funcName) {
+  if (val < min) {
     printf(
-      "Runtime Error @ Line %i: %s function expected a minimum value of %i for argument #%i, %i supplied instead.\n", 
-      lineNumber, funcName, min, argNum, *p_val
+      "Runtime Error @ Line %i: %s function expected a minimum value of %i for argument #%i, %lld supplied instead.\n", 
+      lineNumber, funcName, min, argNum, (long long) val
     );
 
     exit(0);
@@ -190,7 +193,7 @@ Generic *applyFunc(Generic *func, Scope *p_scope, Generic *args[], int length, i
 
       for (int j = 0; j < keyCount; j++) {
         if (keys[j]->type == TYPE_STRING) {
-          char *varName = *((char **) keys[j]->p_val);
+          char *varName = keys[j]->strVal;
           Generic *val = Dict_get(p_closure_ptr->p_snapshot, keys[j]);
 
           if (val != NULL) {
@@ -257,7 +260,7 @@ Generic *StdLib_print(Scope *p_scope, Generic *args[], int length, int lineNumbe
   }
   fflush(stdout);  // Flush output buffer to ensure immediate display
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (println args...)
@@ -268,7 +271,7 @@ Generic *StdLib_println(Scope *p_scope, Generic *args[], int length, int lineNum
     if (i < length - 1) printf(" ");
   }
   printf("\n");
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (input)
@@ -302,11 +305,8 @@ Generic *StdLib_input(Scope *p_scope, Generic *args[], int length, int lineNumbe
   // enable events again (turn off echo)
   tcsetattr(STDIN_FILENO, TCSAFLUSH, &run_termios);
 
-  // create pointer
-  char **p_res = (char **) malloc(sizeof(char *));
-  *p_res = res;
 
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(String_fromHeap(res), 0);
 }
 
 // (columns)
@@ -317,11 +317,10 @@ Generic *StdLib_columns(Scope *p_scope, Generic *args[], int length, int lineNum
   ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
 
   // create pointer to rows
-  int *rows = (int *) malloc(sizeof(int));
-  *rows = w.ws_col;
+  int64_t rows = w.ws_col;
 
   // return generic
-  return Generic_new(TYPE_INT, rows, 0);
+  return Generic_newInt(rows, 0);
 }
 
 // (rows)
@@ -332,11 +331,10 @@ Generic *StdLib_rows(Scope *p_scope, Generic *args[], int length, int lineNumber
   ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
 
   // create pointer to rows
-  int *rows = (int *) malloc(sizeof(int));
-  *rows = w.ws_row;
+  int64_t rows = w.ws_row;
 
   // return generic
-  return Generic_new(TYPE_INT, rows, 0);
+  return Generic_newInt(rows, 0);
 }
 
 // (read_file filepath)
@@ -348,17 +346,13 @@ Generic *StdLib_read_file(Scope *p_scope, Generic *args[], int length, int lineN
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "read_file");
 
   // read file
-  char *res = readFile(*((char **) args[0]->p_val), false);
+  char *res = readFile(args[0]->strVal, false);
   
   // if file couldn't be read, return void
-  if (res == NULL) return Generic_new(TYPE_VOID, NULL, 0);
-
-  // malloc pointer to string
-  char **p_res = (char **) malloc(sizeof(char *));
-  *p_res = res;
+  if (res == NULL) return Generic_void();
 
   // return
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(String_fromHeap(res), 0);
 }
 
 // (write_file filepath string)
@@ -371,8 +365,8 @@ Generic *StdLib_write_file(Scope *p_scope, Generic *args[], int length, int line
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "write_file");
   validateType(allowedTypes, 1, args[1]->type, 2, lineNumber, "write_file");
 
-  writeFile(*((char **) args[0]->p_val), *((char **) args[1]->p_val), lineNumber);
-  return Generic_new(TYPE_VOID, NULL, 0);
+  writeFile(args[0]->strVal, args[1]->strVal, lineNumber);
+  return Generic_void();
 }
 
 //  (file_exists filepath)
@@ -384,14 +378,12 @@ Generic *StdLib_file_exists(Scope *p_scope, Generic *args[], int length, int lin
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "file_exists");
 
   // check if file exists
-  int exists = fileExists(*((char **) args[0]->p_val));
+  int exists = fileExists(args[0]->strVal);
 
   // malloc pointer to int
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = exists;
 
   // return
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(exists, 0);
 }
 
 //  (append_file filepath string)
@@ -404,8 +396,8 @@ Generic *StdLib_append_file(Scope *p_scope, Generic *args[], int length, int lin
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "append_file");
   validateType(allowedTypes, 1, args[1]->type, 2, lineNumber, "append_file");
 
-  appendFile(*((char **) args[0]->p_val), *((char **) args[1]->p_val), lineNumber);
-  return Generic_new(TYPE_VOID, NULL, 0);
+  appendFile(args[0]->strVal, args[1]->strVal, lineNumber);
+  return Generic_void();
 }
 
 // ============================================================================
@@ -421,17 +413,17 @@ Generic *StdLib_read_binary(Scope *p_scope, Generic *args[], int length, int lin
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "read_binary");
 
   size_t size = 0;
-  char *data = readBinary(*((char **) args[0]->p_val), &size);
+  char *data = readBinary(args[0]->strVal, &size);
 
   if (data == NULL) {
     // Return empty string on error
-    char *empty = malloc(1);
-    empty[0] = '\0';
-    return Generic_new(TYPE_STRING, &empty, 0);
+    return Generic_newString(String_new(0), 0);
   }
 
-  // Return binary data as string
-  return Generic_new(TYPE_STRING, &data, 0);
+  // Return binary data as string; its length is size, so NUL bytes are kept
+  char *res = String_fromBytes(data, (int) size);
+  free(data);
+  return Generic_newString(res, 0);
 }
 
 // (write_binary filepath data)
@@ -443,12 +435,12 @@ Generic *StdLib_write_binary(Scope *p_scope, Generic *args[], int length, int li
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "write_binary");
   validateType(allowedTypes, 1, args[1]->type, 2, lineNumber, "write_binary");
 
-  char *path = *((char **) args[0]->p_val);
-  char *data = *((char **) args[1]->p_val);
+  char *path = args[0]->strVal;
+  char *data = args[1]->strVal;
   size_t size = strlen(data);  // Get data length
 
   writeBinary(path, data, size, lineNumber);
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (list_files dirpath)
@@ -459,7 +451,7 @@ Generic *StdLib_list_files(Scope *p_scope, Generic *args[], int length, int line
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "list_files");
 
-  List *fileList = listFiles(*((char **) args[0]->p_val), lineNumber);
+  List *fileList = listFiles(args[0]->strVal, lineNumber);
 
   return Generic_new(TYPE_LIST, fileList, 0);
 }
@@ -472,11 +464,9 @@ Generic *StdLib_create_dir(Scope *p_scope, Generic *args[], int length, int line
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "create_dir");
 
-  int result = createDir(*((char **) args[0]->p_val), lineNumber);
+  int result = createDir(args[0]->strVal, lineNumber);
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = result;
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(result, 0);
 }
 
 // (dir_exists dirpath)
@@ -487,11 +477,9 @@ Generic *StdLib_dir_exists(Scope *p_scope, Generic *args[], int length, int line
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "dir_exists");
 
-  int exists = dirExists(*((char **) args[0]->p_val));
+  int exists = dirExists(args[0]->strVal);
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = exists;
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(exists, 0);
 }
 
 // (remove_dir dirpath)
@@ -502,11 +490,9 @@ Generic *StdLib_remove_dir(Scope *p_scope, Generic *args[], int length, int line
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "remove_dir");
 
-  int result = removeDir(*((char **) args[0]->p_val), lineNumber);
+  int result = removeDir(args[0]->strVal, lineNumber);
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = result;
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(result, 0);
 }
 
 // (file_size filepath)
@@ -517,11 +503,9 @@ Generic *StdLib_file_size(Scope *p_scope, Generic *args[], int length, int lineN
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "file_size");
 
-  long size = fileSize(*((char **) args[0]->p_val));
+  long size = fileSize(args[0]->strVal);
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = (int)size;  // Cast long to int
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(size, 0);
 }
 
 // (file_mtime filepath)
@@ -532,11 +516,9 @@ Generic *StdLib_file_mtime(Scope *p_scope, Generic *args[], int length, int line
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "file_mtime");
 
-  long mtime = fileMtime(*((char **) args[0]->p_val));
+  long mtime = fileMtime(args[0]->strVal);
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = (int)mtime;  // Cast long to int
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(mtime, 0);
 }
 
 // (is_directory path)
@@ -547,11 +529,9 @@ Generic *StdLib_is_directory(Scope *p_scope, Generic *args[], int length, int li
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "is_directory");
 
-  int isDir = isDirectory(*((char **) args[0]->p_val));
+  int isDir = isDirectory(args[0]->strVal);
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = isDir;
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(isDir, 0);
 }
 
 // (event time) or (event)
@@ -566,31 +546,31 @@ Generic *StdLib_event(Scope *p_scope, Generic *args[], int length, int lineNumbe
     validateType(allowedTypes, 3, args[0]->type, 1, lineNumber, "event");
   
     if (args[0]->type == TYPE_INT) {
-      decisecondsBlock = *((int *) args[0]->p_val) * 10;
+      decisecondsBlock = args[0]->intVal * 10;
     }
     if (args[0]->type == TYPE_FLOAT) {
-      decisecondsBlock = (int) ceilf(*((double *) args[0]->p_val) * 10);
+      decisecondsBlock = (int) ceilf(args[0]->floatVal * 10);
     }
   }
 
-  char **p_res = (char **) malloc(sizeof(char *));
+  char *res = NULL;
 
   int i = 0;
   while (length == 0 || i < decisecondsBlock) {
     if (i != 0) {
-      free(*p_res);
+      free(res);
     }
-    *p_res = event();
+    res = event();
 
     // if an event is received
-    if (strcmp(*p_res, "") != 0) {
-      return Generic_new(TYPE_STRING, p_res, 0);
+    if (strcmp(res, "") != 0) {
+      return Generic_newString(String_fromHeap(res), 0);
     }
 
     i += 1;
   }
   
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(String_fromHeap(res), 0);
 }
 
 // (use path1 path2 path3 ... fn)
@@ -613,7 +593,7 @@ Generic *StdLib_use(Scope *p_scope, Generic *args[], int length, int lineNumber)
 
   // for each path
   for (int i = 0; i < length - 1; i++) {
-    char *module_path = *((char **) args[i]->p_val);
+    char *module_path = args[i]->strVal;
     AstNode *p_headAstNode = NULL;
 
     // Check for circular dependency BEFORE loading
@@ -689,7 +669,7 @@ Generic *StdLib_use_as(Scope *p_scope, Generic *args[], int length, int lineNumb
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "use_as");
 
-  char *module_path = *((char **) args[0]->p_val);
+  char *module_path = args[0]->strVal;
   AstNode *p_headAstNode = NULL;
 
   // Check for circular dependency BEFORE loading
@@ -784,7 +764,7 @@ Generic *StdLib_use_with(Scope *p_scope, Generic *args[], int length, int lineNu
 
   // Load and evaluate each module file in the capability-restricted scope
   for (int i = 1; i < length - 1; i++) {
-    char *module_path = *((char **) args[i]->p_val);
+    char *module_path = args[i]->strVal;
     AstNode *p_headAstNode = NULL;
 
     // Check for circular dependency BEFORE loading
@@ -862,7 +842,7 @@ Generic *StdLib_shell(Scope *p_scope, Generic *args[], int length, int lineNumbe
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "shell");
 
   // open process to run file
-  FILE *p_out = popen(*((char **) args[0]->p_val), "r");
+  FILE *p_out = popen(args[0]->strVal, "r");
 
   // ensure process returned
   if (p_out == NULL) {
@@ -889,11 +869,8 @@ Generic *StdLib_shell(Scope *p_scope, Generic *args[], int length, int lineNumbe
   // close process
   pclose(p_out);
 
-  // create pointer for generic to return
-  char **p_res = malloc(sizeof(char *));
-  *p_res = res;
   
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(String_fromHeap(res), 0);
 }
 
 /* comparissions */
@@ -904,9 +881,7 @@ Generic *StdLib_is(Scope *p_scope, Generic *args[], int length, int lineNumber)
   validateArgCount(2, 2, length, lineNumber);
 
   // return
-  int *res = (int *) malloc(sizeof(int));
-  *res = Generic_is(args[0], args[1]);
-  return Generic_new(TYPE_INT, res, 0);
+  return Generic_newInt(Generic_is(args[0], args[1]), 0);
 }
 
 // (less_than a b)
@@ -922,13 +897,12 @@ Generic *StdLib_less_than(Scope *p_scope, Generic *args[], int length, int lineN
   // do comparision and return
   Generic *a = args[0];
   Generic *b = args[1];
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = (
-    (a->type == TYPE_FLOAT ? *((double *) a->p_val) : *((int *) a->p_val))
-    < (b->type == TYPE_FLOAT ? *((double *) b->p_val) : *((int *) b->p_val))
+  int64_t res = (
+    (a->type == TYPE_FLOAT ? a->floatVal : a->intVal)
+    < (b->type == TYPE_FLOAT ? b->floatVal : b->intVal)
   );
 
-  return Generic_new(TYPE_INT, p_res, 0); 
+  return Generic_newInt(res, 0); 
 }
 
 // (greater_than a b)
@@ -944,13 +918,12 @@ Generic *StdLib_greater_than(Scope *p_scope, Generic *args[], int length, int li
   // do comparision and return
   Generic *a = args[0];
   Generic *b = args[1];
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = (
-    (a->type == TYPE_FLOAT ? *((double *) a->p_val) : *((int *) a->p_val))
-    > (b->type == TYPE_FLOAT ? *((double *) b->p_val) : *((int *) b->p_val))
+  int64_t res = (
+    (a->type == TYPE_FLOAT ? a->floatVal : a->intVal)
+    > (b->type == TYPE_FLOAT ? b->floatVal : b->intVal)
   );
 
-  return Generic_new(TYPE_INT, p_res, 0); 
+  return Generic_newInt(res, 0); 
 }
 
 /* logical operators */
@@ -962,12 +935,11 @@ Generic *StdLib_not(Scope *p_scope, Generic *args[], int length, int lineNumber)
   enum Type allowedTypes[] = {TYPE_INT};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "not");
 
-  validateBinary(args[0]->p_val, 1, lineNumber, "not");
+  validateBinary(args[0]->intVal, 1, lineNumber, "not");
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = 1 - *((int *) args[0]->p_val);
+  int64_t res = 1 - args[0]->intVal;
 
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(res, 0);
 }
 
 // (and a b)
@@ -979,19 +951,18 @@ Generic *StdLib_and(Scope *p_scope, Generic *args[], int length, int lineNumber)
   enum Type allowedTypes[] = {TYPE_INT};
   for (int i = 0; i < length; i++) {
     validateType(allowedTypes, 1, args[i]->type, i + 1, lineNumber, "and");
-    validateBinary(args[i]->p_val, i + 1, lineNumber, "and");
+    validateBinary(args[i]->intVal, i + 1, lineNumber, "and");
   };
 
   // set up result
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = 1;
+  int64_t res = 1;
 
-  // add each arg to *p_res
+  // add each arg to res
   for (int i = 0; i < length; i++) {
-    *p_res = *p_res && *((int *) args[i]->p_val);
+    res = res && args[i]->intVal;
   }
 
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(res, 0);
 }
 
 // (or a b ...)
@@ -1003,19 +974,18 @@ Generic *StdLib_or(Scope *p_scope, Generic *args[], int length, int lineNumber)
   enum Type allowedTypes[] = {TYPE_INT};
   for (int i = 0; i < length; i++) {
     validateType(allowedTypes, 1, args[i]->type, i + 1, lineNumber, "or");
-    validateBinary(args[i]->p_val, i + 1, lineNumber, "or");
+    validateBinary(args[i]->intVal, i + 1, lineNumber, "or");
   };
 
   // set up result
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = 0;
+  int64_t res = 0;
 
-  // add each arg to *p_res
+  // add each arg to res
   for (int i = 0; i < length; i++) {
-    *p_res = *p_res || *((int *) args[i]->p_val);
+    res = res || args[i]->intVal;
   }
 
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(res, 0);
 }
 
 /* arithmetic */
@@ -1036,29 +1006,27 @@ Generic *StdLib_add(Scope *p_scope, Generic *args[], int length, int lineNumber)
   
   if (resIsInt) {
     // case where we can return int
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = 0;
+    int64_t res = 0;
 
-    // add each arg to *p_res
+    // add each arg to res
     for (int i = 0; i < length; i++) {
-      *p_res += *((int *) args[i]->p_val);
+      res += args[i]->intVal;
     }
 
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(res, 0);
 
   } else {
     // case where we must return float
-    double *p_res = (double *) malloc(sizeof(double));
-    *p_res = 0;
+    double res = 0;
 
-    // add each arg to *p_res
+    // add each arg to res
     for (int i = 0; i < length; i++) {
-      *p_res += args[i]->type == TYPE_FLOAT 
-        ? *((double *) args[i]->p_val) 
-        : *((int *) args[i]->p_val);
+      res += args[i]->type == TYPE_FLOAT 
+        ? args[i]->floatVal 
+        : args[i]->intVal;
     }
 
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(res, 0);
   }
 }
 
@@ -1079,31 +1047,29 @@ Generic *StdLib_subtract(Scope *p_scope, Generic *args[], int length, int lineNu
   
   if (resIsInt) {
     // case where we can return int
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = *((int *) args[0]->p_val);
+    int64_t res = args[0]->intVal;
 
-    // subtract each arg from *p_res
+    // subtract each arg from res
     for (int i = 1; i < length; i++) {
-      *p_res -= *((int *) args[i]->p_val);
+      res -= args[i]->intVal;
     }
 
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(res, 0);
 
   } else {
     // case where we must return float
-    double *p_res = (double *) malloc(sizeof(double));
-    *p_res = args[0]->type == TYPE_FLOAT 
-        ? *((double *) args[0]->p_val) 
-        : *((int *) args[0]->p_val);;
+    double res = args[0]->type == TYPE_FLOAT 
+        ? args[0]->floatVal 
+        : args[0]->intVal;;
 
-    // subtract each arg from *p_res
+    // subtract each arg from res
     for (int i = 1; i < length; i++) {
-      *p_res -= args[i]->type == TYPE_FLOAT 
-        ? *((double *) args[i]->p_val) 
-        : *((int *) args[i]->p_val);
+      res -= args[i]->type == TYPE_FLOAT 
+        ? args[i]->floatVal 
+        : args[i]->intVal;
     }
 
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(res, 0);
   }
 }
 
@@ -1119,16 +1085,15 @@ Generic *StdLib_divide(Scope *p_scope, Generic *args[], int length, int lineNumb
   };
   
   // initial value
-  double *p_res = (double *) malloc(sizeof(double));
-  *p_res = args[0]->type == TYPE_FLOAT 
-      ? *((double *) args[0]->p_val) 
-      : *((int *) args[0]->p_val);;
+  double res = args[0]->type == TYPE_FLOAT 
+      ? args[0]->floatVal 
+      : args[0]->intVal;;
 
-  // divide each arg from *p_res
+  // divide each arg from res
   for (int i = 1; i < length; i++) {
     double val = args[i]->type == TYPE_FLOAT 
-      ? *((double *) args[i]->p_val) 
-      : *((int *) args[i]->p_val);
+      ? args[i]->floatVal 
+      : args[i]->intVal;
 
     if (val == 0) {
       // throw error for division by 0
@@ -1139,10 +1104,10 @@ Generic *StdLib_divide(Scope *p_scope, Generic *args[], int length, int lineNumb
       exit(0);
     };
 
-    *p_res /= val;
+    res /= val;
   }
 
-  return Generic_new(TYPE_FLOAT, p_res, 0);
+  return Generic_newFloat(res, 0);
 }
 
 // (multiply arg1 arg2 arg3 ...)
@@ -1162,31 +1127,29 @@ Generic *StdLib_multiply(Scope *p_scope, Generic *args[], int length, int lineNu
   
   if (resIsInt) {
     // case where we can return int
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = *((int *) args[0]->p_val);;
+    int64_t res = args[0]->intVal;;
 
-    // multiply each arg to *p_res
+    // multiply each arg to res
     for (int i = 1; i < length; i++) {
-      *p_res *= *((int *) args[i]->p_val);
+      res *= args[i]->intVal;
     }
 
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(res, 0);
 
   } else {
     // case where we must return float
-    double *p_res = (double *) malloc(sizeof(double));
-    *p_res = args[0]->type == TYPE_FLOAT 
-        ? *((double *) args[0]->p_val) 
-        : *((int *) args[0]->p_val);
+    double res = args[0]->type == TYPE_FLOAT 
+        ? args[0]->floatVal 
+        : args[0]->intVal;
 
-    // multiply each arg to *p_res
+    // multiply each arg to res
     for (int i = 1; i < length; i++) {
-      *p_res *= args[i]->type == TYPE_FLOAT 
-        ? *((double *) args[i]->p_val) 
-        : *((int *) args[i]->p_val);
+      res *= args[i]->type == TYPE_FLOAT 
+        ? args[i]->floatVal 
+        : args[i]->intVal;
     }
 
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(res, 0);
   }
 }
 
@@ -1199,7 +1162,7 @@ Generic *StdLib_remainder(Scope *p_scope, Generic *args[], int length, int lineN
   validateType(allowedTypes, 3, args[0]->type, 1, lineNumber, "remainder");
   validateType(allowedTypes, 3, args[1]->type, 2, lineNumber, "remainder");
 
-  if ((args[1]->type == TYPE_FLOAT ? *((double *) args[1]->p_val) : *((int *) args[1]->p_val)) == 0) {
+  if ((args[1]->type == TYPE_FLOAT ? args[1]->floatVal : args[1]->intVal) == 0) {
     // throw error for division by 0
     printf(
       "Runtime Error @ Line %i: Remainder of division by 0.\n", 
@@ -1210,19 +1173,15 @@ Generic *StdLib_remainder(Scope *p_scope, Generic *args[], int length, int lineN
 
   if (args[0]->type == TYPE_INT && args[1]->type == TYPE_INT) {
     // if we can return integer
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = *((int *) args[0]->p_val) % *((int *) args[1]->p_val);
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(args[0]->intVal % args[1]->intVal, 0);
   } else {
     // if we must return float
-    double *p_res = (double *) malloc(sizeof(double));
-
-    *p_res = fmod(
-      (args[0]->type == TYPE_FLOAT ? *((double *) args[0]->p_val) : *((int *) args[0]->p_val)),
-      (args[1]->type == TYPE_FLOAT ? *((double *) args[1]->p_val) : *((int *) args[1]->p_val))
+    double res = fmod(
+      (args[0]->type == TYPE_FLOAT ? args[0]->floatVal : args[0]->intVal),
+      (args[1]->type == TYPE_FLOAT ? args[1]->floatVal : args[1]->intVal)
     );
 
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(res, 0);
   }
 }
 
@@ -1237,24 +1196,20 @@ Generic *StdLib_power(Scope *p_scope, Generic *args[], int length, int lineNumbe
 
   if (args[0]->type == TYPE_INT && args[1]->type == TYPE_INT) {
     // if we can return integer
-    int *p_res = (int *) malloc(sizeof(int));
-
-    *p_res = pow(
-      *((int *) args[0]->p_val),
-      *((int *) args[1]->p_val)
+    int64_t res = pow(
+      args[0]->intVal,
+      args[1]->intVal
     );
 
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(res, 0);
   } else {
     // if we must return float
-    double *p_res = (double *) malloc(sizeof(double));
-
-    *p_res = pow(
-      (args[0]->type == TYPE_FLOAT ? *((double *) args[0]->p_val) : *((int *) args[0]->p_val)),
-      (args[1]->type == TYPE_FLOAT ? *((double *) args[1]->p_val) : *((int *) args[1]->p_val))
+    double res = pow(
+      (args[0]->type == TYPE_FLOAT ? args[0]->floatVal : args[0]->intVal),
+      (args[1]->type == TYPE_FLOAT ? args[1]->floatVal : args[1]->intVal)
     );
 
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(res, 0);
   }
 }
 
@@ -1263,10 +1218,9 @@ Generic *StdLib_power(Scope *p_scope, Generic *args[], int length, int lineNumbe
 Generic *StdLib_random(Scope *p_scope, Generic *args[], int length, int lineNumber) {
   validateArgCount(0, 0, length, lineNumber);
 
-  double *p_res = (double *) malloc(sizeof(double));
-  *p_res = (double) rand() / (double) RAND_MAX;
+  double res = (double) rand() / (double) RAND_MAX;
   
-  return Generic_new(TYPE_FLOAT, p_res, 0);
+  return Generic_newFloat(res, 0);
 }
 
 // (floor n)
@@ -1279,14 +1233,10 @@ Generic *StdLib_floor(Scope *p_scope, Generic *args[], int length, int lineNumbe
 
   if (args[0]->type == TYPE_INT) {
     // Already an integer, return as-is
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = *((int *) args[0]->p_val);
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(args[0]->intVal, 0);
   } else {
     // Float - use floor function
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = (int) floor(*((double *) args[0]->p_val));
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt((int) floor(args[0]->floatVal), 0);
   }
 }
 
@@ -1300,14 +1250,10 @@ Generic *StdLib_ceil(Scope *p_scope, Generic *args[], int length, int lineNumber
 
   if (args[0]->type == TYPE_INT) {
     // Already an integer, return as-is
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = *((int *) args[0]->p_val);
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(args[0]->intVal, 0);
   } else {
     // Float - use ceil function
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = (int) ceil(*((double *) args[0]->p_val));
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt((int) ceil(args[0]->floatVal), 0);
   }
 }
 
@@ -1321,14 +1267,10 @@ Generic *StdLib_round(Scope *p_scope, Generic *args[], int length, int lineNumbe
 
   if (args[0]->type == TYPE_INT) {
     // Already an integer, return as-is
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = *((int *) args[0]->p_val);
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(args[0]->intVal, 0);
   } else {
     // Float - use round function
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = (int) round(*((double *) args[0]->p_val));
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt((int) round(args[0]->floatVal), 0);
   }
 }
 
@@ -1341,14 +1283,10 @@ Generic *StdLib_abs(Scope *p_scope, Generic *args[], int length, int lineNumber)
   validateType(allowedTypes, 2, args[0]->type, 1, lineNumber, "abs");
 
   if (args[0]->type == TYPE_INT) {
-    int *p_res = (int *) malloc(sizeof(int));
-    int val = *((int *) args[0]->p_val);
-    *p_res = val < 0 ? -val : val;
-    return Generic_new(TYPE_INT, p_res, 0);
+    int64_t val = args[0]->intVal;
+    return Generic_newInt(val < 0 ? -val : val, 0);
   } else {
-    double *p_res = (double *) malloc(sizeof(double));
-    *p_res = fabs(*((double *) args[0]->p_val));
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(fabs(args[0]->floatVal), 0);
   }
 }
 
@@ -1376,28 +1314,24 @@ Generic *StdLib_min(Scope *p_scope, Generic *args[], int length, int lineNumber)
   if (hasFloat) {
     // Find minimum as float
     double minVal = args[0]->type == TYPE_FLOAT ?
-      *((double *) args[0]->p_val) : (double)(*((int *) args[0]->p_val));
+      args[0]->floatVal : (double)(args[0]->intVal);
 
     for (int i = 1; i < length; i++) {
       double val = args[i]->type == TYPE_FLOAT ?
-        *((double *) args[i]->p_val) : (double)(*((int *) args[i]->p_val));
+        args[i]->floatVal : (double)(args[i]->intVal);
       if (val < minVal) minVal = val;
     }
 
-    double *p_res = (double *) malloc(sizeof(double));
-    *p_res = minVal;
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(minVal, 0);
   } else {
     // All integers
-    int minVal = *((int *) args[0]->p_val);
+    int minVal = args[0]->intVal;
     for (int i = 1; i < length; i++) {
-      int val = *((int *) args[i]->p_val);
+      int val = args[i]->intVal;
       if (val < minVal) minVal = val;
     }
 
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = minVal;
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(minVal, 0);
   }
 }
 
@@ -1425,28 +1359,24 @@ Generic *StdLib_max(Scope *p_scope, Generic *args[], int length, int lineNumber)
   if (hasFloat) {
     // Find maximum as float
     double maxVal = args[0]->type == TYPE_FLOAT ?
-      *((double *) args[0]->p_val) : (double)(*((int *) args[0]->p_val));
+      args[0]->floatVal : (double)(args[0]->intVal);
 
     for (int i = 1; i < length; i++) {
       double val = args[i]->type == TYPE_FLOAT ?
-        *((double *) args[i]->p_val) : (double)(*((int *) args[i]->p_val));
+        args[i]->floatVal : (double)(args[i]->intVal);
       if (val > maxVal) maxVal = val;
     }
 
-    double *p_res = (double *) malloc(sizeof(double));
-    *p_res = maxVal;
-    return Generic_new(TYPE_FLOAT, p_res, 0);
+    return Generic_newFloat(maxVal, 0);
   } else {
     // All integers
-    int maxVal = *((int *) args[0]->p_val);
+    int maxVal = args[0]->intVal;
     for (int i = 1; i < length; i++) {
-      int val = *((int *) args[i]->p_val);
+      int val = args[i]->intVal;
       if (val > maxVal) maxVal = val;
     }
 
-    int *p_res = (int *) malloc(sizeof(int));
-    *p_res = maxVal;
-    return Generic_new(TYPE_INT, p_res, 0);
+    return Generic_newInt(maxVal, 0);
   }
 }
 
@@ -1458,15 +1388,15 @@ Generic *StdLib_sqrt(Scope *p_scope, Generic *args[], int length, int lineNumber
   enum Type allowedTypes[] = {TYPE_INT, TYPE_FLOAT};
   validateType(allowedTypes, 2, args[0]->type, 1, lineNumber, "sqrt");
 
-  double *p_res = (double *) malloc(sizeof(double));
+  double res = 0;
 
   if (args[0]->type == TYPE_INT) {
-    *p_res = sqrt((double)(*((int *) args[0]->p_val)));
+    res = sqrt((double)(args[0]->intVal));
   } else {
-    *p_res = sqrt(*((double *) args[0]->p_val));
+    res = sqrt(args[0]->floatVal);
   }
 
-  return Generic_new(TYPE_FLOAT, p_res, 0);
+  return Generic_newFloat(res, 0);
 }
 
 // (random_int n)
@@ -1477,7 +1407,7 @@ Generic *StdLib_random_int(Scope *p_scope, Generic *args[], int length, int line
   enum Type allowedTypes[] = {TYPE_INT};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "random_int");
 
-  int maxVal = *((int *) args[0]->p_val);
+  int maxVal = args[0]->intVal;
 
   if (maxVal <= 0) {
     printf("Runtime Error @ Line %i: random_int argument must be positive (got %d).\n",
@@ -1485,10 +1415,9 @@ Generic *StdLib_random_int(Scope *p_scope, Generic *args[], int length, int line
     exit(0);
   }
 
-  int *p_res = (int *) malloc(sizeof(int));
-  *p_res = rand() % maxVal;
+  int64_t res = rand() % maxVal;
 
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(res, 0);
 }
 
 // (random_range min max)
@@ -1502,9 +1431,9 @@ Generic *StdLib_random_range(Scope *p_scope, Generic *args[], int length, int li
 
   // Convert both args to doubles
   double minVal = args[0]->type == TYPE_FLOAT ?
-    *((double *) args[0]->p_val) : (double)(*((int *) args[0]->p_val));
+    args[0]->floatVal : (double)(args[0]->intVal);
   double maxVal = args[1]->type == TYPE_FLOAT ?
-    *((double *) args[1]->p_val) : (double)(*((int *) args[1]->p_val));
+    args[1]->floatVal : (double)(args[1]->intVal);
 
   if (minVal >= maxVal) {
     printf("Runtime Error @ Line %i: random_range min must be less than max (got min=%f, max=%f).\n",
@@ -1512,11 +1441,10 @@ Generic *StdLib_random_range(Scope *p_scope, Generic *args[], int length, int li
     exit(0);
   }
 
-  double *p_res = (double *) malloc(sizeof(double));
   double range = maxVal - minVal;
-  *p_res = minVal + (((double) rand() / (double) RAND_MAX) * range);
+  double res = minVal + (((double) rand() / (double) RAND_MAX) * range);
 
-  return Generic_new(TYPE_FLOAT, p_res, 0);
+  return Generic_newFloat(res, 0);
 }
 
 // (random_seed n)
@@ -1528,10 +1456,10 @@ Generic *StdLib_random_seed(Scope *p_scope, Generic *args[], int length, int lin
   enum Type allowedTypes[] = {TYPE_INT};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "random_seed");
 
-  int seed = *((int *) args[0]->p_val);
+  int seed = args[0]->intVal;
   srand((unsigned int)seed);
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 /* control */
@@ -1548,15 +1476,13 @@ Generic *StdLib_loop(Scope *p_scope, Generic *args[], int length, int lineNumber
   validateType(allowedTypes1, 1, args[0]->type, 1, lineNumber, "loop");
   validateType(allowedTypes2, 3, args[1]->type, 2, lineNumber, "loop");  //  3 types now
 
-  validateMin(args[0]->p_val, 0, 1, lineNumber, "loop");
+  validateMin(args[0]->intVal, 0, 1, lineNumber, "loop");
   
   // loop
-  for (int i = 0; i < *((int *) args[0]->p_val); i++) {
+  for (int i = 0; i < args[0]->intVal; i++) {
 
     // get arg to pass to cb
-    int *p_arg = (int *) malloc(sizeof(int));
-    *p_arg = i;
-    Generic *newArgs[1] = {Generic_new(TYPE_INT, p_arg, 0)};
+    Generic *newArgs[1] = {Generic_newInt(i, 0)};
     
     // call cb
     Generic *res = applyFunc(args[1], p_scope, newArgs, 1, lineNumber);
@@ -1566,7 +1492,7 @@ Generic *StdLib_loop(Scope *p_scope, Generic *args[], int length, int lineNumber
     else Generic_free(res);
   }
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (until stop f initial)
@@ -1586,7 +1512,7 @@ Generic *StdLib_until(Scope *p_scope, Generic *args[], int length, int lineNumbe
   if (length == 3) {
     state = Generic_copy(args[2]);
   } else {
-    state = Generic_new(TYPE_VOID, NULL, 0);
+    state = Generic_void();
   }
 
   // flags and index
@@ -1596,9 +1522,7 @@ Generic *StdLib_until(Scope *p_scope, Generic *args[], int length, int lineNumbe
   while (true) {
 
     // get index
-    int *p_i = (int *) malloc(sizeof(int));
-    *p_i = i;
-    Generic *newArgs[2] = {Generic_copy(state), Generic_new(TYPE_INT, p_i, 0)};
+    Generic *newArgs[2] = {Generic_copy(state), Generic_newInt(i, 0)};
 
     // callback
     Generic *res = applyFunc(args[1], p_scope, newArgs, 2, lineNumber);
@@ -1638,10 +1562,10 @@ Generic *StdLib_if(Scope *p_scope, Generic *args[], int length, int lineNumber)
       } else {
         // condition case
         validateType(allowedTypesCond, 1, args[i]->type, i + 1, lineNumber, "if");
-        validateBinary(args[i]->p_val, i + 1, lineNumber, "if");
+        validateBinary(args[i]->intVal, i + 1, lineNumber, "if");
 
         // find if condition is true
-        conditionPassed = *((int *) args[i]->p_val) == 1;
+        conditionPassed = args[i]->intVal == 1;
       }
     } else {
       // callback case
@@ -1654,7 +1578,7 @@ Generic *StdLib_if(Scope *p_scope, Generic *args[], int length, int lineNumber)
     }
   }
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (wait t)
@@ -1666,10 +1590,10 @@ Generic *StdLib_wait(Scope *p_scope, Generic *args[], int length, int lineNumber
   int initialTime = clock();
   while (
     (((double) clock()) - ((double) initialTime)) / ((double) CLOCKS_PER_SEC)
-    < (args[0]->type == TYPE_INT ? *((int *) args[0]->p_val) : *((double *) args[0]->p_val))
+    < (args[0]->type == TYPE_INT ? args[0]->intVal : args[0]->floatVal)
   ) {}
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (time)
@@ -1678,10 +1602,8 @@ Generic *StdLib_time(Scope *p_scope, Generic *args[], int length, int lineNumber
   validateArgCount(0, 0, length, lineNumber);
 
   double time_seconds = ((double) clock()) / ((double) CLOCKS_PER_SEC);
-  double *p_time = malloc(sizeof(double));
-  *p_time = time_seconds;
 
-  return Generic_new(TYPE_FLOAT, p_time, lineNumber);
+  return Generic_newFloat(time_seconds, lineNumber);
 }
 
 /* error handling */
@@ -1709,9 +1631,7 @@ Generic *StdLib_try(Scope *p_scope, Generic *args[], int length, int lineNumber)
     const char *error_msg = ErrorState_getMessage();
 
     // Create error message string to pass to handler
-    char **p_msg = malloc(sizeof(char *));
-    *p_msg = strdup(error_msg);
-    Generic *error_obj = Generic_new(TYPE_STRING, p_msg, 0);
+    Generic *error_obj = Generic_newString(String_fromText(error_msg), 0);
 
     // Clear the error before calling handler
     ErrorState_clearError();
@@ -1781,14 +1701,14 @@ Generic *StdLib_error(Scope *p_scope, Generic *args[], int length, int lineNumbe
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "error");
 
-  char *message = *((char **) args[0]->p_val);
+  char *message = args[0]->strVal;
 
   // Set error state (will exit if not in try block)
   ErrorState_setError(ERROR_CUSTOM, lineNumber, "%s", message);
 
   // If we reach here, we're in a try block - return void
   // (the try block will check for error and handle it)
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 /* types */
@@ -1800,20 +1720,20 @@ Generic *StdLib_integer(Scope *p_scope, Generic *args[], int length, int lineNum
   enum Type allowedTypes[] = {TYPE_STRING, TYPE_INT, TYPE_FLOAT};
   validateType(allowedTypes, 3, args[0]->type, 1, lineNumber, "integer");
 
-  int *p_res = malloc(sizeof(int));
+  int64_t res = 0;
 
   if (args[0]->type == TYPE_STRING) {
-    char *str = *((char **) args[0]->p_val);
-    *p_res = atoi(str);
+    char *str = args[0]->strVal;
+    res = atoi(str);
   } else if (args[0]->type == TYPE_FLOAT) {
-    double f = *((double *) args[0]->p_val);
-    *p_res = (int) f;
+    double f = args[0]->floatVal;
+    res = (int) f;
   } else {
-    int i = *((int *) args[0]->p_val);
-    *p_res = i;
+    int i = args[0]->intVal;
+    res = i;
   }
 
-  return Generic_new(TYPE_INT, p_res, 0);
+  return Generic_newInt(res, 0);
 }
 
 // (string x)
@@ -1824,26 +1744,23 @@ Generic *StdLib_string(Scope *p_scope, Generic *args[], int length, int lineNumb
   enum Type allowedTypes[] = {TYPE_STRING, TYPE_INT, TYPE_FLOAT};
   validateType(allowedTypes, 3, args[0]->type, 1, lineNumber, "string");
   
+  // a string is already immutable, so it is returned shared
+  if (args[0]->type == TYPE_STRING) return Generic_copy(args[0]);
+
   char *res;
 
   if (args[0]->type == TYPE_FLOAT) {
-    int length = snprintf(NULL, 0, "%f", *((double *) args[0]->p_val)); // get length
-    res = malloc(sizeof(char) * (length + 1)); // allocate memory
-    snprintf(res, length + 1, "%f", *((double *) args[0]->p_val)); // populate memory
-  } else if (args[0]->type == TYPE_INT) {
-    int length = snprintf(NULL, 0, "%i", *((int *) args[0]->p_val));
-    res = malloc(sizeof(char) * (length + 1));
-    snprintf(res, length + 1, "%i", *((int *) args[0]->p_val));
+    int length = snprintf(NULL, 0, "%f", args[0]->floatVal); // get length
+    res = String_new(length); // allocate memory
+    snprintf(res, length + 1, "%f", args[0]->floatVal); // populate memory
   } else {
-    int length = snprintf(NULL, 0, "%s", *((char **) args[0]->p_val));
-    res = malloc(sizeof(char) * (length + 1));
-    snprintf(res, length + 1, "%s", *((char **) args[0]->p_val));
+    int length = snprintf(NULL, 0, "%lld", (long long) args[0]->intVal);
+    res = String_new(length);
+    snprintf(res, length + 1, "%lld", (long long) args[0]->intVal);
   }
 
-  char **p_res = (char **) malloc(sizeof(char *));
-  *p_res = res;
 
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(res, 0);
 }
 
 // (float x)
@@ -1854,20 +1771,20 @@ Generic *StdLib_float(Scope *p_scope, Generic *args[], int length, int lineNumbe
   enum Type allowedTypes[] = {TYPE_STRING, TYPE_INT, TYPE_FLOAT};
   validateType(allowedTypes, 3, args[0]->type, 1, lineNumber, "float");
 
-  double *p_res = malloc(sizeof(double));
+  double res = 0;
 
   if (args[0]->type == TYPE_STRING) {
-    char *str = *((char **) args[0]->p_val);
-    *p_res = atof(str);
+    char *str = args[0]->strVal;
+    res = atof(str);
   } else if (args[0]->type == TYPE_FLOAT) {
-    double f = *((double *) args[0]->p_val);
-    *p_res = f;
+    double f = args[0]->floatVal;
+    res = f;
   } else {
-    int i = *((int *) args[0]->p_val);
-    *p_res = (double) i;
+    int i = args[0]->intVal;
+    res = (double) i;
   }
 
-  return Generic_new(TYPE_FLOAT, p_res, 0);
+  return Generic_newFloat(res, 0);
 }
 
 //  (format-int value base)
@@ -1881,8 +1798,8 @@ Generic *StdLib_format_int(Scope *p_scope, Generic *args[], int length, int line
   enum Type allowedTypes2[] = {TYPE_INT};
   validateType(allowedTypes2, 1, args[1]->type, 2, lineNumber, "format-int");
 
-  int64_t value = *((int *) args[0]->p_val);
-  int base = *((int *) args[1]->p_val);
+  int64_t value = args[0]->intVal;
+  int base = args[1]->intVal;
 
   // Validate base
   if (base != 2 && base != 8 && base != 10 && base != 16) {
@@ -1894,10 +1811,8 @@ Generic *StdLib_format_int(Scope *p_scope, Generic *args[], int length, int line
   // Format using number_parse module
   char *formatted = formatInteger(value, base);
 
-  char **p_res = (char **) malloc(sizeof(char *));
-  *p_res = formatted;
 
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(String_fromHeap(formatted), 0);
 }
 
 //  (format-float value precision)
@@ -1913,12 +1828,12 @@ Generic *StdLib_format_float(Scope *p_scope, Generic *args[], int length, int li
 
   double value;
   if (args[0]->type == TYPE_FLOAT) {
-    value = *((double *) args[0]->p_val);
+    value = args[0]->floatVal;
   } else {
-    value = (double) *((int *) args[0]->p_val);
+    value = (double) args[0]->intVal;
   }
 
-  int precision = *((int *) args[1]->p_val);
+  int precision = args[1]->intVal;
 
   // Validate precision
   if (precision < 0 || precision > 17) {
@@ -1930,10 +1845,8 @@ Generic *StdLib_format_float(Scope *p_scope, Generic *args[], int length, int li
   // Format using number_parse module
   char *formatted = formatFloat(value, precision);
 
-  char **p_res = (char **) malloc(sizeof(char *));
-  *p_res = formatted;
 
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(String_fromHeap(formatted), 0);
 }
 
 // (type arg)
@@ -1944,17 +1857,8 @@ Generic *StdLib_type(Scope *p_scope, Generic *args[], int length, int lineNumber
   // get type
   char *type = getTypeString(args[0]->type);
   
-  // malloc memory for result and write
-  char *res = malloc(sizeof(char) * (strlen(type) + 1));
-  strcpy(res, type);
-  res[strlen(type)] = '\0';
-
-  // pointer to string
-  char **p_res = (char **) malloc(sizeof(char *));
-  *p_res = res;
-
   // return new generic
-  return Generic_new(TYPE_STRING, p_res, 0);
+  return Generic_newString(String_fromText(type), 0);
 }
 
 /* list and string */
@@ -1973,12 +1877,12 @@ Generic *StdLib_length(Scope *p_scope, Generic *args[], int length, int lineNumb
   validateType(allowedTypes, 3, args[0]->type, 1, lineNumber, "length");
 
   // create int
-  int *p_res = (int *) malloc(sizeof(int));
+  int64_t res = 0;
 
   // get length and return
-  if (args[0]->type == TYPE_LIST) *p_res = List_length((List *) args[0]->p_val);
-  else *p_res = strlen(*((char **) args[0]->p_val));
-  return Generic_new(TYPE_INT, p_res, 0);
+  if (args[0]->type == TYPE_LIST) res = List_length((List *) args[0]->p_val);
+  else res = String_length(args[0]->strVal);
+  return Generic_newInt(res, 0);
 }
 
 // (join arg1 arg2 arg3 ...)
@@ -1997,23 +1901,21 @@ Generic *StdLib_join(Scope *p_scope, Generic *args[], int length, int lineNumber
   }
   
   if (args[0]->type == TYPE_STRING) {
-    // string case
-    // calculate size (starts at 1 for \0)
-    int stringSize = 1;
-    for (int i = 0; i < length; i++) stringSize += strlen(*((char **) args[i]->p_val));
-
-    // malloc memory
-    char *res = (char *) malloc(sizeof(char) * stringSize);
+    // string case: the lengths are known, so each part is copied once
+    int stringSize = 0;
+    for (int i = 0; i < length; i++) stringSize += String_length(args[i]->strVal);
 
-    // copy / concat
-    strcpy(res, *((char **) args[0]->p_val));
-    for (int i = 1; i < length; i++) strcat(res, *((char **) args[i]->p_val));
+    char *res = String_new(stringSize);
 
-    // malloc pointer
-    char **p_res = (char **) malloc(sizeof(char *));
-    *p_res = res;
+    // copy each part after the last
+    int offset = 0;
+    for (int i = 0; i < length; i++) {
+      int partLength = String_length(args[i]->strVal);
+      memcpy(res + offset, args[i]->strVal, partLength);
+      offset += partLength;
+    }
 
-    return Generic_new(TYPE_STRING, p_res, 0);
+    return Generic_newString(res, 0);
   } else {
     // list case
     // create array of lists
@@ -2039,30 +1941,37 @@ Generic *StdLib_repeat(Scope *p_scope, Generic *args[], int length, int lineNumb
   enum Type allowedTypes2[] = {TYPE_INT};
   validateType(allowedTypes2, 1, args[1]->type, 2, lineNumber, "repeat");
 
-  char *str = *((char **) args[0]->p_val);
-  int count = *((int *) args[1]->p_val);
+  char *str = args[0]->strVal;
+  int count = args[1]->intVal;
 
   // Edge case: count <= 0 returns empty string
   if (count <= 0) {
-    char *empty = (char *) malloc(sizeof(char));
-    empty[0] = '\0';
-    return Generic_new(TYPE_STRING, &empty, 0);
+    return Generic_newString(String_new(0), 0);
   }
 
   // Calculate total size needed
-  int strLen = strlen(str);
-  int totalSize = (strLen * count) + 1;  // +1 for \0
-
-  // Allocate memory
-  char *result = (char *) malloc(sizeof(char) * totalSize);
-  result[0] = '\0';
+  int strLen = String_length(str);
+  char *result = String_new(strLen * count);
 
   // Repeat string count times
   for (int i = 0; i < count; i++) {
-    strcat(result, str);
+    memcpy(result + i * strLen, str, strLen);
   }
 
-  return Generic_new(TYPE_STRING, &result, 0);
+  return Generic_newString(result, 0);
+}
+
+// (intern string)
+// returns the interned copy of string: equal interned strings are the same
+// object, so comparing them or using them as dict keys never scans their text
+// interned strings live until the program exits
+Generic *StdLib_intern(Scope *p_scope, Generic *args[], int length, int lineNumber) {
+  validateArgCount(1, 1, length, lineNumber);
+
+  enum Type allowedTypes[] = {TYPE_STRING};
+  validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "intern");
+
+  return Intern_generic(args[0]);
 }
 
 // (get list index1) or (get list index1 index2)
@@ -2079,63 +1988,51 @@ Generic *StdLib_get(Scope *p_scope, Generic *args[], int length, int lineNumber)
 
   if (args[0]->type == TYPE_LIST) {
     int inputLength = List_length((List *) args[0]->p_val);
-    validateRange(args[1]->p_val, 0, inputLength - 1, 2, lineNumber, "get");
 
     // single item from list
-    if (length == 2) return List_get((List *) (args[0]->p_val), *((int *) args[1]->p_val));
+    if (length == 2) {
+      validateRange(args[1]->intVal, 0, inputLength - 1, 2, lineNumber, "get");
+      return List_get((List *) (args[0]->p_val), args[1]->intVal);
+    }
 
-    // multiple items from list
+    // multiple items from list, as a view (an empty slice is allowed)
     else if (length == 3) {
-      validateRange(args[2]->p_val, *((int *) args[1]->p_val) + 1, inputLength, 3, lineNumber, "get");
+      validateRange(args[1]->intVal, 0, inputLength, 2, lineNumber, "get");
+      validateRange(args[2]->intVal, args[1]->intVal, inputLength, 3, lineNumber, "get");
 
       return Generic_new(TYPE_LIST, List_sublist(
         (List *) (args[0]->p_val), 
-        *((int *) args[1]->p_val), 
-        *((int *) args[2]->p_val)
+        args[1]->intVal, 
+        args[2]->intVal
       ), 0);
     }
 
   } else if (args[0]->type == TYPE_STRING) {
-    int inputLength = strlen(*((char **) args[0]->p_val));
-    validateRange(args[1]->p_val, 0, inputLength - 1, 2, lineNumber, "get");
+    int inputLength = String_length(args[0]->strVal);
+    validateRange(args[1]->intVal, 0, inputLength - 1, 2, lineNumber, "get");
 
     if (length == 2) {
       // single item from string
-      char *res = malloc(sizeof(char) * 2);
-      res[0] = (*((char **) args[0]->p_val))[*((int *) args[1]->p_val)];
-      res[1] = '\0';
+      char *res = String_new(1);
+      res[0] = (args[0]->strVal)[args[1]->intVal];
 
-      char **p_res = (char **) malloc(sizeof(char *));
-      *p_res = res;
 
-      return Generic_new(TYPE_STRING, p_res, 0);
+      return Generic_newString(res, 0);
     } else if (length == 3) {
       // mutliple items from string
-      validateRange(args[2]->p_val, *((int *) args[1]->p_val) + 1, inputLength, 3, lineNumber, "get");
+      validateRange(args[2]->intVal, args[1]->intVal + 1, inputLength, 3, lineNumber, "get");
 
       // create substring
-      int start = *((int *) args[1]->p_val);
-      int end = *((int *) args[2]->p_val);
-
-      char *res = malloc(sizeof(char) * (end - start + 1));
-      strncpy(
-        res, 
-        &(*((char **) args[0]->p_val))[start], 
-        end - start
-      );
-      
-      res[end - start] = 0;
+      int start = args[1]->intVal;
+      int end = args[2]->intVal;
 
-      // create pointer
-      char **p_res = (char **) malloc(sizeof(char *));
-      *p_res = res;
+      char *res = String_fromBytes(&(args[0]->strVal)[start], end - start);
 
-      // return
-      return Generic_new(TYPE_STRING, p_res, 0);
+      return Generic_newString(res, 0);
     }
   }
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (insert list item index) or (insert list item)
@@ -2158,8 +2055,8 @@ Generic *StdLib_insert(Scope *p_scope, Generic *args[], int length, int lineNumb
 
     int inputLength = args[0]->type == TYPE_LIST 
       ? List_length((List *) args[0]->p_val)
-      : strlen(*((char **) args[0]->p_val));
-    validateRange(args[2]->p_val, 0, inputLength, 3, lineNumber, "insert");
+      : String_length(args[0]->strVal);
+    validateRange(args[2]->intVal, 0, inputLength, 3, lineNumber, "insert");
   }
 
   if (args[0]->type == TYPE_LIST) {
@@ -2171,7 +2068,7 @@ Generic *StdLib_insert(Scope *p_scope, Generic *args[], int length, int lineNumb
       ), 0);
     } else if (length == 3) {
       return Generic_new(TYPE_LIST, List_insert(
-        (List *) (args[0]->p_val), args[1], *((int *) args[2]->p_val)
+        (List *) (args[0]->p_val), args[1], args[2]->intVal
       ), 0); 
     }
   } else if (args[0]->type == TYPE_STRING) {
@@ -2182,29 +2079,26 @@ Generic *StdLib_insert(Scope *p_scope, Generic *args[], int length, int lineNumb
       // when an index is not supplied, put simply acts like join
       return StdLib_join(p_scope, args, length, lineNumber);
     } else if (length == 3) {
-      int stringSize = strlen(*((char **) args[0]->p_val)) + strlen(*((char **) args[1]->p_val)) + 1;
-
-      // malloc memory
-      char *res = (char *) malloc(sizeof(char) * stringSize);
+      char *target = args[0]->strVal;
+      char *item = args[1]->strVal;
+      int index = args[2]->intVal;
+      int targetLength = String_length(target);
+      int itemLength = String_length(item);
 
+      char *res = String_new(targetLength + itemLength);
 
       // copy / concat
-      strncpy(res, *((char **) args[0]->p_val), *((int *) args[2]->p_val));
-      res[*((int *) args[2]->p_val)] = '\0';
-
-      strcat(res, *((char **) args[1]->p_val));
-      strcat(res, &((*((char **) args[0]->p_val))[*((int *) args[2]->p_val)]));
+      memcpy(res, target, index);
+      memcpy(res + index, item, itemLength);
+      memcpy(res + index + itemLength, target + index, targetLength - index);
 
-      // pointer
-      char **p_res = (char **) malloc(sizeof(char *));
-      *p_res = res;
 
       // return
-      return Generic_new(TYPE_STRING, p_res, 0);
+      return Generic_newString(res, 0);
     }
   }
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (set list item index)
@@ -2226,44 +2120,39 @@ Generic *StdLib_set(Scope *p_scope, Generic *args[], int length, int lineNumber)
 
   int inputLength = args[0]->type == TYPE_LIST 
     ? List_length((List *) args[0]->p_val)
-    : strlen(*((char **) args[0]->p_val));
-  validateRange(args[2]->p_val, 0, inputLength - 1, 3, lineNumber, "set");
+    : String_length(args[0]->strVal);
+  validateRange(args[2]->intVal, 0, inputLength - 1, 3, lineNumber, "set");
 
   if (args[0]->type == TYPE_LIST) {
     // list case
     return Generic_new(TYPE_LIST, List_set(
-      (List *) (args[0]->p_val), args[1], *((int *) args[2]->p_val)
+      (List *) (args[0]->p_val), args[1], args[2]->intVal
     ), 0); 
 
   } else if (args[0]->type == TYPE_STRING) {
-    char *target = *((char **) args[0]->p_val);
-    char *item = *((char **) args[1]->p_val);
-    int index = *((int *) args[2]->p_val);
+    char *target = args[0]->strVal;
+    char *item = args[1]->strVal;
+    int index = args[2]->intVal;
 
     // string case
     // length of result
-    int stringSize = index + (strlen(item) > strlen(target) - index ? strlen(item) : strlen(target) - index) + 1;
-
-    // malloc memory
-    char *res = (char *) malloc(sizeof(char) * stringSize);
-
-    // copy / concat
-    strncpy(res, target, index);
-    res[index] = '\0';
+    int targetLength = String_length(target);
+    int itemLength = String_length(item);
+    int stringSize = index + (itemLength > targetLength - index ? itemLength : targetLength - index);
 
-    strcat(res, item);
+    char *res = String_new(stringSize);
 
-    strncat(res, &(target[index]), stringSize - strlen(res) - 1);
+    // copy / concat, then fill the rest from target[index]
+    memcpy(res, target, index);
+    memcpy(res + index, item, itemLength);
+    memcpy(res + index + itemLength, &(target[index]), stringSize - index - itemLength);
 
-    // pointer
-    char **p_res = (char **) malloc(sizeof(char *));
-    *p_res = res;
 
     // return
-    return Generic_new(TYPE_STRING, p_res, 0);
+    return Generic_newString(res, 0);
   }
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (delete list index)
@@ -2280,74 +2169,62 @@ Generic *StdLib_delete(Scope *p_scope, Generic *args[], int length, int lineNumb
 
   if (args[0]->type == TYPE_LIST) {
     int inputLength = List_length((List *) args[0]->p_val);
-    validateRange(args[1]->p_val, 0, inputLength - 1, 2, lineNumber, "delete");
+    validateRange(args[1]->intVal, 0, inputLength - 1, 2, lineNumber, "delete");
 
     // list case
     if (length == 2) {
-      return Generic_new(TYPE_LIST, List_delete((List *) (args[0]->p_val), *((int *) args[1]->p_val)), 0);
+      return Generic_new(TYPE_LIST, List_delete((List *) (args[0]->p_val), args[1]->intVal), 0);
     } else if (length == 3) {
-      validateRange(args[2]->p_val, *((int *) args[1]->p_val) + 1, inputLength, 3, lineNumber, "delete");
+      validateRange(args[2]->intVal, args[1]->intVal + 1, inputLength, 3, lineNumber, "delete");
 
       // case where we must delete multiple items
       return Generic_new(TYPE_LIST, List_deleteMultiple(
-        (List *) (args[0]->p_val), *((int *) args[1]->p_val), *((int *) args[2]->p_val)
+        (List *) (args[0]->p_val), args[1]->intVal, args[2]->intVal
       ), 0);
     }
 
   } else {
     // string case
-    int inputLength = strlen(*((char **) args[0]->p_val));
-    validateRange(args[1]->p_val, 0, inputLength - 1, 2, lineNumber, "delete");
+    int inputLength = String_length(args[0]->strVal);
+    validateRange(args[1]->intVal, 0, inputLength - 1, 2, lineNumber, "delete");
 
-    char *target = *((char **) args[0]->p_val);
-    int index1 = *((int *) args[1]->p_val);
+    char *target = args[0]->strVal;
+    int index1 = args[1]->intVal;
 
     if (length == 2) {
 
-      // length of result (no +1, as we are removing a charechter)
-      int stringSize = strlen(target);
+      // length of result (one less, as we are removing a charechter)
+      int stringSize = inputLength - 1;
 
-      // malloc memory
-      char *res = (char *) malloc(sizeof(char) * stringSize);
+      char *res = String_new(stringSize);
 
       // copy / concat
-      strncpy(res, target, index1);
-      res[index1] = '\0';
-      strncat(res, &(target[index1 + 1]), stringSize - strlen(res) - 1);
+      memcpy(res, target, index1);
+      memcpy(res + index1, &(target[index1 + 1]), stringSize - index1);
 
-      // pointer
-      char **p_res = (char **) malloc(sizeof(char *));
-      *p_res = res;
 
       // return
-      return Generic_new(TYPE_STRING, p_res, 0);
+      return Generic_newString(res, 0);
     } else if (length == 3) {
       // mutliple items from string
-      validateRange(args[2]->p_val, *((int *) args[1]->p_val) + 1, inputLength, 3, lineNumber, "delete");
+      validateRange(args[2]->intVal, args[1]->intVal + 1, inputLength, 3, lineNumber, "delete");
 
-      int index2 = *((int *) args[2]->p_val);
+      int index2 = args[2]->intVal;
 
       // length of result
-      int stringSize = strlen(target) + 1 - (index2 - index1);
+      int stringSize = inputLength - (index2 - index1);
 
-      // malloc memory
-      char *res = (char *) malloc(sizeof(char) * stringSize);
+      char *res = String_new(stringSize);
 
       // copy / concat
-      strncpy(res, target, index1);
-      res[index1] = '\0';
-      strncat(res, &(target[index2]), stringSize - strlen(res) - 1);
+      memcpy(res, target, index1);
+      memcpy(res + index1, &(target[index2]), stringSize - index1);
 
-      // pointer
-      char **p_res = (char **) malloc(sizeof(char *));
-      *p_res = res;
-
-      // return
-      return Generic_new(TYPE_STRING, p_res, 0); 
+      return Generic_newString(res, 0);
     }
   }
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // (map list fn)
@@ -2361,18 +2238,21 @@ Generic *StdLib_map(Scope *p_scope, Generic *args[], int length, int lineNumber)
   enum Type allowedTypes2[] = {TYPE_FUNCTION, TYPE_NATIVEFUNCTION, TYPE_BYTECODE_CLOSURE, TYPE_BYTECODE_CLOSURE};  //  Support closures
   validateType(allowedTypes2, 3, args[1]->type, 2, lineNumber, "map");  //  3 types now
 
-  // create copy of list
-  Generic *res = Generic_copy(args[0]);
-  List *p_list = (List *) (res->p_val);
+  // lists are immutable, so the results go to a new list
+  List *p_list = (List *) (args[0]->p_val);
+  Generic **mapped = (Generic **) malloc(sizeof(Generic *) * p_list->len);
 
   for (int i = 0; i < p_list->len; i += 1) {
-    int *p_i = (int *) malloc(sizeof(int));
-    *p_i = i;
 
-    Generic *newArgs[] = {p_list->vals[i], Generic_new(TYPE_INT, p_i, 0)};
-    p_list->vals[i] = applyFunc(args[1], p_scope, newArgs, 2, lineNumber);
+    // the item is passed as is: the list keeps it alive while fn holds it
+    Generic *newArgs[] = {List_at(p_list, i), Generic_newInt(i, 0)};
+    mapped[i] = applyFunc(args[1], p_scope, newArgs, 2, lineNumber);
   }
 
+  // the new list takes a reference to every result
+  Generic *res = Generic_new(TYPE_LIST, List_new(mapped, p_list->len), 0);
+  free(mapped);
+
   return res;
 }
 
@@ -2395,7 +2275,7 @@ Generic *StdLib_reduce(Scope *p_scope, Generic *args[], int length, int lineNumb
   if (length == 3) {
     p_acc = Generic_copy(args[2]);
   } else {
-    p_acc = Generic_new(TYPE_VOID, NULL, 0);
+    p_acc = Generic_void();
   }
 
   // Get list
@@ -2403,12 +2283,9 @@ Generic *StdLib_reduce(Scope *p_scope, Generic *args[], int length, int lineNumb
  
   // loop on every item
   for (int i = 0; i < p_list->len; i += 1) {
-    // create pointer for index, to create generic for args
-    int *p_i = (int *) malloc(sizeof(int));
-    *p_i = i;
     
     // apply function
-    Generic *newArgs[] = {p_acc, Generic_copy(p_list->vals[i]), Generic_new(TYPE_INT, p_i, 0)};
+    Generic *newArgs[] = {p_acc, List_at(p_list, i), Generic_newInt(i, 0)};
     p_acc = applyFunc(args[1], p_scope, newArgs, 3, lineNumber);
   }
 
@@ -2422,26 +2299,18 @@ Generic *StdLib_range(Scope *p_scope, Generic *args[], int length, int lineNumbe
 
   enum Type allowedTypes[] = {TYPE_INT};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "range");
-  validateMin(args[0]->p_val, 0, 1, lineNumber, "range");
+  validateMin(args[0]->intVal, 0, 1, lineNumber, "range");
 
   // make list of arguments to pass to List_new
-  int count = *((int *) args[0]->p_val);
+  int count = args[0]->intVal;
   Generic *argList[count];
   
   for (int i = 0; i < count; i++) {
-    int *p_i = (int *) malloc(sizeof(int));
-    *p_i = i;
-    argList[i] = Generic_new(TYPE_INT, p_i, 0);
+    argList[i] = Generic_newInt(i, 0);
   }
 
-  Generic *res = Generic_new(TYPE_LIST, List_new(argList, count), 0);
-
-  // free
-  for (int i = 0; i < count; i++) {
-    Generic_free(argList[i]);
-  }
-
-  return res;
+  // the list holds the ints now
+  return Generic_new(TYPE_LIST, List_new(argList, count), 0);
 }
 
 // (find x item)
@@ -2459,16 +2328,13 @@ Generic *StdLib_find(Scope *p_scope, Generic *args[], int length, int lineNumber
     validateType(allowedTypes2, 1, args[1]->type, 2, lineNumber, "find");
 
     // find pointer to substring
-    char *p_sub = strstr(*((char **) args[0]->p_val), *((char **) args[1]->p_val));
+    char *p_sub = strstr(args[0]->strVal, args[1]->strVal);
 
     // return void if not found
-    if (p_sub == NULL) return Generic_new(TYPE_VOID, NULL, 0);
+    if (p_sub == NULL) return Generic_void();
 
     // get index and return
-    int *p_index = malloc(sizeof(int)); 
-    *p_index = p_sub - *((char **) args[0]->p_val);
-
-    return Generic_new(TYPE_INT, p_index, 0);
+    return Generic_newInt(p_sub - args[0]->strVal, 0);
   } else {
     // list case
     List *p_list = ((List *) args[0]->p_val);
@@ -2477,15 +2343,13 @@ Generic *StdLib_find(Scope *p_scope, Generic *args[], int length, int lineNumber
     for (int i = 0; i < p_list->len; i += 1) {
 
       // if found, return index
-      if (Generic_is(p_list->vals[i], args[1])) {
-        int *p_index = (int *) malloc(sizeof(int));
-        *p_index = i;
-        return Generic_new(TYPE_INT, p_index, 0);
+      if (Generic_is(List_at(p_list, i), args[1])) {
+        return Generic_newInt(i, 0);
       }
     }
 
     // if not found return void
-    return Generic_new(TYPE_VOID, NULL, 0);
+    return Generic_void();
   }
 }
 
@@ -2516,8 +2380,7 @@ Generic *StdLib_variant(Scope *p_scope, Generic *args[], int length, int lineNum
   items[1] = valuesGen;
   List *variantList = List_new(items, 2);
 
-  // cleanup temporary generic (List_new made a deep copy)
-  Generic_free(valuesGen);
+  // valuesGen is held by variantList, only the array is temporary
   if (vals) free(vals);
 
   return Generic_new(TYPE_LIST, variantList, 0);
@@ -2604,13 +2467,13 @@ Generic *StdLib_match(Scope *p_scope, Generic *args[], int length, int lineNumbe
       exit(0);
     }
 
-    if (strcmp(*((char **) args[i]->p_val), *((char **) tag->p_val)) == 0) {
+    if (strcmp(args[i]->strVal, tag->strVal) == 0) {
       // Build call args from variant values
       int argcVals = values->len;
       Generic **callArgs = NULL;
       if (argcVals > 0) {
         callArgs = (Generic **) malloc(sizeof(Generic *) * argcVals);
-        for (int k = 0; k < argcVals; k++) callArgs[k] = Generic_copy(values->vals[k]);
+        for (int k = 0; k < argcVals; k++) callArgs[k] = Generic_copy(List_at(values, k));
       }
       Generic *res = applyFunc(args[i + 1], p_scope, callArgs, argcVals, lineNumber);
       if (callArgs) {
@@ -2642,7 +2505,7 @@ Generic *StdLib_match(Scope *p_scope, Generic *args[], int length, int lineNumbe
 
   Generic_free(tag);
   Generic_free(valsGen);
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // ===== List Helper Functions (for recursive programming) =====
@@ -2656,10 +2519,10 @@ Generic *StdLib_head(Scope *p_scope, Generic *args[], int length, int lineNumber
 
   List *lst = (List *) args[0]->p_val;
   if (lst->len == 0) {
-    return Generic_new(TYPE_VOID, NULL, 0);
+    return Generic_void();
   }
   // Return a copy to avoid reference issues
-  return Generic_copy(lst->vals[0]);
+  return Generic_copy(List_at(lst, 0));
 }
 
 // (tail lst)
@@ -2695,9 +2558,7 @@ Generic *StdLib_is_empty(Scope *p_scope, Generic *args[], int length, int lineNu
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "empty?");
 
   List *lst = (List *) args[0]->p_val;
-  int *res = (int *) malloc(sizeof(int));
-  *res = (lst->len == 0) ? 1 : 0;
-  return Generic_new(TYPE_INT, res, 0);
+  return Generic_newInt((lst->len == 0) ? 1 : 0, 0);
 }
 
 /* Immutability Functions */
@@ -2709,12 +2570,12 @@ Generic *StdLib_freeze(Scope *p_scope, Generic *args[], int length, int lineNumb
   enum Type allowedTypes[] = {TYPE_STRING};
   validateType(allowedTypes, 1, args[0]->type, 1, lineNumber, "freeze");
 
-  char *name = *((char **) args[0]->p_val);
+  char *name = args[0]->strVal;
 
   // Freeze the binding
   Scope_freeze(p_scope, name, lineNumber);
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 /* Function Composition Helpers */
@@ -2782,9 +2643,9 @@ Generic *StdLib_partial(Scope *p_scope, Generic *args[], int length, int lineNum
   // Create a list to store: [function, arg1, arg2, ...]
   Generic **partialData = (Generic **) malloc(sizeof(Generic *) * length);
 
-  // Store function and all fixed arguments
+  // Store function and all fixed arguments (the list takes a reference to each)
   for (int i = 0; i < length; i++) {
-    partialData[i] = Generic_copy(args[i]);
+    partialData[i] = args[i];
   }
 
   List *partialList = List_new(partialData, length);
@@ -2820,7 +2681,7 @@ Generic *StdLib_call(Scope *p_scope, Generic *args[], int length, int lineNumber
   }
 
   // Extract original function (first element)
-  Generic *original_fn = partial->vals[0];
+  Generic *original_fn = List_at(partial, 0);
 
   //  Validate it's actually a function (including closures)
   if (original_fn->type != TYPE_FUNCTION && original_fn->type != TYPE_NATIVEFUNCTION && original_fn->type != TYPE_BYTECODE_CLOSURE) {
@@ -2843,7 +2704,7 @@ Generic *StdLib_call(Scope *p_scope, Generic *args[], int length, int lineNumber
   // Copy fixed args from partial
   // Increment refCount to protect from applyFunc freeing them
   for (int i = 0; i < fixed_count; i++) {
-    combined_args[i] = partial->vals[i + 1];
+    combined_args[i] = List_at(partial, i + 1);
     combined_args[i]->refCount++;
   }
 
@@ -2895,7 +2756,7 @@ Generic *StdLib_thread_first(Scope *p_scope, Generic *args[], int length, int li
       exit(0);
     }
 
-    Generic *fn = form_list->vals[0];
+    Generic *fn = List_at(form_list, 0);
 
     //  Support closures in thread-first
     if (fn->type != TYPE_FUNCTION && fn->type != TYPE_NATIVEFUNCTION && fn->type != TYPE_BYTECODE_CLOSURE) {
@@ -2909,7 +2770,7 @@ Generic *StdLib_thread_first(Scope *p_scope, Generic *args[], int length, int li
 
     funcArgs[0] = result; // Result goes FIRST
     for (int j = 1; j < form_list->len; j++) {
-      funcArgs[j] = form_list->vals[j];
+      funcArgs[j] = List_at(form_list, j);
       funcArgs[j]->refCount++;
     }
 
@@ -2954,7 +2815,7 @@ Generic *StdLib_thread_last(Scope *p_scope, Generic *args[], int length, int lin
       exit(0);
     }
 
-    Generic *fn = form_list->vals[0];
+    Generic *fn = List_at(form_list, 0);
 
     //  Support closures in thread-last
     if (fn->type != TYPE_FUNCTION && fn->type != TYPE_NATIVEFUNCTION && fn->type != TYPE_BYTECODE_CLOSURE) {
@@ -2968,7 +2829,7 @@ Generic *StdLib_thread_last(Scope *p_scope, Generic *args[], int length, int lin
 
     // Copy form args first
     for (int j = 1; j < form_list->len; j++) {
-      funcArgs[j - 1] = form_list->vals[j];
+      funcArgs[j - 1] = List_at(form_list, j);
       funcArgs[j - 1]->refCount++;
     }
 
@@ -3043,24 +2904,23 @@ Generic *StdLib_filter(Scope *p_scope, Generic *args[], int length, int lineNumb
   int count = 0;
 
   for (int i = 0; i < input->len; i++) {
-    int *p_i = (int *) malloc(sizeof(int));
-    *p_i = i;
+    Generic *item = List_at(input, i);
 
     // Protect input value from being freed by applyFunc
-    input->vals[i]->refCount++;
+    item->refCount++;
 
-    Generic *funcArgs[] = {input->vals[i], Generic_new(TYPE_INT, p_i, 0)};
+    Generic *funcArgs[] = {item, Generic_newInt(i, 0)};
 
     args[1]->refCount++;
     Generic *result = applyFunc(args[1], p_scope, funcArgs, 2, lineNumber);
     args[1]->refCount--;
 
     // Restore refCount
-    input->vals[i]->refCount--;
+    item->refCount--;
 
     // If result is truthy (not 0), include this element
-    if (result->type == TYPE_INT && *((int *) result->p_val) != 0) {
-      filtered[count++] = Generic_copy(input->vals[i]);
+    if (result->type == TYPE_INT && result->intVal != 0) {
+      filtered[count++] = item;
     }
 
     if (result->refCount == 0) Generic_free(result);
@@ -3104,8 +2964,7 @@ Generic *StdLib_dict(Scope *p_scope, Generic *args[], int length, int lineNumber
 
   // Create new dict with appropriate capacity
   int pair_count = length / 2;
-  int initial_capacity = pair_count > 0 ? pair_count * 2 : 16;
-  Dict *dict = Dict_new(initial_capacity);
+  Dict *dict = Dict_new(pair_count);
 
   // Insert all key-value pairs using in-place mutation (efficient building)
   for (int i = 0; i < pair_count; i++) {
@@ -3136,7 +2995,7 @@ Generic *StdLib_dict_get(Scope *p_scope, Generic *args[], int length, int lineNu
   Generic *value = Dict_get(dict, key);
 
   if (value == NULL) {
-    return Generic_new(TYPE_VOID, NULL, 0);
+    return Generic_void();
   }
 
   return Generic_copy(value);
@@ -3144,7 +3003,7 @@ Generic *StdLib_dict_get(Scope *p_scope, Generic *args[], int length, int lineNu
 
 // (dict_set dict key value)
 // Returns a new dict with the key-value pair added/updated (immutable)
-// O(n) for immutable copy, O(1) for lookup
+// O(log n): the new dict shares all nodes off the path to key
 Generic *StdLib_dict_set(Scope *p_scope, Generic *args[], int length, int lineNumber) {
   if (length != 3) {
     printf("Runtime Error @ Line %i: dict_set requires exactly 3 arguments (dict, key, value).\n", lineNumber);
@@ -3179,14 +3038,8 @@ Generic *StdLib_dict_keys(Scope *p_scope, Generic *args[], int length, int lineN
   int count;
   Generic **keys_arr = Dict_keys(dict, &count);
 
-  // Copy keys for return
-  Generic **keys_copy = (Generic **) malloc(sizeof(Generic *) * count);
-  for (int i = 0; i < count; i++) {
-    keys_copy[i] = Generic_copy(keys_arr[i]);
-  }
-
-  List *result = List_new(keys_copy, count);
-  free(keys_copy);
+  // The list shares the keys with the dict
+  List *result = List_new(keys_arr, count);
   free(keys_arr);
 
   return Generic_new(TYPE_LIST, result, 0);
@@ -3208,14 +3061,8 @@ Generic *StdLib_dict_values(Scope *p_scope, Generic *args[], int length, int lin
   int count;
   Generic **values_arr = Dict_values(dict, &count);
 
-  // Copy values for return
-  Generic **values_copy = (Generic **) malloc(sizeof(Generic *) * count);
-  for (int i = 0; i < count; i++) {
-    values_copy[i] = Generic_copy(values_arr[i]);
-  }
-
-  List *result = List_new(values_copy, count);
-  free(values_copy);
+  // The list shares the values with the dict
+  List *result = List_new(values_arr, count);
   free(values_arr);
 
   return Generic_new(TYPE_LIST, result, 0);
@@ -3238,14 +3085,12 @@ Generic *StdLib_dict_has(Scope *p_scope, Generic *args[], int length, int lineNu
 
   int has = Dict_has(dict, key);
 
-  int *result = (int *) malloc(sizeof(int));
-  *result = has;
-  return Generic_new(TYPE_INT, result, 0);
+  return Generic_newInt(has, 0);
 }
 
 // (dict_merge dict1 dict2)
 // Returns a new dict with all keys from both dicts (dict2 values override dict1)
-// O(n + m) where n, m are sizes of dict1, dict2
+// O(m log n) where m is the size of the smaller dict; the larger one's trie is shared
 Generic *StdLib_dict_merge(Scope *p_scope, Generic *args[], int length, int lineNumber) {
   if (length != 2) {
     printf("Runtime Error @ Line %i: dict_merge requires exactly 2 arguments (dict1, dict2).\n", lineNumber);
@@ -3266,7 +3111,7 @@ Generic *StdLib_dict_merge(Scope *p_scope, Generic *args[], int length, int line
 
 // (dict_remove dict key)
 // Returns a new dict with the key removed (immutable)
-// O(n) for immutable copy
+// O(log n): the new dict shares all nodes off the path to key
 Generic *StdLib_dict_remove(Scope *p_scope, Generic *args[], int length, int lineNumber) {
   if (length != 2) {
     printf("Runtime Error @ Line %i: dict_remove requires exactly 2 arguments (dict, key).\n", lineNumber);
@@ -3304,36 +3149,36 @@ Generic *StdLib_dict_map(Scope *p_scope, Generic *args[], int length, int lineNu
   Generic *map_fn = args[1];
 
   // Create new empty dict
-  Dict *new_dict = Dict_new(dict->capacity);
+  Dict *new_dict = Dict_new(dict->size);
 
   // Iterate through all entries
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      Generic *key = entry->key;
-      Generic *value = entry->value;
+  int count;
+  DictEntry *entries = Dict_entries(dict, &count);
+  for (int i = 0; i < count; i++) {
+    DictEntry *entry = &entries[i];
 
-      // Call fn with key and value
-      key->refCount++;
-      value->refCount++;
+    Generic *key = entry->key;
+    Generic *value = entry->value;
 
-      Generic *fn_args[] = {key, value};
+    // Call fn with key and value
+    key->refCount++;
+    value->refCount++;
 
-      map_fn->refCount++;
-      Generic *new_value = applyFunc(map_fn, p_scope, fn_args, 2, lineNumber);
-      map_fn->refCount--;
+    Generic *fn_args[] = {key, value};
 
-      key->refCount--;
-      value->refCount--;
+    map_fn->refCount++;
+    Generic *new_value = applyFunc(map_fn, p_scope, fn_args, 2, lineNumber);
+    map_fn->refCount--;
 
-      // Insert into new dict using in-place mutation
-      Dict_set_inplace(new_dict, key, new_value);
+    key->refCount--;
+    value->refCount--;
 
-      if (new_value->refCount == 0) Generic_free(new_value);
+    // Insert into new dict using in-place mutation
+    Dict_set_inplace(new_dict, key, new_value);
 
-      entry = entry->next;
-    }
+    if (new_value->refCount == 0) Generic_free(new_value);
   }
+  free(entries);
 
   return Generic_new(TYPE_DICT, new_dict, 0);
 }
@@ -3358,43 +3203,43 @@ Generic *StdLib_dict_filter(Scope *p_scope, Generic *args[], int length, int lin
   Generic *filter_fn = args[1];
 
   // Create new empty dict
-  Dict *new_dict = Dict_new(dict->capacity);
+  Dict *new_dict = Dict_new(dict->size);
 
   // Iterate through all entries
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      Generic *key = entry->key;
-      Generic *value = entry->value;
+  int count;
+  DictEntry *entries = Dict_entries(dict, &count);
+  for (int i = 0; i < count; i++) {
+    DictEntry *entry = &entries[i];
 
-      // Call fn with key and value
-      key->refCount++;
-      value->refCount++;
+    Generic *key = entry->key;
+    Generic *value = entry->value;
 
-      Generic *fn_args[] = {key, value};
+    // Call fn with key and value
+    key->refCount++;
+    value->refCount++;
 
-      filter_fn->refCount++;
-      Generic *result = applyFunc(filter_fn, p_scope, fn_args, 2, lineNumber);
-      filter_fn->refCount--;
+    Generic *fn_args[] = {key, value};
 
-      key->refCount--;
-      value->refCount--;
+    filter_fn->refCount++;
+    Generic *result = applyFunc(filter_fn, p_scope, fn_args, 2, lineNumber);
+    filter_fn->refCount--;
 
-      // If result is truthy, keep this pair
-      bool should_keep = false;
-      if (result->type == TYPE_INT && *((int *) result->p_val) != 0) {
-        should_keep = true;
-      }
-
-      if (should_keep) {
-        Dict_set_inplace(new_dict, key, value);
-      }
+    key->refCount--;
+    value->refCount--;
 
-      if (result->refCount == 0) Generic_free(result);
+    // If result is truthy, keep this pair
+    bool should_keep = false;
+    if (result->type == TYPE_INT && result->intVal != 0) {
+      should_keep = true;
+    }
 
-      entry = entry->next;
+    if (should_keep) {
+      Dict_set_inplace(new_dict, key, value);
     }
+
+    if (result->refCount == 0) Generic_free(result);
   }
+  free(entries);
 
   return Generic_new(TYPE_DICT, new_dict, 0);
 }
@@ -3440,7 +3285,7 @@ Generic *StdLib_set_ref(Scope *p_scope, Generic *args[], int length, int lineNum
 
   Ref_set(ref, new_value);
 
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // creates a new global scope
@@ -3455,28 +3300,16 @@ Scope *newGlobal(int argc, char *argv[]) {
 
   // for each arg
   for (int i = 0; i < argc; i++) {
-    char **p_val = (char **) malloc(sizeof(char *));
-
-    // create string
-    char *val = (char *) malloc(sizeof(char) * (strlen(argv[i]) + 1));
-    strcpy(val, argv[i]);
-    *p_val = val;
-
-    // add to args
-    args[i] = Generic_new(TYPE_STRING, p_val, 0);
+    // create string and add to args
+    args[i] = Generic_newString(String_fromText(argv[i]), 0);
   }
   
   // add arguments and arguments count
+  // (the list holds the argument strings)
   Scope_set(p_global, "arguments", Generic_new(TYPE_LIST, List_new(args, argc), 0), -1);
 
-  // free arguments memory (as List_new does a copy)
-  for (int i = 0; i < argc; i++) {
-    Generic_free(args[i]);
-    args[i] = NULL;
-  }
-
   // add void
-  Scope_set(p_global, "void", Generic_new(TYPE_VOID, NULL, 0), -1);
+  Scope_set(p_global, "void", Generic_void(), -1);
 
   // populate global scope with stdlib functions
   /* IO */
@@ -3563,6 +3396,7 @@ Scope *newGlobal(int argc, char *argv[]) {
   Scope_set(p_global, "length", Generic_new(TYPE_NATIVEFUNCTION, &StdLib_length, 0), -1);
   Scope_set(p_global, "join", Generic_new(TYPE_NATIVEFUNCTION, &StdLib_join, 0), -1);
   Scope_set(p_global, "repeat", Generic_new(TYPE_NATIVEFUNCTION, &StdLib_repeat, 0), -1);
+  Scope_set(p_global, "intern", Generic_new(TYPE_NATIVEFUNCTION, &StdLib_intern, 0), -1);
   Scope_set(p_global, "get", Generic_new(TYPE_NATIVEFUNCTION, &StdLib_get, 0), -1);
   Scope_set(p_global, "insert", Generic_new(TYPE_NATIVEFUNCTION, &StdLib_insert, 0), -1);
   Scope_set(p_global, "set", Generic_new(TYPE_NATIVEFUNCTION, &StdLib_set, 0), -1);
@@ -3627,9 +3461,7 @@ Scope *newGlobal(int argc, char *argv[]) {
 // Helper: Box an i64 value into Generic*
 Generic *franz_box_int(int64_t value) {
   // fprintf(stderr, "[BOX INT] Boxing value: %lld\n", (long long)value);
-  int *p_val = (int *)malloc(sizeof(int));
-  *p_val = (int)value;
-  Generic *result = Generic_new(TYPE_INT, p_val, 0);
+  Generic *result = Generic_newInt(value, 0);
   // fprintf(stderr, "[BOX INT] Created Generic* at %p, type=%d\n", result, result->type);
   return result;
 }
@@ -3637,9 +3469,7 @@ Generic *franz_box_int(int64_t value) {
 // Helper: Box a double value into Generic*
 Generic *franz_box_float(double value) {
   // fprintf(stderr, "[BOX FLOAT] Boxing value: %f\n", value);
-  double *p_val = (double *)malloc(sizeof(double));
-  *p_val = value;
-  Generic *result = Generic_new(TYPE_FLOAT, p_val, 0);
+  Generic *result = Generic_newFloat(value, 0);
   // fprintf(stderr, "[BOX FLOAT] Created Generic* at %p, type=%d\n", result, result->type);
   return result;
 }
@@ -3647,40 +3477,55 @@ Generic *franz_box_float(double value) {
 // Helper: Box a string (i8*) value into Generic*
 Generic *franz_box_string(char *value) {
   // fprintf(stderr, "[BOX STRING] Boxing value: %p = '%s'\n", value, value ? value : "(null)");
-  // Franz stores strings as char** (pointer to pointer)
   if (!value) {
     // fprintf(stderr, "[FRANZ_BOX_STRING ERROR] NULL input!\n");
     // Return empty string Generic*
-    char **p_val = (char **)malloc(sizeof(char *));
-    *p_val = (char *)malloc(1);
-    (*p_val)[0] = '\0';
-    Generic *result = Generic_new(TYPE_STRING, p_val, 0);
+    Generic *result = Generic_newString(String_new(0), 0);
     // fprintf(stderr, "[BOX STRING] Created Generic* at %p, type=%d\n", result, result->type);
     return result;
   }
 
-  char **p_val = (char **)malloc(sizeof(char *));
-  *p_val = (char *)malloc(strlen(value) + 1);
-  strcpy(*p_val, value);
-  Generic *result = Generic_new(TYPE_STRING, p_val, 0);
-  // fprintf(stderr, "[BOX STRING] Created Generic* at %p, type=%d, value='%s'\n", result, result->type, *p_val);
+  // The text of an interned string (from intern or a variant tag) boxes back to it
+  Generic *interned = Intern_fromText(value);
+  if (interned) return interned;
+
+  Generic *result = Generic_newString(String_fromText(value), 0);
+  // fprintf(stderr, "[BOX STRING] Created Generic* at %p, type=%d, value='%s'\n", result, result->type, result->strVal);
   return result;
 }
 
+// franz_intern(string) -> the interned Generic with the same text
+// Used once per string literal site to fill its slot (LLVMConstants_internedString)
+Generic *franz_intern(Generic *string) {
+  return Intern_generic(string);
+}
+
+// franz_intern_find(string) -> the interned Generic with the same text, or NULL
+// match uses it on a variant's tag, then compares it with the interned patterns by pointer
+Generic *franz_intern_find(Generic *string) {
+  if (!string || string->type != TYPE_STRING) return NULL;
+  return Intern_find(string);
+}
+
+// franz_intern_text(text) -> text of the interned copy, for (intern s) on an i8* string
+char *franz_intern_text(char *text) {
+  return Intern_string(text ? text : "")->strVal;
+}
+
 //  Smart pointer boxing - checks if already Generic*, otherwise boxes as string
 // This handles polymorphic closures returning POINTER type (could be string OR Generic* list)
 Generic *franz_box_pointer_smart(void *ptr) {
-  fprintf(stderr, "[BOX POINTER SMART] Checking pointer: %p\n", ptr);
+  TRACE(TRACE_VALUES, "box pointer: Checking pointer: %p", ptr);
 
   uintptr_t addr = (uintptr_t)ptr;
   if (addr == 0) {
-    fprintf(stderr, "[BOX POINTER SMART] NULL pointer, treating as int 0 payload\n");
+    TRACE(TRACE_VALUES, "box pointer: NULL pointer, treating as int 0 payload");
     return franz_box_int(0);
   }
 
   if (addr < 4096) {
     // Pointer is actually an int payload (from inttoptr), box as int safely
-    fprintf(stderr, "[BOX POINTER SMART] Small address (%zu) treated as int payload\n", (size_t)addr);
+    TRACE(TRACE_VALUES, "box pointer: Small address (%zu) treated as int payload", (size_t)addr);
     return franz_box_int((int64_t)addr);
   }
 
@@ -3692,11 +3537,11 @@ Generic *franz_box_pointer_smart(void *ptr) {
   // If it looks like a Generic*, return it as-is
   // Otherwise, treat as raw string pointer and box it
   if (potential_generic->type >= TYPE_INT && potential_generic->type <= TYPE_REF) {
-    fprintf(stderr, "[BOX POINTER SMART] Detected Generic* (type=%d), returning as-is\n", potential_generic->type);
+    TRACE(TRACE_VALUES, "box pointer: Detected Generic* (type=%d), returning as-is", potential_generic->type);
     return potential_generic;
   } else {
-    fprintf(stderr, "[BOX POINTER SMART] Not Generic* (type=%d at first 4 bytes), boxing as string\n", potential_generic->type);
-    fprintf(stderr, "[BOX POINTER SMART] String content: %.20s\n", (char*)ptr);
+    TRACE(TRACE_VALUES, "box pointer: Not Generic* (type=%d at first 4 bytes), boxing as string", potential_generic->type);
+    TRACE(TRACE_VALUES, "box pointer: String content: %.20s", (char*)ptr);
     return franz_box_string((char *)ptr);
   }
 }
@@ -3738,7 +3583,7 @@ Generic *franz_box_param_tag(int64_t rawValue, int tag) {
 // Input: Generic* (i64 cast to Generic*)
 // Output: Raw closure i64 (from Generic->p_value)
 int64_t franz_generic_to_closure_ptr(int64_t generic_i64) {
-  fprintf(stderr, "[UNBOX CLOSURE] Unboxing Generic* %lld to closure i64\n", (long long)generic_i64);
+  TRACE(TRACE_CLOSURES, "unbox closure: Unboxing Generic* %lld to closure i64", (long long)generic_i64);
 
   // Cast i64 back to Generic*
   Generic *generic = (Generic *)(intptr_t)generic_i64;
@@ -3748,13 +3593,13 @@ int64_t franz_generic_to_closure_ptr(int64_t generic_i64) {
     return 0;
   }
 
-  fprintf(stderr, "[UNBOX CLOSURE] Generic type = %d (should be TYPE_CLOSURE)\n", generic->type);
+  TRACE(TRACE_CLOSURES, "unbox closure: Generic type = %d (should be TYPE_CLOSURE)", generic->type);
 
   // Extract the closure i64 from p_val
   // The p_val contains the raw closure struct (cast to void*)
   int64_t closure_i64 = (int64_t)(intptr_t)(generic->p_val);
 
-  fprintf(stderr, "[UNBOX CLOSURE] Extracted closure i64: %lld\n", (long long)closure_i64);
+  TRACE(TRACE_CLOSURES, "unbox closure: Extracted closure i64: %lld", (long long)closure_i64);
 
   return closure_i64;
 }
@@ -3774,18 +3619,64 @@ Generic *franz_box_closure(void *closure_ptr) {
   return Generic_new(TYPE_BYTECODE_CLOSURE, closure_ptr, 0);
 }
 
-// LLVM Closure struct layout: { i8* funcPtr, i8* envPtr, i32 returnTypeTag }
+// Stub table of an LLVM closure (LLVMClosures_emitStubs)
+// boxed unboxes args[0 .. arity-1] for the closure's own ABI, calls it and boxes the
+// result, all specialized when the closure was compiled
+typedef struct LLVMClosureStubs {
+  int arity;
+  int returnTypeTag;
+  Generic *(*boxed)(void *env, Generic **args);
+} LLVMClosureStubs;
+
+// LLVM Closure struct layout: { i8* funcPtr, i8* envPtr, i32 returnTypeTag, i32 paramIndex, i8* stubs }
 typedef struct LLVMClosure {
   void *funcPtr;
   void *envPtr;
   int returnTypeTag;  // 0=int, 1=float, 2=pointer
+  int paramIndex;
+  const LLVMClosureStubs *stubs;
 } LLVMClosure;
 
+// Payload of a tagged closure parameter: the int, the float's bits, or the Generic* itself
+int64_t franz_closure_arg(Generic *arg) {
+  if (arg->type == TYPE_INT) return (int64_t)arg->intVal;
+  if (arg->type == TYPE_FLOAT) {
+    int64_t bits;
+    memcpy(&bits, &arg->floatVal, sizeof(bits));
+    return bits;
+  }
+  return (int64_t)(intptr_t)arg;
+}
+
+// i64 parameter of a typed function: the int, a truncated float, or the Generic* itself
+int64_t franz_closure_arg_int(Generic *arg) {
+  if (arg->type == TYPE_INT) return (int64_t)arg->intVal;
+  if (arg->type == TYPE_FLOAT) return (int64_t)arg->floatVal;
+  return (int64_t)(intptr_t)arg;
+}
+
+// double parameter of a typed function
+double franz_closure_arg_float(Generic *arg) {
+  return franz_unbox_float(arg);
+}
+
+// Pointer parameter of a typed function: a string's text, otherwise the Generic* itself
+void *franz_closure_arg_pointer(Generic *arg) {
+  if (arg->type == TYPE_STRING) return arg->strVal;
+  return arg;
+}
+
+// Stub table of an LLVM closure that takes at most argCount arguments, NULL if it has none
+static const LLVMClosureStubs *franz_closure_stubs(Generic *closure_gen, int argCount) {
+  if (!closure_gen || closure_gen->type != TYPE_BYTECODE_CLOSURE) return NULL;
+  const LLVMClosureStubs *stubs = ((LLVMClosure *)closure_gen->p_val)->stubs;
+  if (!stubs || !stubs->boxed || stubs->arity > argCount) return NULL;
+  return stubs;
+}
+
 // Helper: Call an LLVM closure from runtime
 // LLVM closures have function signature: result (*)(env, arg1, arg2, ...)
 Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argCount, int lineNumber) {
-  fprintf(stderr, "[RUNTIME DEBUG] franz_call_llvm_closure called with %d args\n", argCount);
-
   if (closure_gen->type != TYPE_BYTECODE_CLOSURE) {
     fprintf(stderr, "Runtime Error @ Line %d: Expected LLVM closure, got type %d\n", lineNumber, closure_gen->type);
     exit(1);
@@ -3793,8 +3684,17 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
   // Extract LLVM closure struct
   LLVMClosure *llvm_closure = (LLVMClosure *)closure_gen->p_val;
-  fprintf(stderr, "[RUNTIME DEBUG] LLVM closure: funcPtr=%p, envPtr=%p, returnTypeTag=%d\n",
-          llvm_closure->funcPtr, llvm_closure->envPtr, llvm_closure->returnTypeTag);
+
+  // Closures compiled with stubs: one call, no argument or result switching
+  const LLVMClosureStubs *stubs = franz_closure_stubs(closure_gen, argCount);
+  if (stubs) {
+    TRACE(TRACE_CLOSURES, "call %p: %d args through its boxed entry", (void *)llvm_closure, argCount);
+    return stubs->boxed(llvm_closure->envPtr, args);
+  }
+
+  TRACE(TRACE_CLOSURES, "franz_call_llvm_closure called with %d args", argCount);
+  TRACE(TRACE_CLOSURES, "LLVM closure: funcPtr=%p, envPtr=%p, returnTypeTag=%d",
+      llvm_closure->funcPtr, llvm_closure->envPtr, llvm_closure->returnTypeTag);
 
   // Function signature depends on whether it's a closure or regular function:
   // - Closure: result (*)(env, arg1, arg2, ...)
@@ -3808,9 +3708,9 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
     int64_t key_i64;
     if (args[0]->type == TYPE_INT) {
-      key_i64 = (int64_t)(*((int *)args[0]->p_val));
+      key_i64 = (int64_t)(args[0]->intVal);
     } else if (args[0]->type == TYPE_FLOAT) {
-      double fval = *((double *)args[0]->p_val);
+      double fval = args[0]->floatVal;
       key_i64 = *((int64_t *)&fval);  // Bitcast double to i64
     } else {
       key_i64 = (int64_t)args[0];  // Pass Generic* as pointer
@@ -3818,18 +3718,18 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
     int64_t val_i64;
     if (args[1]->type == TYPE_INT) {
-      val_i64 = (int64_t)(*((int *)args[1]->p_val));
+      val_i64 = (int64_t)(args[1]->intVal);
     } else if (args[1]->type == TYPE_FLOAT) {
-      double fval = *((double *)args[1]->p_val);
+      double fval = args[1]->floatVal;
       val_i64 = *((int64_t *)&fval);  // Bitcast double to i64
     } else {
       val_i64 = (int64_t)args[1];  // Pass Generic* as pointer
     }
 
-    fprintf(stderr, "[ARG UNBOX DEBUG] args[0]=0x%llx (Generic*), key_i64=%lld (0x%llx)\n",
-            (unsigned long long)args[0], key_i64, (unsigned long long)key_i64);
-    fprintf(stderr, "[ARG UNBOX DEBUG] args[1]=0x%llx (Generic*), val_i64=%lld (0x%llx)\n",
-            (unsigned long long)args[1], val_i64, (unsigned long long)val_i64);
+    TRACE(TRACE_CLOSURES, "args[0]=0x%llx (Generic*), key_i64=%lld (0x%llx)",
+        (unsigned long long)args[0], (long long)key_i64, (unsigned long long)key_i64);
+    TRACE(TRACE_CLOSURES, "args[1]=0x%llx (Generic*), val_i64=%lld (0x%llx)",
+        (unsigned long long)args[1], (long long)val_i64, (unsigned long long)val_i64);
 
     int64_t result;
 
@@ -3841,21 +3741,21 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
     if (llvm_closure->envPtr != NULL) {
       // CLOSURE: Has captured environment - call with env as first parameter
       int64_t env_i64 = (int64_t)llvm_closure->envPtr;
-      fprintf(stderr, "[RUNTIME DEBUG] Calling CLOSURE with env_i64=%lld, key_i64=%lld, key_tag=%d, val_i64=%lld, val_tag=%d\n",
-              env_i64, key_i64, key_tag, val_i64, val_tag);
+      TRACE(TRACE_CLOSURES, "Calling CLOSURE with env_i64=%lld, key_i64=%lld, key_tag=%d, val_i64=%lld, val_tag=%d",
+          (long long)env_i64, (long long)key_i64, key_tag, (long long)val_i64, val_tag);
 
       int64_t (*func)(int64_t, int64_t, int32_t, int64_t, int32_t) = (int64_t (*)(int64_t, int64_t, int32_t, int64_t, int32_t))llvm_closure->funcPtr;
       result = func(env_i64, key_i64, key_tag, val_i64, val_tag);
     } else {
       // REGULAR FUNCTION: No environment - call directly with args as i64 + tags
-      fprintf(stderr, "[RUNTIME DEBUG] Calling REGULAR FUNCTION with key_i64=%lld, key_tag=%d, val_i64=%lld, val_tag=%d\n",
-              key_i64, key_tag, val_i64, val_tag);
+      TRACE(TRACE_CLOSURES, "Calling REGULAR FUNCTION with key_i64=%lld, key_tag=%d, val_i64=%lld, val_tag=%d",
+          (long long)key_i64, key_tag, (long long)val_i64, val_tag);
 
       int64_t (*func)(int64_t, int32_t, int64_t, int32_t) = (int64_t (*)(int64_t, int32_t, int64_t, int32_t))llvm_closure->funcPtr;
       result = func(key_i64, key_tag, val_i64, val_tag);
     }
 
-    fprintf(stderr, "[RUNTIME DEBUG] LLVM function returned: %lld (0x%llx)\n", result, (unsigned long long)result);
+    TRACE(TRACE_CLOSURES, "LLVM function returned: %lld (0x%llx)", (long long)result, (unsigned long long)result);
 
     // CRITICAL: LLVM arithmetic operations return RAW primitive values, not Generic* pointers
     // We need to BOX the result based on returnTypeTag
@@ -3865,17 +3765,17 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
     if (llvm_closure->returnTypeTag == 0) {
       // INT - box the raw integer
-      fprintf(stderr, "[RESULT DEBUG] Boxing INT result: %lld\n", result);
+      TRACE(TRACE_CLOSURES, "Boxing INT result: %lld", (long long)result);
       return franz_box_int(result);
     } else if (llvm_closure->returnTypeTag == 1) {
       // FLOAT - reinterpret i64 as double, then box
       double fval = *((double *)&result);
-      fprintf(stderr, "[RESULT DEBUG] Boxing FLOAT result: %f\n", fval);
+      TRACE(TRACE_CLOSURES, "Boxing FLOAT result: %f", fval);
       return franz_box_float(fval);
     } else {
       // POINTER - already a Generic* pointer cast to i64
       Generic *result_generic = (Generic *)result;
-      fprintf(stderr, "[RESULT DEBUG] Returning POINTER result: %p\n", result_generic);
+      TRACE(TRACE_CLOSURES, "Returning POINTER result: %p", result_generic);
       return result_generic;
     }
   } else if (argCount == 1) {
@@ -3883,36 +3783,36 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
     //  FIX: LLVM closures need UNBOXED primitive values, NOT Generic* pointers!
     int64_t arg_i64;
     if (args[0]->type == TYPE_INT) {
-      arg_i64 = (int64_t)(*((int *)args[0]->p_val));
+      arg_i64 = (int64_t)(args[0]->intVal);
     } else if (args[0]->type == TYPE_FLOAT) {
-      double fval = *((double *)args[0]->p_val);
+      double fval = args[0]->floatVal;
       arg_i64 = *((int64_t *)&fval);  // Bitcast double to i64
     } else {
       arg_i64 = (int64_t)args[0];  // Pass Generic* as pointer
     }
 
-    fprintf(stderr, "[ARG UNBOX DEBUG] args[0]=0x%llx (Generic*), arg_i64=%lld (0x%llx)\n",
-            (unsigned long long)args[0], arg_i64, (unsigned long long)arg_i64);
+    TRACE(TRACE_CLOSURES, "args[0]=0x%llx (Generic*), arg_i64=%lld (0x%llx)",
+        (unsigned long long)args[0], (long long)arg_i64, (unsigned long long)arg_i64);
 
     int64_t result;
 
     if (llvm_closure->envPtr != NULL) {
       // CLOSURE: Has captured environment - call with env as first parameter
       int64_t env_i64 = (int64_t)llvm_closure->envPtr;
-      fprintf(stderr, "[RUNTIME DEBUG] Calling CLOSURE with env_i64=%lld, arg_i64=%lld\n",
-              env_i64, arg_i64);
+      TRACE(TRACE_CLOSURES, "Calling CLOSURE with env_i64=%lld, arg_i64=%lld",
+          (long long)env_i64, (long long)arg_i64);
 
       int64_t (*func)(int64_t, int64_t) = (int64_t (*)(int64_t, int64_t))llvm_closure->funcPtr;
       result = func(env_i64, arg_i64);
     } else {
       // REGULAR FUNCTION: No environment - call directly with arg as i64
-      fprintf(stderr, "[RUNTIME DEBUG] Calling REGULAR FUNCTION with arg_i64=%lld\n", arg_i64);
+      TRACE(TRACE_CLOSURES, "Calling REGULAR FUNCTION with arg_i64=%lld", (long long)arg_i64);
 
       int64_t (*func)(int64_t) = (int64_t (*)(int64_t))llvm_closure->funcPtr;
       result = func(arg_i64);
     }
 
-    fprintf(stderr, "[RUNTIME DEBUG] LLVM function returned: %lld (0x%llx)\n", result, (unsigned long long)result);
+    TRACE(TRACE_CLOSURES, "LLVM function returned: %lld (0x%llx)", (long long)result, (unsigned long long)result);
 
     // CRITICAL: Box the result based on returnTypeTag
     // - returnTypeTag=0: INT - box as Generic* with TYPE_INT
@@ -3921,17 +3821,17 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
     if (llvm_closure->returnTypeTag == 0) {
       // INT - box the raw integer
-      fprintf(stderr, "[RESULT DEBUG] Boxing INT result: %lld\n", result);
+      TRACE(TRACE_CLOSURES, "Boxing INT result: %lld", (long long)result);
       return franz_box_int(result);
     } else if (llvm_closure->returnTypeTag == 1) {
       // FLOAT - reinterpret i64 as double, then box
       double fval = *((double *)&result);
-      fprintf(stderr, "[RESULT DEBUG] Boxing FLOAT result: %f\n", fval);
+      TRACE(TRACE_CLOSURES, "Boxing FLOAT result: %f", fval);
       return franz_box_float(fval);
     } else {
       // POINTER - already a Generic* pointer cast to i64
       Generic *result_generic = (Generic *)result;
-      fprintf(stderr, "[RESULT DEBUG] Returning POINTER result: %p\n", result_generic);
+      TRACE(TRACE_CLOSURES, "Returning POINTER result: %p", result_generic);
       return result_generic;
     }
   } else if (argCount == 3) {
@@ -3941,9 +3841,9 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
     int64_t arg1_i64;
     if (args[0]->type == TYPE_INT) {
-      arg1_i64 = (int64_t)(*((int *)args[0]->p_val));
+      arg1_i64 = (int64_t)(args[0]->intVal);
     } else if (args[0]->type == TYPE_FLOAT) {
-      double fval = *((double *)args[0]->p_val);
+      double fval = args[0]->floatVal;
       arg1_i64 = *((int64_t *)&fval);  // Bitcast double to i64
     } else {
       arg1_i64 = (int64_t)args[0];  // Pass Generic* as pointer
@@ -3951,9 +3851,9 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
     int64_t arg2_i64;
     if (args[1]->type == TYPE_INT) {
-      arg2_i64 = (int64_t)(*((int *)args[1]->p_val));
+      arg2_i64 = (int64_t)(args[1]->intVal);
     } else if (args[1]->type == TYPE_FLOAT) {
-      double fval = *((double *)args[1]->p_val);
+      double fval = args[1]->floatVal;
       arg2_i64 = *((int64_t *)&fval);  // Bitcast double to i64
     } else {
       arg2_i64 = (int64_t)args[1];  // Pass Generic* as pointer
@@ -3961,20 +3861,20 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
 
     int64_t arg3_i64;
     if (args[2]->type == TYPE_INT) {
-      arg3_i64 = (int64_t)(*((int *)args[2]->p_val));
+      arg3_i64 = (int64_t)(args[2]->intVal);
     } else if (args[2]->type == TYPE_FLOAT) {
-      double fval = *((double *)args[2]->p_val);
+      double fval = args[2]->floatVal;
       arg3_i64 = *((int64_t *)&fval);  // Bitcast double to i64
     } else {
       arg3_i64 = (int64_t)args[2];  // Pass Generic* as pointer
     }
 
-    fprintf(stderr, "[ARG UNBOX DEBUG] args[0]=0x%llx, arg1_i64=%lld (0x%llx)\n",
-            (unsigned long long)args[0], arg1_i64, (unsigned long long)arg1_i64);
-    fprintf(stderr, "[ARG UNBOX DEBUG] args[1]=0x%llx, arg2_i64=%lld (0x%llx)\n",
-            (unsigned long long)args[1], arg2_i64, (unsigned long long)arg2_i64);
-    fprintf(stderr, "[ARG UNBOX DEBUG] args[2]=0x%llx, arg3_i64=%lld (0x%llx)\n",
-            (unsigned long long)args[2], arg3_i64, (unsigned long long)arg3_i64);
+    TRACE(TRACE_CLOSURES, "args[0]=0x%llx, arg1_i64=%lld (0x%llx)",
+        (unsigned long long)args[0], (long long)arg1_i64, (unsigned long long)arg1_i64);
+    TRACE(TRACE_CLOSURES, "args[1]=0x%llx, arg2_i64=%lld (0x%llx)",
+        (unsigned long long)args[1], (long long)arg2_i64, (unsigned long long)arg2_i64);
+    TRACE(TRACE_CLOSURES, "args[2]=0x%llx, arg3_i64=%lld (0x%llx)",
+        (unsigned long long)args[2], (long long)arg3_i64, (unsigned long long)arg3_i64);
 
     int64_t result;
 
@@ -3986,38 +3886,38 @@ Generic *franz_call_llvm_closure(Generic *closure_gen, Generic *args[], int argC
     if (llvm_closure->envPtr != NULL) {
       // CLOSURE: Has captured environment
       int64_t env_i64 = (int64_t)llvm_closure->envPtr;
-      fprintf(stderr, "[RUNTIME DEBUG] Calling CLOSURE with env_i64=%lld, arg1=%lld (tag=%d), arg2=%lld (tag=%d), arg3=%lld (tag=%d)\n",
-              env_i64, arg1_i64, arg1_tag, arg2_i64, arg2_tag, arg3_i64, arg3_tag);
+      TRACE(TRACE_CLOSURES, "Calling CLOSURE with env_i64=%lld, arg1=%lld (tag=%d), arg2=%lld (tag=%d), arg3=%lld (tag=%d)",
+          (long long)env_i64, (long long)arg1_i64, arg1_tag, (long long)arg2_i64, arg2_tag, (long long)arg3_i64, arg3_tag);
 
       int64_t (*func)(int64_t, int64_t, int32_t, int64_t, int32_t, int64_t, int32_t) =
         (int64_t (*)(int64_t, int64_t, int32_t, int64_t, int32_t, int64_t, int32_t))llvm_closure->funcPtr;
       result = func(env_i64, arg1_i64, arg1_tag, arg2_i64, arg2_tag, arg3_i64, arg3_tag);
     } else {
       // REGULAR FUNCTION: No environment
-      fprintf(stderr, "[RUNTIME DEBUG] Calling REGULAR FUNCTION with arg1=%lld (tag=%d), arg2=%lld (tag=%d), arg3=%lld (tag=%d)\n",
-              arg1_i64, arg1_tag, arg2_i64, arg2_tag, arg3_i64, arg3_tag);
+      TRACE(TRACE_CLOSURES, "Calling REGULAR FUNCTION with arg1=%lld (tag=%d), arg2=%lld (tag=%d), arg3=%lld (tag=%d)",
+          (long long)arg1_i64, arg1_tag, (long long)arg2_i64, arg2_tag, (long long)arg3_i64, arg3_tag);
 
       int64_t (*func)(int64_t, int32_t, int64_t, int32_t, int64_t, int32_t) =
         (int64_t (*)(int64_t, int32_t, int64_t, int32_t, int64_t, int32_t))llvm_closure->funcPtr;
       result = func(arg1_i64, arg1_tag, arg2_i64, arg2_tag, arg3_i64, arg3_tag);
     }
 
-    fprintf(stderr, "[RUNTIME DEBUG] LLVM function returned: %lld (0x%llx)\n", result, (unsigned long long)result);
+    TRACE(TRACE_CLOSURES, "LLVM function returned: %lld (0x%llx)", (long long)result, (unsigned long long)result);
 
     // Box the result based on returnTypeTag
     if (llvm_closure->returnTypeTag == 0) {
       // INT - box the raw integer
-      fprintf(stderr, "[RESULT DEBUG] Boxing INT result: %lld\n", result);
+      TRACE(TRACE_CLOSURES, "Boxing INT result: %lld", (long long)result);
       return franz_box_int(result);
     } else if (llvm_closure->returnTypeTag == 1) {
       // FLOAT - reinterpret i64 as double, then box
       double fval = *((double *)&result);
-      fprintf(stderr, "[RESULT DEBUG] Boxing FLOAT result: %f\n", fval);
+      TRACE(TRACE_CLOSURES, "Boxing FLOAT result: %f", fval);
       return franz_box_float(fval);
     } else {
       // POINTER - already a Generic* pointer cast to i64
       Generic *result_generic = (Generic *)result;
-      fprintf(stderr, "[RESULT DEBUG] Returning POINTER result: %p\n", result_generic);
+      TRACE(TRACE_CLOSURES, "Returning POINTER result: %p", result_generic);
       return result_generic;
     }
   }
@@ -4047,7 +3947,7 @@ Generic *franz_list_head(Generic *list) {
     fprintf(stderr, "Runtime Error: head called on empty list\n");
     exit(1);
   }
-  return l->vals[0];
+  return List_at(l, 0);
 }
 
 // Helper: Get rest of list (tail/cdr)
@@ -4061,12 +3961,39 @@ Generic *franz_list_tail(Generic *list) {
     fprintf(stderr, "Runtime Error: tail called on empty list\n");
     exit(1);
   }
-  // Create new list with elements [1..len)
-  Generic **newElements = (Generic **)malloc(sizeof(Generic *) * (l->len - 1));
-  for (int i = 1; i < l->len; i++) {
-    newElements[i - 1] = l->vals[i];
+  // View of [1..len) sharing the trie with list: O(1), no copy
+  return Generic_new(TYPE_LIST, List_sublist(l, 1, l->len), 0);
+}
+
+// Helper: Slice list (get list start end)
+Generic *franz_list_slice(Generic *list, int64_t start, int64_t end) {
+  if (!list || list->type != TYPE_LIST) {
+    fprintf(stderr, "Runtime Error: slice requires a list argument\n");
+    exit(1);
+  }
+  List *l = (List *)list->p_val;
+  if (start < 0 || start > l->len || end < start || end > l->len) {
+    fprintf(stderr, "Runtime Error: list slice [%lld, %lld) out of bounds (length %d)\n",
+            (long long)start, (long long)end, l->len);
+    exit(1);
+  }
+  // View of [start..end) sharing the trie with list: O(1), no copy
+  return Generic_new(TYPE_LIST, List_sublist(l, (int)start, (int)end), 0);
+}
+
+// Helper: Slice string (get string start end), one copy straight into a new String
+Generic *franz_string_slice(Generic *string, int64_t start, int64_t end) {
+  if (!string || string->type != TYPE_STRING) {
+    fprintf(stderr, "Runtime Error: slice requires a string argument\n");
+    exit(1);
+  }
+  int len = String_length(string->strVal);
+  if (start < 0 || start > len || end < start || end > len) {
+    fprintf(stderr, "Runtime Error: string slice [%lld, %lld) out of bounds (length %d)\n",
+            (long long)start, (long long)end, len);
+    exit(1);
   }
-  return franz_list_new(newElements, l->len - 1);
+  return Generic_newString(String_fromBytes(string->strVal + start, (int)(end - start)), 0);
 }
 
 // Helper: Prepend element to list (cons)
@@ -4075,14 +4002,8 @@ Generic *franz_list_cons(Generic *elem, Generic *list) {
     fprintf(stderr, "Runtime Error: cons requires a list as second argument\n");
     exit(1);
   }
-  List *l = (List *)list->p_val;
-  // Create new list with elem prepended
-  Generic **newElements = (Generic **)malloc(sizeof(Generic *) * (l->len + 1));
-  newElements[0] = elem;
-  for (int i = 0; i < l->len; i++) {
-    newElements[i + 1] = l->vals[i];
-  }
-  return franz_list_new(newElements, l->len + 1);
+  // Persistent prepend, shares the trie with list: O(log n)
+  return Generic_new(TYPE_LIST, List_insert((List *)list->p_val, elem, 0), 0);
 }
 
 // Helper: Check if list is empty
@@ -4105,8 +4026,7 @@ int64_t franz_list_length(Generic *list) {
     return l->len;
   }
   if (list->type == TYPE_STRING) {
-    char **p_str = (char **)list->p_val;
-    return (int64_t)strlen(*p_str);
+    return (int64_t)String_length(list->strVal);
   }
   fprintf(stderr, "Runtime Error: length requires a list or string argument\n");
   exit(1);
@@ -4124,7 +4044,7 @@ Generic *franz_list_nth(Generic *list, int64_t index) {
             (long long)index, l->len);
     exit(1);
   }
-  return l->vals[index];
+  return List_at(l, index);
 }
 
 // Helper: Check if Generic* is a list
@@ -4133,6 +4053,36 @@ int64_t franz_is_list(Generic *value) {
   return (value->type == TYPE_LIST) ? 1 : 0;
 }
 
+// Helper: (range n) - list of 0 .. n - 1
+// The ints go through a heap array, so large ranges do not overflow the stack
+Generic *franz_list_range(int64_t count, int64_t lineNumber) {
+  if (count < 0) {
+    fprintf(stderr, "Runtime Error @ Line %d: range requires a non-negative count (got %lld)\n",
+            (int)lineNumber, (long long)count);
+    exit(1);
+  }
+
+  Generic **items = malloc(sizeof(Generic *) * (count > 0 ? count : 1));
+  for (int64_t i = 0; i < count; i++) {
+    items[i] = Generic_newInt(i, 0);
+  }
+
+  // the list holds the ints now
+  List *list = List_new(items, (int)count);
+  free(items);
+  return Generic_new(TYPE_LIST, list, 0);
+}
+
+// Helper: length of the list an inlined map/filter/reduce loop walks (llvm-callbacks)
+int64_t franz_callback_list_length(Generic *list, char *caller, int64_t lineNumber) {
+  if (!list || list->type != TYPE_LIST) {
+    fprintf(stderr, "Runtime Error @ Line %d: %s requires a list as first argument\n",
+            (int)lineNumber, caller);
+    exit(1);
+  }
+  return ((List *)list->p_val)->len;
+}
+
 // ============================================================================
 // LLVM Filter Implementation
 // ============================================================================
@@ -4149,8 +4099,8 @@ int64_t franz_is_list(Generic *value) {
  * @return Generic* - New filtered list
  */
 Generic *franz_llvm_filter(Generic *list, Generic *predicate, int lineNumber) {
-  fprintf(stderr, "[LLVM FILTER] Called with list type=%d, predicate type=%d\n",
-          list ? list->type : -1, predicate ? predicate->type : -1);
+  TRACE(TRACE_LISTS, "filter: Called with list type=%d, predicate type=%d",
+      list ? list->type : -1, predicate ? predicate->type : -1);
 
   // Validate list argument
   if (!list || list->type != TYPE_LIST) {
@@ -4166,34 +4116,39 @@ Generic *franz_llvm_filter(Generic *list, Generic *predicate, int lineNumber) {
   }
 
   List *input = (List *)list->p_val;
-  fprintf(stderr, "[LLVM FILTER] Processing list with %d elements\n", input->len);
+  TRACE(TRACE_LISTS, "filter: Processing list with %d elements", input->len);
 
   // Build result list - allocate for worst case (all elements pass)
   Generic **filtered = (Generic **)malloc(sizeof(Generic *) * input->len);
   int count = 0;
 
+  // Boxed entry of the predicate, looked up once for the whole list
+  const LLVMClosureStubs *stubs = franz_closure_stubs(predicate, 2);
+  void *env = ((LLVMClosure *)predicate->p_val)->envPtr;
+
   // Iterate through list elements
   for (int i = 0; i < input->len; i++) {
-    fprintf(stderr, "[LLVM FILTER] Processing element %d\n", i);
+    TRACE(TRACE_LISTS, "filter: Processing element %d", i);
 
     // Prepare arguments for predicate: (element, index)
-    Generic *elem = input->vals[i];
+    Generic *elem = List_at(input, i);
     Generic *index_gen = franz_box_int(i);
 
     Generic *predicateArgs[] = { elem, index_gen };
 
     // Call the predicate closure with (element, index)
-    fprintf(stderr, "[LLVM FILTER] Calling predicate for element %d\n", i);
-    Generic *result = franz_call_llvm_closure(predicate, predicateArgs, 2, lineNumber);
-    fprintf(stderr, "[LLVM FILTER] Predicate returned type=%d\n", result ? result->type : -1);
+    TRACE(TRACE_LISTS, "filter: Calling predicate for element %d", i);
+    Generic *result = stubs ? stubs->boxed(env, predicateArgs)
+                            : franz_call_llvm_closure(predicate, predicateArgs, 2, lineNumber);
+    TRACE(TRACE_LISTS, "filter: Predicate returned type=%d", result ? result->type : -1);
 
     // Check if result is truthy (non-zero for integers)
     int is_truthy = 0;
     if (result) {
       if (result->type == TYPE_INT) {
-        int result_val = *((int *)result->p_val);
+        int result_val = result->intVal;
         is_truthy = (result_val != 0);
-        fprintf(stderr, "[LLVM FILTER] Integer result: %d (truthy=%d)\n", result_val, is_truthy);
+        TRACE(TRACE_LISTS, "filter: Integer result: %d (truthy=%d)", result_val, is_truthy);
       } else {
         // Non-integer truthy values (strings, lists, etc. are truthy if non-null)
         is_truthy = 1;
@@ -4202,14 +4157,14 @@ Generic *franz_llvm_filter(Generic *list, Generic *predicate, int lineNumber) {
 
     // Include element if predicate returned truthy value
     if (is_truthy) {
-      fprintf(stderr, "[LLVM FILTER] Including element %d in result\n", i);
-      filtered[count++] = Generic_copy(elem);
+      TRACE(TRACE_LISTS, "filter: Including element %d in result", i);
+      filtered[count++] = elem;
     } else {
-      fprintf(stderr, "[LLVM FILTER] Excluding element %d from result\n", i);
+      TRACE(TRACE_LISTS, "filter: Excluding element %d from result", i);
     }
 
-    // Clean up index Generic
-    if (index_gen->refCount == 0) {
+    // Clean up index Generic (unless the predicate returned it)
+    if (index_gen != result && index_gen->refCount == 0) {
       Generic_free(index_gen);
     }
 
@@ -4219,7 +4174,7 @@ Generic *franz_llvm_filter(Generic *list, Generic *predicate, int lineNumber) {
     }
   }
 
-  fprintf(stderr, "[LLVM FILTER] Filtered %d elements down to %d\n", input->len, count);
+  TRACE(TRACE_LISTS, "filter: Filtered %d elements down to %d", input->len, count);
 
   // Create result list with only the filtered elements
   List *resultList = List_new(filtered, count);
@@ -4261,16 +4216,22 @@ Generic *franz_llvm_map(Generic *list, Generic *callback, int lineNumber) {
   // Build result list - allocate for all elements
   Generic **mapped = (Generic **)malloc(sizeof(Generic *) * input->len);
 
+  // Boxed entry of the callback, looked up once for the whole list
+  const LLVMClosureStubs *stubs = franz_closure_stubs(callback, 2);
+  void *env = ((LLVMClosure *)callback->p_val)->envPtr;
+  TRACE(TRACE_LISTS, "map: %d elements, %s", input->len, stubs ? "boxed entry" : "franz_call_llvm_closure");
+
   // Iterate through list elements
   for (int i = 0; i < input->len; i++) {
     // Prepare arguments for callback: (element, index)
-    Generic *elem = input->vals[i];
+    Generic *elem = List_at(input, i);
     Generic *index_gen = franz_box_int(i);
 
     Generic *callbackArgs[] = { elem, index_gen };
 
     // Call the callback closure with (element, index)
-    Generic *result = franz_call_llvm_closure(callback, callbackArgs, 2, lineNumber);
+    Generic *result = stubs ? stubs->boxed(env, callbackArgs)
+                            : franz_call_llvm_closure(callback, callbackArgs, 2, lineNumber);
 
     // Store the transformed value
     if (!result) {
@@ -4278,17 +4239,13 @@ Generic *franz_llvm_map(Generic *list, Generic *callback, int lineNumber) {
       exit(1);
     }
 
-    mapped[i] = Generic_copy(result);
+    // The result list takes a reference to it below, no copy
+    mapped[i] = result;
 
-    // Clean up index Generic
-    if (index_gen->refCount == 0) {
+    // Clean up index Generic (unless the callback returned it)
+    if (index_gen != result && index_gen->refCount == 0) {
       Generic_free(index_gen);
     }
-
-    // Clean up result if not referenced
-    if (result && result->refCount == 0) {
-      Generic_free(result);
-    }
   }
 
   // Create result list with all transformed elements
@@ -4343,17 +4300,23 @@ Generic *franz_llvm_map2(Generic *list1, Generic *list2, Generic *callback, int
   // Build result list
   Generic **mapped = (Generic **)malloc(sizeof(Generic *) * resultLen);
 
+  // Boxed entry of the callback, looked up once for both lists
+  const LLVMClosureStubs *stubs = franz_closure_stubs(callback, 3);
+  void *env = ((LLVMClosure *)callback->p_val)->envPtr;
+  TRACE(TRACE_LISTS, "map2: %d elements, %s", resultLen, stubs ? "boxed entry" : "franz_call_llvm_closure");
+
   // Iterate through list elements
   for (int i = 0; i < resultLen; i++) {
     // Prepare arguments for callback: (element1, element2, index)
-    Generic *elem1 = input1->vals[i];
-    Generic *elem2 = input2->vals[i];
+    Generic *elem1 = List_at(input1, i);
+    Generic *elem2 = List_at(input2, i);
     Generic *index_gen = franz_box_int(i);
 
     Generic *callbackArgs[] = { elem1, elem2, index_gen };
 
     // Call the callback closure with (element1, element2, index)
-    Generic *result = franz_call_llvm_closure(callback, callbackArgs, 3, lineNumber);
+    Generic *result = stubs ? stubs->boxed(env, callbackArgs)
+                            : franz_call_llvm_closure(callback, callbackArgs, 3, lineNumber);
 
     // Store the transformed value
     if (!result) {
@@ -4361,17 +4324,13 @@ Generic *franz_llvm_map2(Generic *list1, Generic *list2, Generic *callback, int
       exit(1);
     }
 
-    mapped[i] = Generic_copy(result);
+    // The result list takes a reference to it below, no copy
+    mapped[i] = result;
 
-    // Clean up index Generic
-    if (index_gen->refCount == 0) {
+    // Clean up index Generic (unless the callback returned it)
+    if (index_gen != result && index_gen->refCount == 0) {
       Generic_free(index_gen);
     }
-
-    // Clean up result if not referenced
-    if (result && result->refCount == 0) {
-      Generic_free(result);
-    }
   }
 
   // Create result list with all combined elements
@@ -4391,7 +4350,7 @@ int32_t franz_generic_get_type(Generic *g) {
   return (int32_t)g->type;
 }
 
-// franz_generic_get_pval(Generic*) -> void* (p_val field)
+// franz_generic_get_pval(Generic*) -> void* (p_val field; the char* itself for strings)
 void *franz_generic_get_pval(Generic *g) {
   if (!g) return NULL;
   return g->p_val;
@@ -4435,27 +4394,33 @@ Generic *franz_llvm_reduce(Generic *list, Generic *callback, Generic *initial, i
     acc = Generic_copy(initial);
   } else {
     // No initial value - use void
-    acc = Generic_new(TYPE_VOID, NULL, 0);
+    acc = Generic_void();
   }
 
+  // Boxed entry of the callback, looked up once for the whole list
+  const LLVMClosureStubs *stubs = franz_closure_stubs(callback, 3);
+  void *env = ((LLVMClosure *)callback->p_val)->envPtr;
+  TRACE(TRACE_LISTS, "reduce: %d elements, %s", input->len, stubs ? "boxed entry" : "franz_call_llvm_closure");
+
   // Iterate through list elements
   for (int i = 0; i < input->len; i++) {
     // Prepare arguments for callback: (accumulator, element, index)
-    Generic *elem = input->vals[i];
+    Generic *elem = List_at(input, i);
     Generic *index_gen = franz_box_int(i);
 
     Generic *callbackArgs[] = { acc, elem, index_gen };
 
     // Call the callback closure with (acc, element, index)
-    Generic *result = franz_call_llvm_closure(callback, callbackArgs, 3, lineNumber);
+    Generic *result = stubs ? stubs->boxed(env, callbackArgs)
+                            : franz_call_llvm_closure(callback, callbackArgs, 3, lineNumber);
 
-    // Clean up old accumulator
-    if (acc && acc->refCount == 0) {
+    // Clean up old accumulator (unless the callback returned it)
+    if (acc && acc != result && acc->refCount == 0) {
       Generic_free(acc);
     }
 
     // Clean up index Generic
-    if (index_gen->refCount == 0) {
+    if (index_gen != result && index_gen->refCount == 0) {
       Generic_free(index_gen);
     }
 
@@ -4573,7 +4538,7 @@ Generic *franz_llvm_set_ref(Generic *ref, Generic *value, int lineNumber) {
   Ref_set(ref_ptr, new_value);
 
   // Return TYPE_VOID
-  return Generic_new(TYPE_VOID, NULL, 0);
+  return Generic_void();
 }
 
 // ============================================================================
@@ -4594,8 +4559,8 @@ void *franz_get(Generic *collection, int64_t start, int64_t end_or_unused, int h
 
   if (collection->type == TYPE_STRING) {
     // String operations
-    char *str = *((char **)collection->p_val);
-    int len = strlen(str);
+    char *str = collection->strVal;
+    int len = String_length(str);
 
     if (start < 0 || start >= len) {
       fprintf(stderr, "Runtime Error: string index %lld out of bounds (length %d)\n",
@@ -4628,33 +4593,19 @@ void *franz_get(Generic *collection, int64_t start, int64_t end_or_unused, int h
     // List operations
     List *list = (List *)collection->p_val;
 
+    if (has_end) {
+      // Slice: view sharing the trie, see franz_list_slice
+      return franz_list_slice(collection, start, end_or_unused);
+    }
+
     if (start < 0 || start >= list->len) {
       fprintf(stderr, "Runtime Error: list index %lld out of bounds (length %d)\n",
               (long long)start, list->len);
       exit(1);
     }
 
-    if (!has_end) {
-      // Single element: return Generic*
-      return list->vals[start];
-    } else {
-      // Slice: return Generic* wrapping new List*
-      int64_t end = end_or_unused;
-      if (end < start || end > list->len) {
-        fprintf(stderr, "Runtime Error: list end index %lld out of bounds (start=%lld, length=%d)\n",
-                (long long)end, (long long)start, list->len);
-        exit(1);
-      }
-
-      int slice_len = end - start;
-      Generic **slice_vals = malloc(sizeof(Generic*) * slice_len);
-      for (int i = 0; i < slice_len; i++) {
-        slice_vals[i] = list->vals[start + i];
-      }
-
-      List *slice_list = List_new(slice_vals, slice_len);
-      return Generic_new(TYPE_LIST, slice_list, 0);
-    }
+    // Single element: return Generic*
+    return List_at(list, start);
   } else {
     fprintf(stderr, "Runtime Error: get requires string or list, got %s\n",
             getTypeString(collection->type));
@@ -4681,25 +4632,22 @@ void franz_print_generic(Generic *value) {
 
   switch (value->type) {
     case TYPE_INT: {
-      long long val = (long long)(*((int *)value->p_val));
-      printf("%lld", val);
+      printf("%lld", (long long) value->intVal);
       break;
     }
     case TYPE_FLOAT: {
-      double *p_float = (double *)value->p_val;
-      printf("%f", *p_float);
+      printf("%f", value->floatVal);
       break;
     }
     case TYPE_STRING: {
-      char **p_str = (char **)value->p_val;
-      printf("%s", *p_str);
+      printf("%s", value->strVal);
       break;
     }
     case TYPE_LIST: {
       List *l = (List *)value->p_val;
       printf("[");
       for (int i = 0; i < l->len; i++) {
-        franz_print_generic(l->vals[i]);
+        franz_print_generic(List_at(l, i));
         if (i < l->len - 1) printf(", ");
       }
       printf("]");
@@ -4751,10 +4699,10 @@ int64_t franz_unbox_int(Generic *generic) {
   }
 
   if (generic->type == TYPE_INT) {
-    return (int64_t)(*((int *)generic->p_val));
+    return (int64_t)(generic->intVal);
   } else if (generic->type == TYPE_FLOAT) {
     // Auto-convert float to int
-    return (int64_t)(*((double *)generic->p_val));
+    return (int64_t)(generic->floatVal);
   } else {
     fprintf(stderr, "Runtime Error: Cannot unbox %s to int\n",
             getTypeString(generic->type));
@@ -4771,10 +4719,10 @@ double franz_unbox_float(Generic *generic) {
   }
 
   if (generic->type == TYPE_FLOAT) {
-    return *((double *)generic->p_val);
+    return generic->floatVal;
   } else if (generic->type == TYPE_INT) {
     // Auto-convert int to float
-    return (double)(*((int *)generic->p_val));
+    return (double)(generic->intVal);
   } else {
     fprintf(stderr, "Runtime Error: Cannot unbox %s to float\n",
             getTypeString(generic->type));
@@ -4791,7 +4739,7 @@ char *franz_unbox_string(Generic *generic) {
   }
 
   if (generic->type == TYPE_STRING) {
-    return *((char **)generic->p_val);
+    return generic->strVal;
   } else {
     fprintf(stderr, "Runtime Error: Cannot unbox %s to string\n",
             getTypeString(generic->type));
@@ -4803,9 +4751,9 @@ char *franz_unbox_string(Generic *generic) {
 // Dict Runtime Wrappers for LLVM
 // ===========================================================================
 
-// franz_dict_new(capacity) -> Dict*
-void *franz_dict_new(int capacity) {
-  return Dict_new(capacity);
+// franz_dict_new(expected_size) -> Dict*, pre-sized for that many pairs
+void *franz_dict_new(int expected_size) {
+  return Dict_new(expected_size);
 }
 
 // franz_dict_set_inplace(dict, key, value) -> void
@@ -4864,78 +4812,73 @@ void *franz_unbox_dict(void *generic) {
 // franz_dict_map(dict_generic, closure_generic, lineNumber) -> Generic* (new dict)
 // Runtime fallback for dict_map - calls closure for each key-value pair
 void *franz_dict_map(void *dict_generic, void *closure_generic, int lineNumber) {
-  fprintf(stderr, "[RUNTIME DEBUG] franz_dict_map called at line %d\n", lineNumber);
-  fprintf(stderr, "[RUNTIME DEBUG] dict_generic=%p, closure_generic=%p\n", dict_generic, closure_generic);
+  TRACE(TRACE_DICTS, "dict_map: franz_dict_map called at line %d", lineNumber);
+  TRACE(TRACE_DICTS, "dict_map: dict_generic=%p, closure_generic=%p", dict_generic, closure_generic);
 
   Generic *dict_gen = (Generic *)dict_generic;
   Generic *closure_gen = (Generic *)closure_generic;
 
-  fprintf(stderr, "[RUNTIME DEBUG] dict_gen type=%d, closure_gen type=%d\n", dict_gen->type, closure_gen->type);
+  TRACE(TRACE_DICTS, "dict_map: dict_gen type=%d, closure_gen type=%d", dict_gen->type, closure_gen->type);
 
   if (dict_gen->type != TYPE_DICT) {
     fprintf(stderr, "Runtime Error @ Line %d: dict_map expects dict as first argument\n", lineNumber);
     exit(1);
   }
 
-  fprintf(stderr, "[RUNTIME DEBUG] Dict validation passed\n");
 
   Dict *dict = (Dict *)dict_gen->p_val;
-  Dict *new_dict = Dict_new(dict->capacity);
+  Dict *new_dict = Dict_new(dict->size);
 
-  fprintf(stderr, "[RUNTIME DEBUG] Starting iteration, capacity=%d\n", dict->capacity);
+  TRACE(TRACE_DICTS, "dict_map: Starting iteration, size=%d", dict->size);
 
   // Iterate through all entries
   int entry_count = 0;
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      entry_count++;
-      fprintf(stderr, "[RUNTIME DEBUG] Processing entry %d at bucket %d\n", entry_count, i);
+  int count;
+  DictEntry *entries = Dict_entries(dict, &count);
+  for (int i = 0; i < count; i++) {
+    DictEntry *entry = &entries[i];
 
-      Generic *key = entry->key;
-      Generic *value = entry->value;
+    entry_count++;
+    TRACE(TRACE_DICTS, "dict_map: Processing entry %d of %d", entry_count, count);
 
-      fprintf(stderr, "[RUNTIME DEBUG] key type=%d, value type=%d\n", key->type, value->type);
+    Generic *key = entry->key;
+    Generic *value = entry->value;
 
-      // Call closure with key and value
-      key->refCount++;
-      value->refCount++;
+    TRACE(TRACE_DICTS, "dict_map: key type=%d, value type=%d", key->type, value->type);
 
-      Generic *fn_args[] = {key, value};
+    // Call closure with key and value
+    key->refCount++;
+    value->refCount++;
 
-      fprintf(stderr, "[RUNTIME DEBUG] Calling closure with 2 args\n");
-      closure_gen->refCount++;
+    Generic *fn_args[] = {key, value};
 
-      // Check if LLVM closure or runtime closure
-      Generic *new_value;
-      if (closure_gen->type == TYPE_BYTECODE_CLOSURE) {
-        // LLVM closure - use special caller
-        fprintf(stderr, "[RUNTIME DEBUG] Detected LLVM closure, using franz_call_llvm_closure\n");
-        new_value = franz_call_llvm_closure(closure_gen, fn_args, 2, lineNumber);
-      } else {
-        // Runtime closure - use applyFunc
-        fprintf(stderr, "[RUNTIME DEBUG] Detected runtime closure, using applyFunc\n");
-        new_value = applyFunc(closure_gen, NULL, fn_args, 2, lineNumber);
-      }
+    closure_gen->refCount++;
 
-      closure_gen->refCount--;
+    // Check if LLVM closure or runtime closure
+    Generic *new_value;
+    if (closure_gen->type == TYPE_BYTECODE_CLOSURE) {
+      // LLVM closure - use special caller
+      new_value = franz_call_llvm_closure(closure_gen, fn_args, 2, lineNumber);
+    } else {
+      // Runtime closure - use applyFunc
+      new_value = applyFunc(closure_gen, NULL, fn_args, 2, lineNumber);
+    }
 
-      fprintf(stderr, "[RUNTIME DEBUG] Closure returned, new_value type=%d\n", new_value->type);
+    closure_gen->refCount--;
 
-      key->refCount--;
-      value->refCount--;
+    TRACE(TRACE_DICTS, "dict_map: Closure returned, new_value type=%d", new_value->type);
 
-      // Insert into new dict
-      Dict_set_inplace(new_dict, key, new_value);
+    key->refCount--;
+    value->refCount--;
 
-      if (new_value->refCount == 0) Generic_free(new_value);
+    // Insert into new dict
+    Dict_set_inplace(new_dict, key, new_value);
 
-      entry = entry->next;
-    }
+    if (new_value->refCount == 0) Generic_free(new_value);
   }
+  free(entries);
 
-  fprintf(stderr, "[RUNTIME DEBUG] Iteration complete, processed %d entries\n", entry_count);
-  fprintf(stderr, "[RUNTIME DEBUG] Returning new dict\n");
+  TRACE(TRACE_DICTS, "dict_map: Iteration complete, processed %d entries", entry_count);
 
   return Generic_new(TYPE_DICT, new_dict, 0);
 }
@@ -4943,96 +4886,91 @@ void *franz_dict_map(void *dict_generic, void *closure_generic, int lineNumber)
 // franz_dict_filter(dict_generic, closure_generic, lineNumber) -> Generic* (filtered dict)
 // Runtime fallback for dict_filter - keeps entries where closure returns truthy
 void *franz_dict_filter(void *dict_generic, void *closure_generic, int lineNumber) {
-  fprintf(stderr, "[RUNTIME DEBUG] franz_dict_filter called at line %d\n", lineNumber);
-  fprintf(stderr, "[RUNTIME DEBUG] dict_generic=%p, closure_generic=%p\n", dict_generic, closure_generic);
+  TRACE(TRACE_DICTS, "dict_filter: franz_dict_filter called at line %d", lineNumber);
+  TRACE(TRACE_DICTS, "dict_filter: dict_generic=%p, closure_generic=%p", dict_generic, closure_generic);
 
   Generic *dict_gen = (Generic *)dict_generic;
   Generic *closure_gen = (Generic *)closure_generic;
 
-  fprintf(stderr, "[RUNTIME DEBUG] dict_gen type=%d, closure_gen type=%d\n", dict_gen->type, closure_gen->type);
+  TRACE(TRACE_DICTS, "dict_filter: dict_gen type=%d, closure_gen type=%d", dict_gen->type, closure_gen->type);
 
   if (dict_gen->type != TYPE_DICT) {
     fprintf(stderr, "Runtime Error @ Line %d: dict_filter expects dict as first argument\n", lineNumber);
     exit(1);
   }
 
-  fprintf(stderr, "[RUNTIME DEBUG] Dict validation passed\n");
 
   Dict *dict = (Dict *)dict_gen->p_val;
-  Dict *new_dict = Dict_new(dict->capacity);
+  Dict *new_dict = Dict_new(dict->size);
 
-  fprintf(stderr, "[RUNTIME DEBUG] Starting iteration, capacity=%d\n", dict->capacity);
+  TRACE(TRACE_DICTS, "dict_filter: Starting iteration, size=%d", dict->size);
 
   // Iterate through all entries
   int entry_count = 0;
   int kept_count = 0;
-  for (int i = 0; i < dict->capacity; i++) {
-    DictEntry *entry = dict->buckets[i];
-    while (entry != NULL) {
-      entry_count++;
-      fprintf(stderr, "[RUNTIME DEBUG] Processing entry %d at bucket %d\n", entry_count, i);
-
-      Generic *key = entry->key;
-      Generic *value = entry->value;
+  int count;
+  DictEntry *entries = Dict_entries(dict, &count);
+  for (int i = 0; i < count; i++) {
+    DictEntry *entry = &entries[i];
 
-      fprintf(stderr, "[RUNTIME DEBUG] key type=%d, value type=%d\n", key->type, value->type);
+    entry_count++;
+    TRACE(TRACE_DICTS, "dict_filter: Processing entry %d of %d", entry_count, count);
 
-      // Call closure with key and value
-      key->refCount++;
-      value->refCount++;
+    Generic *key = entry->key;
+    Generic *value = entry->value;
 
-      Generic *fn_args[] = {key, value};
+    TRACE(TRACE_DICTS, "dict_filter: key type=%d, value type=%d", key->type, value->type);
 
-      fprintf(stderr, "[RUNTIME DEBUG] Calling closure with 2 args\n");
-      closure_gen->refCount++;
+    // Call closure with key and value
+    key->refCount++;
+    value->refCount++;
 
-      // Check if LLVM closure or runtime closure
-      Generic *result;
-      if (closure_gen->type == TYPE_BYTECODE_CLOSURE) {
-        // LLVM closure - use special caller
-        fprintf(stderr, "[RUNTIME DEBUG] Detected LLVM closure, using franz_call_llvm_closure\n");
-        result = franz_call_llvm_closure(closure_gen, fn_args, 2, lineNumber);
-      } else {
-        // Runtime closure - use applyFunc
-        fprintf(stderr, "[RUNTIME DEBUG] Detected runtime closure, using applyFunc\n");
-        result = applyFunc(closure_gen, NULL, fn_args, 2, lineNumber);
-      }
+    Generic *fn_args[] = {key, value};
 
-      closure_gen->refCount--;
+    closure_gen->refCount++;
 
-      fprintf(stderr, "[RUNTIME DEBUG] Closure returned, result type=%d\n", result->type);
+    // Check if LLVM closure or runtime closure
+    Generic *result;
+    if (closure_gen->type == TYPE_BYTECODE_CLOSURE) {
+      // LLVM closure - use special caller
+      result = franz_call_llvm_closure(closure_gen, fn_args, 2, lineNumber);
+    } else {
+      // Runtime closure - use applyFunc
+      result = applyFunc(closure_gen, NULL, fn_args, 2, lineNumber);
+    }
 
-      key->refCount--;
-      value->refCount--;
+    closure_gen->refCount--;
 
-      // Check if result is truthy (non-zero for int, non-void)
-      int keep = 0;
-      if (result->type == TYPE_INT) {
-        keep = (*((int *)result->p_val) != 0);
-        fprintf(stderr, "[RUNTIME DEBUG] Result is INT, value=%d, keep=%d\n", *((int *)result->p_val), keep);
-      } else if (result->type != TYPE_VOID) {
-        keep = 1;  // Non-void is truthy
-        fprintf(stderr, "[RUNTIME DEBUG] Result is non-void, keep=1\n");
-      } else {
-        fprintf(stderr, "[RUNTIME DEBUG] Result is void, keep=0\n");
-      }
+    TRACE(TRACE_DICTS, "dict_filter: Closure returned, result type=%d", result->type);
 
-      if (keep) {
-        Dict_set_inplace(new_dict, key, value);
-        kept_count++;
-        fprintf(stderr, "[RUNTIME DEBUG] Entry kept, total kept=%d\n", kept_count);
-      } else {
-        fprintf(stderr, "[RUNTIME DEBUG] Entry filtered out\n");
-      }
+    key->refCount--;
+    value->refCount--;
 
-      if (result->refCount == 0) Generic_free(result);
+    // Check if result is truthy (non-zero for int, non-void)
+    int keep = 0;
+    if (result->type == TYPE_INT) {
+      keep = (result->intVal != 0);
+      TRACE(TRACE_DICTS, "dict_filter: Result is INT, value=%lld, keep=%d", (long long) result->intVal, keep);
+    } else if (result->type != TYPE_VOID) {
+      keep = 1;  // Non-void is truthy
+      TRACE(TRACE_DICTS, "dict_filter: Result is non-void, keep=1");
+    } else {
+      TRACE(TRACE_DICTS, "dict_filter: Result is void, keep=0");
+    }
 
-      entry = entry->next;
+    if (keep) {
+      Dict_set_inplace(new_dict, key, value);
+      kept_count++;
+      TRACE(TRACE_DICTS, "dict_filter: Entry kept, total kept=%d", kept_count);
+    } else {
+      TRACE(TRACE_DICTS, "dict_filter: Entry filtered out");
     }
+
+    if (result->refCount == 0) Generic_free(result);
   }
+  free(entries);
 
-  fprintf(stderr, "[RUNTIME DEBUG] Iteration complete, processed %d entries, kept %d\n", entry_count, kept_count);
-  fprintf(stderr, "[RUNTIME DEBUG] Returning filtered dict\n");
+  TRACE(TRACE_DICTS, "dict_filter: Iteration complete, processed %d entries, kept %d", entry_count, kept_count);
 
   return Generic_new(TYPE_DICT, new_dict, 0);
 }
@@ -5052,19 +4990,17 @@ void *franz_dict_filter(void *dict_generic, void *closure_generic, int lineNumbe
 int franz_generic_is(void *a, void *b) {
   if (!a || !b) return 0;
 
-  fprintf(stderr, "[GENERIC IS DEBUG] Comparing Generic* %p and %p\n", a, b);
+  TRACE(TRACE_VALUES, "is: Comparing Generic* %p and %p", a, b);
   Generic *ga = (Generic *)a;
   Generic *gb = (Generic *)b;
-  fprintf(stderr, "[GENERIC IS DEBUG] Types: %d and %d\n", ga->type, gb->type);
+  TRACE(TRACE_VALUES, "is: Types: %d and %d", ga->type, gb->type);
 
   if (ga->type == TYPE_STRING && gb->type == TYPE_STRING) {
-    char *sa = *((char **)ga->p_val);
-    char *sb = *((char **)gb->p_val);
-    fprintf(stderr, "[GENERIC IS DEBUG] String comparison: '%s' vs '%s'\n", sa, sb);
+    TRACE(TRACE_VALUES, "is: String comparison: '%s' vs '%s'", ga->strVal, gb->strVal);
   }
 
   int result = Generic_is(ga, gb);
-  fprintf(stderr, "[GENERIC IS DEBUG] Result: %d\n", result);
+  TRACE(TRACE_VALUES, "is: Result: %d", result);
   return result;
 }
 
@@ -5091,16 +5027,16 @@ int franz_generic_is(void *a, void *b) {
  */
 const char* franz_get_type_string(void *generic_ptr) {
   if (!generic_ptr) {
-    fprintf(stderr, "[TYPE DEBUG] NULL pointer passed to franz_get_type_string\n");
+    TRACE(TRACE_VALUES, "type: NULL pointer passed to franz_get_type_string");
     return "void";
   }
 
   Generic *g = (Generic *)generic_ptr;
-  fprintf(stderr, "[TYPE DEBUG] Examining Generic* at %p, type=%d\n", generic_ptr, g->type);
+  TRACE(TRACE_VALUES, "type: Examining Generic* at %p, type=%d", generic_ptr, g->type);
 
   // Use getTypeString helper (defined in generic.c)
   const char *typeStr = getTypeString(g->type);
-  fprintf(stderr, "[TYPE DEBUG] Type string: '%s'\n", typeStr);
+  TRACE(TRACE_VALUES, "type: Type string: '%s'", typeStr);
 
   return typeStr;
 }
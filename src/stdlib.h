@@ -18,17 +18,33 @@ Generic *franz_box_pointer_smart(void *ptr);
 Generic *franz_box_param_tag(int64_t rawValue, int tag);
 Generic *franz_list_new(Generic **elements, int length);
 
+//  Interned strings (src/intern) for LLVM code
+Generic *franz_intern(Generic *string);
+Generic *franz_intern_find(Generic *string);
+char *franz_intern_text(char *text);
+
 //  Unbox Generic* to get closure i64 (for nested closures)
 int64_t franz_generic_to_closure_ptr(int64_t generic_i64);
 
+//  Closure arguments, for the boxed entries LLVMClosures_emitStubs generates
+int64_t franz_closure_arg(Generic *arg);
+int64_t franz_closure_arg_int(Generic *arg);
+double franz_closure_arg_float(Generic *arg);
+void *franz_closure_arg_pointer(Generic *arg);
+int32_t franz_generic_get_type(Generic *g);
+
 //  Industry-standard list operations (Rust-like)
 Generic *franz_list_head(Generic *list);
 Generic *franz_list_tail(Generic *list);
+Generic *franz_list_slice(Generic *list, int64_t start, int64_t end);
+Generic *franz_string_slice(Generic *string, int64_t start, int64_t end);
 Generic *franz_list_cons(Generic *elem, Generic *list);
 int64_t franz_list_is_empty(Generic *list);
 int64_t franz_list_length(Generic *list);
 Generic *franz_list_nth(Generic *list, int64_t index);
 int64_t franz_is_list(Generic *value);
+Generic *franz_list_range(int64_t count, int64_t lineNumber);
+int64_t franz_callback_list_length(Generic *list, char *caller, int64_t lineNumber);
 void franz_print_generic(Generic *value);
 
 // LLVM Filter
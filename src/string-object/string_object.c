@@ -0,0 +1,83 @@
+#include "string_object.h"
+#include "../slab/slab.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Length-Prefixed String Objects
+ *
+ * Header and text share one block, sized up to its slab class (or exactly,
+ * above the largest class, where Slab_alloc hands over to malloc). The block
+ * size is recomputed from capacity when the string is freed.
+ */
+
+char *String_new(int length) {
+  size_t blockSize = Slab_blockSize(sizeof(String) + length + 1);
+  String *string = Slab_alloc(blockSize, SLAB_STRING);
+  string->refCount = 1;
+  string->length = length;
+  string->capacity = (int) (blockSize - sizeof(String) - 1);
+  string->hash = 0;
+  string->text[length] = '\0';
+  return string->text;
+}
+
+char *String_fromBytes(const char *bytes, int length) {
+  char *text = String_new(length);
+  memcpy(text, bytes, length);
+  return text;
+}
+
+char *String_fromText(const char *text) {
+  return String_fromBytes(text, (int) strlen(text));
+}
+
+char *String_fromHeap(char *heap) {
+  char *text = String_fromText(heap);
+  free(heap);
+  return text;
+}
+
+void String_retain(char *text) {
+  String *string = String_of(text);
+  if (!String_isImmortal(string)) string->refCount++;
+}
+
+void String_release(char *text) {
+  String *string = String_of(text);
+  if (String_isImmortal(string)) return;
+  if (--string->refCount > 0) return;
+  Slab_free(string, sizeof(String) + string->capacity + 1, SLAB_STRING);
+}
+
+unsigned int String_hashBytes(const char *bytes, int length) {
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < length; i++) {
+    hash ^= (unsigned char) bytes[i];
+    hash *= 16777619u;
+  }
+
+  // Final mix (from MurmurHash3)
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash ? hash : 1;
+}
+
+unsigned int String_hash(const char *text) {
+  String *string = String_of(text);
+  if (string->hash == 0) string->hash = String_hashBytes(string->text, string->length);
+  return string->hash;
+}
+
+int String_equals(const char *a, const char *b) {
+  if (a == b) return 1;
+
+  String *first = String_of(a);
+  String *second = String_of(b);
+  if (first->length != second->length) return 0;
+  if (first->hash && second->hash && first->hash != second->hash) return 0;
+  return memcmp(a, b, first->length) == 0;
+}
@@ -0,0 +1,85 @@
+#ifndef STRING_OBJECT_H
+#define STRING_OBJECT_H
+
+#include <stddef.h>
+
+/**
+ * Length-Prefixed String Objects
+ *
+ * Every string a Generic holds is a String: a small header followed by the
+ * text itself, NUL-terminated, in the same block. Generic.strVal points at the
+ * text, so C code keeps reading it as a plain char*, while String_of() steps
+ * back to the header for the length, the cached hash and the refcount.
+ *
+ *   [ refCount | length | capacity | hash ][ text ... \0 ]
+ *                                           ^ strVal
+ *
+ * Short strings (a block of up to 272 bytes, so up to 255 bytes of text) come
+ * from the slab allocator like Generics do; longer ones are one malloc block.
+ * capacity is what the block can hold, so size classes leave some slack.
+ *
+ * A String is never changed after it is filled in, so Generic_copy shares it
+ * (refCount++) instead of duplicating the bytes. Strings baked into LLVM code
+ * and interned strings are immortal, like immortal Generics.
+ */
+
+#define STRING_IMMORTAL (1 << 30)
+
+typedef struct String {
+  int refCount;        // Generics holding the text; >= STRING_IMMORTAL / 2 never freed
+  int length;          // bytes of text, not counting the NUL (the text may contain NULs)
+  int capacity;        // bytes of text the block can hold
+  unsigned int hash;   // String_hash of the text, 0 until first asked for
+  char text[];
+} String;
+
+// Header of a text obtained from String_new / String_fromText / String_fromBytes
+static inline String *String_of(const char *text) {
+  return (String *) (text - offsetof(String, text));
+}
+
+static inline int String_length(const char *text) {
+  return String_of(text)->length;
+}
+
+static inline int String_isImmortal(String *string) {
+  return string->refCount >= STRING_IMMORTAL / 2;
+}
+
+/**
+ * Allocate a string of length bytes for the caller to fill in
+ *
+ * @param length Bytes of text (text[length] is set to NUL)
+ * @return The text, refCount 1 (owned by the caller, usually handed to Generic_newString)
+ */
+char *String_new(int length);
+
+// Copy length bytes (text may contain NULs) into a new string, refCount 1
+char *String_fromBytes(const char *bytes, int length);
+
+// Copy a NUL-terminated C string into a new string, refCount 1
+char *String_fromText(const char *text);
+
+// Move a malloc'd C string into a new string (the C string is freed), refCount 1
+char *String_fromHeap(char *heap);
+
+void String_retain(char *text);
+
+// Drop one reference, freeing the string at 0 (immortal strings are left alone)
+void String_release(char *text);
+
+/**
+ * Hash of the text (FNV-1a, then the MurmurHash3 final mix), cached in the header
+ *
+ * This is the hash Dict uses for string keys. It is never 0, so 0 can mean
+ * "not computed yet" and immortal strings emitted with their hash are never written.
+ */
+unsigned int String_hash(const char *text);
+
+// The same hash for bytes that are not (yet) a String
+unsigned int String_hashBytes(const char *bytes, int length);
+
+// 1 if the two texts are equal: length, then hash if both are known, then the bytes
+int String_equals(const char *a, const char *b);
+
+#endif
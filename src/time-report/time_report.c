@@ -0,0 +1,226 @@
+#include "time_report.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "../run.h"
+
+/**
+ * Compilation Time Report for Franz (--time-report)
+ *
+ * A growable table of stages, looked up by name. CPU time comes from
+ * getrusage() and includes waited-for child processes, so the linker and
+ * an --aot executable count towards "link" and "run". Peak RSS is the
+ * high-water mark of the franz process when the stage last ended.
+ */
+
+typedef enum TimeReportKind {
+  TIME_REPORT_STAGE,
+  TIME_REPORT_MODULE
+} TimeReportKind;
+
+typedef struct TimeReportStage {
+  char *name;
+  TimeReportKind kind;
+  int depth;            // Module nesting (0 for stages and top-level modules)
+  double wall;          // Accumulated wall time (seconds)
+  double cpu;           // Accumulated user + system CPU time (seconds)
+  long peakRssKb;       // Process peak RSS when the stage last ended
+  double wallStart;     // Monotonic start of the running interval, < 0 if stopped
+  double cpuStart;
+} TimeReportStage;
+
+static int timeReportEnabled = 0;
+static TimeReportFormat timeReportFormat = TIME_REPORT_TEXT;
+static TimeReportStage *stages = NULL;
+static int stageCount = 0;
+static int stageCapacity = 0;
+static int moduleDepth = 0;
+
+static double TimeReport_wallNow(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static double TimeReport_seconds(struct timeval tv) {
+  return (double)tv.tv_sec + (double)tv.tv_usec / 1e6;
+}
+
+static double TimeReport_cpuNow(void) {
+  struct rusage self, children;
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+  return TimeReport_seconds(self.ru_utime) + TimeReport_seconds(self.ru_stime) +
+         TimeReport_seconds(children.ru_utime) + TimeReport_seconds(children.ru_stime);
+}
+
+static long TimeReport_peakRssKb(void) {
+  struct rusage self;
+  getrusage(RUSAGE_SELF, &self);
+#ifdef __APPLE__
+  return self.ru_maxrss / 1024;  // bytes on macOS
+#else
+  return self.ru_maxrss;         // kilobytes on Linux
+#endif
+}
+
+static TimeReportStage *TimeReport_find(const char *name, TimeReportKind kind) {
+  for (int i = 0; i < stageCount; i++) {
+    if (stages[i].kind == kind && strcmp(stages[i].name, name) == 0) return &stages[i];
+  }
+
+  if (stageCount == stageCapacity) {
+    int capacity = stageCapacity ? stageCapacity * 2 : 32;
+    TimeReportStage *grown = realloc(stages, capacity * sizeof(TimeReportStage));
+    if (!grown) return NULL;
+    stages = grown;
+    stageCapacity = capacity;
+  }
+
+  char *copy = strdup(name);
+  if (!copy) return NULL;
+
+  TimeReportStage *entry = &stages[stageCount++];
+  entry->name = copy;
+  entry->kind = kind;
+  entry->depth = kind == TIME_REPORT_MODULE ? moduleDepth : 0;
+  entry->wall = 0.0;
+  entry->cpu = 0.0;
+  entry->peakRssKb = 0;
+  entry->wallStart = -1.0;
+  entry->cpuStart = 0.0;
+  return entry;
+}
+
+static void TimeReport_start(TimeReportStage *entry) {
+  entry->wallStart = TimeReport_wallNow();
+  entry->cpuStart = TimeReport_cpuNow();
+}
+
+static void TimeReport_stop(TimeReportStage *entry) {
+  if (entry->wallStart < 0) return;
+
+  entry->wall += TimeReport_wallNow() - entry->wallStart;
+  entry->cpu += TimeReport_cpuNow() - entry->cpuStart;
+  entry->peakRssKb = TimeReport_peakRssKb();
+  entry->wallStart = -1.0;
+}
+
+void TimeReport_enable(TimeReportFormat format) {
+  timeReportEnabled = 1;
+  timeReportFormat = format;
+}
+
+int TimeReport_isEnabled(void) {
+  return timeReportEnabled;
+}
+
+void TimeReport_begin(const char *stage) {
+  if (!timeReportEnabled) return;
+
+  TimeReportStage *entry = TimeReport_find(stage, TIME_REPORT_STAGE);
+  if (entry) TimeReport_start(entry);
+}
+
+void TimeReport_end(const char *stage) {
+  if (!timeReportEnabled) return;
+
+  TimeReportStage *entry = TimeReport_find(stage, TIME_REPORT_STAGE);
+  if (entry) TimeReport_stop(entry);
+}
+
+void TimeReport_beginModule(const char *path) {
+  if (!timeReportEnabled) return;
+
+  TimeReportStage *entry = TimeReport_find(path, TIME_REPORT_MODULE);
+  moduleDepth++;
+  if (entry) TimeReport_start(entry);
+}
+
+void TimeReport_endModule(const char *path) {
+  if (!timeReportEnabled) return;
+
+  TimeReportStage *entry = TimeReport_find(path, TIME_REPORT_MODULE);
+  if (moduleDepth > 0) moduleDepth--;
+  if (entry) TimeReport_stop(entry);
+}
+
+static void TimeReport_printJsonString(FILE *out, const char *text) {
+  fputc('"', out);
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+    if (*c == '"' || *c == '\\') {
+      fprintf(out, "\\%c", *c);
+    } else if (*c < 0x20) {
+      fprintf(out, "\\u%04x", *c);
+    } else {
+      fputc(*c, out);
+    }
+  }
+  fputc('"', out);
+}
+
+static void TimeReport_printText(FILE *out, double wall, double cpu, long peakRssKb) {
+  fprintf(out, "\n=== Franz time report ===\n");
+  fprintf(out, "  %-24s %10s %10s %10s\n", "stage", "wall ms", "cpu ms", "peak RSS");
+  for (int i = 0; i < stageCount; i++) {
+    TimeReportStage *entry = &stages[i];
+    char label[256];
+    if (entry->kind == TIME_REPORT_MODULE) {
+      snprintf(label, sizeof(label), "%*suse %s", 2 + 2 * entry->depth, "", entry->name);
+    } else {
+      snprintf(label, sizeof(label), "%s", entry->name);
+    }
+    fprintf(out, "  %-24s %10.3f %10.3f %7.1f MB\n", label,
+            entry->wall * 1000.0, entry->cpu * 1000.0, entry->peakRssKb / 1024.0);
+  }
+  fprintf(out, "  %-24s %10.3f %10.3f %7.1f MB\n", "total",
+          wall * 1000.0, cpu * 1000.0, peakRssKb / 1024.0);
+}
+
+static void TimeReport_printJson(FILE *out, double wall, double cpu, long peakRssKb) {
+  fprintf(out, "{\"franz_version\": ");
+  TimeReport_printJsonString(out, FRANZ_VERSION);
+  fprintf(out, ", \"stages\": [");
+  int printedStages = 0;
+  for (int i = 0; i < stageCount; i++) {
+    if (stages[i].kind != TIME_REPORT_STAGE) continue;
+    fprintf(out, "%s{\"name\": ", printedStages++ ? ", " : "");
+    TimeReport_printJsonString(out, stages[i].name);
+    fprintf(out, ", \"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"peak_rss_kb\": %ld}",
+            stages[i].wall * 1000.0, stages[i].cpu * 1000.0, stages[i].peakRssKb);
+  }
+  fprintf(out, "], \"modules\": [");
+  int printedModules = 0;
+  for (int i = 0; i < stageCount; i++) {
+    if (stages[i].kind != TIME_REPORT_MODULE) continue;
+    fprintf(out, "%s{\"path\": ", printedModules++ ? ", " : "");
+    TimeReport_printJsonString(out, stages[i].name);
+    fprintf(out, ", \"depth\": %d, \"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"peak_rss_kb\": %ld}",
+            stages[i].depth, stages[i].wall * 1000.0, stages[i].cpu * 1000.0, stages[i].peakRssKb);
+  }
+  fprintf(out, "], \"total\": {\"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"peak_rss_kb\": %ld}}\n",
+          wall * 1000.0, cpu * 1000.0, peakRssKb);
+}
+
+void TimeReport_print(FILE *out) {
+  if (!timeReportEnabled || stageCount == 0) return;
+
+  // A stage still running (the script called exit()) counts up to now
+  double wall = 0.0;
+  double cpu = 0.0;
+  for (int i = 0; i < stageCount; i++) {
+    TimeReport_stop(&stages[i]);
+    if (stages[i].kind == TIME_REPORT_STAGE) {
+      wall += stages[i].wall;
+      cpu += stages[i].cpu;
+    }
+  }
+  long peakRssKb = TimeReport_peakRssKb();
+
+  if (timeReportFormat == TIME_REPORT_JSON) {
+    TimeReport_printJson(out, wall, cpu, peakRssKb);
+  } else {
+    TimeReport_printText(out, wall, cpu, peakRssKb);
+  }
+}
@@ -0,0 +1,76 @@
+#ifndef TIME_REPORT_H
+#define TIME_REPORT_H
+
+#include <stdio.h>
+
+/**
+ * Compilation Time Report for Franz (--time-report)
+ *
+ * Accumulates wall time, CPU time and the peak resident set size per
+ * pipeline stage (read, lex, parse, codegen, optimize, emit, link, run, ...)
+ * and prints a table or a JSON object when the run ends. Stages are
+ * identified by name; timing the same stage twice adds up.
+ *
+ * Modules compiled for use()/use_as()/use_with() get their own entries.
+ * They run inside the codegen stage (and inside each other), so their times
+ * are a breakdown of that stage and are not added to the total.
+ *
+ * Disabled by default: every call returns immediately until
+ * TimeReport_enable() is called.
+ */
+
+typedef enum TimeReportFormat {
+  TIME_REPORT_TEXT,   // --time-report: aligned table
+  TIME_REPORT_JSON    // --time-report=json: one JSON object, for CI
+} TimeReportFormat;
+
+/**
+ * Turn on timing for this process
+ *
+ * @param format How TimeReport_print() writes the report
+ */
+void TimeReport_enable(TimeReportFormat format);
+
+/**
+ * Check whether --time-report is active
+ *
+ * @return 1 if enabled, 0 otherwise
+ */
+int TimeReport_isEnabled(void);
+
+/**
+ * Start timing a stage
+ *
+ * @param stage Stage name (copied)
+ */
+void TimeReport_begin(const char *stage);
+
+/**
+ * Stop timing a stage started with TimeReport_begin()
+ *
+ * @param stage Same name passed to TimeReport_begin()
+ */
+void TimeReport_end(const char *stage);
+
+/**
+ * Start timing the compilation of a module loaded by use()
+ *
+ * @param path Module path (copied)
+ */
+void TimeReport_beginModule(const char *path);
+
+/**
+ * Stop timing a module started with TimeReport_beginModule()
+ *
+ * @param path Same path passed to TimeReport_beginModule()
+ */
+void TimeReport_endModule(const char *path);
+
+/**
+ * Print every stage in first-started order, plus the total
+ *
+ * @param out Stream to print to (franz uses stderr or --time-report-file)
+ */
+void TimeReport_print(FILE *out);
+
+#endif // TIME_REPORT_H
@@ -53,8 +53,8 @@ TokenArray* TokenArray_new(void) {
   return arr;
 }
 
-//  Add token to array (O(1) amortized)
-void TokenArray_push(TokenArray *arr, char *val, enum TokenType type, int lineNumber) {
+//  Add token to array (O(1) amortized), text is a span of the source buffer
+void TokenArray_push(TokenArray *arr, const char *start, int length, enum TokenType type, int lineNumber) {
   if (arr == NULL) {
     fprintf(stderr, "Error: TokenArray is NULL\n");
     exit(1);
@@ -75,12 +75,20 @@ void TokenArray_push(TokenArray *arr, char *val, enum TokenType type, int lineNu
   }
 
   // Add token at end (O(1))
-  arr->tokens[arr->count].val = val;
+  arr->tokens[arr->count].start = start;
+  arr->tokens[arr->count].length = length;
+  arr->tokens[arr->count].owned = false;
   arr->tokens[arr->count].type = type;
   arr->tokens[arr->count].lineNumber = lineNumber;
   arr->count++;
 }
 
+//  Add token whose text is a heap string (decoded string literal), freed with the array
+void TokenArray_pushOwned(TokenArray *arr, char *val, enum TokenType type, int lineNumber) {
+  TokenArray_push(arr, val, strlen(val), type, lineNumber);
+  arr->tokens[arr->count - 1].owned = true;
+}
+
 //  Print token array
 void TokenArray_print(TokenArray *arr) {
   if (arr == NULL) {
@@ -90,21 +98,21 @@ void TokenArray_print(TokenArray *arr) {
 
   for (int i = 0; i < arr->count; i++) {
     Token *tok = &arr->tokens[i];
-    if (tok->val == NULL) {
+    if (tok->start == NULL) {
       printf("%i| %s\n", tok->lineNumber, getTokenTypeString(tok->type));
     } else {
-      printf("%i| %s: %s\n", tok->lineNumber, getTokenTypeString(tok->type), tok->val);
+      printf("%i| %s: %.*s\n", tok->lineNumber, getTokenTypeString(tok->type), tok->length, tok->start);
     }
   }
 }
 
-//  Free token array and all token values
+//  Free token array and the token values it owns (spans belong to the source buffer)
 void TokenArray_free(TokenArray *arr) {
   if (arr == NULL) return;
 
-  // Free all token values
+  // Free decoded string literals
   for (int i = 0; i < arr->count; i++) {
-    free(arr->tokens[i].val);
+    if (arr->tokens[i].owned) free((char *) arr->tokens[i].start);
   }
 
   // Free token array
@@ -1,5 +1,6 @@
 #ifndef TOKENS_H
 #define TOKENS_H
+#include <stdbool.h>
 
 enum TokenType {
   TOK_ASSIGNMENT,
@@ -26,8 +27,13 @@ enum TokenType {
 
 //  Industry-standard array-based token 
 // Individual token element (no p_next pointer - stored in array)
+// The text is a span of the source buffer, not a copy: it is not '\0'-terminated
+// and is only valid while the source buffer is. String literals with escape
+// codes are the exception, their decoded text is heap allocated (owned).
 typedef struct Token {
-  char *val;
+  const char *start;    // Token text (NULL for punctuation and keywords)
+  int length;           // Length of the text in bytes
+  bool owned;           // start is a heap copy freed by TokenArray_free
   enum TokenType type;
   int lineNumber;
 } Token;
@@ -45,7 +51,8 @@ char* getTokenTypeString(enum TokenType);
 
 //  Array-based token operations
 TokenArray* TokenArray_new(void);
-void TokenArray_push(TokenArray *arr, char *val, enum TokenType type, int lineNumber);
+void TokenArray_push(TokenArray *arr, const char *start, int length, enum TokenType type, int lineNumber);
+void TokenArray_pushOwned(TokenArray *arr, char *val, enum TokenType type, int lineNumber);
 void TokenArray_print(TokenArray *arr);
 void TokenArray_free(TokenArray *arr);
 
@@ -0,0 +1,232 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Runtime Tracing for Franz
+ *
+ * Each thread formats its records into its own ring: a fixed array of
+ * TRACE_LINE_SIZE lines and a count. The ring is malloc'd on the thread's
+ * first record and pushed on a global lock-free stack, which is how the exit
+ * and crash handlers find every thread's ring. Records are written as finished
+ * lines (timestamp, category, message, newline) so dumping is plain write(2)
+ * calls.
+ */
+
+typedef struct TraceRing {
+  struct TraceRing *next;
+  int thread;                      // 1 for the first thread that recorded
+  unsigned long count;             // Records ever made; the last TRACE_RING_SIZE are kept
+  unsigned short length[TRACE_RING_SIZE];
+  char lines[TRACE_RING_SIZE][TRACE_LINE_SIZE];
+} TraceRing;
+
+unsigned int Trace_categories = 0;
+
+static _Thread_local TraceRing *traceRing = NULL;
+static _Atomic(TraceRing *) traceRings = NULL;
+static atomic_int traceThreads = 0;
+static atomic_flag traceHandlersInstalled = ATOMIC_FLAG_INIT;
+static atomic_flag traceDumped = ATOMIC_FLAG_INIT;
+static struct timespec traceStart;
+
+static const struct {
+  const char *name;
+  TraceCategory category;
+} traceCategoryNames[] = {
+  {"closures", TRACE_CLOSURES},
+  {"lists", TRACE_LISTS},
+  {"dicts", TRACE_DICTS},
+  {"refs", TRACE_REFS},
+  {"modules", TRACE_MODULES},
+  {"values", TRACE_VALUES},
+};
+#define TRACE_CATEGORY_COUNT (int)(sizeof(traceCategoryNames) / sizeof(traceCategoryNames[0]))
+
+static const int traceFatalSignals[] = {SIGSEGV, SIGBUS, SIGABRT, SIGFPE, SIGILL};
+#define TRACE_FATAL_SIGNAL_COUNT (int)(sizeof(traceFatalSignals) / sizeof(traceFatalSignals[0]))
+
+static const char *Trace_categoryName(TraceCategory category) {
+  for (int i = 0; i < TRACE_CATEGORY_COUNT; i++) {
+    if (traceCategoryNames[i].category == category) return traceCategoryNames[i].name;
+  }
+  return "?";
+}
+
+int Trace_parse(const char *spec) {
+  if (!spec || *spec == '\0' || strcmp(spec, "all") == 0 || strcmp(spec, "1") == 0) return TRACE_ALL;
+  if (strcmp(spec, "0") == 0) return 0;
+
+  int categories = 0;
+  const char *start = spec;
+  while (*start) {
+    const char *end = strchr(start, ',');
+    size_t length = end ? (size_t)(end - start) : strlen(start);
+
+    int found = 0;
+    if (length == 3 && strncmp(start, "all", 3) == 0) {
+      categories |= TRACE_ALL;
+      found = 1;
+    }
+    for (int i = 0; i < TRACE_CATEGORY_COUNT && !found; i++) {
+      if (strlen(traceCategoryNames[i].name) == length && strncmp(start, traceCategoryNames[i].name, length) == 0) {
+        categories |= traceCategoryNames[i].category;
+        found = 1;
+      }
+    }
+    if (!found && length > 0) {
+      fprintf(stderr, "Error: Unknown trace category '%.*s'. Use closures, lists, dicts, refs, modules, values or all.\n",
+              (int)length, start);
+      return -1;
+    }
+
+    if (!end) break;
+    start = end + 1;
+  }
+  return categories;
+}
+
+static void Trace_write(int fd, const char *text, size_t length) {
+  while (length > 0) {
+    ssize_t n = write(fd, text, length);
+    if (n <= 0) return;
+    text += n;
+    length -= (size_t)n;
+  }
+}
+
+// Append text, or the decimal digits of value, to a dump header (no stdio in a signal handler)
+static void Trace_appendText(char *buffer, size_t *length, const char *text) {
+  size_t n = strlen(text);
+  memcpy(buffer + *length, text, n);
+  *length += n;
+}
+
+static void Trace_appendNumber(char *buffer, size_t *length, unsigned long value) {
+  char digits[24];
+  size_t count = 0;
+  do {
+    digits[count++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  while (count > 0) buffer[(*length)++] = digits[--count];
+}
+
+void Trace_dump(int fd) {
+  if (atomic_flag_test_and_set(&traceDumped)) return;
+
+  for (TraceRing *ring = atomic_load(&traceRings); ring; ring = ring->next) {
+    unsigned long count = ring->count;
+    unsigned long kept = count < TRACE_RING_SIZE ? count : TRACE_RING_SIZE;
+
+    char header[128];
+    size_t length = 0;
+    Trace_appendText(header, &length, "\n=== Franz trace: thread ");
+    Trace_appendNumber(header, &length, (unsigned long)ring->thread);
+    Trace_appendText(header, &length, ", ");
+    Trace_appendNumber(header, &length, count);
+    Trace_appendText(header, &length, " records");
+    if (kept < count) {
+      Trace_appendText(header, &length, " (last ");
+      Trace_appendNumber(header, &length, kept);
+      Trace_appendText(header, &length, " kept)");
+    }
+    Trace_appendText(header, &length, " ===\n");
+    Trace_write(fd, header, length);
+
+    for (unsigned long i = count - kept; i < count; i++) {
+      unsigned long slot = i % TRACE_RING_SIZE;
+      Trace_write(fd, ring->lines[slot], ring->length[slot]);
+    }
+  }
+}
+
+static void Trace_dumpAtExit(void) {
+  Trace_dump(STDERR_FILENO);
+}
+
+// Only async-signal-safe calls: write the rings and re-raise
+static void Trace_crashHandler(int sig) {
+  Trace_dump(STDERR_FILENO);
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
+void Trace_enable(unsigned int categories) {
+#ifdef FRANZ_NO_TRACE
+  if (categories) {
+    fprintf(stderr, "Warning: franz was built without tracing (make release); --trace is ignored.\n");
+  }
+  (void) categories;
+#else
+  Trace_categories = categories & TRACE_ALL;
+  if (!Trace_categories || atomic_flag_test_and_set(&traceHandlersInstalled)) return;
+
+  atexit(Trace_dumpAtExit);
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = Trace_crashHandler;
+  sigemptyset(&action.sa_mask);
+  for (int i = 0; i < TRACE_FATAL_SIGNAL_COUNT; i++) {
+    sigaction(traceFatalSignals[i], &action, NULL);
+  }
+#endif
+}
+
+// Give this thread a ring and make it visible to the dump
+static TraceRing *Trace_ring(void) {
+  TraceRing *ring = calloc(1, sizeof(TraceRing));
+  if (!ring) return NULL;
+  ring->thread = atomic_fetch_add(&traceThreads, 1) + 1;
+
+  ring->next = atomic_load(&traceRings);
+  while (!atomic_compare_exchange_weak(&traceRings, &ring->next, ring)) {
+  }
+  traceRing = ring;
+  return ring;
+}
+
+void Trace_record(TraceCategory category, const char *format, ...) {
+  TraceRing *ring = traceRing ? traceRing : Trace_ring();
+  if (!ring) return;
+
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  double seconds = (double)(now.tv_sec - traceStart.tv_sec) + (double)(now.tv_nsec - traceStart.tv_nsec) / 1e9;
+
+  unsigned long slot = ring->count % TRACE_RING_SIZE;
+  char *line = ring->lines[slot];
+  int length = snprintf(line, TRACE_LINE_SIZE, "%10.6f %-8s ", seconds, Trace_categoryName(category));
+
+  va_list args;
+  va_start(args, format);
+  if (length >= 0 && length < TRACE_LINE_SIZE - 1) {
+    int message = vsnprintf(line + length, (size_t)(TRACE_LINE_SIZE - 1 - length), format, args);
+    if (message > 0) length += message;
+  }
+  va_end(args);
+
+  if (length < 0) length = 0;
+  if (length > TRACE_LINE_SIZE - 2) length = TRACE_LINE_SIZE - 2;
+  line[length++] = '\n';
+  ring->length[slot] = (unsigned short)length;
+  ring->count++;
+}
+
+// $FRANZ_TRACE: franz itself and executables from franz build / --aot
+__attribute__((constructor))
+static void Trace_init(void) {
+  clock_gettime(CLOCK_MONOTONIC, &traceStart);
+
+  const char *spec = getenv("FRANZ_TRACE");
+  if (!spec || *spec == '\0') return;
+  int categories = Trace_parse(spec);
+  if (categories > 0) Trace_enable((unsigned int)categories);
+}
@@ -0,0 +1,91 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/**
+ * Runtime Tracing for Franz (--trace=, FRANZ_TRACE)
+ *
+ * The runtime used to print [RUNTIME DEBUG] / [LLVM FILTER] / ... lines to
+ * stderr on every closure call and every element. Those are now TRACE()
+ * records in one of a few categories, off unless asked for:
+ *
+ *   franz --trace=closures,lists script.franz
+ *   FRANZ_TRACE=all ./script          (an executable from franz build)
+ *
+ * A record is formatted into a ring buffer owned by the calling thread, so
+ * recording takes no lock and no I/O; only the last TRACE_RING_SIZE records
+ * of each thread are kept. The rings are written to stderr when the process
+ * exits, or when it dies on SIGSEGV / SIGBUS / SIGABRT / SIGFPE / SIGILL, so
+ * a crash shows what the runtime was doing just before it.
+ *
+ * With tracing off a TRACE() is one load and a predicted branch. Built with
+ * -DFRANZ_NO_TRACE (make release) it is compiled out: the arguments are not
+ * even evaluated.
+ */
+
+typedef enum TraceCategory {
+  TRACE_CLOSURES = 1 << 0,  // franz_call_llvm_closure, argument / result boxing
+  TRACE_LISTS    = 1 << 1,  // map / filter / reduce runtime helpers
+  TRACE_DICTS    = 1 << 2,  // dict_map / dict_filter
+  TRACE_REFS     = 1 << 3,  // ref / set! / deref
+  TRACE_MODULES  = 1 << 4,  // use / use_as / use_with
+  TRACE_VALUES   = 1 << 5,  // is, type, pointer boxing heuristics
+  TRACE_ALL      = (1 << 6) - 1
+} TraceCategory;
+
+// Records kept per thread
+#define TRACE_RING_SIZE 4096
+// Longest record, with its timestamp and category (longer ones are truncated)
+#define TRACE_LINE_SIZE 128
+
+// Categories being recorded (0: tracing off)
+extern unsigned int Trace_categories;
+
+#ifdef FRANZ_NO_TRACE
+#define TRACE(category, ...) ((void) 0)
+#else
+#define TRACE(category, ...)                                       \
+  do {                                                             \
+    if (__builtin_expect(Trace_categories & (category), 0)) {      \
+      Trace_record((category), __VA_ARGS__);                       \
+    }                                                              \
+  } while (0)
+#endif
+
+/**
+ * Parse a category list
+ *
+ * @param spec Comma-separated category names (closures, lists, dicts, refs,
+ *             modules, values) or "all"
+ * @return The categories, or -1 if a name is unknown (an error is printed)
+ */
+int Trace_parse(const char *spec);
+
+/**
+ * Start recording categories
+ *
+ * Installs the exit and crash handlers that write the rings. Called at
+ * startup with $FRANZ_TRACE, and by main for --trace=.
+ *
+ * @param categories TraceCategory bits
+ */
+void Trace_enable(unsigned int categories);
+
+/**
+ * Append a record to the calling thread's ring (use TRACE())
+ *
+ * @param category One TraceCategory
+ * @param format printf format of the message
+ */
+void Trace_record(TraceCategory category, const char *format, ...)
+  __attribute__((format(printf, 2, 3)));
+
+/**
+ * Write every thread's ring, oldest record first
+ *
+ * Only uses write(2), so it may run in a signal handler.
+ *
+ * @param fd File descriptor to write to
+ */
+void Trace_dump(int fd);
+
+#endif // TRACE_H